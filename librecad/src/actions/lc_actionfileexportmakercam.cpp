@@ -24,8 +24,6 @@
 
 #include "lc_actionfileexportmakercam.h"
 
-#include <fstream>
-
 #include <QAction>
 
 #include "rs_dialogfactory.h"
@@ -64,7 +62,7 @@ void LC_ActionFileExportMakerCam::trigger() {
 
                 RS_SETTINGS->beginGroup("/ExportMakerCam");
 
-				std::unique_ptr<LC_MakerCamSVG> generator(new LC_MakerCamSVG(new LC_XMLWriterQXmlStreamWriter(),
+				std::unique_ptr<LC_MakerCamSVG> generator(new LC_MakerCamSVG(new LC_XMLWriterQXmlStreamWriter(filename),
                                                                (bool)RS_SETTINGS->readNumEntry("/ExportInvisibleLayers"),
                                                                (bool)RS_SETTINGS->readNumEntry("/ExportConstructionLayers"),
                                                                (bool)RS_SETTINGS->readNumEntry("/WriteBlocksInline"),
@@ -72,17 +70,16 @@ void LC_ActionFileExportMakerCam::trigger() {
                                                                (bool)RS_SETTINGS->readNumEntry("/ExportImages"),
                                                                (bool)RS_SETTINGS->readNumEntry("/BakeDashDotLines"),
                                                                (double)RS_SETTINGS->readEntry("/DefaultElementWidth").toDouble(),
-                                                               (double)RS_SETTINGS->readEntry("/DefaultDashLinePatternLength").toDouble())
+                                                               (double)RS_SETTINGS->readEntry("/DefaultDashLinePatternLength").toDouble(),
+                                                               (bool)RS_SETTINGS->readNumEntry("/MergeConnectedPaths"))
 														  );
 
                 RS_SETTINGS->endGroup();
 
-                if (generator->generate(graphic)) {
+                // the document is written to the file while it is generated
+                if (!generator->generate(graphic)) {
 
-                    std::ofstream file;
-                    file.open(filename.toStdString());
-                    file << generator->resultAsString();
-                    file.close();
+                    RS_DIALOGFACTORY->commandMessage(tr("Cannot write file: %1").arg(filename));
                 }
             }
         }
@@ -31,6 +31,8 @@
 #include "rs_graphicview.h"
 #include "rs_information.h"
 #include "rs_hatch.h"
+#include "rs_line.h"
+#include "rs_spline.h"
 #include "rs_debug.h"
 
 RS_ActionDrawHatch::RS_ActionDrawHatch(RS_EntityContainer& container, RS_GraphicView& graphicView)
@@ -118,13 +120,16 @@ void RS_ActionDrawHatch::trigger() {
 
         if (e->isSelected()) {
             e->setSelected(false);
-			// entity is part of a complex entity (spline, polyline, ..):
-			if (e->getParent() &&
-// RVT - Don't de-delect the parent EntityPolyline, this is messing up the getFirst and getNext iterators
-//			    (e->getParent()->rtti()==RS2::EntitySpline ||
-//				 e->getParent()->rtti()==RS2::EntityPolyline)) {
-                (e->getParent()->rtti()==RS2::EntitySpline)) {
-                e->getParent()->setSelected(false);
+            if (e->rtti() == RS2::EntitySpline) {
+                // the contour follows the segments of the spline:
+                std::vector<RS_Vector> const& points
+                        = static_cast<RS_Spline*>(e)->getSegmentPoints();
+                for (size_t i = 1; i < points.size(); ++i) {
+                    RS_Line* line = new RS_Line{loop, points[i - 1], points[i]};
+                    line->setPen(RS_Pen(RS2::FlagInvalid));
+                    loop->addEntity(line);
+                }
+                continue;
             }
             RS_Entity* cp = e->clone();
             cp->setPen(RS_Pen(RS2::FlagInvalid));
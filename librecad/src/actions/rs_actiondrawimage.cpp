@@ -25,7 +25,7 @@
 **********************************************************************/
 #include<cmath>
 #include <QAction>
-#include <QImage>
+#include <QImageReader>
 #include <QMouseEvent>
 #include "rs_image.h"
 #include "rs_line.h"
@@ -42,7 +42,7 @@
 
 struct RS_ActionDrawImage::ImageData {
 	RS_ImageData data;
-	QImage img;
+	QSize size;
 };
 
 /**
@@ -73,7 +73,8 @@ void RS_ActionDrawImage::init(int status) {
 		//std::cout << "file: " << pImg->data.file << "\n";
 		//qDebug() << "file: " << pImg->data.file;
 
-		pImg->img = QImage(pImg->data.file);
+		// the preview only needs the size, don't decode the image
+		pImg->size = QImageReader(pImg->data.file).size();
 
         setStatus(SetTargetPoint);
     } else {
@@ -118,8 +119,8 @@ void RS_ActionDrawImage::mouseMoveEvent(QMouseEvent* e) {
         deletePreview();
 		//RS_Creation creation(preview, nullptr, false);
         //creation.createInsert(data);
-		double const w=pImg->img.width();
-		double const h=pImg->img.height();
+		double const w=pImg->size.width();
+		double const h=pImg->size.height();
 		RS_Line* line = new RS_Line{preview.get(), {0., 0.}, {w, 0.}};
         preview->addEntity(line);
 		line = new RS_Line{preview.get(), {w, 0.}, {w, h}};
@@ -31,6 +31,8 @@
 #include "rs_dialogfactory.h"
 #include "rs_graphicview.h"
 #include "rs_information.h"
+#include "rs_document.h"
+#include "lc_intersectionindex.h"
 #include "rs_circle.h"
 #include "rs_coordinateevent.h"
 #include "rs_preview.h"
@@ -75,8 +77,9 @@ void RS_ActionSnapIntersectionManual::trigger() {
     if (entity2 && entity2->isAtomic() &&
             entity1 && entity1->isAtomic()) {
 
-        RS_VectorSolutions sol =
-            RS_Information::getIntersection(entity1, entity2, false);
+        RS_VectorSolutions sol = document
+                ? document->getIntersectionIndex()->getIntersection(entity1, entity2, false)
+                : RS_Information::getIntersection(entity1, entity2, false);
 
         entity2 = NULL;
         entity1 = NULL;
@@ -109,8 +112,10 @@ void RS_ActionSnapIntersectionManual::mouseMoveEvent(QMouseEvent* e) {
             entity2 = se;
 			*coord = mouse;
 
-            RS_VectorSolutions sol =
-                RS_Information::getIntersection(entity1, entity2, false);
+            // the index caches the solution while the mouse stays on the entities
+            RS_VectorSolutions sol = document
+                    ? document->getIntersectionIndex()->getIntersection(entity1, entity2, false)
+                    : RS_Information::getIntersection(entity1, entity2, false);
 
             //for (int i=0; i<sol.getNumber(); i++) {
             //    ip = sol.get(i);
@@ -60,11 +60,13 @@ void RS_ActionToolRegenerateDimensions::trigger() {
 			if (((RS_Dimension*)e)->getLabel()==";;") {
 				((RS_Dimension*)e)->setLabel("");
 			}
-            ((RS_Dimension*)e)->updateDim(true);
+            // regenerated when drawn:
+            ((RS_Dimension*)e)->invalidateDim(true);
         }
     }
 
     if (num>0) {
+        container->invalidateBorders();
     	graphicView->redraw();
         RS_DIALOGFACTORY->commandMessage(
             tr("Regenerated %1 dimension entities").arg(num));
@@ -40,7 +40,24 @@
 #include "rs_coordinateevent.h"
 #include "rs_entitycontainer.h"
 #include "rs_pen.h"
+#include "rs_document.h"
+#include "rs_layerlist.h"
 #include "rs_debug.h"
+#include "lc_trace.h"
+
+namespace {
+//size of the cursor cells sharing nearby entities, in pixels
+const int snapCellSize = 32;
+//range around a cell in which entities are collected, in pixels
+const int snapCellRange = 64;
+
+//! @return revision of the layers of the document, hiding or locking them changes the snap
+unsigned long layerRevision(RS_Document* doc)
+{
+	RS_LayerList* layers = doc ? doc->getLayerList() : nullptr;
+	return layers ? layers->getRevision() : 0;
+}
+}
 
 struct RS_Snapper::Indicator
 {
@@ -56,6 +73,27 @@ struct RS_Snapper::Indicator
 struct RS_Snapper::ImpData {
 RS_Vector snapCoord;
 RS_Vector snapSpot;
+
+//! \{ entities near the cursor cell, valid for one revision and view
+RS_EntityContainer nearby{nullptr, false};
+unsigned long revision = 0;
+unsigned long layerRevision = 0;
+unsigned entityCount = 0;
+RS_Vector factor{false};
+int offsetX = 0;
+int offsetY = 0;
+QPoint cell{-1, -1};
+//! \}
+
+//! \{ snap result for the last cursor position
+bool spotCached = false;
+QPoint pos;
+RS_SnapMode snapMode;
+int middlePoints = 0;
+double snapDistance = 0.;
+RS_Vector cachedSpot;
+RS_Entity* cachedKeyEntity = nullptr;
+//! \}
 };
 
 /**
@@ -162,7 +200,7 @@ RS_SnapMode* RS_Snapper::getSnapMode() {
 //get current mouse coordinates
 RS_Vector RS_Snapper::snapFree(QMouseEvent* e) {
 	if (!e) {
-                RS_DEBUG->print(RS_Debug::D_WARNING,
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_Snapper::snapFree: event is nullptr");
         return RS_Vector(false);
     }
@@ -180,11 +218,12 @@ RS_Vector RS_Snapper::snapFree(QMouseEvent* e) {
  */
 RS_Vector RS_Snapper::snapPoint(QMouseEvent* e)
 {
+	LC_TRACE_SCOPE("snap", "snapPoint");
 	pImpData->snapSpot = RS_Vector(false);
     RS_Vector t(false);
 
 	if (!e) {
-                RS_DEBUG->print(RS_Debug::D_WARNING,
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_Snapper::snapPoint: event is nullptr");
 		return pImpData->snapSpot;
     }
@@ -192,71 +231,83 @@ RS_Vector RS_Snapper::snapPoint(QMouseEvent* e)
     RS_Vector mouseCoord = graphicView->toGraph(e->x(), e->y());
     double ds2Min=RS_MAXDOUBLE*RS_MAXDOUBLE;
 
-    if (snapMode.snapEndpoint) {
-        t = snapEndpoint(mouseCoord);
-		double ds2=mouseCoord.squaredTo(t);
+    //this is still brutal force
+    //todo: accept value from widget QG_SnapMiddleOptions
+    if (snapMode.snapMiddle)
+        RS_DIALOGFACTORY->requestSnapMiddleOptions(middlePoints, snapMode.snapMiddle);
+    //todo: accept value from widget QG_SnapDistOptions
+    if (snapMode.snapDistance)
+        RS_DIALOGFACTORY->requestSnapDistOptions(m_SnapDistance, snapMode.snapDistance);
+
+    if (isSnapCached(e->pos())) {
+        pImpData->snapSpot = pImpData->cachedSpot;
+        keyEntity = pImpData->cachedKeyEntity;
+    } else {
+        updateNearby(e->pos());
+
+        if (snapMode.snapEndpoint) {
+            t = snapNearby(&RS_Snapper::snapEndpoint, mouseCoord);
+			double ds2=mouseCoord.squaredTo(t);
 
-        if (ds2 < ds2Min){
-            ds2Min=ds2;
-			pImpData->snapSpot = t;
+            if (ds2 < ds2Min){
+                ds2Min=ds2;
+				pImpData->snapSpot = t;
+            }
         }
-    }
-    if (snapMode.snapCenter) {
-        t = snapCenter(mouseCoord);
-		double ds2=mouseCoord.squaredTo(t);
-        if (ds2 < ds2Min){
-            ds2Min=ds2;
-			pImpData->snapSpot = t;
+        if (snapMode.snapCenter) {
+            t = snapCenter(mouseCoord);
+			double ds2=mouseCoord.squaredTo(t);
+            if (ds2 < ds2Min){
+                ds2Min=ds2;
+				pImpData->snapSpot = t;
+            }
         }
-    }
-    if (snapMode.snapMiddle) {
-        //this is still brutal force
-        //todo: accept value from widget QG_SnapMiddleOptions
-		RS_DIALOGFACTORY->requestSnapMiddleOptions(middlePoints, snapMode.snapMiddle);
-        t = snapMiddle(mouseCoord);
-		double ds2=mouseCoord.squaredTo(t);
-        if (ds2 < ds2Min){
-            ds2Min=ds2;
-			pImpData->snapSpot = t;
+        if (snapMode.snapMiddle) {
+            t = snapNearby(&RS_Snapper::snapMiddle, mouseCoord);
+			double ds2=mouseCoord.squaredTo(t);
+            if (ds2 < ds2Min){
+                ds2Min=ds2;
+				pImpData->snapSpot = t;
+            }
         }
-    }
-    if (snapMode.snapDistance) {
-        //this is still brutal force
-        //todo: accept value from widget QG_SnapDistOptions
-		RS_DIALOGFACTORY->requestSnapDistOptions(m_SnapDistance, snapMode.snapDistance);
-        t = snapDist(mouseCoord);
-		double ds2=mouseCoord.squaredTo(t);
-        if (ds2 < ds2Min){
-            ds2Min=ds2;
-			pImpData->snapSpot = t;
+        if (snapMode.snapDistance) {
+            t = snapNearby(&RS_Snapper::snapDist, mouseCoord);
+			double ds2=mouseCoord.squaredTo(t);
+            if (ds2 < ds2Min){
+                ds2Min=ds2;
+				pImpData->snapSpot = t;
+            }
         }
-    }
-    if (snapMode.snapIntersection) {
-        t = snapIntersection(mouseCoord);
-		double ds2=mouseCoord.squaredTo(t);
-        if (ds2 < ds2Min){
-            ds2Min=ds2;
-			pImpData->snapSpot = t;
+        if (snapMode.snapIntersection) {
+            t = snapNearby(&RS_Snapper::snapIntersection, mouseCoord);
+			double ds2=mouseCoord.squaredTo(t);
+            if (ds2 < ds2Min){
+                ds2Min=ds2;
+				pImpData->snapSpot = t;
+            }
         }
-    }
 
-    if (snapMode.snapOnEntity &&
-		pImpData->snapSpot.distanceTo(mouseCoord) > snapMode.distance) {
-        t = snapOnEntity(mouseCoord);
-		double ds2=mouseCoord.squaredTo(t);
-        if (ds2 < ds2Min){
-            ds2Min=ds2;
-			pImpData->snapSpot = t;
+        if (snapMode.snapOnEntity &&
+			pImpData->snapSpot.distanceTo(mouseCoord) > snapMode.distance) {
+            t = snapNearby(&RS_Snapper::snapOnEntity, mouseCoord);
+			double ds2=mouseCoord.squaredTo(t);
+            if (ds2 < ds2Min){
+                ds2Min=ds2;
+				pImpData->snapSpot = t;
+            }
         }
-    }
 
-    if (snapMode.snapGrid) {
-        t = snapGrid(mouseCoord);
-		double ds2=mouseCoord.squaredTo(t);
-        if (ds2 < ds2Min){
+        if (snapMode.snapGrid) {
+            t = snapGrid(mouseCoord);
+			double ds2=mouseCoord.squaredTo(t);
+            if (ds2 < ds2Min){
 //            ds2Min=ds2;
-			pImpData->snapSpot = t;
+				pImpData->snapSpot = t;
+            }
         }
+
+        pImpData->cachedSpot = pImpData->snapSpot;
+        pImpData->cachedKeyEntity = keyEntity;
     }
 
 	if( !pImpData->snapSpot.valid ) {
@@ -321,6 +372,92 @@ RS_Vector RS_Snapper::snapPoint(const RS_Vector& coord, bool setSpot)
     }
     return coord;
 }
+/**
+ * @return true if the snap spot for the cursor at pos is known already:
+ * neither the cursor, the document, the view nor the snap mode changed.
+ * Entities growing in place, like a polyline while it's drawn, change
+ * the document revision as well.
+ */
+bool RS_Snapper::isSnapCached(const QPoint& pos)
+{
+	ImpData& d = *pImpData;
+	RS_Document* doc = container->getDocument();
+	bool const cached = d.spotCached && doc && pos == d.pos
+			&& doc->getRevision() == d.revision && layerRevision(doc) == d.layerRevision
+			&& container->count() == d.entityCount
+			&& graphicView->getFactor() == d.factor
+			&& graphicView->getOffsetX() == d.offsetX && graphicView->getOffsetY() == d.offsetY
+			&& snapMode == d.snapMode && middlePoints == d.middlePoints
+			&& m_SnapDistance == d.snapDistance;
+
+	d.spotCached = doc != nullptr;
+	d.pos = pos;
+	d.snapMode = snapMode;
+	d.middlePoints = middlePoints;
+	d.snapDistance = m_SnapDistance;
+	return cached;
+}
+
+/**
+ * Collects the entities near the cursor cell of pos, unless the cell,
+ * the document and the view are unchanged.
+ */
+void RS_Snapper::updateNearby(const QPoint& pos)
+{
+	ImpData& d = *pImpData;
+	RS_Document* doc = container->getDocument();
+	unsigned long const revision = doc ? doc->getRevision() : 0;
+	unsigned long const layers = layerRevision(doc);
+	QPoint const cell(pos.x() / snapCellSize, pos.y() / snapCellSize);
+	if (doc && cell == d.cell && revision == d.revision && layers == d.layerRevision
+			&& container->count() == d.entityCount
+			&& graphicView->getFactor() == d.factor
+			&& graphicView->getOffsetX() == d.offsetX && graphicView->getOffsetY() == d.offsetY)
+		return;
+
+	d.cell = cell;
+	d.revision = revision;
+	d.layerRevision = layers;
+	d.entityCount = container->count();
+	d.factor = graphicView->getFactor();
+	d.offsetX = graphicView->getOffsetX();
+	d.offsetY = graphicView->getOffsetY();
+
+	// cell in drawing coordinates, grown by the range:
+	int const x0 = cell.x() * snapCellSize - snapCellRange;
+	int const y0 = cell.y() * snapCellSize - snapCellRange;
+	int const size = snapCellSize + 2 * snapCellRange;
+	RS_Vector const vpMin = graphicView->toGraph(x0, y0 + size);
+	RS_Vector const vpMax = graphicView->toGraph(x0 + size, y0);
+
+	d.nearby.clear();
+	for (RS_Entity* e: *container) {
+		RS_Vector const eMin = e->getMin();
+		RS_Vector const eMax = e->getMax();
+		if (eMax.x >= vpMin.x && eMin.x <= vpMax.x && eMax.y >= vpMin.y && eMin.y <= vpMax.y)
+			d.nearby.addEntity(e);
+	}
+}
+
+/**
+ * Runs the snap function on the entities near the cursor only. Results
+ * within the range are exact, as all entities in range were collected.
+ * Otherwise all entities are searched.
+ */
+RS_Vector RS_Snapper::snapNearby(RS_Vector (RS_Snapper::*snapFunction)(const RS_Vector&),
+								 const RS_Vector& coord)
+{
+	RS_EntityContainer* const all = container;
+	container = &pImpData->nearby;
+	RS_Vector vp = (this->*snapFunction)(coord);
+	container = all;
+
+	double const range = (snapCellRange - 1) / graphicView->getFactor().x;
+	if (!vp.valid || coord.squaredTo(vp) > range * range)
+		vp = (this->*snapFunction)(coord);
+	return vp;
+}
+
 double RS_Snapper::getSnapRange() const
 {
 	if(graphicView )
@@ -514,7 +651,7 @@ RS_Vector RS_Snapper::restrictVertical(const RS_Vector& coord) {
 RS_Entity* RS_Snapper::catchEntity(const RS_Vector& pos,
                                    RS2::ResolveLevel level) {
 
-    RS_DEBUG->print("RS_Snapper::catchEntity");
+    RS_DEBUG_PRINT_DEBUG("RS_Snapper::catchEntity");
 
         // set default distance for points inside solids
     double dist (0.);
@@ -529,13 +666,13 @@ RS_Entity* RS_Snapper::catchEntity(const RS_Vector& pos,
 
 	if (entity && dist<=getSnapRange()) {
         // highlight:
-        RS_DEBUG->print("RS_Snapper::catchEntity: found: %d", idx);
+        RS_DEBUG_PRINT_DEBUG("RS_Snapper::catchEntity: found: %d", idx);
         return entity;
     } else {
-        RS_DEBUG->print("RS_Snapper::catchEntity: not found");
+        RS_DEBUG_PRINT_DEBUG("RS_Snapper::catchEntity: not found");
 		return nullptr;
     }
-    RS_DEBUG->print("RS_Snapper::catchEntity: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_Snapper::catchEntity: OK");
 }
 
 
@@ -551,7 +688,7 @@ RS_Entity* RS_Snapper::catchEntity(const RS_Vector& pos,
 RS_Entity* RS_Snapper::catchEntity(const RS_Vector& pos, RS2::EntityType enType,
                                    RS2::ResolveLevel level) {
 
-    RS_DEBUG->print("RS_Snapper::catchEntity");
+    RS_DEBUG_PRINT_DEBUG("RS_Snapper::catchEntity");
 //                    std::cout<<"RS_Snapper::catchEntity(): enType= "<<enType<<std::endl;
 
     // set default distance for points inside solids
@@ -601,10 +738,10 @@ RS_Entity* RS_Snapper::catchEntity(const RS_Vector& pos, RS2::EntityType enType,
 
 	if (entity && dist<=getSnapRange()) {
         // highlight:
-        RS_DEBUG->print("RS_Snapper::catchEntity: found: %d", idx);
+        RS_DEBUG_PRINT_DEBUG("RS_Snapper::catchEntity: found: %d", idx);
         return entity;
     } else {
-        RS_DEBUG->print("RS_Snapper::catchEntity: not found");
+        RS_DEBUG_PRINT_DEBUG("RS_Snapper::catchEntity: not found");
 		return nullptr;
     }
 }
@@ -36,6 +36,7 @@ class RS_GraphicView;
 class RS_Vector;
 class RS_Preview;
 class QMouseEvent;
+class QPoint;
 class RS_EntityContainer;
 
 /**
@@ -178,6 +179,10 @@ public:
 protected:
     void deleteSnapper();
     double getSnapRange() const;
+    bool isSnapCached(const QPoint& pos);
+    void updateNearby(const QPoint& pos);
+    RS_Vector snapNearby(RS_Vector (RS_Snapper::*snapFunction)(const RS_Vector&),
+                         const RS_Vector& coord);
     RS_EntityContainer* container;
     RS_GraphicView* graphicView;
 	RS_Entity* keyEntity;
@@ -0,0 +1,155 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <cstdio>
+#include <map>
+#include <memory>
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <QThread>
+
+#include "lc_trace.h"
+
+namespace {
+
+struct TraceEvent {
+    const char* category;
+    const char* name;
+    qint64 start;
+    qint64 end;
+    quintptr thread;
+};
+
+/** Allocated when tracing is enabled for the first time. */
+std::unique_ptr<TraceEvent[]> events;
+/** Number of events recorded, the next one goes to recorded % Capacity. */
+std::atomic<quint64> recorded {0};
+
+const QElapsedTimer& traceClock()
+{
+    static const QElapsedTimer timer = []() -> QElapsedTimer {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return timer;
+}
+
+/** Appends s as JSON string, names are expected to be plain ASCII. */
+void appendString(QByteArray& out, const char* s)
+{
+    out += '"';
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\')
+            out += '\\';
+        out += *s;
+    }
+    out += '"';
+}
+
+}
+
+std::atomic<bool> LC_Trace::enabled {false};
+
+
+void LC_Trace::setEnabled(bool on)
+{
+    if (on && !events) {
+        events.reset(new TraceEvent[Capacity]);
+        traceClock();
+    }
+    enabled.store(on);
+}
+
+
+void LC_Trace::clear()
+{
+    recorded.store(0);
+}
+
+
+qint64 LC_Trace::now()
+{
+    return traceClock().nsecsElapsed();
+}
+
+
+void LC_Trace::record(const char* category, const char* name,
+                      qint64 start, qint64 end)
+{
+    if (!events)
+        return;
+
+    quint64 i = recorded.fetch_add(1, std::memory_order_relaxed);
+    TraceEvent& e = events[i % Capacity];
+    e.category = category;
+    e.name = name;
+    e.start = start;
+    e.end = end;
+    e.thread = reinterpret_cast<quintptr>(QThread::currentThreadId());
+}
+
+
+/**
+ * Writes the events as "complete" events, with timestamps and durations
+ * in microseconds. Threads are numbered in the order of their first event.
+ */
+bool LC_Trace::write(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    quint64 count = recorded.load();
+    quint64 first = count > quint64(Capacity) ? count - Capacity : 0;
+    std::map<quintptr, int> threads;
+
+    QByteArray out("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    char number[128];
+
+    for (quint64 i = first; events && i < count; ++i) {
+        const TraceEvent& e = events[i % Capacity];
+        auto t = threads.insert(std::make_pair(e.thread, int(threads.size()) + 1));
+
+        if (i > first)
+            out += ",\n";
+        out += "{\"ph\":\"X\",\"pid\":1,\"cat\":";
+        appendString(out, e.category);
+        out += ",\"name\":";
+        appendString(out, e.name);
+        std::snprintf(number, sizeof(number), ",\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                      t.first->second, e.start / 1000.0, (e.end - e.start) / 1000.0);
+        out += number;
+
+        if (out.size() > (1 << 20)) {
+            file.write(out);
+            out.clear();
+        }
+    }
+
+    out += "\n]}\n";
+    return file.write(out) == out.size();
+}
@@ -0,0 +1,107 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#ifndef LC_TRACE_H
+#define LC_TRACE_H
+
+#include <atomic>
+#include <QtGlobal>
+
+class QString;
+
+/**
+ * Traces the time spent in scopes, for finding out where the time of a
+ * slow operation goes.
+ *
+ * Use LC_TRACE_SCOPE("category", "name") at the start of a scope. While
+ * tracing is off, this costs one test of a flag. While it is on, the start
+ * and the end of the scope are recorded in a ring buffer, which holds the
+ * last Capacity events. Category and name must be string literals, or
+ * other strings which live until the trace is written.
+ *
+ * The trace is written in the Chrome trace event format, which can be
+ * viewed with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Defining LC_NO_TRACE removes all trace scopes at compile time.
+ */
+class LC_Trace {
+public:
+    static const int Capacity = 1 << 16;
+
+    static bool isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+    static void setEnabled(bool on);
+    /** Forgets all recorded events. */
+    static void clear();
+
+    /** @return nanoseconds since the start of the program. */
+    static qint64 now();
+    static void record(const char* category, const char* name,
+                       qint64 start, qint64 end);
+
+    /** Writes the recorded events as Chrome trace JSON. */
+    static bool write(const QString& fileName);
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+
+/**
+ * Records the time from its construction to its destruction.
+ */
+class LC_TraceScope {
+public:
+    LC_TraceScope(const char* category, const char* name)
+        : category(category), name(name),
+          start(LC_Trace::isEnabled() ? LC_Trace::now() : -1) {}
+
+    ~LC_TraceScope() {
+        if (start >= 0)
+            LC_Trace::record(category, name, start, LC_Trace::now());
+    }
+
+    LC_TraceScope(const LC_TraceScope&) = delete;
+    LC_TraceScope& operator = (const LC_TraceScope&) = delete;
+
+private:
+    const char* category;
+    const char* name;
+    qint64 start;
+};
+
+
+#ifndef LC_NO_TRACE
+#define LC_TRACE_CONCAT2(a, b) a##b
+#define LC_TRACE_CONCAT(a, b) LC_TRACE_CONCAT2(a, b)
+#define LC_TRACE_SCOPE(category, name) \
+    LC_TraceScope LC_TRACE_CONCAT(lcTraceScope, __LINE__)(category, name)
+#else
+#define LC_TRACE_SCOPE(category, name) do {} while (false)
+#endif
+
+#endif
+// EOF
@@ -32,10 +32,101 @@
 #include <cstdarg>
 #include <QString>
 
+#include <QByteArray>
 #include <QDateTime>
 #include <QDebug>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QThread>
+#include <QWaitCondition>
+
+namespace {
+
+/**
+ * Writes the messages of RS_Debug in a thread of its own, so printing
+ * doesn't wait for the stream. The thread is started with the first
+ * message and stopped at program exit, after writing all messages.
+ */
+class DebugWriter : public QThread {
+public:
+    ~DebugWriter() {
+        mutex.lock();
+        stopping = true;
+        wake.wakeAll();
+        mutex.unlock();
+        wait();
+    }
+
+    void write(FILE* stream, const QByteArray& line) {
+        QMutexLocker locker(&mutex);
+        if (stopping) {
+            fwrite(line.constData(), 1, line.size(), stream);
+            fflush(stream);
+            return;
+        }
+        queue.append(qMakePair(stream, line));
+        if (!started) {
+            started = true;
+            start(QThread::LowPriority);
+        }
+        wake.wakeOne();
+    }
+
+    void flush() {
+        QMutexLocker locker(&mutex);
+        while (!queue.isEmpty() || busy)
+            idle.wait(&mutex);
+    }
+
+protected:
+    void run() override {
+        QMutexLocker locker(&mutex);
+        for (;;) {
+            while (queue.isEmpty() && !stopping)
+                wake.wait(&mutex);
+            if (queue.isEmpty())
+                break;
+
+            QList<QPair<FILE*, QByteArray>> lines;
+            lines.swap(queue);
+            busy = true;
+            locker.unlock();
+
+            FILE* last = nullptr;
+            for (auto const& l: lines) {
+                if (last && last != l.first)
+                    fflush(last);
+                fwrite(l.second.constData(), 1, l.second.size(), l.first);
+                last = l.first;
+            }
+            fflush(last);
+
+            locker.relock();
+            busy = false;
+            idle.wakeAll();
+        }
+    }
+
+private:
+    QMutex mutex;
+    QWaitCondition wake;
+    QWaitCondition idle;
+    QList<QPair<FILE*, QByteArray>> queue;
+    bool started {false};
+    bool busy {false};
+    bool stopping {false};
+};
+
+DebugWriter& writer() {
+    static DebugWriter w;
+    return w;
+}
+
+}
 
 RS_Debug* RS_Debug::uniqueInstance = nullptr;
+std::atomic<int> RS_Debug::currentLevel {RS_Debug::D_DEBUGGING};
 void debugHeader(char const* file, char const* func, int line)
 {
 	std::cout<<file<<" : "<<func<<" : line "<<line<<std::endl;
@@ -74,6 +165,7 @@ RS_Debug* RS_Debug::instance() {
 void
 RS_Debug::deleteInstance() {
     if (uniqueInstance) {
+        uniqueInstance->flush();
         fclose(uniqueInstance->stream);
         delete uniqueInstance;
     }
@@ -92,6 +184,7 @@ RS_Debug::RS_Debug() {
 void RS_Debug::setLevel(RS_DebugLevel level) {
     if(debugLevel==level) return;
     debugLevel = level;
+    currentLevel.store(level, std::memory_order_relaxed);
     print( D_NOTHING, "RS_DEBUG::setLevel(%d)", level);
     print( D_CRITICAL, "RS_DEBUG: Critical");
     print( D_ERROR, "RS_DEBUG: Errors");
@@ -103,45 +196,58 @@ void RS_Debug::setLevel(RS_DebugLevel level) {
 
 
 /**
- * Gets the current debugging level.
- */
-RS_Debug::RS_DebugLevel RS_Debug::getLevel() {
-    return debugLevel;
-}
-
-
-/**
- * Prints the given message to stdout.
+ * Prints the given message if the current debug level is D_DEBUGGING.
  */
 void RS_Debug::print(const char* format ...) {
-    if(debugLevel==D_DEBUGGING) {
+    if (isEnabled(D_DEBUGGING)) {
         va_list ap;
         va_start(ap, format);
-        vfprintf(stream, format, ap);
-        fprintf(stream, "\n");
+        write(D_DEBUGGING, format, ap);
         va_end(ap);
-        fflush(stream);
     }
-
 }
 
 /**
- * Prints the given message to stdout if the current debug level
- * is lower then the given level
+ * Prints the given message if the current debug level
+ * is the given level or higher.
  *
  * @param level Debug level.
  */
 void RS_Debug::print(RS_DebugLevel level, const char* format ...) {
-
-    if(debugLevel>=level) {
+    if (isEnabled(level)) {
         va_list ap;
         va_start(ap, format);
-        vfprintf(stream, format, ap);
-        fprintf(stream, "\n");
+        write(level, format, ap);
         va_end(ap);
-        fflush(stream);
     }
+}
+
+
+/**
+ * Formats the message and queues it for the writer thread.
+ * Critical messages and errors are written right away.
+ */
+void RS_Debug::write(RS_DebugLevel level, const char* format, va_list ap) {
+    char buffer[512];
+    va_list copy;
+    va_copy(copy, ap);
+    int size = vsnprintf(buffer, sizeof(buffer), format, copy);
+    va_end(copy);
+    if (size < 0)
+        return;
+
+    QByteArray line;
+    if (size < (int) sizeof(buffer)) {
+        line = QByteArray(buffer, size);
+    } else {
+        line.resize(size);
+        vsnprintf(line.data(), size + 1, format, ap);
+    }
+    line.append('\n');
 
+    writer().write(stream, line);
+    if (level <= D_ERROR)
+        writer().flush();
 }
 
 
@@ -153,9 +259,22 @@ void RS_Debug::timestamp() {
     QString nowStr;
 
 	nowStr = now.toString("yyyyMMdd_hh:mm:ss:zzz ");
-    fprintf(stream, "%s", nowStr.toLatin1().data());
-    fprintf(stream, "\n");
-    fflush(stream);
+    writer().write(stream, nowStr.toLatin1() + '\n');
+}
+
+
+/**
+ * Sets the stream to print to, messages printed before are
+ * written to the previous stream.
+ */
+void RS_Debug::setStream(FILE* s) {
+    flush();
+    stream = s;
+}
+
+
+void RS_Debug::flush() {
+    writer().flush();
 }
 
 
@@ -163,6 +282,8 @@ void RS_Debug::timestamp() {
  * Prints the unicode for every character in the given string.
  */
 void RS_Debug::printUnicode(const QString& text) {
+    if (!isEnabled(D_DEBUGGING))
+        return;
 	for(auto const& v: text){
 		print("[%X] %c", v.unicode(), v.toLatin1());
     }
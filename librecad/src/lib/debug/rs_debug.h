@@ -28,6 +28,9 @@
 #ifndef RS_DEBUG_H
 #define RS_DEBUG_H
 
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
 #include <iosfwd>
 #ifdef __hpux
 #include <sys/_size_t.h>
@@ -42,9 +45,40 @@ void debugHeader(char const* file, char const* func, int line);
 #define RS_DEBUG_VERBOSE DEBUG_HEADER \
 	RS_Debug::instance()
 
+/**
+ * Prints a message of the given level. Unlike RS_DEBUG->print(), the
+ * arguments are only evaluated if the level is enabled, so this is cheap
+ * enough for code which runs per entity, e.g. while drawing or snapping.
+ */
+#define RS_DEBUG_PRINT(level, ...) \
+	do { \
+		if (RS_Debug::isEnabled(level)) \
+			RS_Debug::instance()->print(level, __VA_ARGS__); \
+	} while (false)
+
+/**
+ * Prints a message of level D_DEBUGGING. Release builds drop these
+ * messages at compile time, unless LC_DEBUG_LOG is defined.
+ */
+#if defined(QT_NO_DEBUG) && !defined(LC_DEBUG_LOG)
+#define RS_DEBUG_PRINT_DEBUG(...) \
+	do { \
+		if (false) \
+			RS_Debug::instance()->print(RS_Debug::D_DEBUGGING, __VA_ARGS__); \
+	} while (false)
+#else
+#define RS_DEBUG_PRINT_DEBUG(...) \
+	RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, __VA_ARGS__)
+#endif
+
 /**
  * Debugging facilities.
  *
+ * Messages are formatted by the caller and written to the stream by
+ * a background thread, so a caller never waits for the stream to be
+ * flushed. Critical messages and errors are written before print()
+ * returns.
+ *
  * @author Andrew Mustun
  */
 class RS_Debug {
@@ -82,18 +116,30 @@ public:
     static RS_Debug* instance();
 
     static void deleteInstance();
+
+    /** @return true if messages of the given level are printed. */
+    static bool isEnabled(RS_DebugLevel level) {
+        return level <= currentLevel.load(std::memory_order_relaxed);
+    }
+
     void setLevel(RS_DebugLevel level);
-    RS_DebugLevel getLevel();
+    RS_DebugLevel getLevel() {
+        return debugLevel;
+    }
     void print(RS_DebugLevel level, const char* format ...);
     void print(const char* format ...);
     void printUnicode(const QString& text);
     void timestamp();
-    void setStream(FILE* s) {
-        stream = s;
-    }
+    void setStream(FILE* s);
+    /** Waits until all messages printed so far are written. */
+    void flush();
 
 private:
+    void write(RS_DebugLevel level, const char* format, va_list ap);
+
     static RS_Debug* uniqueInstance;
+    /** Copy of debugLevel, to test the level without the instance. */
+    static std::atomic<int> currentLevel;
 
     RS_DebugLevel debugLevel;
     FILE* stream;
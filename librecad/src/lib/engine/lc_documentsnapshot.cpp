@@ -0,0 +1,131 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include "lc_documentsnapshot.h"
+#include "rs_block.h"
+#include "rs_document.h"
+#include "rs_insert.h"
+#include "rs_layer.h"
+#include "rs_layerlist.h"
+
+/**
+ * Creates a snapshot of the given document.
+ * Must be called on the thread which owns the document.
+ */
+LC_DocumentSnapshot::LC_DocumentSnapshot(RS_Document& document) :
+    blocks( true),
+    entities( nullptr, true)
+{
+    QHash<RS_Layer*, RS_Layer*> layerMap;
+    RS_LayerList* layerList = document.getLayerList();
+    if (nullptr != layerList) {
+        for (RS_Layer* l: *layerList) {
+            layers.emplace_back( l->clone());
+            layerMap.insert( l, layers.back().get());
+        }
+    }
+
+    // regenerate dimensions in the live document, the copies need no update
+    document.validateAllDimensions();
+    // regeneration changes the revision:
+    revision = document.getRevision();
+
+    RS_BlockList* blockList = document.getBlockList();
+    if (nullptr != blockList) {
+        for (RS_Block* b: *blockList) {
+            RS_Block* c = static_cast<RS_Block*>(b->clone());
+            c->setParent( nullptr);
+            blocks.add( c, false);
+        }
+    }
+
+    for (RS_Entity* e: document) {
+        if (nullptr == e || e->isUndone()) {
+            continue;
+        }
+        RS_Entity* c = e->clone();
+        c->setParent( &entities);
+        entities.addEntity( c);
+    }
+
+    for (RS_Block* b: blocks) {
+        isolate( b, layerMap);
+    }
+    isolate( &entities, layerMap);
+    entities.getMin();
+}
+
+/**
+ * RS_BlockList doesn't delete its blocks, the copies are deleted here
+ * after the inserts which refer to them.
+ */
+LC_DocumentSnapshot::~LC_DocumentSnapshot()
+{
+    entities.clear();
+    for (RS_Block* b: blocks) {
+        delete b;
+    }
+    blocks.clear();
+}
+
+/**
+ * @return Copy of the layer with the given name or nullptr.
+ */
+const RS_Layer* LC_DocumentSnapshot::findLayer(const QString& name) const
+{
+    for (auto const& l: layers) {
+        if (l->getName() == name) {
+            return l.get();
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Points all entities to the copied layers and inserts of the document
+ * to the copied blocks. Also resolves lazily computed borders and blocks,
+ * so readers never modify the copy. Inserts of font letters keep their
+ * fonts, which are not part of the document.
+ */
+void LC_DocumentSnapshot::isolate(RS_EntityContainer* container,
+                                  const QHash<RS_Layer*, RS_Layer*>& layerMap)
+{
+    for (RS_Entity* e: *container) {
+        RS_Layer* layer = e->getLayer( false);
+        if (nullptr != layer) {
+            e->setLayer( layerMap.value( layer, nullptr));
+        }
+        if (RS2::EntityInsert == e->rtti()) {
+            RS_Insert* insert = static_cast<RS_Insert*>(e);
+            if (nullptr == insert->getData().blockSource) {
+                insert->setBlockSource( &blocks);
+            }
+            insert->getBlockForInsert();
+        }
+        if (e->isContainer()) {
+            isolate( static_cast<RS_EntityContainer*>(e), layerMap);
+        }
+        e->getMin();
+    }
+}
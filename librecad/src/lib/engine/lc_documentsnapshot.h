@@ -0,0 +1,100 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#ifndef LC_DOCUMENTSNAPSHOT_H
+#define LC_DOCUMENTSNAPSHOT_H
+
+#include <memory>
+#include <vector>
+#include <QHash>
+#include "rs_blocklist.h"
+#include "rs_entitycontainer.h"
+
+class RS_Document;
+class RS_Layer;
+
+/**
+ * Immutable copy of the entities of a document.
+ *
+ * A snapshot is created on the GUI thread by RS_Document::getSnapshot()
+ * and shared through std::shared_ptr. Once published it is never
+ * modified, so any number of background threads (export, measurements,
+ * autosave) can read it while the user keeps editing. It is freed when
+ * the last reader drops its reference.
+ *
+ * The snapshot contains deep copies of all entities which are not undone,
+ * of all layers and of all blocks. The copied entities refer to the copied
+ * layers and inserts to the copied blocks, they have no connection to the
+ * live document. State which entities compute lazily (borders, the block
+ * of inserts and invalidated dimensions) is resolved when the snapshot is
+ * created, so const queries don't write to it.
+ *
+ * Readers must only use const methods and never call update() on snapshot
+ * entities. Drawing is not covered: splines and the letters of texts cache
+ * their outlines while they are drawn, and the letters share their fonts
+ * with the live document.
+ */
+class LC_DocumentSnapshot
+{
+public:
+    explicit LC_DocumentSnapshot(RS_Document& document);
+    ~LC_DocumentSnapshot();
+
+    LC_DocumentSnapshot(const LC_DocumentSnapshot&) = delete;
+    LC_DocumentSnapshot& operator = (const LC_DocumentSnapshot&) = delete;
+
+    /**
+     * @return Revision of the document this snapshot was taken from.
+     */
+    unsigned long getRevision() const {
+        return revision;
+    }
+
+    /**
+     * @return The copied entities, top level entities only.
+     */
+    const RS_EntityContainer& getEntities() const {
+        return entities;
+    }
+
+    const RS_Layer* findLayer(const QString& name) const;
+
+    RS_Vector getMin() const {
+        return entities.getMin();
+    }
+    RS_Vector getMax() const {
+        return entities.getMax();
+    }
+
+private:
+    void isolate(RS_EntityContainer* container,
+                 const QHash<RS_Layer*, RS_Layer*>& layerMap);
+
+    unsigned long revision {0};
+    std::vector<std::unique_ptr<RS_Layer>> layers;
+    RS_BlockList blocks;
+    RS_EntityContainer entities;
+};
+
+#endif // LC_DOCUMENTSNAPSHOT_H
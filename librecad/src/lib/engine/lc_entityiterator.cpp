@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2018 A. Stebich (librecad@mail.lordofbikes.de)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include "lc_entityiterator.h"
+#include "rs_entitycontainer.h"
+
+LC_EntityIterator::LC_EntityIterator(const RS_EntityContainer& container,
+                                     RS2::ResolveLevel level) :
+    container( container),
+    level( level)
+{
+}
+
+/**
+ * Skip invisible entities and invisible containers with all their children.
+ */
+LC_EntityIterator& LC_EntityIterator::setVisibleOnly(bool on)
+{
+    visibleOnly = on;
+    return *this;
+}
+
+/**
+ * Return only entities on the given layer, nullptr for all layers.
+ */
+LC_EntityIterator& LC_EntityIterator::setLayer(const RS_Layer* layer)
+{
+    this->layer = layer;
+    return *this;
+}
+
+/**
+ * @return First entity of the container tree or nullptr if empty.
+ * Restarts the iteration.
+ */
+RS_Entity* LC_EntityIterator::first()
+{
+    stack.clear();
+    stack.push_back( {container.begin(), container.end()});
+
+    return next();
+}
+
+/**
+ * @return Next entity or nullptr after the last entity.
+ */
+RS_Entity* LC_EntityIterator::next()
+{
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        if (frame.it == frame.end) {
+            stack.pop_back();
+            continue;
+        }
+
+        RS_Entity* e = *frame.it;
+        ++frame.it;
+        if (nullptr == e
+            || (visibleOnly && !e->isVisible())) {
+            continue;
+        }
+
+        if (isResolved( e)) {
+            auto sub = static_cast<const RS_EntityContainer*>(e);
+            stack.push_back( {sub->begin(), sub->end()});
+            continue;
+        }
+
+        if (isFiltered( e)) {
+            continue;
+        }
+
+        return e;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @return true, when e is a container to descend into for the resolve level.
+ */
+bool LC_EntityIterator::isResolved(const RS_Entity* e) const
+{
+    if (!e->isContainer()) {
+        return false;
+    }
+
+    switch (level) {
+    case RS2::ResolveAllButInserts:
+        return RS2::EntityInsert != e->rtti();
+
+    case RS2::ResolveAllButTextImage:
+    case RS2::ResolveAllButTexts:
+        return RS2::EntityText != e->rtti() && RS2::EntityMText != e->rtti();
+
+    case RS2::ResolveAll:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+/**
+ * @return true, when e doesn't pass the layer filter.
+ */
+bool LC_EntityIterator::isFiltered(const RS_Entity* e) const
+{
+    return nullptr != layer && e->getLayer() != layer;
+}
@@ -0,0 +1,93 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2018 A. Stebich (librecad@mail.lordofbikes.de)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_ENTITYITERATOR_H
+#define LC_ENTITYITERATOR_H
+
+#include <vector>
+#include <QList>
+#include "rs.h"
+
+class RS_Entity;
+class RS_EntityContainer;
+class RS_Layer;
+
+/**
+ * External iterator over the entities of a container tree.
+ *
+ * Unlike RS_EntityContainer::firstEntity()/nextEntity() the iteration
+ * state is kept in the iterator on an explicit stack, not in the
+ * containers. Nested traversals of the same container don't interfere.
+ * Several threads may only iterate a container which nobody modifies
+ * and whose lazily computed state is resolved, like the entities of
+ * a LC_DocumentSnapshot: e.g. getMin() of a container with outdated
+ * borders and getBlockForInsert() write to the entities.
+ *
+ * The resolve level has the same meaning as for firstEntity():
+ * resolved containers are descended into and not returned themselves.
+ * Optional filters skip invisible entities (including the subtrees of
+ * invisible containers) and entities on other layers.
+ *
+ * The container must not be modified while it is iterated.
+ */
+class LC_EntityIterator
+{
+public:
+    explicit LC_EntityIterator(const RS_EntityContainer& container,
+                               RS2::ResolveLevel level = RS2::ResolveNone);
+
+    LC_EntityIterator& setVisibleOnly(bool on = true);
+    LC_EntityIterator& setLayer(const RS_Layer* layer);
+
+    RS_Entity* first();
+    RS_Entity* next();
+
+    /**
+     * Calls visitor(RS_Entity*) for every entity of the iteration.
+     */
+    template <typename Visitor>
+    void visit(Visitor visitor) {
+        for (RS_Entity* e = first(); nullptr != e; e = next()) {
+            visitor( e);
+        }
+    }
+
+private:
+    bool isResolved(const RS_Entity* e) const;
+    bool isFiltered(const RS_Entity* e) const;
+
+    struct Frame {
+        QList<RS_Entity*>::const_iterator it;
+        QList<RS_Entity*>::const_iterator end;
+    };
+
+    const RS_EntityContainer& container;
+    RS2::ResolveLevel level {RS2::ResolveNone};
+    bool visibleOnly {false};
+    const RS_Layer* layer {nullptr};
+    std::vector<Frame> stack;
+};
+
+#endif // LC_ENTITYITERATOR_H
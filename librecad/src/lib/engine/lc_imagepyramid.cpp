@@ -0,0 +1,603 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2018 A. Stebich (librecad@mail.lordofbikes.de)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QThread>
+
+#include "lc_imagepyramid.h"
+#include "rs_debug.h"
+#include "rs_graphicview.h"
+#include "rs_settings.h"
+#include "rs_system.h"
+
+namespace {
+//! first line of the index file, increase the number whenever the layout changes
+const char* indexHeader = "LibreCAD image pyramid 1";
+//! memory for decoded tiles in KiB
+const int tileCacheSize = 128 * 1024;
+//! delay between redraws while tiles arrive in ms
+const int redrawDelay = 50;
+//! suffix of cache folders which are being removed
+const char* evictedSuffix = ".evicted";
+
+class BuildJob : public QRunnable {
+public:
+    BuildJob(const QString& file, const QString& cacheDir, const QString& cacheKey):
+        file(file)
+      , cacheDir(cacheDir)
+      , cacheKey(cacheKey)
+    {}
+
+    void run() override {
+        QImage const image = QImageReader(file).read();
+        if (!image.isNull()) {
+            QMetaObject::invokeMethod(LC_ImageLoader::instance(), "previewReady",
+                                      Qt::QueuedConnection,
+                                      Q_ARG(QString, cacheKey),
+                                      Q_ARG(QImage, LC_ImagePyramid::previewOf(image)));
+        }
+        bool ok = LC_ImagePyramid::build(image, cacheDir);
+        QMetaObject::invokeMethod(LC_ImageLoader::instance(), "buildFinished",
+                                  Qt::QueuedConnection,
+                                  Q_ARG(QString, cacheKey), Q_ARG(bool, ok));
+    }
+
+private:
+    QString file;
+    QString cacheDir;
+    QString cacheKey;
+};
+
+class TileJob : public QRunnable {
+public:
+    explicit TileJob(const QString& tileFile):
+        tileFile(tileFile)
+    {}
+
+    void run() override {
+        QImage image = LC_ImagePyramid::loadTile(tileFile);
+        QMetaObject::invokeMethod(LC_ImageLoader::instance(), "tileLoaded",
+                                  Qt::QueuedConnection,
+                                  Q_ARG(QString, tileFile), Q_ARG(QImage, image));
+    }
+
+private:
+    QString tileFile;
+};
+
+class EvictJob : public QRunnable {
+public:
+    EvictJob(const QString& cacheRoot, const QSet<QString>& keep,
+             qint64 maxBytes, int maxDays):
+        cacheRoot(cacheRoot)
+      , keep(keep)
+      , maxBytes(maxBytes)
+      , maxDays(maxDays)
+    {}
+
+    void run() override {
+        LC_ImagePyramid::evict(cacheRoot, keep, maxBytes, maxDays);
+        QMetaObject::invokeMethod(LC_ImageLoader::instance(), "evictionFinished",
+                                  Qt::QueuedConnection);
+    }
+
+private:
+    QString cacheRoot;
+    QSet<QString> keep;
+    qint64 maxBytes;
+    int maxDays;
+};
+
+struct CacheEntry {
+    QString dir;
+    QDateTime used;
+    qint64 bytes;
+};
+}
+
+/**
+ * The pyramid is identified by the path, size and modification time
+ * of the file, a changed file gets a new cache.
+ */
+std::shared_ptr<LC_ImagePyramid> LC_ImagePyramid::get(const QString& file) {
+    QFileInfo const info(file);
+    QByteArray const key = QCryptographicHash::hash(
+                QString("%1|%2|%3")
+                .arg(info.absoluteFilePath())
+                .arg(info.size())
+                .arg(info.lastModified().toMSecsSinceEpoch()).toUtf8(),
+                QCryptographicHash::Md5).toHex();
+
+    auto& pyramids = LC_ImageLoader::instance()->pyramids;
+    std::shared_ptr<LC_ImagePyramid> pyramid = pyramids.value(key).lock();
+    if (!pyramid) {
+        pyramid.reset(new LC_ImagePyramid(file, key));
+        pyramids.insert(key, pyramid);
+    }
+    if (!LC_ImageLoader::instance()->evicted) {
+        // once per session, for caches of files which are no longer used
+        LC_ImageLoader::instance()->requestEviction();
+    }
+    return pyramid;
+}
+
+LC_ImagePyramid::LC_ImagePyramid(const QString& file, const QString& cacheKey):
+    file(file)
+  , cacheKey(cacheKey)
+{
+    // only reads the header for most formats
+    QImageReader reader(file);
+    imageSize = reader.size();
+    if (!imageSize.isValid()) {
+        fallback = reader.read();
+        imageSize = fallback.size();
+    }
+    if (imageSize.isEmpty()) {
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "LC_ImagePyramid: cannot read image: %s", qPrintable(file));
+        return;
+    }
+
+    QString const dataDir = RS_SYSTEM->getAppDataDir();
+    if (dataDir.isEmpty()) {
+        buildFailed = true;
+        return;
+    }
+    cacheDir = dataDir + "/imagecache/" + cacheKey;
+    built = readIndex();
+    if (built) {
+        markUsed();
+    }
+}
+
+int LC_ImagePyramid::levelCount() const {
+    int count = 1;
+    QSize size = imageSize;
+    while (size.width() > TileSize || size.height() > TileSize) {
+        size = QSize((size.width() + 1) / 2, (size.height() + 1) / 2);
+        ++count;
+    }
+    return count;
+}
+
+int LC_ImagePyramid::levelFor(double screenPixels) const {
+    int const last = levelCount() - 1;
+    if (screenPixels <= 0.) {
+        return last;
+    }
+    int const level = static_cast<int>(std::floor(std::log2(1. / screenPixels)));
+    return std::max(0, std::min(level, last));
+}
+
+QSize LC_ImagePyramid::levelSize(int level) const {
+    QSize size = imageSize;
+    for (int i = 0; i < level; ++i) {
+        size = QSize((size.width() + 1) / 2, (size.height() + 1) / 2);
+    }
+    return size;
+}
+
+int LC_ImagePyramid::tileColumns(int level) const {
+    return (levelSize(level).width() + TileSize - 1) / TileSize;
+}
+
+int LC_ImagePyramid::tileRows(int level) const {
+    return (levelSize(level).height() + TileSize - 1) / TileSize;
+}
+
+QRect LC_ImagePyramid::tileRect(int level, int column, int row) const {
+    QRect const rect(column * TileSize, row * TileSize, TileSize, TileSize);
+    return rect.intersected(QRect(QPoint(0, 0), levelSize(level)));
+}
+
+QImage LC_ImagePyramid::tile(int level, int column, int row, RS_GraphicView* view) {
+    if (!ensureBuilt(view)) {
+        return QImage();
+    }
+
+    LC_ImageLoader* loader = LC_ImageLoader::instance();
+    QString const path = tileFile(level, column, row);
+    QImage image = loader->cachedTile(path);
+    if (image.isNull()) {
+        if (isShown(view)) {
+            loader->requestTile(path, view);
+        } else {
+            image = loadTile(path);
+            loader->cacheTile(path, image);
+        }
+    }
+    return image;
+}
+
+QImage LC_ImagePyramid::overview(RS_GraphicView* view) {
+    QImage image = tile(levelCount() - 1, 0, 0, view);
+    if (!image.isNull()) {
+        preview = QImage();
+        return image;
+    }
+    if (buildFailed) {
+        // draw the whole image like before, if there is no cache
+        if (fallback.isNull()) {
+            fallback = QImage(file);
+        }
+        return fallback;
+    }
+    return preview;
+}
+
+QString LC_ImagePyramid::tileFile(int level, int column, int row) const {
+    return tileFile(cacheDir, level, column, row);
+}
+
+QString LC_ImagePyramid::tileFile(const QString& cacheDir, int level, int column, int row) {
+    return QString("%1/%2-%3-%4.png").arg(cacheDir).arg(level).arg(column).arg(row);
+}
+
+QString LC_ImagePyramid::indexFile(const QString& cacheDir) {
+    return cacheDir + "/index";
+}
+
+/**
+ * The index is written after all tiles, so a cache without
+ * a matching index is incomplete.
+ */
+bool LC_ImagePyramid::readIndex() {
+    QFile f(indexFile(cacheDir));
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream ts(&f);
+    if (ts.readLine() != indexHeader) {
+        return false;
+    }
+    int width = 0, height = 0, tileSize = 0;
+    ts >> width >> height >> tileSize;
+    return width == imageSize.width() && height == imageSize.height()
+            && tileSize == TileSize;
+}
+
+/**
+ * Touches the "used" file of the cache, evict() removes
+ * the caches which were used least recently first.
+ */
+void LC_ImagePyramid::markUsed() const {
+    QFile f(cacheDir + "/used");
+    if (f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        f.write(QByteArray::number(QDateTime::currentMSecsSinceEpoch()));
+    }
+}
+
+QDateTime LC_ImagePyramid::lastUsed(const QString& cacheDir) {
+    QDateTime used = QFileInfo(cacheDir).lastModified();
+    for (QString const& name: {QString("index"), QString("used")}) {
+        QFileInfo const info(cacheDir + "/" + name);
+        if (info.exists()) {
+            used = std::max(used, info.lastModified());
+        }
+    }
+    return used;
+}
+
+/**
+ * @return true if the tiles are cached on disk, otherwise they are built
+ *         in the background for shown views and right away for others.
+ */
+bool LC_ImagePyramid::ensureBuilt(RS_GraphicView* view) {
+    if (built || buildFailed || isNull()) {
+        return built;
+    }
+    if (isShown(view)) {
+        LC_ImageLoader::instance()->requestBuild(this, view);
+        return false;
+    }
+    built = build(QImageReader(file).read(), cacheDir);
+    buildFailed = !built;
+    return built;
+}
+
+bool LC_ImagePyramid::build(QImage image, const QString& cacheDir) {
+    if (image.isNull() || !QDir().mkpath(cacheDir)) {
+        return false;
+    }
+    QSize const size = image.size();
+
+    for (int level = 0; ; ++level) {
+        for (int y = 0; y < image.height(); y += TileSize) {
+            for (int x = 0; x < image.width(); x += TileSize) {
+                QSaveFile f(tileFile(cacheDir, level, x / TileSize, y / TileSize));
+                QImage const tile = image.copy(x, y,
+                                               std::min(TileSize, image.width() - x),
+                                               std::min(TileSize, image.height() - y));
+                if (!f.open(QIODevice::WriteOnly) || !tile.save(&f, "PNG") || !f.commit()) {
+                    return false;
+                }
+            }
+        }
+        if (image.width() <= TileSize && image.height() <= TileSize) {
+            break;
+        }
+        image = image.scaled((image.width() + 1) / 2, (image.height() + 1) / 2,
+                             Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    QSaveFile f(indexFile(cacheDir));
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream ts(&f);
+    ts << indexHeader << "\n"
+       << size.width() << " " << size.height() << " " << TileSize << "\n";
+    ts.flush();
+    return f.commit();
+}
+
+namespace {
+/**
+ * Converts the image to the format which QPainter draws fastest.
+ */
+QImage toDrawFormat(const QImage& image) {
+    if (image.isNull()) {
+        return image;
+    }
+    return image.convertToFormat(image.hasAlphaChannel()
+                                 ? QImage::Format_ARGB32_Premultiplied
+                                 : QImage::Format_RGB32);
+}
+}
+
+QImage LC_ImagePyramid::previewOf(const QImage& image) {
+    QImage preview = image;
+    if (image.width() > TileSize || image.height() > TileSize) {
+        preview = image.scaled(TileSize, TileSize, Qt::KeepAspectRatio,
+                               Qt::SmoothTransformation);
+    }
+    return toDrawFormat(preview);
+}
+
+QImage LC_ImagePyramid::loadTile(const QString& tileFile) {
+    return toDrawFormat(QImage(tileFile));
+}
+
+/**
+ * A cache is renamed before its files are removed, so a cache which is
+ * removed only partly, e.g. when LibreCAD is closed meanwhile, has no
+ * valid index. Such leftovers are removed on the next run.
+ */
+void LC_ImagePyramid::evict(const QString& cacheRoot, const QSet<QString>& keep,
+                            qint64 maxBytes, int maxDays) {
+    QDateTime const started = QDateTime::currentDateTime();
+    QDateTime const expired = started.addDays(-maxDays);
+    std::vector<CacheEntry> entries;
+    qint64 total = 0;
+
+    QDir const root(cacheRoot);
+    for (QString const& name: root.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        QString const dir = root.filePath(name);
+        if (name.endsWith(evictedSuffix)) {
+            QDir(dir).removeRecursively();
+            continue;
+        }
+        qint64 bytes = 0;
+        QDirIterator it(dir, QDir::Files);
+        while (it.hasNext()) {
+            it.next();
+            bytes += it.fileInfo().size();
+        }
+        total += bytes;
+        if (!keep.contains(name)) {
+            entries.push_back({name, lastUsed(dir), bytes});
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const CacheEntry& a, const CacheEntry& b) {
+        return a.used < b.used;
+    });
+    for (auto const& entry: entries) {
+        if (entry.used >= expired && total <= maxBytes) {
+            break;
+        }
+        QString const dir = root.filePath(entry.dir);
+        // opened by another LibreCAD instance meanwhile
+        if (lastUsed(dir) >= started) {
+            continue;
+        }
+        QString const evicted = dir + evictedSuffix;
+        if (!root.rename(entry.dir, entry.dir + evictedSuffix)) {
+            continue;
+        }
+        RS_DEBUG_PRINT_DEBUG("LC_ImagePyramid::evict: %s", qPrintable(entry.dir));
+        QDir(evicted).removeRecursively();
+        total -= entry.bytes;
+    }
+}
+
+bool LC_ImagePyramid::isShown(RS_GraphicView* view) {
+    return view && view->isVisible();
+}
+
+
+LC_ImageLoader* LC_ImageLoader::uniqueInstance = nullptr;
+
+LC_ImageLoader* LC_ImageLoader::instance() {
+    if (!uniqueInstance) {
+        uniqueInstance = new LC_ImageLoader();
+    }
+    return uniqueInstance;
+}
+
+LC_ImageLoader::LC_ImageLoader():
+    tiles(tileCacheSize)
+{
+    // leave some cores to the GUI thread
+    pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+
+    redrawTimer.setSingleShot(true);
+    redrawTimer.setInterval(redrawDelay);
+    connect(&redrawTimer, SIGNAL(timeout()), this, SLOT(redrawViews()));
+}
+
+void LC_ImageLoader::requestBuild(LC_ImagePyramid* pyramid, RS_GraphicView* view) {
+    addView(view);
+    QString const job = "build:" + pyramid->cacheKey;
+    if (pending.contains(job)) {
+        return;
+    }
+    RS_DEBUG_PRINT_DEBUG("LC_ImageLoader::requestBuild: %s", qPrintable(pyramid->file));
+    pending.insert(job);
+    pool.start(new BuildJob(pyramid->file, pyramid->cacheDir, pyramid->cacheKey));
+}
+
+void LC_ImageLoader::requestTile(const QString& tileFile, RS_GraphicView* view) {
+    if (failed.contains(tileFile)) {
+        return;
+    }
+    addView(view);
+    if (pending.contains(tileFile)) {
+        return;
+    }
+    pending.insert(tileFile);
+    pool.start(new TileJob(tileFile));
+}
+
+/**
+ * The limits are read from the settings, the caches of
+ * the pyramids in use are kept.
+ */
+void LC_ImageLoader::requestEviction() {
+    if (evicting) {
+        return;
+    }
+    QString const dataDir = RS_SYSTEM->getAppDataDir();
+    if (dataDir.isEmpty()) {
+        return;
+    }
+    RS_SETTINGS->beginGroup("/Defaults");
+    qint64 const maxBytes = RS_SETTINGS->readNumEntry("/ImageCacheSize", 2048) * qint64(1024 * 1024);
+    int const maxDays = RS_SETTINGS->readNumEntry("/ImageCacheDays", 90);
+    RS_SETTINGS->endGroup();
+
+    QSet<QString> keep;
+    for (auto it = pyramids.cbegin(); it != pyramids.cend(); ++it) {
+        if (!it.value().expired()) {
+            keep.insert(it.key());
+        }
+    }
+    evicting = true;
+    evicted = true;
+    pool.start(new EvictJob(dataDir + "/imagecache", keep, maxBytes, maxDays));
+}
+
+QImage LC_ImageLoader::cachedTile(const QString& tileFile) const {
+    QImage* image = tiles.object(tileFile);
+    return image ? *image : QImage();
+}
+
+void LC_ImageLoader::cacheTile(const QString& tileFile, const QImage& image) {
+    if (!image.isNull()) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+        qint64 const bytes = image.sizeInBytes();
+#else
+        qint64 const bytes = image.byteCount();
+#endif
+        tiles.insert(tileFile, new QImage(image),
+                     static_cast<int>(std::max<qint64>(1, bytes / 1024)));
+    }
+}
+
+void LC_ImageLoader::previewReady(const QString& cacheKey, const QImage& preview) {
+    std::shared_ptr<LC_ImagePyramid> pyramid = pyramids.value(cacheKey).lock();
+    if (pyramid && !pyramid->built) {
+        pyramid->preview = preview;
+        if (!redrawTimer.isActive()) {
+            redrawTimer.start();
+        }
+    }
+}
+
+void LC_ImageLoader::buildFinished(const QString& cacheKey, bool ok) {
+    pending.remove("build:" + cacheKey);
+    std::shared_ptr<LC_ImagePyramid> pyramid = pyramids.value(cacheKey).lock();
+    if (pyramid) {
+        pyramid->built = ok;
+        pyramid->buildFailed = !ok;
+        if (!ok) {
+            pyramid->preview = QImage();
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                           "LC_ImageLoader::buildFinished: cannot cache image: %s",
+                           qPrintable(pyramid->file));
+        }
+    }
+    if (ok) {
+        // the new cache may have pushed the folder over its limit
+        requestEviction();
+    }
+    if (!redrawTimer.isActive()) {
+        redrawTimer.start();
+    }
+}
+
+void LC_ImageLoader::tileLoaded(const QString& tileFile, const QImage& image) {
+    pending.remove(tileFile);
+    if (image.isNull()) {
+        failed.insert(tileFile);
+    }
+    cacheTile(tileFile, image);
+    if (!redrawTimer.isActive()) {
+        redrawTimer.start();
+    }
+}
+
+void LC_ImageLoader::evictionFinished() {
+    evicting = false;
+}
+
+void LC_ImageLoader::addView(RS_GraphicView* view) {
+    if (!views.contains(view)) {
+        views.append(view);
+    }
+}
+
+void LC_ImageLoader::redrawViews() {
+    QList<QPointer<RS_GraphicView>> const toRedraw = views;
+    views.clear();
+    for (auto const& view: toRedraw) {
+        if (view) {
+            view->redraw(RS2::RedrawDrawing);
+        }
+    }
+}
@@ -0,0 +1,200 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2018 A. Stebich (librecad@mail.lordofbikes.de)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_IMAGEPYRAMID_H
+#define LC_IMAGEPYRAMID_H
+
+#include <memory>
+#include <QCache>
+#include <QDateTime>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QSize>
+#include <QThreadPool>
+#include <QTimer>
+
+class RS_GraphicView;
+
+/**
+ * Multi-resolution tiles of a raster image file.
+ *
+ * Level 0 is the image in full resolution, every further level halves
+ * width and height until the image fits into one tile. The levels are cut
+ * into tiles of TileSize x TileSize pixels and cached on disk, in the
+ * "imagecache" folder of the application data directory. The cache is
+ * built once per file version, in the background. While it is built,
+ * a downscaled preview of the whole image is drawn instead. Caches which
+ * weren't used for a while, and the least recently used ones when the
+ * folder grows too large, are removed, see evict().
+ *
+ * Only tiles which are drawn are decoded, and only a limited amount of
+ * them is kept in memory. Drawing a tile which is not in memory returns
+ * a null image and loads the tile in the background, the view is redrawn
+ * when it arrives. Views which aren't shown, like the ones used to print
+ * or export, wait for the tiles instead.
+ *
+ * All RS_Image entities of the same file share one pyramid.
+ */
+class LC_ImagePyramid
+{
+public:
+    static const int TileSize = 512;
+
+    /** @return the pyramid of the given image file, never nullptr. */
+    static std::shared_ptr<LC_ImagePyramid> get(const QString& file);
+
+    /** @return size of the full resolution image, empty if unreadable. */
+    QSize size() const {
+        return imageSize;
+    }
+    bool isNull() const {
+        return imageSize.isEmpty();
+    }
+
+    int levelCount() const;
+    /**
+     * @return the coarsest level which still has at least one pixel
+     *         per screen pixel, for the given screen pixels per image pixel.
+     */
+    int levelFor(double screenPixels) const;
+    QSize levelSize(int level) const;
+    int tileColumns(int level) const;
+    int tileRows(int level) const;
+    /** @return pixel area of a tile in its level, rows counted from the top. */
+    QRect tileRect(int level, int column, int row) const;
+
+    /**
+     * @return the tile or a null image if it isn't loaded yet. Loading
+     *         in the background is only done for views which are shown.
+     */
+    QImage tile(int level, int column, int row, RS_GraphicView* view);
+    /**
+     * @return the whole image in its coarsest level, its preview while
+     *         the cache is built, or a null image.
+     */
+    QImage overview(RS_GraphicView* view);
+
+    /**
+     * Writes the tiles of all levels of the decoded image to cacheDir.
+     * Runs in a worker thread, so it must not touch anything but its arguments.
+     */
+    static bool build(QImage image, const QString& cacheDir);
+    /** @return the decoded image, scaled down to fit into one tile. */
+    static QImage previewOf(const QImage& image);
+    /** Runs in a worker thread, like build(). */
+    static QImage loadTile(const QString& tileFile);
+    /**
+     * Removes the caches below cacheRoot which weren't used for maxDays,
+     * then the least recently used ones until they take at most maxBytes.
+     * Caches in keep are not removed. Runs in a worker thread, like build().
+     */
+    static void evict(const QString& cacheRoot, const QSet<QString>& keep,
+                      qint64 maxBytes, int maxDays);
+
+private:
+    friend class LC_ImageLoader;
+
+    LC_ImagePyramid(const QString& file, const QString& cacheKey);
+
+    QString tileFile(int level, int column, int row) const;
+    bool readIndex();
+    void markUsed() const;
+    bool ensureBuilt(RS_GraphicView* view);
+
+    static QString tileFile(const QString& cacheDir, int level, int column, int row);
+    static QString indexFile(const QString& cacheDir);
+    static bool isShown(RS_GraphicView* view);
+    static QDateTime lastUsed(const QString& cacheDir);
+
+    QString file;
+    QString cacheKey;
+    QString cacheDir;
+    QSize imageSize;
+    bool built {false};
+    bool buildFailed {false};
+    /** Whole image, used when no tiles can be cached on disk. */
+    QImage fallback;
+    /** Downscaled whole image, drawn while the cache is built. */
+    QImage preview;
+};
+
+
+/**
+ * Runs the jobs of LC_ImagePyramid in a thread pool and hands their
+ * results back to the GUI thread.
+ */
+class LC_ImageLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    static LC_ImageLoader* instance();
+
+    /** Builds the disk cache of the pyramid in the background. */
+    void requestBuild(LC_ImagePyramid* pyramid, RS_GraphicView* view);
+    /** Loads a tile into the memory cache in the background. */
+    void requestTile(const QString& tileFile, RS_GraphicView* view);
+    /** Removes old caches from disk in the background. */
+    void requestEviction();
+
+    /** @return tile from the memory cache, or a null image. */
+    QImage cachedTile(const QString& tileFile) const;
+    void cacheTile(const QString& tileFile, const QImage& image);
+
+public slots:
+    void previewReady(const QString& cacheKey, const QImage& preview);
+    void buildFinished(const QString& cacheKey, bool ok);
+    void tileLoaded(const QString& tileFile, const QImage& image);
+    void evictionFinished();
+
+private slots:
+    void redrawViews();
+
+private:
+    LC_ImageLoader();
+
+    void addView(RS_GraphicView* view);
+
+    static LC_ImageLoader* uniqueInstance;
+
+    QThreadPool pool;
+    QCache<QString, QImage> tiles;
+    QSet<QString> pending;
+    QSet<QString> failed;
+    QList<QPointer<RS_GraphicView>> views;
+    QTimer redrawTimer;
+    bool evicting {false};
+    bool evicted {false};
+
+    friend class LC_ImagePyramid;
+    /** Pyramids in use by cache key, to share them between entities. */
+    QHash<QString, std::weak_ptr<LC_ImagePyramid>> pyramids;
+};
+
+#endif // LC_IMAGEPYRAMID_H
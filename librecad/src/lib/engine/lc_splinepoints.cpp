@@ -563,7 +563,7 @@ LC_SplinePoints::LC_SplinePoints(RS_EntityContainer* parent,
 	RS_AtomicEntity(parent)
   ,data(d)
 {
-	calculateBorders();
+	update();
 }
 
 RS_Entity* LC_SplinePoints::clone() const
@@ -1225,6 +1225,7 @@ bool LC_SplinePoints::addPoint(const RS_Vector& v)
 		(v - data.splinePoints.back()).squared() > RS_TOLERANCE2)
 	{
 		data.splinePoints.push_back(v);
+		update();
 		return true;
 	}
 	return false;
@@ -1236,6 +1237,7 @@ bool LC_SplinePoints::addPoint(const RS_Vector& v)
 void LC_SplinePoints::removeLastPoint()
 {
 	data.splinePoints.pop_back();
+	update();
 }
 
 void LC_SplinePoints::addControlPoint(const RS_Vector& v)
@@ -1922,12 +1924,10 @@ void LC_SplinePoints::draw(RS_Painter* painter, RS_GraphicView* view, double& pa
 	if(pat) bDrawPattern = pat->num > 0;
 	else
 	{
-		RS_DEBUG->print(RS_Debug::D_WARNING,
+		RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 			"RS_Line::draw: Invalid line pattern");
 	}
 
-	update();
-
     // Pen to draw pattern is always solid:
     RS_Pen pen = painter->getPen();
     pen.setLineType(RS2::SolidLine);
@@ -0,0 +1,467 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include "lc_undodelta.h"
+#include "rs_arc.h"
+#include "rs_block.h"
+#include "rs_blocklist.h"
+#include "rs_circle.h"
+#include "rs_debug.h"
+#include "rs_document.h"
+#include "rs_ellipse.h"
+#include "rs_entitycontainer.h"
+#include "rs_graphic.h"
+#include "rs_insert.h"
+#include "rs_layer.h"
+#include "rs_line.h"
+#include "rs_math.h"
+#include "rs_point.h"
+#include "rs_polyline.h"
+
+namespace {
+
+QString layerName(const RS_Layer* layer)
+{
+    return nullptr != layer ? layer->getName() : QString();
+}
+
+//! @return innermost block which contains entity, or nullptr
+RS_Block* blockOf(const RS_Entity* entity)
+{
+    for (RS_EntityContainer* p = entity->getParent(); nullptr != p; p = p->getParent()) {
+        if (RS2::EntityBlock == p->rtti()) {
+            return static_cast<RS_Block*>(p);
+        }
+    }
+    return nullptr;
+}
+
+}
+
+/**
+ * Records a change of entity attributes. Must be called after the new
+ * pen and layer were applied to the entity.
+ *
+ * @param entity modified entity
+ * @param oldPen pen before the modification
+ * @param oldLayer layer before the modification
+ */
+void LC_UndoAttributes::addChange(RS_Entity* entity,
+                                  const RS_Pen& oldPen, RS_Layer* oldLayer)
+{
+    if (nullptr == entity) {
+        return;
+    }
+
+    if (nullptr == graphic) {
+        graphic = entity->getGraphic();
+    }
+    RS_Block* block = blockOf(entity);
+    changes.push_back({entity, oldPen, entity->getPen(false),
+                       layerName(oldLayer), layerName(entity->getLayer(false)),
+                       block, nullptr != block ? block->getName() : QString()});
+}
+
+bool LC_UndoAttributes::isEmpty() const
+{
+    return changes.empty();
+}
+
+/**
+ * Applies the old attributes when undone and the new ones when redone.
+ * Containers are updated after all their children have been restored.
+ */
+void LC_UndoAttributes::undoStateChanged(bool undone)
+{
+    // an entity of a block used by several inserts is recorded repeatedly,
+    // so undo goes backwards to end with its first recorded state
+    auto apply = [this, undone](const Change& c) {
+        if (isAlive(c)) {
+            c.entity->setPen(undone ? c.oldPen : c.newPen);
+            applyLayer(c.entity, undone ? c.oldLayer : c.newLayer);
+        }
+    };
+    if (undone) {
+        std::for_each(changes.rbegin(), changes.rend(), apply);
+    } else {
+        std::for_each(changes.begin(), changes.end(), apply);
+    }
+    for (auto it = changes.rbegin(); it != changes.rend(); ++it) {
+        if (isAlive(*it)) {
+            it->entity->update();
+        }
+    }
+}
+
+/**
+ * Entities outside of blocks live as long as the undo history. The block
+ * is looked up by name and compared by address, without dereferencing it.
+ */
+bool LC_UndoAttributes::isAlive(const Change& change) const
+{
+    if (nullptr == change.block) {
+        return true;
+    }
+    RS_BlockList* blocks = nullptr != graphic ? graphic->getBlockList() : nullptr;
+    return nullptr != blocks && blocks->find(change.blockName) == change.block;
+}
+
+/**
+ * Sets the layer with the given name, an empty name means no layer.
+ * The entity keeps its layer if no layer with that name exists anymore.
+ */
+void LC_UndoAttributes::applyLayer(RS_Entity* entity, const QString& name) const
+{
+    if (name.isEmpty()) {
+        entity->setLayer(static_cast<RS_Layer*>(nullptr));
+        return;
+    }
+
+    RS_Layer* layer = nullptr != graphic ? graphic->findLayer(name) : nullptr;
+    if (nullptr == layer) {
+        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        "LC_UndoAttributes::applyLayer: layer '%s' was removed, "
+                        "the entity keeps layer '%s'",
+                        qPrintable(name), qPrintable(layerName(entity->getLayer(false))));
+        return;
+    }
+    entity->setLayer(layer);
+}
+
+size_t LC_UndoAttributes::undoMemoryUsage() const
+{
+    size_t names = 0;
+    for (auto const& c: changes) {
+        names += (c.oldLayer.size() + c.newLayer.size() + c.blockName.size()) * sizeof(QChar);
+    }
+    return sizeof(LC_UndoAttributes) + changes.capacity() * sizeof(Change) + names;
+}
+
+
+/**
+ * @param container Container to update borders of after transforming.
+ */
+LC_UndoTransform::LC_UndoTransform(RS_EntityContainer* container) :
+    container( container)
+{
+}
+
+void LC_UndoTransform::addEntity(RS_Entity* entity)
+{
+    if (nullptr != entity) {
+        entities.push_back(entity);
+    }
+}
+
+bool LC_UndoTransform::isEmpty() const
+{
+    return entities.empty() || steps.empty();
+}
+
+void LC_UndoTransform::move(const RS_Vector& offset)
+{
+    steps.push_back({Move, offset, RS_Vector(false), 0.});
+}
+
+void LC_UndoTransform::rotate(const RS_Vector& center, double angle)
+{
+    steps.push_back({Rotate, center, RS_Vector(false), angle});
+}
+
+/**
+ * Both components of factor must be non-zero for the step to be invertible.
+ */
+void LC_UndoTransform::scale(const RS_Vector& center, const RS_Vector& factor)
+{
+    steps.push_back({Scale, center, factor, 0.});
+}
+
+void LC_UndoTransform::mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2)
+{
+    steps.push_back({Mirror, axisPoint1, axisPoint2, 0.});
+}
+
+/**
+ * Applies the recorded steps to all entities, or their inverse
+ * in reverse order. The borders of the container are recalculated
+ * lazily, on their next use. Cached intersections of the entities
+ * are dropped, as they are changed in place.
+ *
+ * The first call records the states before and after the transformation,
+ * later calls restore them.
+ */
+void LC_UndoTransform::apply(bool inverse)
+{
+    bool record = records.empty();
+    if (record) {
+        for (RS_Entity* e: entities) {
+            addRecords(e);
+        }
+    }
+
+    RS_Document* document = nullptr != container ? container->getDocument() : nullptr;
+    for (RS_Entity* e: entities) {
+        if (nullptr != document) {
+            document->invalidateIntersections(e);
+        }
+
+        if (inverse) {
+            for (auto it = steps.rbegin(); it != steps.rend(); ++it) {
+                applyStep(e, *it, true);
+            }
+        }
+        else {
+            for (auto const& step: steps) {
+                applyStep(e, step, false);
+            }
+        }
+    }
+
+    // segments come before their polyline, which is restored last
+    for (auto& r: records) {
+        if (record) {
+            saveState(r.entity, r.transformed);
+        }
+        else {
+            restoreState(r.entity, inverse ? r.original : r.transformed);
+        }
+    }
+
+    if (nullptr != container) {
+        container->invalidateBorders();
+    }
+}
+
+void LC_UndoTransform::applyStep(RS_Entity* e, const Step& step, bool inverse) const
+{
+    switch (step.type) {
+    case Move:
+        e->move(inverse ? -step.v1 : step.v1);
+        break;
+    case Rotate:
+        e->rotate(step.v1, inverse ? -step.angle : step.angle);
+        break;
+    case Scale:
+        e->scale(step.v1, inverse ? RS_Vector(1. / step.v2.x, 1. / step.v2.y) : step.v2);
+        break;
+    case Mirror:
+        e->mirror(step.v1, step.v2);
+        break;
+    }
+}
+
+/**
+ * Records the original state of e, for polylines after their segments.
+ */
+void LC_UndoTransform::addRecords(RS_Entity* e)
+{
+    if (RS2::EntityPolyline == e->rtti()) {
+        for (RS_Entity* segment: *static_cast<RS_Polyline*>(e)) {
+            addRecords(segment);
+        }
+    }
+
+    Record r;
+    r.entity = e;
+    saveState(e, r.original);
+    records.push_back(r);
+}
+
+/**
+ * @return true if e can be restored exactly from state,
+ *         false if state holds reference points for snapTo().
+ */
+bool LC_UndoTransform::saveState(const RS_Entity* e, State& state)
+{
+    state = {RS_Vector(false), RS_Vector(false), 0., 0., 0., false};
+
+    switch (e->rtti()) {
+    case RS2::EntityLine: {
+        auto l = static_cast<const RS_Line*>(e);
+        state.v1 = l->getStartpoint();
+        state.v2 = l->getEndpoint();
+        return true;
+    }
+    case RS2::EntityCircle: {
+        auto c = static_cast<const RS_Circle*>(e);
+        state.v1 = c->getCenter();
+        state.d1 = c->getRadius();
+        return true;
+    }
+    case RS2::EntityArc: {
+        RS_ArcData const& d = static_cast<const RS_Arc*>(e)->getData();
+        state = {d.center, RS_Vector(false), d.radius, d.angle1, d.angle2, d.reversed};
+        return true;
+    }
+    case RS2::EntityEllipse: {
+        RS_EllipseData const& d = static_cast<const RS_Ellipse*>(e)->getData();
+        state = {d.center, d.majorP, d.ratio, d.angle1, d.angle2, d.reversed};
+        return true;
+    }
+    case RS2::EntityPoint:
+        state.v1 = static_cast<const RS_Point*>(e)->getPos();
+        return true;
+    case RS2::EntityInsert: {
+        auto i = static_cast<const RS_Insert*>(e);
+        state.v1 = i->getInsertionPoint();
+        state.v2 = i->getScale();
+        state.d1 = i->getAngle();
+        return true;
+    }
+    case RS2::EntityPolyline: {
+        auto p = static_cast<const RS_Polyline*>(e);
+        state.v1 = p->getStartpoint();
+        state.v2 = p->getEndpoint();
+        return true;
+    }
+    default:
+        break;
+    }
+
+    RS_VectorSolutions const refs = e->getRefPoints();
+    if (refs.size() > 0) {
+        state.v1 = refs.at(0);
+        state.v2 = refs.at(refs.size() - 1);
+    }
+    return false;
+}
+
+/**
+ * Sets the recorded defining values, or snaps the entity to the
+ * recorded reference points if it has no such values.
+ */
+void LC_UndoTransform::restoreState(RS_Entity* e, const State& state)
+{
+    switch (e->rtti()) {
+    case RS2::EntityLine: {
+        auto l = static_cast<RS_Line*>(e);
+        l->setStartpoint(state.v1);
+        l->setEndpoint(state.v2);
+        break;
+    }
+    case RS2::EntityCircle: {
+        auto c = static_cast<RS_Circle*>(e);
+        c->setCenter(state.v1);
+        c->setRadius(state.d1);
+        c->calculateBorders();
+        break;
+    }
+    case RS2::EntityArc: {
+        auto a = static_cast<RS_Arc*>(e);
+        a->setData(RS_ArcData(state.v1, state.d1, state.d2, state.d3, state.flag));
+        a->calculateBorders();
+        break;
+    }
+    case RS2::EntityEllipse: {
+        auto el = static_cast<RS_Ellipse*>(e);
+        el->setCenter(state.v1);
+        el->setMajorP(state.v2);
+        el->setRatio(state.d1);
+        el->setAngle1(state.d2);
+        el->setAngle2(state.d3);
+        el->setReversed(state.flag);
+        el->calculateBorders();
+        break;
+    }
+    case RS2::EntityPoint: {
+        auto p = static_cast<RS_Point*>(e);
+        p->setPos(state.v1);
+        p->calculateBorders();
+        break;
+    }
+    case RS2::EntityInsert: {
+        auto i = static_cast<RS_Insert*>(e);
+        if (i->getInsertionPoint() != state.v1 || i->getScale() != state.v2
+                || i->getAngle() != state.d1) {
+            i->setInsertionPoint(state.v1);
+            i->setScale(state.v2);
+            i->setAngle(state.d1);
+            i->update();
+        }
+        break;
+    }
+    case RS2::EntityPolyline: {
+        auto p = static_cast<RS_Polyline*>(e);
+        p->setStartpoint(state.v1);
+        p->setEndpoint(state.v2);
+        p->invalidateBorders();
+        break;
+    }
+    default:
+        snapTo(e, state);
+        break;
+    }
+}
+
+/**
+ * Rotates, scales and moves the entity by the rounding error between its
+ * first and last reference point and the recorded ones. Larger differences
+ * are left alone.
+ */
+void LC_UndoTransform::snapTo(RS_Entity* e, const State& state)
+{
+    RS_VectorSolutions refs = e->getRefPoints();
+    if (!state.v1.valid || refs.size() == 0 || !refs.at(0).valid) {
+        return;
+    }
+
+    RS_Vector const recorded = state.v2 - state.v1;
+    RS_Vector const current = refs.at(refs.size() - 1) - refs.at(0);
+    if (state.v2.valid && refs.at(refs.size() - 1).valid
+            && RS_TOLERANCE2 < recorded.squared() && RS_TOLERANCE2 < current.squared()) {
+        double const angle = std::remainder(recorded.angle() - current.angle(), 2. * M_PI);
+        double const factor = recorded.magnitude() / current.magnitude();
+        if (std::abs(angle) < RS_TOLERANCE && std::abs(factor - 1.) < RS_TOLERANCE) {
+            if (0. != angle) {
+                e->rotate(refs.at(0), angle);
+            }
+            if (1. != factor) {
+                e->scale(refs.at(0), RS_Vector(factor, factor));
+            }
+            refs = e->getRefPoints();
+        }
+    }
+
+    RS_Vector const offset = state.v1 - refs.at(0);
+    if (0. < offset.squared()
+            && offset.magnitude() < RS_TOLERANCE * (1. + state.v1.magnitude())) {
+        e->move(offset);
+    }
+}
+
+void LC_UndoTransform::undoStateChanged(bool undone)
+{
+    apply(undone);
+}
+
+size_t LC_UndoTransform::undoMemoryUsage() const
+{
+    return sizeof(LC_UndoTransform)
+            + entities.capacity() * sizeof(RS_Entity*)
+            + steps.capacity() * sizeof(Step)
+            + records.capacity() * sizeof(Record);
+}
@@ -0,0 +1,170 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#ifndef LC_UNDODELTA_H
+#define LC_UNDODELTA_H
+
+#include <vector>
+#include <QString>
+#include "rs_pen.h"
+#include "rs_vector.h"
+#include "rs_undoable.h"
+
+class RS_Block;
+class RS_Entity;
+class RS_EntityContainer;
+class RS_Graphic;
+class RS_Layer;
+
+/**
+ * Base class for compact undo records.
+ *
+ * Instead of keeping a full copy of every modified entity, a delta
+ * records only what changed and applies the old or the new state
+ * in undoStateChanged(). Deltas are owned by RS_Undo and deleted
+ * when they drop out of the undo history.
+ */
+class LC_UndoDelta : public RS_Undoable
+{
+public:
+    RS2::UndoableType undoRtti() const override {
+        return RS2::UndoableDelta;
+    }
+};
+
+
+/**
+ * Records pen and layer changes of a set of entities.
+ *
+ * Layers are recorded by name and looked up when the change is applied,
+ * because a layer may be removed and deleted while the record is still
+ * in the undo history. Such a layer is not restored.
+ *
+ * Entities of a block, changed through an insert, are deleted with the
+ * block. Their changes are only applied while the block still exists.
+ */
+class LC_UndoAttributes : public LC_UndoDelta
+{
+public:
+    void addChange(RS_Entity* entity,
+                   const RS_Pen& oldPen, RS_Layer* oldLayer);
+    bool isEmpty() const;
+
+    void undoStateChanged(bool undone) override;
+    size_t undoMemoryUsage() const override;
+
+private:
+    struct Change {
+        RS_Entity* entity;
+        RS_Pen oldPen;
+        RS_Pen newPen;
+        QString oldLayer;
+        QString newLayer;
+        //! block which contains entity, or nullptr
+        RS_Block* block;
+        QString blockName;
+    };
+    bool isAlive(const Change& change) const;
+    void applyLayer(RS_Entity* entity, const QString& name) const;
+
+    RS_Graphic* graphic {nullptr};
+    std::vector<Change> changes;
+};
+
+
+/**
+ * Records a geometric transformation of a set of entities.
+ *
+ * The entities are transformed in place, undo applies the inverse
+ * steps in reverse order. Used by RS_Modification for move, rotate,
+ * scale and mirror when no copies are created.
+ *
+ * To keep repeated undo / redo from accumulating rounding errors, the
+ * defining values of lines, arcs, circles, ellipses, points, inserts and
+ * polylines are recorded before and after the transformation and restored
+ * exactly. Other entities are rotated, scaled and moved back onto two
+ * recorded reference points.
+ */
+class LC_UndoTransform : public LC_UndoDelta
+{
+public:
+    LC_UndoTransform(RS_EntityContainer* container);
+
+    void addEntity(RS_Entity* entity);
+    bool isEmpty() const;
+
+    void move(const RS_Vector& offset);
+    void rotate(const RS_Vector& center, double angle);
+    void scale(const RS_Vector& center, const RS_Vector& factor);
+    void mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2);
+
+    void apply(bool inverse);
+
+    void undoStateChanged(bool undone) override;
+    size_t undoMemoryUsage() const override;
+
+private:
+    enum StepType {
+        Move,
+        Rotate,
+        Scale,
+        Mirror
+    };
+    struct Step {
+        StepType type;
+        RS_Vector v1;
+        RS_Vector v2;
+        double angle;
+    };
+    /**
+     * Defining values of an entity, see saveState(). For entities which
+     * cannot be restored, v1 and v2 are two of their reference points.
+     */
+    struct State {
+        RS_Vector v1;
+        RS_Vector v2;
+        double d1;
+        double d2;
+        double d3;
+        bool flag;
+    };
+    struct Record {
+        RS_Entity* entity;
+        State original;
+        State transformed;
+    };
+    void applyStep(RS_Entity* e, const Step& step, bool inverse) const;
+    void addRecords(RS_Entity* e);
+    static bool saveState(const RS_Entity* e, State& state);
+    static void restoreState(RS_Entity* e, const State& state);
+    static void snapTo(RS_Entity* e, const State& state);
+
+    RS_EntityContainer* container {nullptr};
+    std::vector<RS_Entity*> entities;
+    std::vector<Step> steps;
+    //! transformed entities and the polyline segments in them
+    std::vector<Record> records;
+};
+
+#endif // LC_UNDODELTA_H
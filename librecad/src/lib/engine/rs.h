@@ -82,7 +82,9 @@ public:
         /** Endpoint selected */
         FlagSelected2   = 1<<13,
                 /** Entity is highlighted temporarily (as a user action feedback) */
-                FlagHighlighted = 1<<14
+                FlagHighlighted = 1<<14,
+        /** Container borders need to be recalculated before use */
+        FlagBordersDirty = 1<<15
     };
 
     /**
@@ -434,7 +436,8 @@ public:
     enum UndoableType {
         UndoableUnknown,    /**< Unknown undoable */
         UndoableEntity,     /**< Entity */
-        UndoableLayer       /**< Layer */
+        UndoableLayer,      /**< Layer */
+        UndoableDelta       /**< Compact change record, owned by the undo list */
     };
 
     /**
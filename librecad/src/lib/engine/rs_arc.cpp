@@ -106,7 +106,7 @@ bool RS_Arc::createFrom3P(const RS_Vector& p1, const RS_Vector& p2,
         double rb2=vrb.squared()*0.5;
         double crossp=vra.x * vrb.y - vra.y * vrb.x;
         if (fabs(crossp)< RS_TOLERANCE2) {
-                RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Arc::createFrom3P(): "
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_Arc::createFrom3P(): "
                         "Cannot create a arc with radius 0.0.");
                 return false;
         }
@@ -432,7 +432,7 @@ RS_Vector RS_Arc::getNearestMiddle(const RS_Vector& coord,
     using std::isnormal;
 #endif
 
-    RS_DEBUG->print("RS_Arc::getNearestMiddle(): begin\n");
+    RS_DEBUG_PRINT_DEBUG("RS_Arc::getNearestMiddle(): begin\n");
         double amin=getAngle1();
         double amax=getAngle2();
         //std::cout<<"RS_Arc::getNearestMiddle(): middlePoints="<<middlePoints<<std::endl;
@@ -463,7 +463,7 @@ RS_Vector RS_Arc::getNearestMiddle(const RS_Vector& coord,
 	if (dist) {
         *dist = vp.distanceTo(coord);
     }
-    RS_DEBUG->print("RS_Arc::getNearestMiddle(): end\n");
+    RS_DEBUG_PRINT_DEBUG("RS_Arc::getNearestMiddle(): end\n");
     return vp;
 }
 
@@ -677,7 +677,7 @@ RS2::Ending RS_Arc::getTrimPoint(const RS_Vector& trimCoord,
 RS_Vector RS_Arc::prepareTrim(const RS_Vector& trimCoord,
                               const RS_VectorSolutions& trimSol) {
     //special trimming for ellipse arc
-            RS_DEBUG->print("RS_Ellipse::prepareTrim()");
+            RS_DEBUG_PRINT_DEBUG("RS_Ellipse::prepareTrim()");
         if( ! trimSol.hasValid() ) return (RS_Vector(false));
         if( trimSol.getNumber() == 1 ) return (trimSol.get(0));
         double am=getArcAngle(trimCoord);
@@ -784,22 +784,22 @@ void RS_Arc::move(const RS_Vector& offset) {
 
 
 void RS_Arc::rotate(const RS_Vector& center, const double& angle) {
-    RS_DEBUG->print("RS_Arc::rotate");
+    RS_DEBUG_PRINT_DEBUG("RS_Arc::rotate");
     data.center.rotate(center, angle);
     data.angle1 = RS_Math::correctAngle(data.angle1+angle);
     data.angle2 = RS_Math::correctAngle(data.angle2+angle);
     calculateBorders();
-    RS_DEBUG->print("RS_Arc::rotate: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_Arc::rotate: OK");
 }
 
 void RS_Arc::rotate(const RS_Vector& center, const RS_Vector& angleVector) {
-    RS_DEBUG->print("RS_Arc::rotate");
+    RS_DEBUG_PRINT_DEBUG("RS_Arc::rotate");
     data.center.rotate(center, angleVector);
     double angle(angleVector.angle());
     data.angle1 = RS_Math::correctAngle(data.angle1+angle);
     data.angle2 = RS_Math::correctAngle(data.angle2+angle);
     calculateBorders();
-    RS_DEBUG->print("RS_Arc::rotate: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_Arc::rotate: OK");
 }
 
 
@@ -890,47 +890,58 @@ void RS_Arc::stretch(const RS_Vector& firstCorner,
     correctAngles(); // make sure angleLength is no more than 2*M_PI
 }
 
-/** find the visible part of the arc, and call drawVisible() to draw */
+/**
+ * Arcs with the bounding box inside the window are drawn directly, those
+ * outside are skipped. Otherwise the window crossings are found in closed
+ * form, and only the visible parts are drawn.
+ */
 void RS_Arc::draw(RS_Painter* painter, RS_GraphicView* view,
                   double& patternOffset) {
 	if (!( painter && view)) return;
 
     //only draw the visible portion of line
-    RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-    RS_Vector vpMax(view->toGraph(view->getWidth(),0));
-    QPolygonF visualBox(QRectF(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y));
+    RS_Vector const vpMin(view->toGraph(0,view->getHeight()));
+    RS_Vector const vpMax(view->toGraph(view->getWidth(),0));
+	if (!isVisibleInWindow(view)) return;
+	if (getMin().isInWindowOrdered(vpMin, vpMax) && getMax().isInWindowOrdered(vpMin, vpMax)) {
+		drawVisible(painter, view, patternOffset);
+		return;
+	}
 
     RS_Vector vpStart(isReversed()?getEndpoint():getStartpoint());
     RS_Vector vpEnd(isReversed()?getStartpoint():getEndpoint());
 
-	std::vector<RS_Vector> vertex(0);
-    for(unsigned short i=0;i<4;i++){
-        const QPointF& vp(visualBox.at(i));
-		vertex.push_back(RS_Vector(vp.x(),vp.y()));
-    }
     /** angles at cross points */
 	std::vector<double> crossPoints(0);
 
     double baseAngle=isReversed()?getAngle2():getAngle1();
-    for(unsigned short i=0;i<4;i++){
-		RS_Line line{vertex.at(i),vertex.at((i+1)%4)};
-		auto vpIts=RS_Information::getIntersection(
-                    static_cast<RS_Entity*>(this),
-                    &line,
-                    true);
-        if( vpIts.size()==0) continue;
-		for(const RS_Vector& vp: vpIts){
-			auto ap1=getTangentDirection(vp).angle();
-			auto ap2=line.getTangentDirection(vp).angle();
-            //ignore tangent points, because the arc doesn't cross over
-            if( fabs( remainder(ap2 - ap1, M_PI) ) < RS_TOLERANCE_ANGLE) continue;
-            crossPoints.push_back(
-                        RS_Math::getAngleDifference(baseAngle, getCenter().angleTo(vp))
-                        );
-        }
-    }
+	double const angleLength = getAngleLength();
+	auto addCrossing = [&](double a) {
+		double const da = RS_Math::getAngleDifference(baseAngle, a);
+		if (da < angleLength) crossPoints.push_back(da);
+	};
+	double const r = getRadius();
+	const RS_Vector& c = getCenter();
+	for (double const x: {vpMin.x, vpMax.x}) {
+		//cos(a) = (x - c.x)/r, tangent points don't cross over
+		double const ca = (x - c.x) / r;
+		if (std::abs(ca) >= 1. - RS_TOLERANCE) continue;
+		double const a = std::acos(ca);
+		double const dy = r * std::sin(a);
+		if (c.y + dy >= vpMin.y && c.y + dy <= vpMax.y) addCrossing(a);
+		if (c.y - dy >= vpMin.y && c.y - dy <= vpMax.y) addCrossing(-a);
+	}
+	for (double const y: {vpMin.y, vpMax.y}) {
+		//sin(a) = (y - c.y)/r, corners are counted on vertical borders
+		double const sa = (y - c.y) / r;
+		if (std::abs(sa) >= 1. - RS_TOLERANCE) continue;
+		double const a = std::asin(sa);
+		double const dx = r * std::cos(a);
+		if (c.x + dx > vpMin.x && c.x + dx < vpMax.x) addCrossing(a);
+		if (c.x - dx > vpMin.x && c.x - dx < vpMax.x) addCrossing(M_PI - a);
+	}
     if(vpStart.isInWindowOrdered(vpMin, vpMax)) crossPoints.push_back(0.);
-    if(vpEnd.isInWindowOrdered(vpMin, vpMax)) crossPoints.push_back(getAngleLength());
+    if(vpEnd.isInWindowOrdered(vpMin, vpMax)) crossPoints.push_back(angleLength);
 
     //sorting
     std::sort(crossPoints.begin(),crossPoints.end());
@@ -947,6 +958,17 @@ void RS_Arc::draw(RS_Painter* painter, RS_GraphicView* view,
 
 }
 
+/**
+ * The bounding box covers the arc only, so this is exact enough for drawing.
+ */
+bool RS_Arc::isVisibleInWindow(RS_GraphicView* view) const
+{
+	RS_Vector const vpMin(view->toGraph(0,view->getHeight()));
+	RS_Vector const vpMax(view->toGraph(view->getWidth(),0));
+	return !(getMax().x < vpMin.x || getMax().y < vpMin.y
+			 || getMin().x > vpMax.x || getMin().y > vpMax.y);
+}
+
 /** directly draw the arc, assuming the whole arc is within visible window */
 void RS_Arc::drawVisible(RS_Painter* painter, RS_GraphicView* view,
                   double& patternOffset) {
@@ -989,7 +1011,7 @@ void RS_Arc::drawVisible(RS_Painter* painter, RS_GraphicView* view,
     }
 
 	if (!pat || ra<0.5) {//avoid division by zero from small ra
-		RS_DEBUG->print("%s: Invalid line pattern or radius too small, drawing arc using solid line", __func__);
+		RS_DEBUG_PRINT_DEBUG("%s: Invalid line pattern or radius too small, drawing arc using solid line", __func__);
         painter->drawArc(cp, ra,
                          getAngle1(),getAngle2(),
                          isReversed());
@@ -1011,7 +1033,7 @@ void RS_Arc::drawVisible(RS_Painter* painter, RS_GraphicView* view,
 
     // create scaled pattern:
 	if(pat->num<=0) { //invalid pattern
-		RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Arc::draw(): invalid line pattern\n");
+		RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_Arc::draw(): invalid line pattern\n");
 		painter->drawArc(cp,
 						 ra,
 						 getAngle1(), getAngle2(),
@@ -228,6 +228,7 @@ public:
 	void draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset) override;
     /** directly draw the arc, assuming the whole arc is within visible window */
 	void drawVisible(RS_Painter* painter, RS_GraphicView* view, double& patternOffset);
+	bool isVisibleInWindow(RS_GraphicView* view) const override;
 
     friend std::ostream& operator << (std::ostream& os, const RS_Arc& a);
 
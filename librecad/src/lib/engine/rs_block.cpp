@@ -116,6 +116,9 @@ void RS_Block::setModified(bool m) {
         p->setModified(m);
     }
     modified = m;
+    if (m) {
+        increaseRevision();
+    }
 }
 
 
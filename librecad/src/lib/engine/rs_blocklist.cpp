@@ -53,6 +53,7 @@ RS_BlockList::RS_BlockList(bool owner) {
  */
 void RS_BlockList::clear() {
     blocks.clear();
+    blockIndex.clear();
 	activeBlock = nullptr;
 	setModified(true);
 }
@@ -63,7 +64,7 @@ void RS_BlockList::clear() {
  * Listeners are notified.
  */
 void RS_BlockList::activate(const QString& name) {
-    RS_DEBUG->print("RS_BlockList::activateBlock");
+    RS_DEBUG_PRINT_DEBUG("RS_BlockList::activateBlock");
 
     activate(find(name));
 }
@@ -73,7 +74,7 @@ void RS_BlockList::activate(const QString& name) {
  * Listeners are notified.
  */
 void RS_BlockList::activate(RS_Block* block) {
-    RS_DEBUG->print("RS_BlockList::activateBlock");
+    RS_DEBUG_PRINT_DEBUG("RS_BlockList::activateBlock");
 	activeBlock = block;
 }
 
@@ -88,16 +89,17 @@ void RS_BlockList::activate(RS_Block* block) {
  * @return false: block already existed and was deleted.
  */
 bool RS_BlockList::add(RS_Block* block, bool notify) {
-    RS_DEBUG->print("RS_BlockList::add()");
+    RS_DEBUG_PRINT_DEBUG("RS_BlockList::add()");
 
 	if (!block) {
         return false;
     }
 
     // check if block already exists:
-    RS_Block* b = find(block->getName());
+    RS_Block* b = blockIndex.value(block->getName(), nullptr);
 	if (!b) {
         blocks.append(block);
+        blockIndex.insert(block->getName(), block);
 
         if (notify) {
             addNotification();
@@ -136,10 +138,13 @@ void RS_BlockList::addNotification() {
  * the list but before it gets deleted.
  */
 void RS_BlockList::remove(RS_Block* block) {
-    RS_DEBUG->print("RS_BlockList::removeBlock()");
+    RS_DEBUG_PRINT_DEBUG("RS_BlockList::removeBlock()");
 
     // here the block is removed from the list but not deleted
     blocks.removeOne(block);
+    if (blockIndex.value(block->getName(), nullptr) == block) {
+        blockIndex.remove(block->getName());
+    }
 
 	for(auto l: blockListListeners){
 		l->blockRemoved(block);
@@ -173,6 +178,10 @@ void RS_BlockList::remove(RS_Block* block) {
 bool RS_BlockList::rename(RS_Block* block, const QString& name) {
 	if (block) {
 		if (!find(name)) {
+			if (blockIndex.value(block->getName(), nullptr) == block) {
+				blockIndex.remove(block->getName());
+				blockIndex.insert(name, block);
+			}
 			block->setName(name);
 			setModified(true);
 			return true;
@@ -206,34 +215,40 @@ void RS_BlockList::editBlock(RS_Block* block, const RS_Block& source) {
  */
 RS_Block* RS_BlockList::find(const QString& name) {
     try {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_BlockList::find(): %s", name.toLatin1().constData());
+        RS_DEBUG_PRINT_DEBUG("RS_BlockList::find(): %s", name.toLatin1().constData());
     }
     catch(...) {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_BlockList::find(): wrong name to find");
+        RS_DEBUG_PRINT_DEBUG("RS_BlockList::find(): wrong name to find");
         return nullptr;
     }
-	// Todo : reduce this from O(N) to O(log(N)) complexity based on sorted list or hash
+	// blocks of this list are hashed:
+	RS_Block* found = blockIndex.value(name, nullptr);
+	if (found) {
+		RS_DEBUG_PRINT_DEBUG("RS_BlockList::find(): OK");
+		return found;
+	}
 	//DFS
 	std::vector<RS_BlockList const*> nodes;
 	std::set<RS_BlockList const*> searched;
 	searched.insert(nullptr);
+	searched.insert(this);
 	nodes.push_back(this);
 	while (nodes.size()) {
 		auto list = nodes.back();
 		nodes.pop_back();
         for (RS_Block* blk: *list) {
             if (blk->getName() == name) {
-                RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_BlockList::find(): OK");
+                RS_DEBUG_PRINT_DEBUG("RS_BlockList::find(): OK");
                 return blk;
             }
             auto node = blk->getBlockList();
 			if (!searched.count(node)) {
-				searched.insert(list);
-                nodes.push_back(blk->getBlockList());
+				searched.insert(node);
+                nodes.push_back(node);
 			}
 		}
 	}
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_BlockList::find(): bad");
+    RS_DEBUG_PRINT_DEBUG("RS_BlockList::find(): bad");
 	return nullptr;
 }
 
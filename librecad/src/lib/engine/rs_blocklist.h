@@ -30,8 +30,9 @@
 
 
 #include <QList>
+#include <QHash>
+#include <QString>
 
-class QString;
 class RS_Block;
 class RS_BlockListListener;
 
@@ -102,6 +103,8 @@ private:
     bool owner;
     //! Blocks in the graphic
     QList<RS_Block*> blocks;
+    //! Blocks of this list by name, for constant time lookup
+    QHash<QString, RS_Block*> blockIndex;
     //! List of registered BlockListListeners
     QList<RS_BlockListListener*> blockListListeners;
     //! Currently active block
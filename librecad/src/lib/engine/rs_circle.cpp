@@ -148,7 +148,7 @@ bool RS_Circle::createFromCR(const RS_Vector& c, double r) {
 		data.center = c;
         return true;
     } else {
-        RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Circle::createFromCR(): "
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_Circle::createFromCR(): "
                         "Cannot create a circle with radius 0.0.");
         return false;
     }
@@ -192,7 +192,7 @@ bool RS_Circle::createFrom3P(const RS_Vector& p1, const RS_Vector& p2,
         double rb2=vrb.squared()*0.5;
         double crossp=vra.x * vrb.y - vra.y * vrb.x;
         if (fabs(crossp)< RS_TOLERANCE2) {
-                RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Circle::createFrom3P(): "
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_Circle::createFrom3P(): "
                         "Cannot create a circle with radius 0.0.");
                 return false;
         }
@@ -215,7 +215,7 @@ bool RS_Circle::createFrom3P(const RS_VectorSolutions& sol) {
     double rb2=vrb.squared()*0.5;
     double crossp=vra.x * vrb.y - vra.y * vrb.x;
     if (fabs(crossp)< RS_TOLERANCE2) {
-        RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Circle::createFrom3P(): "
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_Circle::createFrom3P(): "
                         "Cannot create a circle with radius 0.0.");
         return false;
     }
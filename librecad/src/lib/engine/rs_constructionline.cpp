@@ -219,7 +219,7 @@ double RS_ConstructionLine::getDistanceToPoint(const RS_Vector& coord,
         RS_Entity** entity,
         RS2::ResolveLevel /*level*/, double /*solidDist*/) const {
 
-    RS_DEBUG->print("RS_ConstructionLine::getDistanceToPoint");
+    RS_DEBUG_PRINT_DEBUG("RS_ConstructionLine::getDistanceToPoint");
 
 	if (entity) {
         *entity = const_cast<RS_ConstructionLine*>(this);
@@ -152,7 +152,7 @@ RS_Vector const& RS_DimAligned::getExtensionPoint2() const {
  */
 void RS_DimAligned::updateDim(bool autoText) {
 
-    RS_DEBUG->print("RS_DimAligned::update");
+    RS_DEBUG_PRINT_DEBUG("RS_DimAligned::update");
 
     clear();
 
@@ -282,7 +282,7 @@ void RS_DimAngular::arrow(const RS_Vector& point,
 void RS_DimAngular::updateDim(bool autoText /*= false*/)
 {
     Q_UNUSED( autoText)
-    RS_DEBUG->print("RS_DimAngular::update");
+    RS_DEBUG_PRINT_DEBUG("RS_DimAngular::update");
 
     clear();
 
@@ -129,7 +129,7 @@ RS_VectorSolutions RS_DimDiametric::getRefPoints() const
  */
 void RS_DimDiametric::updateDim(bool autoText) {
 
-    RS_DEBUG->print("RS_DimDiametric::update");
+    RS_DEBUG_PRINT_DEBUG("RS_DimDiametric::update");
 
     clear();
 
@@ -26,6 +26,7 @@
 #include<iostream>
 #include<cmath>
 #include<string>
+#include<algorithm>
 #include "rs_information.h"
 #include "rs_line.h"
 #include "rs_dimension.h"
@@ -108,11 +109,161 @@ RS_Dimension::RS_Dimension(RS_EntityContainer* parent,
         : RS_EntityContainer(parent), data(d) {
 }
 
+/**
+ * Dimensions without reference points are regenerated right away, as their
+ * borders can't be estimated.
+ */
+void RS_Dimension::invalidateDim(bool autoText) {
+	if (getRefPoints().size() == 0) {
+		dimInvalid = false;
+		updateDim(autoText);
+		return;
+	}
+	dimInvalid = true;
+	dimInvalidAutoText = dimInvalidAutoText || autoText;
+	calculateBorders();
+}
+
+
+
+void RS_Dimension::validateDim() {
+	if (!dimInvalid) {
+		return;
+	}
+	dimInvalid = false;
+	bool const autoText = dimInvalidAutoText;
+	dimInvalidAutoText = false;
+	updateDim(autoText);
+	// the estimated borders are replaced:
+	if (parent) {
+		parent->invalidateBorders();
+	}
+}
+
+
+
+/**
+ * Uses estimated borders while the dimension is invalid, so it can be
+ * culled without being regenerated.
+ */
+void RS_Dimension::calculateBorders() {
+	if (dimInvalid) {
+		estimateBorders();
+		return;
+	}
+	RS_EntityContainer::calculateBorders();
+}
+
+
+
+/**
+ * The reference points, grown by the arrows, and the label around the
+ * middle of the text. The borders of the previous generation are kept in.
+ */
+void RS_Dimension::estimateBorders() {
+	delFlag(RS2::FlagBordersDirty);
+	RS_Vector const oldMin = minV;
+	RS_Vector const oldMax = maxV;
+	bool const hadBorders = !isEmpty();
+
+	resetBorders();
+	for (const RS_Vector& vp: getRefPoints()) {
+		if (vp.valid) {
+			minV = RS_Vector::minimum(vp, minV);
+			maxV = RS_Vector::maximum(vp, maxV);
+		}
+	}
+	double const scale = getGeneralScale();
+	double const margin = scale * std::max(getArrowSize(), getExtensionLineExtension());
+	minV -= RS_Vector(margin, margin);
+	maxV += RS_Vector(margin, margin);
+
+	// no glyph is wider than the text height, the label may be rotated:
+	double const height = scale * getTextHeight();
+	double const halfWidth = 0.5 * height * std::max(1, getLabel().size());
+	double const radius = std::hypot(halfWidth, 0.5 * height);
+	if (!dimInvalidAutoText && data.middleOfText.valid) {
+		RS_Vector const extent(radius, radius);
+		minV = RS_Vector::minimum(data.middleOfText - extent, minV);
+		maxV = RS_Vector::maximum(data.middleOfText + extent, maxV);
+	} else {
+		// the label will be placed next to the dimension line
+		double const offset = radius + scale * getDimensionLineGap() + height;
+		minV -= RS_Vector(offset, offset);
+		maxV += RS_Vector(offset, offset);
+	}
+
+	if (hadBorders) {
+		minV = RS_Vector::minimum(oldMin, minV);
+		maxV = RS_Vector::maximum(oldMax, maxV);
+	}
+}
+
+
+
+void RS_Dimension::draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset) {
+	validateDim();
+	RS_EntityContainer::draw(painter, view, patternOffset);
+}
+
+
+
+/**
+ * Queries on the sub entities regenerate an invalidated dimension first.
+ */
+double RS_Dimension::getDistanceToPoint(const RS_Vector& coord, RS_Entity** entity,
+                                        RS2::ResolveLevel level, double solidDist) const {
+	const_cast<RS_Dimension*>(this)->validateDim();
+	return RS_EntityContainer::getDistanceToPoint(coord, entity, level, solidDist);
+}
+
+
+
+RS_Vector RS_Dimension::getNearestPointOnEntity(const RS_Vector& coord, bool onEntity,
+                                                double* dist, RS_Entity** entity) const {
+	const_cast<RS_Dimension*>(this)->validateDim();
+	return RS_EntityContainer::getNearestPointOnEntity(coord, onEntity, dist, entity);
+}
+
+
+
+RS_Vector RS_Dimension::getNearestEndpoint(const RS_Vector& coord, double* dist) const {
+	const_cast<RS_Dimension*>(this)->validateDim();
+	return RS_EntityContainer::getNearestEndpoint(coord, dist);
+}
+
+
+
+RS_Vector RS_Dimension::getNearestCenter(const RS_Vector& coord, double* dist) const {
+	const_cast<RS_Dimension*>(this)->validateDim();
+	return RS_EntityContainer::getNearestCenter(coord, dist);
+}
+
+
+
+RS_Vector RS_Dimension::getNearestMiddle(const RS_Vector& coord, double* dist,
+                                         int middlePoints) const {
+	const_cast<RS_Dimension*>(this)->validateDim();
+	return RS_EntityContainer::getNearestMiddle(coord, dist, middlePoints);
+}
+
+
+
+RS_Vector RS_Dimension::getNearestDist(double distance, const RS_Vector& coord,
+                                       double* dist) const {
+	const_cast<RS_Dimension*>(this)->validateDim();
+	return RS_EntityContainer::getNearestDist(distance, coord, dist);
+}
+
+
+
 RS_Vector RS_Dimension::getNearestRef( const RS_Vector& coord,
                                        double* dist /*= nullptr*/) const
 {
     // override the RS_EntityContainer method
     // use RS_Entity instead for refpoint dragging
+    // the label position is a reference point, which may be pending:
+    const_cast<RS_Dimension*>(this)->validateDim();
     return RS_Entity::getNearestRef( coord, dist);
 }
 
@@ -121,6 +272,8 @@ RS_Vector RS_Dimension::getNearestSelectedRef( const RS_Vector& coord,
 {
     // override the RS_EntityContainer method
     // use RS_Entity instead for refpoint dragging
+    // the label position is a reference point, which may be pending:
+    const_cast<RS_Dimension*>(this)->validateDim();
     return RS_Entity::getNearestSelectedRef( coord, dist);
 }
 
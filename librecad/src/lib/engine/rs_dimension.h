@@ -130,6 +130,39 @@ public:
 
     virtual void updateDim(bool autoText=false) = 0;
 
+    /**
+     * Marks the dimension for regeneration, which is deferred until it's
+     * drawn or validateDim() is called.
+     */
+    void invalidateDim(bool autoText=false);
+    /** Regenerates the dimension, if it was invalidated. */
+    void validateDim();
+    bool isDimInvalid() const {
+        return dimInvalid;
+    }
+
+	void calculateBorders() override;
+	void draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset) override;
+	double getDistanceToPoint(const RS_Vector& coord,
+							  RS_Entity** entity,
+							  RS2::ResolveLevel level=RS2::ResolveNone,
+							  double solidDist = RS_MAXDOUBLE) const override;
+	RS_Vector getNearestPointOnEntity(const RS_Vector& coord,
+									  bool onEntity = true,
+									  double* dist = nullptr,
+									  RS_Entity** entity=nullptr) const override;
+	using RS_EntityContainer::getNearestEndpoint;
+	RS_Vector getNearestEndpoint(const RS_Vector& coord,
+								 double* dist = nullptr) const override;
+	RS_Vector getNearestCenter(const RS_Vector& coord,
+							   double* dist = nullptr) const override;
+	RS_Vector getNearestMiddle(const RS_Vector& coord,
+							   double* dist = nullptr,
+							   int middlePoints = 1) const override;
+	RS_Vector getNearestDist(double distance,
+							 const RS_Vector& coord,
+							 double* dist = nullptr) const override;
+
     void updateCreateDimensionLine(const RS_Vector& p1, const RS_Vector& p2,
                   bool arrow1=true, bool arrow2=true, bool autoText=false);
 
@@ -214,6 +247,14 @@ private:
 protected:
     /** Data common to all dimension entities. */
     RS_DimensionData data;
+
+private:
+    void estimateBorders();
+
+    //! \{ pending regeneration, see invalidateDim()
+    bool dimInvalid = false;
+    bool dimInvalidAutoText = false;
+    //! \}
 };
 
 #endif
@@ -156,7 +156,7 @@ bool RS_DimLinear::hasEndpointsWithinWindow(const RS_Vector& v1, const RS_Vector
  */
 void RS_DimLinear::updateDim(bool autoText) {
 
-    RS_DEBUG->print("RS_DimLinear::update");
+    RS_DEBUG_PRINT_DEBUG("RS_DimLinear::update");
 
     clear();
 
@@ -126,7 +126,7 @@ RS_VectorSolutions RS_DimRadial::getRefPoints() const
  */
 void RS_DimRadial::updateDim(bool autoText) {
 
-    RS_DEBUG->print("RS_DimRadial::update");
+    RS_DEBUG_PRINT_DEBUG("RS_DimRadial::update");
 
     clear();
 
@@ -27,6 +27,10 @@
 
 
 #include "rs_document.h"
+#include "lc_documentsnapshot.h"
+#include "lc_intersectionindex.h"
+#include "rs_block.h"
+#include "rs_blocklist.h"
 #include "rs_debug.h"
 
 
@@ -51,6 +55,23 @@ RS_Document::RS_Document(RS_EntityContainer* parent)
     gv = NULL;//used to read/save current view
 }
 
+/**
+ * Copy constructor. The copy gets its own intersection index.
+ */
+RS_Document::RS_Document(const RS_Document& other)
+        : RS_EntityContainer(other), RS_Undo(other),
+          modified(other.modified),
+          activePen(other.activePen),
+          filename(other.filename),
+          autosaveFilename(other.autosaveFilename),
+          formatType(other.formatType),
+          gv(other.gv),
+          revision(other.revision),
+          snapshot(std::atomic_load( &other.snapshot)) {
+}
+
+RS_Document::~RS_Document() = default;
+
 /**
  * Overwritten to set modified flag when undo cycle finished with undoable(s).
  */
@@ -58,8 +79,94 @@ void RS_Document::endUndoCycle()
 {
     if (hasUndoable()) {
         setModified(true);
+        increaseRevision();
     }
 
     RS_Undo::endUndoCycle();
 }
 
+/**
+ * Overwritten to outdate snapshots when the document changes.
+ */
+bool RS_Document::undo()
+{
+    increaseRevision();
+    return RS_Undo::undo();
+}
+
+/**
+ * Overwritten to outdate snapshots when the document changes.
+ */
+bool RS_Document::redo()
+{
+    increaseRevision();
+    return RS_Undo::redo();
+}
+
+/**
+ * Regenerates the invalidated dimensions of the document and its blocks,
+ * for code using their sub entities without drawing them, e.g. export.
+ */
+void RS_Document::validateAllDimensions()
+{
+    validateDimensions();
+    RS_BlockList* blockList = getBlockList();
+    if (nullptr != blockList) {
+        for (RS_Block* b: *blockList) {
+            b->validateDimensions();
+        }
+    }
+}
+
+/**
+ * Returns an immutable snapshot of the current document content.
+ * The snapshot is only rebuilt when the document was modified since
+ * the last call. Must be called on the thread which owns the document,
+ * the result may be handed to any number of background threads.
+ */
+std::shared_ptr<const LC_DocumentSnapshot> RS_Document::getSnapshot()
+{
+    auto current = std::atomic_load( &snapshot);
+    if (nullptr == current || current->getRevision() != revision) {
+        current = std::make_shared<const LC_DocumentSnapshot>( *this);
+        std::atomic_store( &snapshot, current);
+    }
+
+    return current;
+}
+
+/**
+ * Returns the most recently published snapshot without creating a new one.
+ * Lock-free and safe to call from any thread, may return nullptr or
+ * a snapshot of an older revision.
+ */
+std::shared_ptr<const LC_DocumentSnapshot> RS_Document::getLatestSnapshot() const
+{
+    return std::atomic_load( &snapshot);
+}
+
+
+/**
+ * Returns the intersection index of this document, which is created
+ * with the first call. It updates itself with the document content.
+ */
+LC_IntersectionIndex* RS_Document::getIntersectionIndex()
+{
+    if (nullptr == intersectionIndex) {
+        intersectionIndex.reset( new LC_IntersectionIndex( *this));
+    }
+
+    return intersectionIndex.get();
+}
+
+/**
+ * Drops the entity from the intersection index, if there is one.
+ * Called before an entity of this document is changed in place,
+ * removed or deleted.
+ */
+void RS_Document::invalidateIntersections(RS_Entity* entity)
+{
+    if (nullptr != intersectionIndex) {
+        intersectionIndex->invalidate( entity);
+    }
+}
@@ -29,11 +29,14 @@
 #ifndef RS_DOCUMENT_H
 #define RS_DOCUMENT_H
 
+#include <memory>
 #include "rs_layerlist.h"
 #include "rs_entitycontainer.h"
 #include "rs_undo.h"
 
 class RS_BlockList;
+class LC_DocumentSnapshot;
+class LC_IntersectionIndex;
 
 /**
  * Base class for documents. Documents can be either graphics or
@@ -47,7 +50,8 @@ class RS_Document : public RS_EntityContainer,
     public RS_Undo {
 public:
 	RS_Document(RS_EntityContainer* parent=nullptr);
-	virtual ~RS_Document() = default;
+	RS_Document(const RS_Document& other);
+	virtual ~RS_Document();
 
     virtual RS_LayerList* getLayerList() = 0;
     virtual RS_BlockList* getBlockList() = 0;
@@ -118,6 +122,9 @@ public:
 	virtual void setModified(bool m) {
 		//std::cout << "RS_Document::setModified: %d" << (int)m << std::endl;
 		modified = m;
+		if (m) {
+			increaseRevision();
+		}
 	}
 
 	/**
@@ -132,6 +139,32 @@ public:
      * Overwritten to set modified flag when undo cycle finished with undoable(s).
      */
     virtual void endUndoCycle() override;
+    bool undo() override;
+    bool redo() override;
+
+    /**
+     * @return Revision counter, increased with every modification
+     * of the document.
+     */
+    unsigned long getRevision() const {
+        return revision;
+    }
+
+    /**
+     * Marks the document content as changed, outdating snapshots and
+     * caches which depend on it.
+     */
+    void increaseRevision() {
+        ++revision;
+    }
+
+    void validateAllDimensions();
+
+    std::shared_ptr<const LC_DocumentSnapshot> getSnapshot();
+    std::shared_ptr<const LC_DocumentSnapshot> getLatestSnapshot() const;
+
+    LC_IntersectionIndex* getIntersectionIndex();
+    void invalidateIntersections(RS_Entity* entity);
 
     void setGraphicView(RS_GraphicView * g) {gv = g;}
     RS_GraphicView* getGraphicView() {return gv;}
@@ -149,6 +182,13 @@ protected:
 	RS2::FormatType formatType;
     RS_GraphicView * gv;//used to read/save current view
 
+private:
+    /** Revision of the document content, see getRevision(). */
+    unsigned long revision {0};
+    /** Most recent snapshot, accessed with std::atomic_load/store only. */
+    std::shared_ptr<const LC_DocumentSnapshot> snapshot;
+    /** Created on first use, see getIntersectionIndex(). */
+    std::unique_ptr<LC_IntersectionIndex> intersectionIndex;
 };
 
 
@@ -139,6 +139,49 @@ RS_Vector getNearestDistHelper(RS_Ellipse const& e,
 	if (dist) *dist = vp.distanceTo(coord);
 	return vp;
 }
+
+/**
+ * @brief windowCrossings ellipse angles where the ellipse crosses the border
+ * of the window, in closed form. Tangent points are not crossings.
+ * @param vpMin lower left corner of the window
+ * @param vpMax upper right corner of the window
+ * @return ellipse angles in [0, 2 pi)
+ */
+std::vector<double> windowCrossings(RS_EllipseData const& d,
+									RS_Vector const& vpMin,
+									RS_Vector const& vpMax)
+{
+	// ellipse points are center + u cos(t) + v sin(t)
+	RS_Vector const& u = d.majorP;
+	RS_Vector const v = RS_Vector{-u.y, u.x} * d.ratio;
+
+	std::vector<double> ret;
+	for (bool const yBorder: {false, true}) {
+		double const a = yBorder ? u.y : u.x;
+		double const b = yBorder ? v.y : v.x;
+		double const r = std::hypot(a, b);
+		if (r < RS_TOLERANCE) continue;
+		double const phi = std::atan2(b, a);
+		double const c0 = yBorder ? d.center.y : d.center.x;
+		for (double const border: {yBorder ? vpMin.y : vpMin.x, yBorder ? vpMax.y : vpMax.x}) {
+			// a cos(t) + b sin(t) = r cos(t - phi) = border - c0
+			double const ct = (border - c0) / r;
+			if (std::abs(ct) >= 1. - RS_TOLERANCE) continue;
+			double const dt = std::acos(ct);
+			for (double const t: {phi + dt, phi - dt}) {
+				// the crossing must be on the border, corners are counted once
+				double const w = yBorder ?
+							d.center.x + u.x * cos(t) + v.x * sin(t) :
+							d.center.y + u.y * cos(t) + v.y * sin(t);
+				double const wMin = yBorder ? vpMin.x : vpMin.y;
+				double const wMax = yBorder ? vpMax.x : vpMax.y;
+				if (yBorder ? (w > wMin && w < wMax) : (w >= wMin && w <= wMax))
+					ret.push_back(RS_Math::correctAngle(t));
+			}
+		}
+	}
+	return ret;
+}
 }
 
 std::ostream& operator << (std::ostream& os, const RS_EllipseData& ed) {
@@ -473,7 +516,7 @@ RS_Vector RS_Ellipse::getNearestPointOnEntity(const RS_Vector& coord,
         bool onEntity, double* dist, RS_Entity** entity)const
 {
 
-    RS_DEBUG->print("RS_Ellipse::getNearestPointOnEntity");
+    RS_DEBUG_PRINT_DEBUG("RS_Ellipse::getNearestPointOnEntity");
     RS_Vector ret(false);
 
     if( ! coord.valid ) {
@@ -547,7 +590,7 @@ RS_Vector RS_Ellipse::getNearestPointOnEntity(const RS_Vector& coord,
 //        std::cout<<ce[0]<<' '<<ce[1]<<' '<<ce[2]<<' '<<ce[3]<<std::endl;
 //        std::cout<<"(x,y)=( "<<x<<" , "<<y<<" ) a= "<<a<<" b= "<<b<<" sine= "<<s<<" d2= "<<d2<<" dist= "<<d<<std::endl;
 //        std::cout<<"RS_Ellipse::getNearestPointOnEntity() finds no minimum, this should not happen\n";
-        RS_DEBUG->print(RS_Debug::D_ERROR,"RS_Ellipse::getNearestPointOnEntity() finds no minimum, this should not happen\n");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR,"RS_Ellipse::getNearestPointOnEntity() finds no minimum, this should not happen\n");
     }
 	if (dist) {
         *dist = sqrt(dDistance);
@@ -740,7 +783,7 @@ bool	RS_Ellipse::createFromCenter3Points(const RS_VectorSolutions& sol) {
   *@author: Dongxu Li
   */
 bool RS_Ellipse::createFromQuadratic(const std::vector<double>& dn){
-	RS_DEBUG->print("RS_Ellipse::createFromQuadratic() begin\n");
+	RS_DEBUG_PRINT_DEBUG("RS_Ellipse::createFromQuadratic() begin\n");
 	if(dn.size()!=3) return false;
 //	if(fabs(dn[0]) <RS_TOLERANCE2 || fabs(dn[2])<RS_TOLERANCE2) return false; //invalid quadratic form
 
@@ -776,7 +819,7 @@ bool RS_Ellipse::createFromQuadratic(const std::vector<double>& dn){
     setAngle1(0.);
 	setAngle2(0.);
 
-	RS_DEBUG->print("RS_Ellipse::createFromQuadratic(): successful\n");
+	RS_DEBUG_PRINT_DEBUG("RS_Ellipse::createFromQuadratic(): successful\n");
 	return true;
 }
 
@@ -844,7 +887,7 @@ bool	RS_Ellipse::createInscribeQuadrilateral(const std::vector<RS_Line*>& lines)
 		RS_VectorSolutions const& sol=RS_Information::getIntersectionLineLine( & diagonal[0],& diagonal[1]);
 		if(sol.getNumber()==0) {//this should not happen
 			//        RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Ellipse::createInscribeQuadrilateral(): can not locate projection Center");
-			RS_DEBUG->print("RS_Ellipse::createInscribeQuadrilateral(): can not locate projection Center");
+			RS_DEBUG_PRINT_DEBUG("RS_Ellipse::createInscribeQuadrilateral(): can not locate projection Center");
 			return false;
 		}
 		centerProjection=sol.get(0);
@@ -883,14 +926,14 @@ bool	RS_Ellipse::createInscribeQuadrilateral(const std::vector<RS_Line*>& lines)
 		if(sol.getNumber()==0){
 			//this should not happen
 			//        RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Ellipse::createInscribeQuadrilateral(): can not locate Ellipse Center");
-			RS_DEBUG->print("RS_Ellipse::createInscribeQuadrilateral(): can not locate Ellipse Center");
+			RS_DEBUG_PRINT_DEBUG("RS_Ellipse::createInscribeQuadrilateral(): can not locate Ellipse Center");
 			return false;
 		}
 		ellipseCenter=sol.get(0);
 	}
 	//	qDebug()<<"parallel="<<parallel;
 	if(parallel==1){
-		RS_DEBUG->print("RS_Ellipse::createInscribeQuadrilateral(): trapezoid detected\n");
+		RS_DEBUG_PRINT_DEBUG("RS_Ellipse::createInscribeQuadrilateral(): trapezoid detected\n");
 		//trapezoid
 		RS_Line* l0=quad[parallel_index].get();
 		RS_Line* l1=quad[(parallel_index+2)%4].get();
@@ -899,13 +942,13 @@ bool	RS_Ellipse::createInscribeQuadrilateral(const std::vector<RS_Line*>& lines)
 		if( fabs(centerPoint.distanceTo(l0->getStartpoint()) - centerPoint.distanceTo(l0->getEndpoint()))>RS_TOLERANCE)
 			return false;
 		//symmetric
-		RS_DEBUG->print("RS_Ellipse::createInscribeQuadrilateral(): symmetric trapezoid detected\n");
+		RS_DEBUG_PRINT_DEBUG("RS_Ellipse::createInscribeQuadrilateral(): symmetric trapezoid detected\n");
 		double d=l0->getDistanceToPoint(centerPoint);
 		double l=((l0->getLength()+l1->getLength()))*0.25;
 		double k= 4.*d/fabs(l0->getLength()-l1->getLength());
 		double theta=d/(l*k);
 		if(theta>=1. || d<RS_TOLERANCE) {
-			RS_DEBUG->print("RS_Ellipse::createInscribeQuadrilateral(): this should not happen\n");
+			RS_DEBUG_PRINT_DEBUG("RS_Ellipse::createInscribeQuadrilateral(): this should not happen\n");
 			return false;
 		}
 		theta=asin(theta);
@@ -958,7 +1001,7 @@ bool	RS_Ellipse::createInscribeQuadrilateral(const std::vector<RS_Line*>& lines)
 	//    std::cout<<"mt.size()="<<mt.size()<<std::endl;
 	switch(mt.size()){
 	case 2:{// the quadrilateral is a parallelogram
-		RS_DEBUG->print("RS_Ellipse::createInscribeQuadrilateral(): parallelogram detected\n");
+		RS_DEBUG_PRINT_DEBUG("RS_Ellipse::createInscribeQuadrilateral(): parallelogram detected\n");
 
 		//fixme, need to handle degenerate case better
 		//        double angle(center.angleTo(tangent[0]));
@@ -993,7 +1036,7 @@ bool	RS_Ellipse::createInscribeQuadrilateral(const std::vector<RS_Line*>& lines)
 		if ( ! RS_Math::linearSolver(mt,dn) ) return false;
 		break;
 	default:
-		RS_DEBUG->print(RS_Debug::D_WARNING,"No inscribed ellipse for non isosceles trapezoid");
+		RS_DEBUG_PRINT(RS_Debug::D_WARNING,"No inscribed ellipse for non isosceles trapezoid");
 		return false; //invalid quadrilateral
 	}
 
@@ -1024,7 +1067,7 @@ RS_Vector RS_Ellipse::getNearestMiddle(const RS_Vector& coord,
                                        double* dist,
                                        int middlePoints
                                        ) const{
-    RS_DEBUG->print("RS_Ellpse::getNearestMiddle(): begin\n");
+    RS_DEBUG_PRINT_DEBUG("RS_Ellpse::getNearestMiddle(): begin\n");
 	if ( ! isEllipticArc() ) {
         //no middle point for whole ellipse, angle1=angle2=0
 		if (dist) {
@@ -1069,7 +1112,7 @@ RS_Vector RS_Ellipse::getNearestMiddle(const RS_Vector& coord,
         *dist = vp.distanceTo(coord);
     }
     //RS_DEBUG->print("RS_Ellipse::getNearestMiddle: angle1=%g, angle2=%g, middle=%g\n",amin,amax,a);
-    RS_DEBUG->print("RS_Ellpse::getNearestMiddle(): end\n");
+    RS_DEBUG_PRINT_DEBUG("RS_Ellpse::getNearestMiddle(): end\n");
     return vp;
 }
 
@@ -1217,7 +1260,7 @@ RS2::Ending RS_Ellipse::getTrimPoint(const RS_Vector& trimCoord,
 RS_Vector RS_Ellipse::prepareTrim(const RS_Vector& trimCoord,
                                   const RS_VectorSolutions& trimSol) {
 //special trimming for ellipse arc
-        RS_DEBUG->print("RS_Ellipse::prepareTrim()");
+        RS_DEBUG_PRINT_DEBUG("RS_Ellipse::prepareTrim()");
     if( ! trimSol.hasValid() ) return (RS_Vector(false));
     if( trimSol.getNumber() == 1 ) return (trimSol.get(0));
     double am=getEllipseAngle(trimCoord);
@@ -1544,23 +1587,9 @@ bool RS_Ellipse::isVisibleInWindow(RS_GraphicView* view) const
 {
     RS_Vector vpMin(view->toGraph(0,view->getHeight()));
     RS_Vector vpMax(view->toGraph(view->getWidth(),0));
-    //viewport
-    QRectF visualRect(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y);
-    QPolygonF visualBox(visualRect);
-	std::vector<RS_Vector> vps;
-    for(unsigned short i=0;i<4;i++){
-        const QPointF& vp(visualBox.at(i));
-		vps.push_back(RS_Vector(vp.x(),vp.y()));
-    }
-    //check for intersection points with viewport
-    for(unsigned short i=0;i<4;i++){
-		RS_Line line{vps.at(i),vps.at((i+1)%4)};
-		RS_Ellipse e0(nullptr, getData());
-        if( RS_Information::getIntersection(&e0, &line, true).size()>0) return true;
-    }
-    //is startpoint within viewport
-    QRectF ellipseRect(minV.x, minV.y, maxV.x - minV.x, maxV.y - minV.y);
-    return ellipseRect.intersects(visualRect);
+    //the bounding box covers the elliptic arc only
+    return !(getMax().x < vpMin.x || getMax().y < vpMin.y
+             || getMin().x > vpMax.x || getMin().y > vpMax.y);
 }
 
 /** return the equation of the entity
@@ -1695,74 +1724,61 @@ double RS_Ellipse::getMinorRadius() const {
 	return data.majorP.magnitude()*data.ratio;
 }
 
+/**
+ * The bounding box is tested first: an ellipse fully inside the window is
+ * drawn directly, one outside is skipped. Only ellipses crossing the border
+ * are clipped to their visible angle ranges.
+ */
 void RS_Ellipse::draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset) {
-	if(isEllipticArc()==false){
-        RS_Ellipse arc(*this);
-        arc.setAngle2(2.*M_PI);
-        arc.setReversed(false);
-        arc.draw(painter,view,patternOffset);
-        return;
-    }
-    //only draw the visible portion of line
-    RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-    RS_Vector vpMax(view->toGraph(view->getWidth(),0));
-    QPolygonF visualBox(QRectF(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y));
-
-    RS_Vector vpStart(isReversed()?getEndpoint():getStartpoint());
-    RS_Vector vpEnd(isReversed()?getStartpoint():getEndpoint());
-
-	std::vector<RS_Vector> vertex(0);
-    for(unsigned short i=0;i<4;i++){
-        const QPointF& vp(visualBox.at(i));
-		vertex.emplace_back(vp.x(),vp.y());
-    }
-    /** angles at cross points */
-	std::vector<double> crossPoints(0);
-
-    double baseAngle=isReversed()?getAngle2():getAngle1();
-    for(unsigned short i=0;i<4;i++){
-		RS_Line line{vertex.at(i),vertex.at((i+1)%4)};
-		auto vpIts=RS_Information::getIntersection(
-                    static_cast<RS_Entity*>(this), &line, true);
-//    std::cout<<"vpIts.size()="<<vpIts.size()<<std::endl;
-        if( vpIts.size()==0) continue;
-		for(const RS_Vector& vp: vpIts){
-			auto ap1=getTangentDirection(vp).angle();
-			auto ap2=line.getTangentDirection(vp).angle();
-            //ignore tangent points, because the arc doesn't cross over
-            if( fabs( remainder(ap2 - ap1, M_PI) ) < RS_TOLERANCE_ANGLE) continue;
-            crossPoints.push_back(
-                        RS_Math::getAngleDifference(baseAngle, getEllipseAngle(vp))
-                        );
-        }
-    }
-    if(vpStart.isInWindowOrdered(vpMin, vpMax)) crossPoints.push_back(0.);
-    if(vpEnd.isInWindowOrdered(vpMin, vpMax)) crossPoints.push_back(
-                RS_Math::getAngleDifference(baseAngle,isReversed()?getAngle1():getAngle2())
-                );
+	if (!(painter && view)) return;
 
+	RS_Vector const vpMin(view->toGraph(0,view->getHeight()));
+	RS_Vector const vpMax(view->toGraph(view->getWidth(),0));
+	RS_Vector const boxMin = getMin();
+	RS_Vector const boxMax = getMax();
+	if (boxMax.x < vpMin.x || boxMax.y < vpMin.y || boxMin.x > vpMax.x || boxMin.y > vpMax.y)
+		return;
+	if (boxMin.isInWindowOrdered(vpMin, vpMax) && boxMax.isInWindowOrdered(vpMin, vpMax)) {
+		drawVisible(painter, view, patternOffset);
+		return;
+	}
 
-    //sorting
-    std::sort(crossPoints.begin(),crossPoints.end());
-    //draw visible
-//    DEBUG_HEADER
-//    std::cout<<"crossPoints.size()="<<crossPoints.size()<<std::endl;
-    RS_Ellipse arc(*this);
-    arc.setSelected(isSelected());
-    arc.setPen(getPen());
-    arc.setReversed(false);
-    if( crossPoints.size() >= 2) {
-		for(size_t i=1;i<crossPoints.size();i+=2){
-			arc.setAngle1(baseAngle+crossPoints[i-1]);
-			arc.setAngle2(baseAngle+crossPoints[i]);
-            arc.drawVisible(painter,view,patternOffset);
-        }
-        return;
-    }
-    //a workaround for buggy equation solver, can be removed, when line-ellipse equation solver is reliable
-    if(isVisibleInWindow(view)){
-        arc.drawVisible(painter,view,patternOffset);
-    }
+	bool const isArc = isEllipticArc();
+	double const baseAngle = isArc && isReversed() ? getAngle2() : getAngle1();
+	double const angleLength = isArc ?
+				RS_Math::getAngleDifference(baseAngle, isReversed() ? getAngle1() : getAngle2()) :
+				2. * M_PI;
+
+	/** angles at cross points */
+	std::vector<double> crossPoints;
+	for (double const t: windowCrossings(data, vpMin, vpMax)) {
+		double const da = RS_Math::getAngleDifference(baseAngle, t);
+		if (da < angleLength) crossPoints.push_back(da);
+	}
+	if (isArc) {
+		RS_Vector const vpStart(isReversed()?getEndpoint():getStartpoint());
+		RS_Vector const vpEnd(isReversed()?getStartpoint():getEndpoint());
+		if (vpStart.isInWindowOrdered(vpMin, vpMax)) crossPoints.push_back(0.);
+		if (vpEnd.isInWindowOrdered(vpMin, vpMax)) crossPoints.push_back(angleLength);
+	} else if (getEllipsePoint(baseAngle).isInWindowOrdered(vpMin, vpMax)) {
+		// a closed ellipse is visible on both ends of the angle range
+		crossPoints.push_back(0.);
+		crossPoints.push_back(angleLength);
+	}
+	if (crossPoints.size() < 2) return;
+
+	//sorting
+	std::sort(crossPoints.begin(),crossPoints.end());
+	//draw visible
+	RS_Ellipse arc(*this);
+	arc.setSelected(isSelected());
+	arc.setPen(getPen());
+	arc.setReversed(false);
+	for(size_t i=1;i<crossPoints.size();i+=2){
+		arc.setAngle1(baseAngle+crossPoints[i-1]);
+		arc.setAngle2(baseAngle+crossPoints[i]);
+		arc.drawVisible(painter,view,patternOffset);
+	}
 }
 
 /** directly draw the arc, assuming the whole arc is within visible window */
@@ -1798,7 +1814,7 @@ void RS_Ellipse::drawVisible(RS_Painter* painter, RS_GraphicView* view, double&
 				view->getPattern(getPen().getLineType());
 
 	if (!pat) {
-        RS_DEBUG->print(RS_Debug::D_WARNING, "Invalid pattern for Ellipse");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING, "Invalid pattern for Ellipse");
         return;
     }
 
@@ -1811,7 +1827,7 @@ void RS_Ellipse::drawVisible(RS_Painter* painter, RS_GraphicView* view, double&
 	if(a2 <a1+RS_TOLERANCE_ANGLE) a2 += 2.*M_PI;
     painter->setPen(pen);
 	if(pat->num <= 0){
-		RS_DEBUG->print(RS_Debug::D_WARNING,"Invalid pattern when drawing ellipse");
+		RS_DEBUG_PRINT(RS_Debug::D_WARNING,"Invalid pattern when drawing ellipse");
 		painter->drawEllipse(cp, ra, rb, mAngle, a1, a2, false);
 		return;
 	}
@@ -113,6 +113,16 @@ void RS_Entity::resetBorders() {
 }
 
 
+/**
+ * Recalculates invalidated borders on first access.
+ */
+void RS_Entity::validateBorders() const {
+    RS_Entity* self = const_cast<RS_Entity*>(this);
+    self->delFlag(RS2::FlagBordersDirty);
+    self->updateDirtyBorders();
+}
+
+
 void RS_Entity::moveBorders(const RS_Vector& offset){
 	minV.move(offset);
 	maxV.move(offset);
@@ -225,6 +235,15 @@ void RS_Entity::undoStateChanged(bool undone)
 }
 
 
+/**
+ * @return Estimated memory held by this entity for undo purposes.
+ */
+size_t RS_Entity::undoMemoryUsage() const
+{
+    return sizeof(RS_Entity) + varList.size() * 2 * sizeof(QString);
+}
+
+
 /**
  * @return true if this entity or any parent entities are undone.
  */
@@ -304,7 +323,7 @@ bool RS_Entity::isVisibleInWindow(RS_GraphicView* view) const
 		RS_Line const line{vps.at(i),vps.at((i+1)%4)};
 		if( RS_Information::getIntersection(this, &line, true).size()>0) return true;
     }
-    if( minV.isInWindowOrdered(vpMin,vpMax)||maxV.isInWindowOrdered(vpMin,vpMax)) return true;
+    if( getMin().isInWindowOrdered(vpMin,vpMax)||getMax().isInWindowOrdered(vpMin,vpMax)) return true;
     return false;
 }
 
@@ -461,7 +480,7 @@ bool RS_Entity::isHighlighted() const{
 
 
 RS_Vector RS_Entity::getSize() const {
-	return maxV-minV;
+	return getMax()-getMin();
 }
 
 /**
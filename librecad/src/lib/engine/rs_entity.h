@@ -207,6 +207,7 @@ public:
 
 	void undoStateChanged(bool undone) override;
     virtual bool isUndone() const;
+	size_t undoMemoryUsage() const override;
 
     /**
      * Can be implemented by child classes to update the entities
@@ -220,20 +221,28 @@ public:
     }
 
     /**
-     * This method doesn't do any calculations.
+     * This method doesn't do any calculations, unless the borders were
+     * invalidated (RS2::FlagBordersDirty).
      * @return minimum coordinate of the entity.
      * @see calculateBorders()
      */
     RS_Vector getMin() const {
+        if (getFlag(RS2::FlagBordersDirty)) {
+            validateBorders();
+        }
         return minV;
     }
 
     /**
-     * This method doesn't do any calculations.
-     * @return minimum coordinate of the entity.
+     * This method doesn't do any calculations, unless the borders were
+     * invalidated (RS2::FlagBordersDirty).
+     * @return maximum coordinate of the entity.
      * @see calculateBorders()
      */
     RS_Vector getMax() const {
+        if (getFlag(RS2::FlagBordersDirty)) {
+            validateBorders();
+        }
         return maxV;
     }
 
@@ -559,6 +568,16 @@ m0 x + m1 y + m2 =0
 	virtual bool isArcCircleLine() const;
 
 protected:
+	void validateBorders() const;
+
+	/**
+	 * Recalculates borders which were invalidated with RS2::FlagBordersDirty.
+	 * Called lazily on the next getMin()/getMax().
+	 */
+	virtual void updateDirtyBorders() {
+		calculateBorders();
+	}
+
 	//! Entity's parent entity or nullptr is this entity has no parent.
 	RS_EntityContainer* parent = nullptr;
     //! minimum coordinates
@@ -32,9 +32,12 @@
 #include "rs_dialogfactory.h"
 #include "qg_dialogfactory.h"
 #include "rs_entitycontainer.h"
+#include "lc_entityiterator.h"
+#include "lc_intersectionindex.h"
 
 #include "rs_debug.h"
 #include "rs_dimension.h"
+#include "rs_document.h"
 #include "rs_layer.h"
 #include "rs_arc.h"
 #include "rs_ellipse.h"
@@ -91,13 +94,13 @@ RS_EntityContainer::~RS_EntityContainer() {
 
 
 RS_Entity* RS_EntityContainer::clone() const{
-    RS_DEBUG->print("RS_EntityContainer::clone: ori autoDel: %d",
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::clone: ori autoDel: %d",
                     autoDelete);
 
     RS_EntityContainer* ec = new RS_EntityContainer(*this);
     ec->setOwner(autoDelete);
 
-    RS_DEBUG->print("RS_EntityContainer::clone: clone autoDel: %d",
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::clone: clone autoDel: %d",
                     ec->isOwner());
 
     ec->detach();
@@ -115,7 +118,7 @@ RS_Entity* RS_EntityContainer::clone() const{
 void RS_EntityContainer::detach() {
     QList<RS_Entity*> tmp;
     bool autoDel = isOwner();
-    RS_DEBUG->print("RS_EntityContainer::detach: autoDel: %d",
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::detach: autoDel: %d",
                     (int)autoDel);
     setOwner(false);
 
@@ -239,48 +242,57 @@ void RS_EntityContainer::selectWindow(RS_Vector v1, RS_Vector v2,
 
     bool included;
 
+    // edges of the crossing window, each one intersected in one batch
+    // with an entity or the parts of a container:
+    RS_EntityContainer l;
+    if (cross) {
+        l.addRectangle(v1, v2);
+    }
+    std::vector<RS_Entity*> candidates;
+    std::vector<RS_Information::IntersectionHit> hits;
+    auto crossesWindow = [&]() {
+        for (RS_Entity* edge: l) {
+            hits.clear();
+            if (0 < RS_Information::getIntersections(edge, candidates, hits, true)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
 	for(auto e: entities){
 
         included = false;
 
+        // the extent of dimensions is only estimated until they are regenerated
+        if (RS_Information::isDimension(e->rtti())) {
+            static_cast<RS_Dimension*>(e)->validateDim();
+        }
+
         if (e->isVisible()) {
             if (e->isInWindow(v1, v2)) {
                 //e->setSelected(select);
                 included = true;
 			} else if (cross) {
-				RS_EntityContainer l;
-				l.addRectangle(v1, v2);
-                RS_VectorSolutions sol;
-
+                candidates.clear();
                 if (e->isContainer()) {
-                    RS_EntityContainer* ec = (RS_EntityContainer*)e;
-                    for (RS_Entity* se=ec->firstEntity(RS2::ResolveAll);
+                    LC_EntityIterator it(*static_cast<RS_EntityContainer*>(e), RS2::ResolveAll);
+                    for (RS_Entity* se = it.first();
 						 se && included==false;
-                         se=ec->nextEntity(RS2::ResolveAll)) {
+                         se = it.next()) {
 
                         if (se->rtti() == RS2::EntitySolid){
 							included = static_cast<RS_Solid*>(se)->isInCrossWindow(v1,v2);
                         } else {
-							for (auto line: l) {
-                                sol = RS_Information::getIntersection(
-											se, line, true);
-                                if (sol.hasValid()) {
-                                    included = true;
-                                    break;
-                                }
-                            }
+                            candidates.push_back(se);
                         }
                     }
+                    included = included || crossesWindow();
                 } else if (e->rtti() == RS2::EntitySolid){
 					included = static_cast<RS_Solid*>(e)->isInCrossWindow(v1,v2);
                 } else {
-					for (auto line: l) {
-						sol = RS_Information::getIntersection(e, line, true);
-                        if (sol.hasValid()) {
-                            included = true;
-                            break;
-                        }
-                    }
+                    candidates.push_back(e);
+                    included = crossesWindow();
                 }
             }
         }
@@ -321,6 +333,7 @@ void RS_EntityContainer::addEntity(RS_Entity* entity) {
     if (autoUpdateBorders) {
         adjustBorders(entity);
     }
+    contentChanged();
 }
 
 
@@ -334,6 +347,7 @@ void RS_EntityContainer::appendEntity(RS_Entity* entity){
     entities.append(entity);
     if (autoUpdateBorders)
         adjustBorders(entity);
+    contentChanged();
 }
 
 /**
@@ -345,6 +359,7 @@ void RS_EntityContainer::prependEntity(RS_Entity* entity){
     entities.prepend(entity);
     if (autoUpdateBorders)
         adjustBorders(entity);
+    contentChanged();
 }
 
 /**
@@ -394,6 +409,7 @@ void RS_EntityContainer::insertEntity(int index, RS_Entity* entity) {
     if (autoUpdateBorders) {
         adjustBorders(entity);
     }
+    contentChanged();
 }
 
 
@@ -430,21 +446,108 @@ bool RS_EntityContainer::removeEntity(RS_Entity* entity) {
     bool ret;
     ret = entities.removeOne(entity);
 
+    if (ret) {
+        RS_Document* document = getContentDocument();
+        if (nullptr != document) {
+            document->invalidateIntersections(entity);
+            document->increaseRevision();
+        }
+    }
+
+    // the borders can only shrink if the removed entity touched them.
+    // In that case, they are recalculated lazily on the next access:
+    if (autoUpdateBorders && ret && isOnBorder(entity)) {
+        invalidateBorders();
+    }
+
     if (autoDelete && ret) {
         delete entity;
     }
-    if (autoUpdateBorders) {
-        calculateBorders();
-    }
     return ret;
 }
 
 
 
+/**
+ * @return true if the bounding box of the given entity touches the
+ * borders of this container.
+ */
+bool RS_EntityContainer::isOnBorder(const RS_Entity* entity) const {
+    if (getFlag(RS2::FlagBordersDirty)) {
+        return false;
+    }
+    if (entity->isContainer() && entity->count()==0) {
+        return false;
+    }
+    RS_Vector const& eMin = entity->getMin();
+    RS_Vector const& eMax = entity->getMax();
+    return eMin.x <= minV.x + RS_TOLERANCE || eMin.y <= minV.y + RS_TOLERANCE
+            || eMax.x >= maxV.x - RS_TOLERANCE || eMax.y >= maxV.y - RS_TOLERANCE;
+}
+
+
+
+/**
+ * @return the document this container is part of, nullptr if there is
+ * none or it's part of a preview.
+ */
+RS_Document* RS_EntityContainer::getContentDocument() const {
+    for (const RS_Entity* e = this; e; e = e->getParent()) {
+        if (RS2::EntityPreview == e->rtti()) {
+            return nullptr;
+        }
+        if (e->isDocument()) {
+            return static_cast<RS_Document*>(const_cast<RS_Entity*>(e));
+        }
+    }
+    return nullptr;
+}
+
+
+
+/**
+ * Outdates the revision of the document after entities were added or
+ * removed, e.g. of a polyline growing while it's drawn without an undo
+ * cycle.
+ */
+void RS_EntityContainer::contentChanged() const {
+    RS_Document* document = getContentDocument();
+    if (nullptr != document) {
+        document->increaseRevision();
+    }
+}
+
+
+
+/**
+ * Marks the borders of this container as outdated. They are recalculated
+ * from the borders of the direct children on the next getMin() / getMax().
+ * Parents are invalidated as well if this container defines their borders.
+ */
+void RS_EntityContainer::invalidateBorders() {
+    if (getFlag(RS2::FlagBordersDirty)) {
+        return;
+    }
+    if (parent && parent->isOnBorder(this)) {
+        parent->invalidateBorders();
+    }
+    setFlag(RS2::FlagBordersDirty);
+}
+
+
+
 /**
  * Erases all entities in this container and resets the borders..
  */
 void RS_EntityContainer::clear() {
+    if (!entities.isEmpty()) {
+        RS_Document* document = getContentDocument();
+        if (nullptr != document) {
+            document->invalidateIntersections(this);
+            document->increaseRevision();
+        }
+    }
+
     if (autoDelete) {
         while (!entities.isEmpty())
             delete entities.takeFirst();
@@ -471,6 +574,21 @@ unsigned int RS_EntityContainer::countDeep() const{
 
 
 
+/**
+ * @return Estimated memory held by this container and its children.
+ */
+size_t RS_EntityContainer::undoMemoryUsage() const
+{
+    size_t usage = RS_Entity::undoMemoryUsage()
+            + entities.size() * sizeof(RS_Entity*);
+    for (auto e: *this) {
+        usage += e->undoMemoryUsage();
+    }
+    return usage;
+}
+
+
+
 /**
  * Counts the selected entities in this container.
  */
@@ -537,8 +655,9 @@ void RS_EntityContainer::adjustBorders(RS_Entity* entity) {
  * Recalculates the borders of this entity container.
  */
 void RS_EntityContainer::calculateBorders() {
-    RS_DEBUG->print("RS_EntityContainer::calculateBorders");
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::calculateBorders");
 
+	delFlag(RS2::FlagBordersDirty);
 	resetBorders();
 	for (RS_Entity* e: entities){
 
@@ -553,7 +672,7 @@ void RS_EntityContainer::calculateBorders() {
         }
     }
 
-    RS_DEBUG->print("RS_EntityContainer::calculateBorders: size 1: %f,%f",
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::calculateBorders: size 1: %f,%f",
                     getSize().x, getSize().y);
 
     // needed for correcting corrupt data (PLANS.dxf)
@@ -570,7 +689,7 @@ void RS_EntityContainer::calculateBorders() {
         maxV.y = 0.0;
     }
 
-    RS_DEBUG->print("RS_EntityCotnainer::calculateBorders: size: %f,%f",
+    RS_DEBUG_PRINT_DEBUG("RS_EntityCotnainer::calculateBorders: size: %f,%f",
                     getSize().x, getSize().y);
 
     //RS_DEBUG->print("  borders: %f/%f %f/%f", minV.x, minV.y, maxV.x, maxV.y);
@@ -579,6 +698,44 @@ void RS_EntityContainer::calculateBorders() {
     //RS_Entity::calculateBorders();
 }
 
+/**
+ * Recalculates invalidated borders. Unlike calculateBorders(), this
+ * doesn't recurse: the children's borders are still valid.
+ */
+void RS_EntityContainer::updateDirtyBorders() {
+    mergeChildBorders();
+}
+
+
+
+/**
+ * Sets the borders of this container to the union of the current borders
+ * of its visible children.
+ */
+void RS_EntityContainer::mergeChildBorders() {
+    resetBorders();
+    for (RS_Entity* e: entities){
+        RS_Layer* layer = e->getLayer();
+        if (e->isVisible() && !(layer && layer->isFrozen())) {
+            adjustBorders(e);
+        }
+    }
+
+    // needed for correcting corrupt data (PLANS.dxf)
+    if (minV.x>maxV.x || minV.x>RS_MAXDOUBLE || maxV.x>RS_MAXDOUBLE
+            || minV.x<RS_MINDOUBLE || maxV.x<RS_MINDOUBLE) {
+
+        minV.x = 0.0;
+        maxV.x = 0.0;
+    }
+    if (minV.y>maxV.y || minV.y>RS_MAXDOUBLE || maxV.y>RS_MAXDOUBLE
+            || minV.y<RS_MINDOUBLE || maxV.y<RS_MINDOUBLE) {
+
+        minV.y = 0.0;
+        maxV.y = 0.0;
+    }
+}
+
 //namespace {
 //bool isBoundingBoxValid(RS_Entity* e) {
 //	if (!(e->getMin() && e->getMax())) return false;
@@ -596,6 +753,7 @@ void RS_EntityContainer::calculateBorders() {
 void RS_EntityContainer::forcedCalculateBorders() {
     //RS_DEBUG->print("RS_EntityContainer::calculateBorders");
 
+    delFlag(RS2::FlagBordersDirty);
     resetBorders();
     for (RS_Entity* e: entities){
 
@@ -637,7 +795,7 @@ void RS_EntityContainer::forcedCalculateBorders() {
  */
 void RS_EntityContainer::updateDimensions(bool autoText) {
 
-    RS_DEBUG->print("RS_EntityContainer::updateDimensions()");
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::updateDimensions()");
 
     //for (RS_Entity* e=firstEntity(RS2::ResolveNone);
 	//        e;
@@ -645,16 +803,33 @@ void RS_EntityContainer::updateDimensions(bool autoText) {
 
 	for (RS_Entity* e: entities){
         if (RS_Information::isDimension(e->rtti())) {
-            // update and reposition label:
-            ((RS_Dimension*)e)->updateDim(autoText);
+            // update and reposition label, when needed:
+            ((RS_Dimension*)e)->invalidateDim(autoText);
         } else if(e->rtti()==RS2::EntityDimLeader)
             e->update();
         else if (e->isContainer()) {
             ((RS_EntityContainer*)e)->updateDimensions(autoText);
         }
     }
+    invalidateBorders();
 
-    RS_DEBUG->print("RS_EntityContainer::updateDimensions() OK");
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::updateDimensions() OK");
+}
+
+
+
+/**
+ * Regenerates all dimensions which were invalidated, for code using
+ * their sub entities without drawing them.
+ */
+void RS_EntityContainer::validateDimensions() {
+	for (RS_Entity* e: entities){
+        if (RS_Information::isDimension(e->rtti())) {
+            ((RS_Dimension*)e)->validateDim();
+        } else if (e->isContainer()) {
+            ((RS_EntityContainer*)e)->validateDimensions();
+        }
+    }
 }
 
 
@@ -664,25 +839,25 @@ void RS_EntityContainer::updateDimensions(bool autoText) {
  */
 void RS_EntityContainer::updateInserts() {
 
-    RS_DEBUG->print("RS_EntityContainer::updateInserts() ID/type: %d/%d", getId(), rtti());
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::updateInserts() ID/type: %d/%d", getId(), rtti());
 
     for (RS_Entity* e: entities){
         //// Only update our own inserts and not inserts of inserts
         if (e->rtti()==RS2::EntityInsert  /*&& e->getParent()==this*/) {
             ((RS_Insert*)e)->update();
-            RS_DEBUG->print("RS_EntityContainer::updateInserts: updated ID/type: %d/%d", e->getId(), e->rtti());
+            RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::updateInserts: updated ID/type: %d/%d", e->getId(), e->rtti());
         } else if (e->isContainer()) {
             if (e->rtti()==RS2::EntityHatch) {
-                RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_EntityContainer::updateInserts: skip hatch ID/type: %d/%d", e->getId(), e->rtti());
+                RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::updateInserts: skip hatch ID/type: %d/%d", e->getId(), e->rtti());
             } else {
-                RS_DEBUG->print("RS_EntityContainer::updateInserts: update container ID/type: %d/%d", e->getId(), e->rtti());
+                RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::updateInserts: update container ID/type: %d/%d", e->getId(), e->rtti());
                 ((RS_EntityContainer*)e)->updateInserts();
             }
         } else {
-            RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_EntityContainer::updateInserts: skip entity ID/type: %d/%d", e->getId(), e->rtti());
+            RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::updateInserts: skip entity ID/type: %d/%d", e->getId(), e->rtti());
         }
     }
-    RS_DEBUG->print("RS_EntityContainer::updateInserts() ID/type: %d/%d OK", getId(), rtti());
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::updateInserts() ID/type: %d/%d OK", getId(), rtti());
 }
 
 
@@ -693,7 +868,7 @@ void RS_EntityContainer::updateInserts() {
  */
 void RS_EntityContainer::renameInserts(const QString& oldName,
                                        const QString& newName) {
-    RS_DEBUG->print("RS_EntityContainer::renameInserts()");
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::renameInserts()");
 
     //for (RS_Entity* e=firstEntity(RS2::ResolveNone);
 	//        e;
@@ -710,7 +885,7 @@ void RS_EntityContainer::renameInserts(const QString& oldName,
         }
     }
 
-    RS_DEBUG->print("RS_EntityContainer::renameInserts() OK");
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::renameInserts() OK");
 
 }
 
@@ -719,7 +894,7 @@ void RS_EntityContainer::renameInserts(const QString& oldName,
  */
 void RS_EntityContainer::updateSplines() {
 
-    RS_DEBUG->print("RS_EntityContainer::updateSplines()");
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::updateSplines()");
 
 	for (RS_Entity* e: entities){
         //// Only update our own inserts and not inserts of inserts
@@ -730,7 +905,7 @@ void RS_EntityContainer::updateSplines() {
         }
     }
 
-    RS_DEBUG->print("RS_EntityContainer::updateSplines() OK");
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::updateSplines() OK");
 }
 
 
@@ -1312,14 +1487,17 @@ RS_Vector RS_EntityContainer::getNearestIntersection(const RS_Vector& coord,
 
 	closestEntity = getNearestEntity(coord, nullptr, RS2::ResolveAllButTextImage);
 
+    // documents keep an index, which avoids to intersect with every entity
+    if (closestEntity && isDocument()) {
+        return static_cast<RS_Document*>(this)->getIntersectionIndex()
+                ->getNearestIntersection(closestEntity, coord, dist);
+    }
+
 	if (closestEntity) {
-        for (RS_Entity* en = firstEntity(RS2::ResolveAllButTextImage);
-             en;
-             en = nextEntity(RS2::ResolveAllButTextImage)) {
-            if (
-                    !en->isVisible()
-					|| en->getParent()->ignoredSnap()
-                    ){
+        LC_EntityIterator it(*this, RS2::ResolveAllButTextImage);
+        it.setVisibleOnly();
+        for (RS_Entity* en = it.first(); en; en = it.next()) {
+            if (en->getParent()->ignoredSnap()) {
                 continue;
             }
 
@@ -1401,7 +1579,7 @@ double RS_EntityContainer::getDistanceToPoint(const RS_Vector& coord,
                                               RS2::ResolveLevel level,
                                               double solidDist) const{
 
-    RS_DEBUG->print("RS_EntityContainer::getDistanceToPoint");
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::getDistanceToPoint");
 
 
     double minDist = RS_MAXDOUBLE;      // minimum measured distance
@@ -1412,13 +1590,13 @@ double RS_EntityContainer::getDistanceToPoint(const RS_Vector& coord,
 	for(auto e: entities){
 
         if (e->isVisible()) {
-            RS_DEBUG->print("entity: getDistanceToPoint");
-            RS_DEBUG->print("entity: %d", e->rtti());
+            RS_DEBUG_PRINT_DEBUG("entity: getDistanceToPoint");
+            RS_DEBUG_PRINT_DEBUG("entity: %d", e->rtti());
             // bug#426, need to ignore Images to find nearest intersections
             if(level==RS2::ResolveAllButTextImage && e->rtti()==RS2::EntityImage) continue;
             curDist = e->getDistanceToPoint(coord, &subEntity, level, solidDist);
 
-            RS_DEBUG->print("entity: getDistanceToPoint: OK");
+            RS_DEBUG_PRINT_DEBUG("entity: getDistanceToPoint: OK");
 
 			/*
 			 * By using '<=', we will prefer the *last* item in the container if there are multiple
@@ -1447,7 +1625,7 @@ double RS_EntityContainer::getDistanceToPoint(const RS_Vector& coord,
 	if (entity) {
         *entity = closestEntity;
     }
-    RS_DEBUG->print("RS_EntityContainer::getDistanceToPoint: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::getDistanceToPoint: OK");
 
     return minDist;
 }
@@ -1458,7 +1636,7 @@ RS_Entity* RS_EntityContainer::getNearestEntity(const RS_Vector& coord,
                                                 double* dist,
 												RS2::ResolveLevel level) const{
 
-    RS_DEBUG->print("RS_EntityContainer::getNearestEntity");
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::getNearestEntity");
 
 	RS_Entity* e = nullptr;
 
@@ -1478,7 +1656,7 @@ RS_Entity* RS_EntityContainer::getNearestEntity(const RS_Vector& coord,
 	if (dist) {
         *dist = d;
     }
-    RS_DEBUG->print("RS_EntityContainer::getNearestEntity: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::getNearestEntity: OK");
 
     return e;
 }
@@ -1500,7 +1678,7 @@ bool RS_EntityContainer::optimizeContours() {
 
 //    DEBUG_HEADER
 //    std::cout<<"loop with count()="<<count()<<std::endl;
-    RS_DEBUG->print("RS_EntityContainer::optimizeContours");
+    RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::optimizeContours");
 
     RS_EntityContainer tmp;
     tmp.setAutoUpdateBorders(false);
@@ -1575,14 +1753,14 @@ bool RS_EntityContainer::optimizeContours() {
                 QG_DIALOGFACTORY->commandMessage(
                             errMsg.arg(dist).arg(vpTmp.x).arg(vpTmp.y).arg(vpEnd.x).arg(vpEnd.y)
                             );
-                RS_DEBUG->print(RS_Debug::D_ERROR, "RS_EntityContainer::optimizeContours: hatch failed due to a gap");
+                RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_EntityContainer::optimizeContours: hatch failed due to a gap");
                 closed=false;
                 break;
             }
         }
         if(!next) { 	    //workaround if next is nullptr
 //      	    std::cout<<"RS_EntityContainer::optimizeContours: next is nullptr" <<std::endl;
-            RS_DEBUG->print("RS_EntityContainer::optimizeContours: next is nullptr");
+            RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::optimizeContours: next is nullptr");
 //			closed=false;	//workaround if next is nullptr
             break;			//workaround if next is nullptr
         } 					//workaround if next is nullptr
@@ -1614,10 +1792,10 @@ bool RS_EntityContainer::optimizeContours() {
 //    std::cout<<"RS_EntityContainer::optimizeContours: 6"<<std::endl;
 
     if(closed) {
-        RS_DEBUG->print("RS_EntityContainer::optimizeContours: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::optimizeContours: OK");
     }
     else {
-        RS_DEBUG->print("RS_EntityContainer::optimizeContours: bad");
+        RS_DEBUG_PRINT_DEBUG("RS_EntityContainer::optimizeContours: bad");
     }
 //    std::cout<<"RS_EntityContainer::optimizeContours: end: count()="<<count()<<std::endl;
 //    std::cout<<"RS_EntityContainer::optimizeContours: closed="<<closed<<std::endl;
@@ -114,6 +114,7 @@ public:
 	}
 	unsigned count() const override;
 	unsigned countDeep() const override;
+	size_t undoMemoryUsage() const override;
 	//virtual unsigned long int countLayerEntities(RS_Layer* layer);
 	/** \brief countSelected number of selected
 	* @param deep count sub-containers, if true
@@ -131,8 +132,10 @@ public:
     }
     virtual void adjustBorders(RS_Entity* entity);
 	void calculateBorders() override;
+	void invalidateBorders();
 	void forcedCalculateBorders();
 	void updateDimensions( bool autoText=true);
+	void validateDimensions();
     virtual void updateInserts();
     virtual void updateSplines();
 	void update() override;
@@ -230,6 +233,11 @@ public:
     const QList<RS_Entity*>& getEntityList();
 
 protected:
+	void updateDirtyBorders() override;
+	void mergeChildBorders();
+	bool isOnBorder(const RS_Entity* entity) const;
+	RS_Document* getContentDocument() const;
+	void contentChanged() const;
 
     /** entities in the container */
     QList<RS_Entity *> entities;
@@ -27,6 +27,12 @@
 
 
 #include <iostream>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
 #include <QTextStream>
 #include <QTextCodec>
 
@@ -39,6 +45,35 @@
 #include "rs_math.h"
 #include "rs_debug.h"
 
+namespace {
+//! "LCFC", first bytes of a font cache file
+const quint32 fontCacheMagic = 0x4c434643;
+//! increase whenever the layout of the cache files changes
+const quint32 fontCacheVersion = 1;
+
+void writeDoubles(QDataStream& ds, const std::vector<double>& values) {
+    ds << static_cast<quint32>(values.size());
+    for (double v: values) {
+        ds << v;
+    }
+}
+
+bool readDoubles(QDataStream& ds, std::vector<double>& values) {
+    quint32 n = 0;
+    ds >> n;
+    // don't trust the size of damaged files
+    if (ds.status() != QDataStream::Ok
+            || n > static_cast<quint64>(ds.device()->bytesAvailable()) / sizeof(double)) {
+        return false;
+    }
+    values.resize(n);
+    for (double& v: values) {
+        ds >> v;
+    }
+    return ds.status() == QDataStream::Ok;
+}
+}
+
 /**
  * Constructor.
  *
@@ -51,13 +86,13 @@ RS_Font::RS_Font(const QString& fileName, bool owner)
     letterSpacing = 3.0;
     wordSpacing = 6.75;
     lineSpacingFactor = 1.0;
-    rawLffFontList.clear();
 }
 
 
 
 /**
- * Loads the font into memory.
+ * Loads the font into memory. Parsed fonts are cached in a binary
+ * file, which is used as long as the font file doesn't change.
  *
  * @retval true font was already loaded or is loaded now.
  * @retval false font could not be loaded.
@@ -69,10 +104,12 @@ bool RS_Font::loadFont() {
         return true;
     }
 
-    QString path;
+    QString path = filePath;
 
     // Search for the appropriate font if we have only the name of the font:
-    if (!fileName.toLower().contains(".cxf") &&
+    if (!path.isEmpty()) {
+        // path is known from the font list
+    } else if (!fileName.toLower().contains(".cxf") &&
             !fileName.toLower().contains(".lff")) {
         QStringList fonts = RS_SYSTEM->getNewFontList();
         fonts.append(RS_SYSTEM->getFontList());
@@ -115,12 +152,15 @@ bool RS_Font::loadFont() {
     }
     f.close();
 
-    if (path.contains(".cxf"))
-        readCXF(path);
-    if (path.contains(".lff"))
-        readLFF(path);
+    if (!readCache(path)) {
+        if (path.contains(".cxf"))
+            readCXF(path);
+        if (path.contains(".lff"))
+            readLFF(path);
+        writeCache(path);
+    }
 
-    RS_Block* bk = letterList.find(QChar(0xfffd));
+    RS_Block* bk = findLetter(QChar(0xfffd));
 	if (!bk) {
         // create new letter:
 		RS_FontChar* letter = new RS_FontChar(nullptr, QChar(0xfffd), RS_Vector(0.0, 0.0));
@@ -215,14 +255,10 @@ void RS_Font::readCXF(QString path) {
                 ch = line.at(1);
             }
 
-            // create new letter:
-            RS_FontChar* letter =
-					new RS_FontChar(nullptr, ch, RS_Vector(0.0, 0.0));
-
             // Read entities of this letter:
+            LetterData letter;
             QString coordsStr;
             QStringList coords;
-            QStringList::Iterator it2;
             do {
                 line = ts.readLine();
 
@@ -233,44 +269,27 @@ void RS_Font::readCXF(QString path) {
                 coordsStr = line.right(line.length()-2);
                 //                coords = QStringList::split(',', coordsStr);
                 coords = coordsStr.split(',', QString::SkipEmptyParts);
-                it2 = coords.begin();
 
                 // Line:
-                if (line.at(0)=='L') {
-                    double x1 = (*it2++).toDouble();
-                    double y1 = (*it2++).toDouble();
-                    double x2 = (*it2++).toDouble();
-                    double y2 = (*it2).toDouble();
-
-					RS_Line* line = new RS_Line{letter, {{x1, y1}, {x2, y2}}};
-                    line->setPen(RS_Pen(RS2::FlagInvalid));
-					line->setLayer(nullptr);
-                    letter->addEntity(line);
+                if (line.at(0)=='L' && coords.size()>=4) {
+                    for (int i = 0; i < 4; ++i) {
+                        letter.lines.push_back(coords.at(i).toDouble());
+                    }
                 }
 
                 // Arc:
-                else if (line.at(0)=='A') {
-                    double cx = (*it2++).toDouble();
-                    double cy = (*it2++).toDouble();
-                    double r = (*it2++).toDouble();
-					double a1 = RS_Math::deg2rad((*it2++).toDouble());
-					double a2 = RS_Math::deg2rad((*it2).toDouble());
-                    bool reversed = (line.at(1)=='R');
-
-                    RS_ArcData ad(RS_Vector(cx,cy),
-                                  r, a1, a2, reversed);
-                    RS_Arc* arc = new RS_Arc(letter, ad);
-                    arc->setPen(RS_Pen(RS2::FlagInvalid));
-					arc->setLayer(nullptr);
-                    letter->addEntity(arc);
+                else if (line.at(0)=='A' && coords.size()>=5) {
+                    letter.arcs.push_back(coords.at(0).toDouble());
+                    letter.arcs.push_back(coords.at(1).toDouble());
+                    letter.arcs.push_back(coords.at(2).toDouble());
+                    letter.arcs.push_back(RS_Math::deg2rad(coords.at(3).toDouble()));
+                    letter.arcs.push_back(RS_Math::deg2rad(coords.at(4).toDouble()));
+                    letter.arcs.push_back(line.at(1)=='R' ? 1.0 : 0.0);
                 }
             } while (!line.isEmpty());
 
-            if (letter->isEmpty()) {
-                delete letter;
-            } else {
-                letter->calculateBorders();
-                letterList.add(letter);
+            if (!letter.lines.empty() || !letter.arcs.empty()) {
+                rawLetters.insert(QString(ch), letter);
             }
         }
     }
@@ -341,99 +360,116 @@ void RS_Font::readLFF(QString path) {
                 continue;
             }
 
-            QStringList fontData;
-            do {
+            LetterData letter;
+            while (true) {
                 line = ts.readLine();
-                if(line.isEmpty()) break;
-                fontData.push_back(line);
-            } while(true);
-            if(fontData.size()>0) {
-                rawLffFontList[QString(ch)]=fontData;
-            }
+                if (line.isEmpty()) {
+                    break;
+                }
 
+                // Defined char:
+                if (line.at(0)=='C') {
+                    letter.refs.append(QChar(line.mid(1).toInt(nullptr, 16)));
+                    continue;
+                }
+
+                //sequence:
+                QStringList vertex = line.split(';', QString::SkipEmptyParts);
+                //at least is required two vertex
+                if (vertex.size()<2)
+                    continue;
+                std::vector<double> pline;
+                for (int i = 0; i < vertex.size(); ++i) {
+                    QStringList coords = vertex.at(i).split(',', QString::SkipEmptyParts);
+                    //at least X,Y is required
+                    if (coords.size()<2)
+                        continue;
+                    double bulge = 0;
+                    //check presence of bulge
+                    if (coords.size() == 3 && coords.at(2).at(0) == QChar('A')){
+                        QString bulgeStr = coords.at(2);
+                        bulge = bulgeStr.remove(0,1).toDouble();
+                    }
+                    pline.push_back(coords.at(0).toDouble());
+                    pline.push_back(coords.at(1).toDouble());
+                    pline.push_back(bulge);
+                }
+                letter.polylines.push_back(pline);
+            }
 
+            if (!letter.refs.isEmpty() || !letter.polylines.empty()) {
+                rawLetters.insert(QString(ch), letter);
+            }
         }
     }
     f.close();
 }
 
 void RS_Font::generateAllFonts(){
-    QMap<QString, QStringList>::const_iterator i = rawLffFontList.constBegin();
-    while (i != rawLffFontList.constEnd()) {
-        generateLffFont(i.key());
-        ++i;
+    // generating a letter removes it from the raw list:
+    while (!rawLetters.isEmpty()) {
+        generateLetter(rawLetters.constBegin().key());
     }
 }
 
-RS_Block* RS_Font::generateLffFont(const QString& ch){
-        if(rawLffFontList.contains(ch) == false ){
-                RS_DEBUG->print("RS_Font::generateLffFont(QChar %s ) : can not find the letter in given lff font file",qPrintable(ch));
-				return nullptr;
-        }
+/**
+ * Creates the block for a letter from its parsed definition.
+ */
+RS_Block* RS_Font::generateLetter(const QString& ch){
+    if (!rawLetters.contains(ch)) {
+        RS_DEBUG->print("RS_Font::generateLetter(QChar %s ) : can not find the letter in given font file",qPrintable(ch));
+        return nullptr;
+    }
     // create new letter:
     RS_FontChar* letter =
 			new RS_FontChar(nullptr, ch, RS_Vector(0.0, 0.0));
 
-    // Read entities of this letter:
-    QStringList vertex;
-    QStringList coords;
-    QStringList fontData=rawLffFontList[ch];
-    QString line;
+    // each letter is generated only once
+    LetterData const data = rawLetters.take(ch);
 
-    while(fontData.isEmpty() == false) {
-        line = fontData.takeFirst();
-
-        if (line.isEmpty()) {
-            continue;
+    // Defined chars:
+    for (QChar const& ref: data.refs) {
+        RS_Block* bk = letterList.find(ref);
+        if (!bk && rawLetters.contains(ref)) {
+            bk = generateLetter(ref);
         }
-
-        // Defined char:
-        if (line.at(0)=='C') {
-            line.remove(0,1);
-			int uCode = line.toInt(nullptr, 16);
-            QChar ch = QChar(uCode);
-            RS_Block* bk = letterList.find(ch);
-			if (!bk && rawLffFontList.contains(ch)) {
-                generateLffFont(ch);
-                bk = letterList.find(ch);
-            }
-			if (bk) {
-                RS_Entity* bk2 = bk->clone();
-                bk2->setPen(RS_Pen(RS2::FlagInvalid));
-				bk2->setLayer(nullptr);
-                letter->addEntity(bk2);
-            }
+        if (bk) {
+            RS_Entity* bk2 = bk->clone();
+            bk2->setPen(RS_Pen(RS2::FlagInvalid));
+            bk2->setLayer(nullptr);
+            letter->addEntity(bk2);
         }
-        //sequence:
-        else {
-            vertex = line.split(';', QString::SkipEmptyParts);
-            //at least is required two vertex
-            if (vertex.size()<2)
-                continue;
-            RS_Polyline* pline = new RS_Polyline(letter, RS_PolylineData());
-            pline->setPen(RS_Pen(RS2::FlagInvalid));
-			pline->setLayer(nullptr);
-            for (int i = 0; i < vertex.size(); ++i) {
-                double x1, y1;
-                double bulge = 0;
-
-                coords = vertex.at(i).split(',', QString::SkipEmptyParts);
-                //at least X,Y is required
-                if (coords.size()<2)
-                    continue;
-                x1 = coords.at(0).toDouble();
-                y1 = coords.at(1).toDouble();
-                //check presence of bulge
-                if (coords.size() == 3 && coords.at(2).at(0) == QChar('A')){
-                    QString bulgeStr = coords.at(2);
-                    bulge = bulgeStr.remove(0,1).toDouble();
-                }
-                pline->setNextBulge(bulge);
-                pline->addVertex(RS_Vector(x1, y1), bulge);
-            }
-            letter->addEntity(pline);
+    }
+
+    //sequences:
+    for (auto const& vertices: data.polylines) {
+        RS_Polyline* pline = new RS_Polyline(letter, RS_PolylineData());
+        pline->setPen(RS_Pen(RS2::FlagInvalid));
+        pline->setLayer(nullptr);
+        for (size_t i = 0; i + 2 < vertices.size(); i += 3) {
+            double const bulge = vertices[i + 2];
+            pline->setNextBulge(bulge);
+            pline->addVertex(RS_Vector(vertices[i], vertices[i + 1]), bulge);
         }
+        letter->addEntity(pline);
+    }
 
+    for (size_t i = 0; i + 3 < data.lines.size(); i += 4) {
+        RS_Line* line = new RS_Line{letter, {{data.lines[i], data.lines[i + 1]},
+                                             {data.lines[i + 2], data.lines[i + 3]}}};
+        line->setPen(RS_Pen(RS2::FlagInvalid));
+        line->setLayer(nullptr);
+        letter->addEntity(line);
+    }
+
+    for (size_t i = 0; i + 5 < data.arcs.size(); i += 6) {
+        RS_ArcData ad(RS_Vector(data.arcs[i], data.arcs[i + 1]),
+                      data.arcs[i + 2], data.arcs[i + 3], data.arcs[i + 4],
+                      data.arcs[i + 5] > 0.5);
+        RS_Arc* arc = new RS_Arc(letter, ad);
+        arc->setPen(RS_Pen(RS2::FlagInvalid));
+        arc->setLayer(nullptr);
+        letter->addEntity(arc);
     }
 
     if (letter->isEmpty()) {
@@ -449,9 +485,147 @@ RS_Block* RS_Font::generateLffFont(const QString& ch){
 RS_Block* RS_Font::findLetter(const QString& name) {
     RS_Block* ret= letterList.find(name);
 	if (ret) return ret;
-    return generateLffFont(name);
+    return generateLetter(name);
 
 }
+
+/**
+ * @return Path of the binary cache for the given font file.
+ */
+QString RS_Font::cacheFilePath(const QString& path) {
+    QString const dataDir = RS_SYSTEM->getAppDataDir();
+    if (dataDir.isEmpty()) {
+        return QString();
+    }
+    QByteArray const key = QCryptographicHash::hash(
+                QFileInfo(path).absoluteFilePath().toUtf8(),
+                QCryptographicHash::Md5).toHex();
+    return QString("%1/fontcache/%2-%3.lcf")
+            .arg(dataDir, QFileInfo(path).baseName(), QString(key));
+}
+
+/**
+ * Reads the parsed font from the binary cache. The cache file is memory
+ * mapped and only accepted if size and modification time of the font file
+ * still match.
+ *
+ * @retval false no valid cache exists, nothing was changed.
+ */
+bool RS_Font::readCache(const QString& path) {
+    QString const cachePath = cacheFilePath(path);
+    if (cachePath.isEmpty()) {
+        return false;
+    }
+    QFile f(cachePath);
+    if (!f.open(QIODevice::ReadOnly) || f.size() <= 0) {
+        return false;
+    }
+    uchar* mapped = f.map(0, f.size());
+    if (!mapped) {
+        return false;
+    }
+
+    QByteArray const bytes = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped),
+                                                     static_cast<int>(f.size()));
+    QDataStream ds(bytes);
+    ds.setVersion(QDataStream::Qt_5_0);
+
+    QFileInfo const source(path);
+    quint32 magic = 0, version = 0;
+    qint64 size = 0, modified = 0;
+    ds >> magic >> version >> size >> modified;
+    bool ok = magic == fontCacheMagic && version == fontCacheVersion
+            && size == source.size()
+            && modified == source.lastModified().toMSecsSinceEpoch();
+
+    double spacing = 0., word = 0., lineFactor = 0.;
+    QString enc, license, created;
+    QStringList fontNames, fontAuthors;
+    QHash<QString, LetterData> letters;
+    if (ok) {
+        quint32 count = 0;
+        ds >> spacing >> word >> lineFactor >> enc >> license >> created
+           >> fontNames >> fontAuthors >> count;
+        ok = ds.status() == QDataStream::Ok;
+        for (quint32 i = 0; ok && i < count; ++i) {
+            QString ch;
+            LetterData letter;
+            quint32 plines = 0;
+            ds >> ch >> letter.refs >> plines;
+            ok = ds.status() == QDataStream::Ok
+                    && plines <= static_cast<quint64>(bytes.size());
+            for (quint32 j = 0; ok && j < plines; ++j) {
+                letter.polylines.emplace_back();
+                ok = readDoubles(ds, letter.polylines.back());
+            }
+            ok = ok && readDoubles(ds, letter.lines) && readDoubles(ds, letter.arcs);
+            if (ok) {
+                letters.insert(ch, letter);
+            }
+        }
+    }
+
+    f.unmap(mapped);
+    if (!ok) {
+        RS_DEBUG->print("RS_Font::readCache: no valid cache for %s", qPrintable(path));
+        return false;
+    }
+
+    letterSpacing = spacing;
+    wordSpacing = word;
+    lineSpacingFactor = lineFactor;
+    encoding = enc;
+    fileLicense = license;
+    fileCreate = created;
+    names = fontNames;
+    authors = fontAuthors;
+    rawLetters = letters;
+
+    return true;
+}
+
+/**
+ * Writes the parsed font to the binary cache.
+ */
+void RS_Font::writeCache(const QString& path) const {
+    QString const cachePath = cacheFilePath(path);
+    if (cachePath.isEmpty() || !QDir().mkpath(QFileInfo(cachePath).absolutePath())) {
+        return;
+    }
+    QSaveFile f(cachePath);
+    if (!f.open(QIODevice::WriteOnly)) {
+        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        "RS_Font::writeCache: Cannot write font cache: %s",
+                        qPrintable(cachePath));
+        return;
+    }
+
+    QDataStream ds(&f);
+    ds.setVersion(QDataStream::Qt_5_0);
+
+    QFileInfo const source(path);
+    ds << fontCacheMagic << fontCacheVersion
+       << static_cast<qint64>(source.size())
+       << static_cast<qint64>(source.lastModified().toMSecsSinceEpoch());
+    ds << letterSpacing << wordSpacing << lineSpacingFactor
+       << encoding << fileLicense << fileCreate << names << authors
+       << static_cast<quint32>(rawLetters.size());
+    for (auto it = rawLetters.constBegin(); it != rawLetters.constEnd(); ++it) {
+        ds << it.key() << it->refs << static_cast<quint32>(it->polylines.size());
+        for (auto const& pline: it->polylines) {
+            writeDoubles(ds, pline);
+        }
+        writeDoubles(ds, it->lines);
+        writeDoubles(ds, it->arcs);
+    }
+
+    if (ds.status() != QDataStream::Ok || !f.commit()) {
+        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        "RS_Font::writeCache: Cannot write font cache: %s",
+                        qPrintable(cachePath));
+    }
+}
+
 /**
  * Dumps the fonts data to stdout.
  */
@@ -460,4 +634,3 @@ std::ostream& operator << (std::ostream& os, const RS_Font& f) {
     //<< (RS_BlockList&)f << "\n";
     return os;
 }
-
@@ -29,8 +29,10 @@
 #define RS_FONT_H
 
 #include <iosfwd>
+#include <vector>
 #include <QStringList>
 #include <QMap>
+#include <QHash>
 #include "rs_blocklist.h"
 
 /**
@@ -114,13 +116,34 @@ public:
     friend class RS_FontList;
 
 private:
+    /**
+     * Parsed definition of a letter, turned into a block on first use.
+     */
+    struct LetterData {
+        //! letters included in this one (LFF)
+        QString refs;
+        //! polylines as x, y, bulge triplets (LFF)
+        std::vector<std::vector<double>> polylines;
+        //! lines as x1, y1, x2, y2 (CXF)
+        std::vector<double> lines;
+        //! arcs as cx, cy, radius, angle1, angle2, reversed (CXF)
+        std::vector<double> arcs;
+    };
+
     void readCXF(QString path);
     void readLFF(QString path);
-    RS_Block* generateLffFont(const QString& ch);
+    RS_Block* generateLetter(const QString& ch);
+
+    static QString cacheFilePath(const QString& path);
+    bool readCache(const QString& path);
+    void writeCache(const QString& path) const;
 
 private:
-    //raw lff font file list, not processed into blocks yet
-    QMap<QString, QStringList> rawLffFontList;
+    //! letters of the font file, not processed into blocks yet
+    QHash<QString, LetterData> rawLetters;
+
+    //! full path of the font file, if known when the font list was built
+    QString filePath;
 
         //! block list (letters)
         RS_BlockList letterList;
@@ -0,0 +1,128 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <QPainterPath>
+#include "rs_fontchar.h"
+#include "rs_arc.h"
+#include "rs_line.h"
+#include "rs_painter.h"
+#include "rs_graphicview.h"
+#include "lc_entityiterator.h"
+
+namespace {
+//! maximum deviation of tessellated arcs, font units (letter height is 9)
+constexpr double glyphTolerance = 0.01;
+}
+
+/**
+ * Converts the entities of this letter to polylines in font coordinates.
+ *
+ * @return false if the letter contains entities other than lines and arcs.
+ */
+bool RS_FontChar::buildGlyph() const {
+    glyphBuilt = true;
+    glyph.clear();
+
+    LC_EntityIterator it(*this, RS2::ResolveAll);
+    for (const RS_Entity* e = it.first(); e; e = it.next()) {
+        switch (e->rtti()) {
+        case RS2::EntityLine:
+        case RS2::EntityArc:
+            break;
+        default:
+            glyph.clear();
+            return false;
+        }
+
+        RS_Vector const start = e->getStartpoint();
+        if (glyph.empty() || glyph.back().back().distanceTo( start) > RS_TOLERANCE) {
+            glyph.push_back({start});
+        }
+        std::vector<RS_Vector>& stroke = glyph.back();
+
+        if (RS2::EntityArc == e->rtti()) {
+            auto arc = static_cast<const RS_Arc*>(e);
+            double const r = arc->getRadius();
+            double sweep = arc->getAngleLength();
+            if (arc->isReversed()) {
+                sweep = -sweep;
+            }
+            double step = M_PI / 2.;
+            if (r > glyphTolerance) {
+                step = std::min( step, 2. * std::acos( 1. - glyphTolerance / r));
+            }
+            int const n = std::max( 1, static_cast<int>(std::ceil( std::fabs( sweep) / step)));
+            for (int i = 1; i < n; ++i) {
+                stroke.push_back( arc->getCenter()
+                                  + RS_Vector::polar( r, arc->getAngle1() + sweep * i / n));
+            }
+        }
+        stroke.push_back( e->getEndpoint());
+    }
+
+    glyphValid = true;
+    return true;
+}
+
+/**
+ * Draws this letter from its cached outline with a single path, as an
+ * insert with the given parameters would place it.
+ * The pen of the painter must be set up already.
+ *
+ * @return false if the letter can't be drawn from the cache.
+ */
+bool RS_FontChar::drawGlyph(RS_Painter* painter, RS_GraphicView* view,
+                            const RS_Vector& insertionPoint,
+                            const RS_Vector& scaleFactor, double angle) const {
+    if (!glyphBuilt) {
+        buildGlyph();
+    }
+    if (!glyphValid) {
+        return false;
+    }
+
+    RS_Vector const angleVector(angle);
+    RS_Vector const base = getBasePoint();
+    QPainterPath path;
+    for (auto const& stroke: glyph) {
+        bool first = true;
+        for (RS_Vector v: stroke) {
+            v -= base;
+            v.scale( scaleFactor);
+            v.rotate( angleVector);
+            v = view->toGui( v + insertionPoint);
+            if (first) {
+                path.moveTo( v.x, v.y);
+                first = false;
+            } else {
+                path.lineTo( v.x, v.y);
+            }
+        }
+    }
+    painter->drawPath( path);
+
+    return true;
+}
@@ -28,8 +28,12 @@
 #ifndef RS_FONTCHAR_H
 #define RS_FONTCHAR_H
 
+#include <vector>
 #include "rs_block.h"
 
+class RS_Painter;
+class RS_GraphicView;
+
 
 /**
  * A character in a font is represented by this special block class.
@@ -56,6 +60,10 @@ public:
         return RS2::EntityFontChar;
     }
 
+    bool drawGlyph(RS_Painter* painter, RS_GraphicView* view,
+                   const RS_Vector& insertionPoint,
+                   const RS_Vector& scaleFactor, double angle) const;
+
 
     /*friend std::ostream& operator << (std::ostream& os, const RS_FontChar& b) {
        	os << " name: " << b.getName().latin1() << "\n";
@@ -64,7 +72,14 @@ public:
 }*/
 
 
-protected:
+private:
+    bool buildGlyph() const;
+
+    //! outline of the letter as polylines, arcs are tessellated
+    mutable std::vector<std::vector<RS_Vector>> glyph;
+    //! glyph was built, or the letter has entities which can't be cached
+    mutable bool glyphBuilt {false};
+    mutable bool glyphValid {false};
 };
 
 
@@ -44,12 +44,31 @@ RS_FontList* RS_FontList::instance() {
 /**
  * Initializes the font list by creating empty RS_Font 
  * objects, one for each font that could be found.
+ *
+ * The font directories depend on settings and are read here, the files
+ * are listed in the background, which takes a while on network drives.
+ * The fonts are created on first access to the list.
  */
 void RS_FontList::init() {
     RS_DEBUG->print("RS_FontList::initFonts");
 
-    QStringList list = RS_SYSTEM->getNewFontList();
-    list.append(RS_SYSTEM->getFontList());
+    QStringList const dirList = RS_SYSTEM->getDirectoryList("fonts");
+    scan = std::async(std::launch::async, [dirList]() -> QStringList {
+        QStringList list = RS_System::listFiles(dirList, "lff");
+        list.append(RS_System::listFiles(dirList, "cxf"));
+        return list;
+    });
+}
+
+/**
+ * Creates the fonts listed by init(), waits for the list if needed.
+ */
+void RS_FontList::addScannedFonts() const {
+    if (!scan.valid()) {
+        return;
+    }
+
+    QStringList const list = scan.get();
     QHash<QString, int> added; //used to remember added fonts (avoid duplication)
 
     for (int i = 0; i < list.size(); ++i) {
@@ -58,6 +77,9 @@ void RS_FontList::init() {
         QFileInfo fi( list.at(i) );
         if ( !added.contains(fi.baseName()) ) {
 			fonts.emplace_back(new RS_Font(fi.baseName()));
+            // remember the path, so loading doesn't search for it again:
+            fonts.back()->filePath = list.at(i);
+            fontIndex.insert(fi.baseName(), fonts.back().get());
             added.insert(fi.baseName(), 1);
         }
 
@@ -66,16 +88,19 @@ void RS_FontList::init() {
 }
 
 size_t RS_FontList::countFonts() const{
+	addScannedFonts();
 	return fonts.size();
 }
 
 std::vector<std::unique_ptr<RS_Font> >::const_iterator RS_FontList::begin() const
 {
+	addScannedFonts();
 	return fonts.begin();
 }
 
 std::vector<std::unique_ptr<RS_Font> >::const_iterator RS_FontList::end() const
 {
+	addScannedFonts();
 	return fonts.end();
 }
 
@@ -83,6 +108,8 @@ std::vector<std::unique_ptr<RS_Font> >::const_iterator RS_FontList::end() const
  * Removes all fonts in the fontlist.
  */
 void RS_FontList::clearFonts() {
+	addScannedFonts();
+	fontIndex.clear();
 	fonts.clear();
 }
 
@@ -107,14 +134,11 @@ RS_Font* RS_FontList::requestFont(const QString& name) {
     RS_DEBUG->print("name2: %s", name2.toLatin1().data());
 
 	// Search our list of available fonts:
-	for( auto const& f: fonts){
-
-        if (f->getFileName()==name2) {
-            // Make sure this font is loaded into memory:
-            f->loadFont();
-			foundFont = f.get();
-            break;
-        }
+	addScannedFonts();
+	foundFont = fontIndex.value(name2, nullptr);
+	if (foundFont) {
+        // Make sure this font is loaded into memory:
+        foundFont->loadFont();
     }
 
 	if (!foundFont && name!="standard") {
@@ -130,6 +154,7 @@ RS_Font* RS_FontList::requestFont(const QString& name) {
 std::ostream& operator << (std::ostream& os, RS_FontList& l) {
 
     os << "Fontlist: \n";
+	l.addScannedFonts();
 	for(auto const& f: l.fonts){
         os << *f << "\n";
     }
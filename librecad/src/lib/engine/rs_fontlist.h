@@ -25,8 +25,12 @@
 **********************************************************************/
 #ifndef RS_FONTLIST_H
 #define RS_FONTLIST_H
+#include <future>
 #include <memory>
 #include <vector>
+#include <QHash>
+#include <QString>
+#include <QStringList>
 
 class RS_Font;
 
@@ -62,9 +66,14 @@ private:
 	RS_FontList()=default;
 	RS_FontList(RS_FontList const&)=delete;
 	RS_FontList& operator = (RS_FontList const&)=delete;
+	void addScannedFonts() const;
 	static RS_FontList* uniqueInstance;
-    //! fonts in the graphic
-	std::vector<std::unique_ptr<RS_Font>> fonts;
+	//! font files listed in the background, see init()
+	mutable std::future<QStringList> scan;
+    //! fonts in the graphic, filled on first access
+	mutable std::vector<std::unique_ptr<RS_Font>> fonts;
+	//! fonts by name
+	mutable QHash<QString, RS_Font*> fontIndex;
 };
 
 #endif
@@ -172,7 +172,7 @@ void RS_Graphic::removeLayer(RS_Layer* layer) {
  */
 void RS_Graphic::newDoc() {
 
-    RS_DEBUG->print("RS_Graphic::newDoc");
+    RS_DEBUG_PRINT_DEBUG("RS_Graphic::newDoc");
 
     clear();
 
@@ -252,7 +252,7 @@ bool RS_Graphic::BackupDrawingFile(const QString &filename)
                                  *	-------------------- */
                                 else
                                 {
-                    RS_DEBUG->print("%s", msg_err);
+                    RS_DEBUG_PRINT_DEBUG("%s", msg_err);
                                 }
                         }
 
@@ -261,7 +261,7 @@ bool RS_Graphic::BackupDrawingFile(const QString &filename)
                  *	----------------------- */
                 else
                 {
-            RS_DEBUG->print("%s", msg_err);
+            RS_DEBUG_PRINT_DEBUG("%s", msg_err);
                 }
 
                 delete qs_backup_fn;
@@ -294,7 +294,7 @@ bool RS_Graphic::save(bool isAutoSave)
 {
     bool ret	= false;
 
-    RS_DEBUG->print("RS_Graphic::save: Entering...");
+    RS_DEBUG_PRINT_DEBUG("RS_Graphic::save: Entering...");
 
     /*	- Save drawing file only if it has been modified.
          *	- Notes: Potentially dangerous in case of an internal
@@ -348,17 +348,17 @@ bool RS_Graphic::save(bool isAutoSave)
                  *	------------------------------------------------------- */
 		if (!actualName.isEmpty())
         {
-			RS_DEBUG->print("RS_Graphic::save: File: %s", actualName.toLatin1().data());
-            RS_DEBUG->print("RS_Graphic::save: Format: %d", (int) actualType);
-            RS_DEBUG->print("RS_Graphic::save: Export...");
+			RS_DEBUG_PRINT_DEBUG("RS_Graphic::save: File: %s", actualName.toLatin1().data());
+            RS_DEBUG_PRINT_DEBUG("RS_Graphic::save: Format: %d", (int) actualType);
+            RS_DEBUG_PRINT_DEBUG("RS_Graphic::save: Export...");
 
 			ret = RS_FileIO::instance()->fileExport(*this, actualName, actualType);
 			QFileInfo	finfo(actualName);
 			modifiedTime=finfo.lastModified();
 			currentFileName=actualName;
 		} else {
-            RS_DEBUG->print("RS_Graphic::save: Can't create object!");
-            RS_DEBUG->print("RS_Graphic::save: File not saved!");
+            RS_DEBUG_PRINT_DEBUG("RS_Graphic::save: Can't create object!");
+            RS_DEBUG_PRINT_DEBUG("RS_Graphic::save: File not saved!");
         }
 
         /*	Remove AutoSave file after user has successfully saved file.
@@ -380,20 +380,20 @@ bool RS_Graphic::save(bool isAutoSave)
 						 *	------------------------------------------------------------ */
 			if (qf_file.exists())
 			{
-				RS_DEBUG->print(	"RS_Graphic::save: Removing old autosave file %s",
+				RS_DEBUG_PRINT_DEBUG(	"RS_Graphic::save: Removing old autosave file %s",
 									autosaveFilename.toLatin1().data());
 				qf_file.remove();
 			}
 
         }
 
-        RS_DEBUG->print("RS_Graphic::save: Done!");
+        RS_DEBUG_PRINT_DEBUG("RS_Graphic::save: Done!");
 	} else {
-        RS_DEBUG->print("RS_Graphic::save: File not modified, not saved");
+        RS_DEBUG_PRINT_DEBUG("RS_Graphic::save: File not modified, not saved");
         ret = true;
     }
 
-    RS_DEBUG->print("RS_Graphic::save: Exiting...");
+    RS_DEBUG_PRINT_DEBUG("RS_Graphic::save: Exiting...");
 
     return ret;
 }
@@ -422,7 +422,7 @@ bool RS_Graphic::save(bool isAutoSave)
 
 bool RS_Graphic::saveAs(const QString &filename, RS2::FormatType type, bool force)
 {
-	RS_DEBUG->print("RS_Graphic::saveAs: Entering...");
+	RS_DEBUG_PRINT_DEBUG("RS_Graphic::saveAs: Entering...");
 
 	// Set to "failed" by default.
 	bool ret	= false;
@@ -457,7 +457,7 @@ bool RS_Graphic::saveAs(const QString &filename, RS2::FormatType type, bool forc
 		QFile	qf_file(autosaveFilenameSaved);
 
 		if (qf_file.exists()) {
-			RS_DEBUG->print("RS_Graphic::saveAs: Removing old autosave file %s",
+			RS_DEBUG_PRINT_DEBUG("RS_Graphic::saveAs: Removing old autosave file %s",
 							autosaveFilenameSaved.toLatin1().data());
 			qf_file.remove();
 		}
@@ -477,7 +477,7 @@ bool RS_Graphic::saveAs(const QString &filename, RS2::FormatType type, bool forc
  * Loads the given file into this graphic.
  */
 bool RS_Graphic::loadTemplate(const QString &filename, RS2::FormatType type) {
-    RS_DEBUG->print("RS_Graphic::loadTemplate(%s)", filename.toLatin1().data());
+    RS_DEBUG_PRINT_DEBUG("RS_Graphic::loadTemplate(%s)", filename.toLatin1().data());
 
     bool ret = false;
 
@@ -497,7 +497,7 @@ bool RS_Graphic::loadTemplate(const QString &filename, RS2::FormatType type) {
     QFileInfo finfo;
     modifiedTime = finfo.lastModified();
 
-    RS_DEBUG->print("RS_Graphic::loadTemplate(%s): OK", filename.toLatin1().data());
+    RS_DEBUG_PRINT_DEBUG("RS_Graphic::loadTemplate(%s): OK", filename.toLatin1().data());
 
     return ret;
 }
@@ -506,7 +506,7 @@ bool RS_Graphic::loadTemplate(const QString &filename, RS2::FormatType type) {
  * Loads the given file into this graphic.
  */
 bool RS_Graphic::open(const QString &filename, RS2::FormatType type) {
-    RS_DEBUG->print("RS_Graphic::open(%s)", filename.toLatin1().data());
+    RS_DEBUG_PRINT_DEBUG("RS_Graphic::open(%s)", filename.toLatin1().data());
 
         bool ret = false;
 
@@ -532,7 +532,7 @@ bool RS_Graphic::open(const QString &filename, RS2::FormatType type) {
         //cout << *((RS_Graphic*)graphic);
         //calculateBorders();
 
-        RS_DEBUG->print("RS_Graphic::open(%s): OK", filename.toLatin1().data());
+        RS_DEBUG_PRINT_DEBUG("RS_Graphic::open(%s): OK", filename.toLatin1().data());
     }
 
     return ret;
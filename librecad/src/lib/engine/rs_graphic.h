@@ -287,6 +287,9 @@ public:
         modified = m;
         layerList.setModified(m);
         blockList.setModified(m);
+        if (m) {
+            increaseRevision();
+        }
     }
     virtual QDateTime getModifyTime(void){
         return modifiedTime;
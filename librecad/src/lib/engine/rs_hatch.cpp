@@ -45,6 +45,7 @@
 #include "rs_patternlist.h"
 #include "rs_math.h"
 #include "rs_debug.h"
+#include "lc_trace.h"
 
 
 RS_HatchData::RS_HatchData(bool _solid,
@@ -102,14 +103,14 @@ bool RS_Hatch::validate() {
 
 
 RS_Entity* RS_Hatch::clone() const{
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::clone()");
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::clone()");
     RS_Hatch* t = new RS_Hatch(*this);
     t->setOwner(isOwner());
     t->initId();
     t->detach();
     t->update();
 //    t->hatch = nullptr;
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::clone(): OK");
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::clone(): OK");
     return t;
 }
 
@@ -133,13 +134,13 @@ bool RS_Hatch::isContainer() const {
  * Recalculates the borders of this hatch.
  */
 void RS_Hatch::calculateBorders() {
-    RS_DEBUG->print("RS_Hatch::calculateBorders");
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::calculateBorders");
 
     activateContour(true);
 
     RS_EntityContainer::calculateBorders();
 
-        RS_DEBUG->print("RS_Hatch::calculateBorders: size: %f,%f",
+        RS_DEBUG_PRINT_DEBUG("RS_Hatch::calculateBorders: size: %f,%f",
                 getSize().x, getSize().y);
 
     activateContour(false);
@@ -154,27 +155,28 @@ void RS_Hatch::calculateBorders() {
  * Refill hatch with pattern. Move, scale, rotate, trim, etc.
  */
 void RS_Hatch::update() {
+    LC_TRACE_SCOPE("update", "Hatch");
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update");
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::update");
 
     updateError = HATCH_OK;
     if (updateRunning) {
-        RS_DEBUG->print(RS_Debug::D_NOTICE, "RS_Hatch::update: skip hatch in updating process");
+        RS_DEBUG_PRINT(RS_Debug::D_NOTICE, "RS_Hatch::update: skip hatch in updating process");
         return;
     }
 
     if (updateEnabled==false) {
-        RS_DEBUG->print(RS_Debug::D_NOTICE, "RS_Hatch::update: skip hatch forbidden to update");
+        RS_DEBUG_PRINT(RS_Debug::D_NOTICE, "RS_Hatch::update: skip hatch forbidden to update");
         return;
     }
 
     if (data.solid==true) {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: processing solid hatch");
-        calculateBorders();
+        RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: processing solid hatch");
+        invalidateBorders();
         return;
     }
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: contour has %d loops", count());
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: contour has %d loops", count());
     updateRunning = true;
 
     // save attributes for the current hatch
@@ -188,52 +190,57 @@ void RS_Hatch::update() {
     }
 
     if (isUndone()) {
-        RS_DEBUG->print(RS_Debug::D_NOTICE, "RS_Hatch::update: skip undone hatch");
+        RS_DEBUG_PRINT(RS_Debug::D_NOTICE, "RS_Hatch::update: skip undone hatch");
         updateRunning = false;
         return;
     }
 
     if (!validate()) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Hatch::update: invalid contour in hatch found");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Hatch::update: invalid contour in hatch found");
         updateRunning = false;
         updateError = HATCH_INVALID_CONTOUR;
         return;
     }
 
     // search for pattern
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: requesting pattern");
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: requesting pattern");
     RS_Pattern* pat = RS_PATTERNLIST->requestPattern(data.pattern);
 	if (!pat) {
         updateRunning = false;
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Hatch::update: requesting pattern: not found");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Hatch::update: requesting pattern: not found");
         updateError = HATCH_PATTERN_NOT_FOUND;
         return;
     } else {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: requesting pattern: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: requesting pattern: OK");
         // make a working copy of hatch pattern
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: cloning pattern");
+        RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: cloning pattern");
         pat = (RS_Pattern*)pat->clone();
         if (pat) {
-            RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: cloning pattern: OK");
+            RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: cloning pattern: OK");
         } else {
-            RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Hatch::update: error while cloning hatch pattern");
+            RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Hatch::update: error while cloning hatch pattern");
             return;
         }
     }
 
     // scale pattern
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: scaling pattern");
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: scaling pattern");
     pat->scale(RS_Vector(0.0,0.0), RS_Vector(data.scale, data.scale));
     pat->calculateBorders();
-    forcedCalculateBorders();
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: scaling pattern: OK");
+    // loops may have been filled after they were added, the borders
+    // are recalculated with the contour on the next use below
+    invalidateBorders();
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: scaling pattern: OK");
 
     // find out how many pattern-instances we need in x/y:
     int px1, py1, px2, py2;
     double f;
     RS_Hatch* copy = (RS_Hatch*)this->clone();
     copy->rotate(RS_Vector(0.0,0.0), -data.angle);
-    copy->forcedCalculateBorders();
+    // rotate() only recalculates the borders if automatic updates are on
+    if (!autoUpdateBorders) {
+        copy->invalidateBorders();
+    }
 
     // create a pattern over the whole contour.
     RS_Vector pSize = pat->getSize();
@@ -241,8 +248,8 @@ void RS_Hatch::update() {
 //    RS_Vector cPos = getMin();
     RS_Vector cSize = getSize();
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: pattern size: %f/%f", pSize.x, pSize.y);
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: contour size: %f/%f", cSize.x, cSize.y);
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: pattern size: %f/%f", pSize.x, pSize.y);
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: contour size: %f/%f", cSize.x, cSize.y);
 
     // check pattern sizes for sanity
     if (cSize.x<1.0e-6 || cSize.y<1.0e-6 ||
@@ -252,13 +259,13 @@ void RS_Hatch::update() {
         delete pat;
         delete copy;
         updateRunning = false;
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Hatch::update: contour size or pattern size too small");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Hatch::update: contour size or pattern size too small");
         updateError = HATCH_TOO_SMALL;
         return;
     }
     // avoid huge memory consumption:
     else if ( cSize.x* cSize.y/(pSize.x*pSize.y)>1e4) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Hatch::update: contour size too large or pattern size too small");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Hatch::update: contour size too large or pattern size too small");
         delete pat;
         delete copy;
         updateError = HATCH_AREA_TOO_BIG;
@@ -282,7 +289,7 @@ void RS_Hatch::update() {
     RS_EntityContainer tmp;   // container for untrimmed lines
 
     // adding array of patterns to tmp:
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: creating pattern carpet");
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: creating pattern carpet");
     for (int px=px1; px<px2; px++) {
 		for (int py=py1; py<py2; py++) {
 			for(auto e: *pat){
@@ -298,20 +305,31 @@ void RS_Hatch::update() {
     pat = nullptr;
     delete copy;
     copy = nullptr;
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: creating pattern carpet: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: creating pattern carpet: OK");
 
     // cut pattern to contour shape
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: cutting pattern carpet");
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: cutting pattern carpet");
     RS_EntityContainer tmp2;   // container for small cut lines
 	RS_Line* line = nullptr;
 	RS_Arc* arc = nullptr;
 	RS_Circle* circle = nullptr;
 	RS_Ellipse* ellipse = nullptr;
 
+    // the contour entities, intersected in one batch with each pattern entity:
+    std::vector<RS_Entity*> contour;
+    for(auto loop: entities){
+        if (loop->isContainer()) {
+            for(auto p: * static_cast<RS_EntityContainer*>(loop)){
+                contour.push_back(p);
+            }
+        }
+    }
+    std::vector<RS_Information::IntersectionHit> hits;
+
     for(auto e: tmp) {
 
         if (!e) {
-            RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Hatch::update: nullptr entity found");
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_Hatch::update: nullptr entity found");
             continue;
         }
 
@@ -359,23 +377,12 @@ void RS_Hatch::update() {
         // getting all intersections of this pattern line with the contour:
 		QList<RS_Vector> is;
 
-		for(auto loop: entities){
-
-            if (loop->isContainer()) {
-				for(auto p: * static_cast<RS_EntityContainer*>(loop)){
-
-                    RS_VectorSolutions sol =
-                        RS_Information::getIntersection(e, p, true);
-
-                    for (const RS_Vector& vp: sol) {
-						if (vp.valid) {
-							is.append(vp);
-                            RS_DEBUG->print(RS_Debug::D_DEBUGGING, "  pattern line intersection: %f/%f", vp.x, vp.y);
-						}
-					}
-				}
-			}
-		}
+        hits.clear();
+        RS_Information::getIntersections(e, contour, hits, true);
+        for (const RS_Information::IntersectionHit& hit: hits) {
+            is.append(hit.point);
+            RS_DEBUG_PRINT_DEBUG("  pattern line intersection: %f/%f", hit.point.x, hit.point.y);
+        }
 
         QList<RS_Vector> is2;       //to be filled with sorted intersections
 		is2.append(startPoint);
@@ -469,7 +476,7 @@ void RS_Hatch::update() {
     } // end for very very long for(auto e: tmp) loop
 
     // updating hatch / adding entities that are inside
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: cutting pattern carpet: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: cutting pattern carpet: OK");
 
     //RS_EntityContainer* rubbish = new RS_EntityContainer(getGraphic());
 
@@ -516,17 +523,19 @@ void RS_Hatch::update() {
         }
     }
 
+    // the pattern lies within the contour, which defines the borders
+    if (!autoUpdateBorders) {
+        hatch->calculateBorders();
+    }
     addEntity(hatch);
     //getGraphic()->addEntity(rubbish);
 
-    forcedCalculateBorders();
-
     // deactivate contour:
     activateContour(false);
 
     updateRunning = false;
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_Hatch::update: OK");
 }
 
 
@@ -535,22 +544,22 @@ void RS_Hatch::update() {
  * Activates of deactivates the hatch boundary.
  */
 void RS_Hatch::activateContour(bool on) {
-        RS_DEBUG->print("RS_Hatch::activateContour: %d", (int)on);
+        RS_DEBUG_PRINT_DEBUG("RS_Hatch::activateContour: %d", (int)on);
 		for(auto e: entities){
         if (!e->isUndone()) {
             if (!e->getFlag(RS2::FlagTemp)) {
-                                RS_DEBUG->print("RS_Hatch::activateContour: set visible");
+                                RS_DEBUG_PRINT_DEBUG("RS_Hatch::activateContour: set visible");
                 e->setVisible(on);
             }
                         else {
-                                RS_DEBUG->print("RS_Hatch::activateContour: entity temp");
+                                RS_DEBUG_PRINT_DEBUG("RS_Hatch::activateContour: entity temp");
                         }
         }
                 else {
-                        RS_DEBUG->print("RS_Hatch::activateContour: entity undone");
+                        RS_DEBUG_PRINT_DEBUG("RS_Hatch::activateContour: entity undone");
                 }
     }
-        RS_DEBUG->print("RS_Hatch::activateContour: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_Hatch::activateContour: OK");
 }
 
 //#include<QDebug>
@@ -165,6 +165,11 @@ public:
         friend std::ostream& operator << (std::ostream& os, const RS_Hatch& p);
 
 protected:
+        //! the contour has to be activated, a shallow merge is not enough
+        void updateDirtyBorders() override {
+            calculateBorders();
+        }
+
         RS_HatchData data;
         RS_EntityContainer* hatch;
         bool updateRunning;
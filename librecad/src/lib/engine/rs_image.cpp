@@ -24,8 +24,12 @@
 **
 **********************************************************************/
 #include<iostream>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 #include <QImage>
 #include "rs_image.h"
+#include "lc_imagepyramid.h"
 #include "rs_line.h"
 #include "rs_settings.h"
 
@@ -75,32 +79,28 @@ RS_Image::RS_Image(RS_EntityContainer* parent,
 RS_Image::RS_Image(const RS_Image& _image):
 	RS_AtomicEntity(_image.getParent())
   ,data(_image.data)
-  ,img(_image.img.get()?new QImage(*_image.img):nullptr)
+  ,pyramid(_image.pyramid)
 {
 }
 
 RS_Image& RS_Image::operator = (const RS_Image& _image)
 {
 	data=_image.data;
-	if(_image.img.get()){
-		img.reset(new QImage(*_image.img));
-	}else{
-		img.reset();
-	}
+	pyramid=_image.pyramid;
 	return *this;
 }
 
 RS_Image::RS_Image(RS_Image&& _image):
 	RS_AtomicEntity(_image.getParent())
   ,data(std::move(_image.data))
-  ,img(std::move(_image.img))
+  ,pyramid(std::move(_image.pyramid))
 {
 }
 
 RS_Image& RS_Image::operator = (RS_Image&& _image)
 {
 	data=_image.data;
-	img = std::move(_image.img);
+	pyramid = std::move(_image.pyramid);
 	return *this;
 }
 
@@ -125,50 +125,15 @@ void RS_Image::updateData(RS_Vector size, RS_Vector Uv, RS_Vector Vv) {
 
 void RS_Image::update() {
 
-    RS_DEBUG->print("RS_Image::update");
+    RS_DEBUG_PRINT_DEBUG("RS_Image::update");
 
-    // the whole image:
-    //QImage image = QImage(data.file);
-	img.reset(new QImage(data.file));
-	if (!img->isNull()) {
-		data.size = RS_Vector(img->width(), img->height());
+    // the pixels are only loaded when they are drawn
+    pyramid = LC_ImagePyramid::get(data.file);
+    if (!pyramid->isNull()) {
+        data.size = RS_Vector(pyramid->size().width(), pyramid->size().height());
     }
 
-    RS_DEBUG->print("RS_Image::update: OK");
-
-    /*
-    // number of small images:
-    nx = image.width()/100;
-    ny = image.height()/100;
-
-    // create small images:
-    img = new QImage*[nx];
-    QPixmap pm;
-    int w,h;
-    for (int x = 0; x<nx; ++x) {
-        img[x] = new QImage[ny];
-        for (int y = 0; y<ny; ++y) {
-                if (x<nx-1) {
-                        w = 100;
-                }
-                else {
-                        w = image.width()%100;
-                }
-
-                if (y<ny-1) {
-                        h = 100;
-                }
-                else {
-                        h = image.height()%100;
-                }
-
-                pm = QPixmap(w, h);
-                RS_PainterQt painter(&pm);
-                painter.drawImage(-x*100, -y*100, image);
-                img[x][y] = pm.convertToImage();
-        }
-    }
-    */
+    RS_DEBUG_PRINT_DEBUG("RS_Image::update: OK");
 }
 
 
@@ -378,23 +343,83 @@ void RS_Image::mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2)
 
 
 
+/**
+ * Draws the tiles of the pyramid level matching the zoom which are inside
+ * the view. Until all of them are loaded, the coarsest level is drawn
+ * below as a placeholder.
+ */
 void RS_Image::draw(RS_Painter* painter, RS_GraphicView* view, double& /*patternOffset*/) {
-	if (!(painter && view) || !img.get() || img->isNull())
+	if (!(painter && view) || !pyramid || pyramid->isNull())
 		return;
 
-    // erase image:
-    //if (painter->getPen().getColor()==view->getBackground()) {
-    //	RS_VectorSolutions sol = getCorners();
-    //
-    //}
+	RS_Vector const& u = data.uVector;
+	RS_Vector const& v = data.vVector;
+	double const det = u.x * v.y - u.y * v.x;
+	if (std::abs(det) < RS_TOLERANCE2)
+		return;
 
-	RS_Vector scale{view->toGuiDX(data.uVector.magnitude()),
-								view->toGuiDY(data.vVector.magnitude())};
-    double angle = data.uVector.angle();
+	// view corners in full resolution pixels, rows counted from the top
+	double const width = pyramid->size().width();
+	double const height = pyramid->size().height();
+	double minX = RS_MAXDOUBLE, minY = RS_MAXDOUBLE;
+	double maxX = RS_MINDOUBLE, maxY = RS_MINDOUBLE;
+	for (RS_Vector const& corner: {view->toGraph(0, 0),
+		 view->toGraph(view->getWidth(), 0),
+		 view->toGraph(0, view->getHeight()),
+		 view->toGraph(view->getWidth(), view->getHeight())}) {
+		RS_Vector const d = corner - data.insertionPoint;
+		double const x = (d.x * v.y - d.y * v.x) / det;
+		double const y = height - (u.x * d.y - u.y * d.x) / det;
+		minX = std::min(minX, x);
+		maxX = std::max(maxX, x);
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+	}
+	minX = std::max(minX, 0.);
+	minY = std::max(minY, 0.);
+	maxX = std::min(maxX, width);
+	maxY = std::min(maxY, height);
+
+	if (minX < maxX && minY < maxY) {
+		double const screenPixels = std::min(std::abs(view->toGuiDX(u.magnitude())),
+											 std::abs(view->toGuiDY(v.magnitude())));
+		int const level = pyramid->levelFor(screenPixels);
+		QSize const levelSize = pyramid->levelSize(level);
+		double const fx = levelSize.width() / width;
+		double const fy = levelSize.height() / height;
+		int const tileSize = LC_ImagePyramid::TileSize;
+		int const col1 = static_cast<int>(minX * fx) / tileSize;
+		int const row1 = static_cast<int>(minY * fy) / tileSize;
+		int const col2 = std::min(static_cast<int>(maxX * fx) / tileSize,
+								  pyramid->tileColumns(level) - 1);
+		int const row2 = std::min(static_cast<int>(maxY * fy) / tileSize,
+								  pyramid->tileRows(level) - 1);
+
+		std::vector<std::pair<QRect, QImage>> tiles;
+		bool complete = true;
+		for (int row = row1; row <= row2; ++row) {
+			for (int col = col1; col <= col2; ++col) {
+				QImage tile = pyramid->tile(level, col, row, view);
+				if (tile.isNull()) {
+					complete = false;
+				} else {
+					tiles.emplace_back(pyramid->tileRect(level, col, row), tile);
+				}
+			}
+		}
 
-	painter->drawImg(*img,
-                     view->toGui(data.insertionPoint),
-                     angle, scale);
+		if (!complete) {
+			int const last = pyramid->levelCount() - 1;
+			QImage overview = pyramid->overview(view);
+			if (!overview.isNull()) {
+				drawTile(painter, view, overview, last,
+						 QRect(QPoint(0, 0), pyramid->levelSize(last)));
+			}
+		}
+		for (auto& tile: tiles) {
+			drawTile(painter, view, tile.second, level, tile.first);
+		}
+	}
 
     if (isSelected()) {
         RS_VectorSolutions sol = getCorners();
@@ -407,6 +432,30 @@ void RS_Image::draw(RS_Painter* painter, RS_GraphicView* view, double& /*pattern
 
 
 
+/**
+ * Draws an image which covers rect of the given pyramid level. Images of
+ * another size than rect, like the uncached whole image, are fit into it.
+ */
+void RS_Image::drawTile(RS_Painter* painter, RS_GraphicView* view,
+						QImage& image, int level, const QRect& rect) const {
+	QSize const levelSize = pyramid->levelSize(level);
+	// full resolution pixels per pixel of the level
+	double const fx = pyramid->size().width() / double(levelSize.width());
+	double const fy = pyramid->size().height() / double(levelSize.height());
+	double const sx = fx * rect.width() / image.width();
+	double const sy = fy * rect.height() / image.height();
+
+	RS_Vector const bottomLeft = data.insertionPoint
+			+ data.uVector * (rect.left() * fx)
+			+ data.vVector * (pyramid->size().height() - (rect.top() + rect.height()) * fy);
+	RS_Vector const scale{view->toGuiDX(data.uVector.magnitude() * sx),
+						  view->toGuiDY(data.vVector.magnitude() * sy)};
+
+	painter->drawImg(image, view->toGui(bottomLeft), data.uVector.angle(), scale);
+}
+
+
+
 /**
  * Dumps the point's data to stdout.
  */
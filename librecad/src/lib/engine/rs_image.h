@@ -29,7 +29,9 @@
 #include <memory>
 #include "rs_atomicentity.h"
 
+class LC_ImagePyramid;
 class QImage;
+class QRect;
 
 /**
  * Holds the data that defines a line.
@@ -219,11 +221,11 @@ public:
 protected:
 	// whether the point is within image
 	bool containsPoint(const RS_Vector& coord) const;
+	void drawTile(RS_Painter* painter, RS_GraphicView* view,
+				  QImage& image, int level, const QRect& rect) const;
 	RS_ImageData data;
-	std::unique_ptr<QImage> img;
-        //QImage** img;
-        //int nx;
-        //int ny;
+	/** Tiles in the resolutions needed to draw, shared by all images of the file. */
+	std::shared_ptr<LC_ImagePyramid> pyramid;
 };
 
 #endif
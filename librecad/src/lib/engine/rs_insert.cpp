@@ -32,10 +32,13 @@
 #include "rs_circle.h"
 #include "rs_ellipse.h"
 #include "rs_block.h"
+#include "rs_fontchar.h"
+#include "rs_painter.h"
 #include "rs_graphic.h"
 #include "rs_layer.h"
 #include "rs_math.h"
 #include "rs_debug.h"
+#include "lc_trace.h"
 
 RS_InsertData::RS_InsertData(const QString& _name,
 							 RS_Vector _insertionPoint,
@@ -91,9 +94,10 @@ RS_Entity* RS_Insert::clone() const{
  * needs to be called whenever the block this insert is based on changes.
  */
 void RS_Insert::update() {
+        LC_TRACE_SCOPE("update", "Insert");
 
-        RS_DEBUG->print("RS_Insert::update");
-        RS_DEBUG->print("RS_Insert::update: name: %s", data.name.toLatin1().data());
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::update");
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::update: name: %s", data.name.toLatin1().data());
 //        RS_DEBUG->print("RS_Insert::update: insertionPoint: %f/%f",
 //                data.insertionPoint.x, data.insertionPoint.y);
 
@@ -106,17 +110,17 @@ void RS_Insert::update() {
     RS_Block* blk = getBlockForInsert();
 	if (!blk) {
 		//return nullptr;
-				RS_DEBUG->print("RS_Insert::update: Block is nullptr");
+				RS_DEBUG_PRINT_DEBUG("RS_Insert::update: Block is nullptr");
         return;
     }
 
     if (isUndone()) {
-                RS_DEBUG->print("RS_Insert::update: Insert is in undo list");
+                RS_DEBUG_PRINT_DEBUG("RS_Insert::update: Insert is in undo list");
         return;
     }
 
         if (fabs(data.scaleFactor.x)<1.0e-6 || fabs(data.scaleFactor.y)<1.0e-6) {
-                RS_DEBUG->print("RS_Insert::update: scale factor is 0");
+                RS_DEBUG_PRINT_DEBUG("RS_Insert::update: scale factor is 0");
                 return;
         }
 
@@ -127,10 +131,12 @@ void RS_Insert::update() {
 	while ( (e = it.current())  ) {
         ++it;*/
 
-        RS_DEBUG->print("RS_Insert::update: cols: %d, rows: %d",
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::update: cols: %d, rows: %d",
                 data.cols, data.rows);
-        RS_DEBUG->print("RS_Insert::update: block has %d entities",
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::update: block has %d entities",
                 blk->count());
+    // the copies are transformed, regenerate pending dimensions first:
+    blk->validateDimensions();
 //int i_en_counts=0;
 		for(auto e: *blk){
         for (int c=0; c<data.cols; ++c) {
@@ -241,9 +247,10 @@ void RS_Insert::update() {
             }
         }
     }
-    calculateBorders();
+    // the new entities have valid borders already, no need to recurse:
+    mergeChildBorders();
 
-        RS_DEBUG->print("RS_Insert::update: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::update: OK");
 }
 
 
@@ -309,6 +316,16 @@ bool RS_Insert::isVisible() const
 }
 
 
+bool RS_Insert::isLetter() const
+{
+    if (!data.blockSource || isEmpty()) {
+        return false;
+    }
+    RS_Block* blk = getBlockForInsert();
+    return blk && RS2::EntityFontChar == blk->rtti();
+}
+
+
 RS_VectorSolutions RS_Insert::getRefPoints() const
 {
 	return RS_VectorSolutions{data.insertionPoint};
@@ -325,52 +342,71 @@ RS_Vector RS_Insert::getNearestRef(const RS_Vector& coord,
 
 
 void RS_Insert::move(const RS_Vector& offset) {
-        RS_DEBUG->print("RS_Insert::move: offset: %f/%f",
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::move: offset: %f/%f",
                 offset.x, offset.y);
-        RS_DEBUG->print("RS_Insert::move1: insertionPoint: %f/%f",
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::move1: insertionPoint: %f/%f",
                 data.insertionPoint.x, data.insertionPoint.y);
     data.insertionPoint.move(offset);
-        RS_DEBUG->print("RS_Insert::move2: insertionPoint: %f/%f",
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::move2: insertionPoint: %f/%f",
                 data.insertionPoint.x, data.insertionPoint.y);
-    update();
+    if (isLetter()) {
+        // same result as regenerating the entities from the letter:
+        RS_EntityContainer::move(offset);
+    } else {
+        update();
+    }
 }
 
 
 
 void RS_Insert::rotate(const RS_Vector& center, const double& angle) {
-        RS_DEBUG->print("RS_Insert::rotate1: insertionPoint: %f/%f "
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::rotate1: insertionPoint: %f/%f "
             "/ center: %f/%f",
                 data.insertionPoint.x, data.insertionPoint.y,
                 center.x, center.y);
     data.insertionPoint.rotate(center, angle);
     data.angle = RS_Math::correctAngle(data.angle+angle);
-        RS_DEBUG->print("RS_Insert::rotate2: insertionPoint: %f/%f",
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::rotate2: insertionPoint: %f/%f",
                 data.insertionPoint.x, data.insertionPoint.y);
-    update();
+    if (isLetter()) {
+        RS_EntityContainer::rotate(center, angle);
+    } else {
+        update();
+    }
 }
 void RS_Insert::rotate(const RS_Vector& center, const RS_Vector& angleVector) {
-        RS_DEBUG->print("RS_Insert::rotate1: insertionPoint: %f/%f "
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::rotate1: insertionPoint: %f/%f "
             "/ center: %f/%f",
                 data.insertionPoint.x, data.insertionPoint.y,
                 center.x, center.y);
     data.insertionPoint.rotate(center, angleVector);
     data.angle = RS_Math::correctAngle(data.angle+angleVector.angle());
-        RS_DEBUG->print("RS_Insert::rotate2: insertionPoint: %f/%f",
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::rotate2: insertionPoint: %f/%f",
                 data.insertionPoint.x, data.insertionPoint.y);
-    update();
+    if (isLetter()) {
+        RS_EntityContainer::rotate(center, angleVector);
+    } else {
+        update();
+    }
 }
 
 
 
 void RS_Insert::scale(const RS_Vector& center, const RS_Vector& factor) {
-        RS_DEBUG->print("RS_Insert::scale1: insertionPoint: %f/%f",
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::scale1: insertionPoint: %f/%f",
                 data.insertionPoint.x, data.insertionPoint.y);
     data.insertionPoint.scale(center, factor);
     data.scaleFactor.scale(RS_Vector(0.0, 0.0), factor);
     data.spacing.scale(RS_Vector(0.0, 0.0), factor);
-        RS_DEBUG->print("RS_Insert::scale2: insertionPoint: %f/%f",
+        RS_DEBUG_PRINT_DEBUG("RS_Insert::scale2: insertionPoint: %f/%f",
                 data.insertionPoint.x, data.insertionPoint.y);
-    update();
+    // only uniform scaling commutes with the rotation of the insert:
+    if (isLetter() && factor.x > RS_TOLERANCE
+            && fabs(factor.x - factor.y) <= RS_TOLERANCE) {
+        RS_EntityContainer::scale(center, factor);
+    } else {
+        update();
+    }
 }
 
 
@@ -388,6 +424,32 @@ void RS_Insert::mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2)
 }
 
 
+/**
+ * Letters of texts are drawn from the glyph cache of their font, the
+ * generated entities are only used as a fallback.
+ */
+void RS_Insert::draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset) {
+    if (!(painter && view)) {
+        return;
+    }
+
+    RS_Block* blk = getBlockForInsert();
+    if (blk && RS2::EntityFontChar == blk->rtti() && !isEmpty()
+            && 1 == data.cols && 1 == data.rows
+            && RS2::SolidLine == painter->getPen().getLineType()) {
+        if (isSelected() != painter->shouldDrawSelected()) {
+            return;
+        }
+        if (static_cast<RS_FontChar*>(blk)->drawGlyph(painter, view,
+                data.insertionPoint, data.scaleFactor, data.angle)) {
+            return;
+        }
+    }
+
+    RS_EntityContainer::draw(painter, view, patternOffset);
+}
+
+
 std::ostream& operator << (std::ostream& os, const RS_Insert& i) {
     os << " Insert: " << i.getData() << std::endl;
     return os;
@@ -108,17 +108,29 @@ public:
     }
 
         /**
-         * Reimplementation of reparent. Invalidates block cache pointer.
+         * Reimplementation of reparent. Invalidates block cache pointer
+         * unless the block comes from an explicit block source.
          */
     virtual void reparent(RS_EntityContainer* parent) {
                 RS_Entity::reparent(parent);
-                block = NULL;
+                if (!data.blockSource) {
+                        block = NULL;
+                }
     }
 
 	RS_Block* getBlockForInsert() const;
+    /**
+     * Looks the block up in source from now on, e.g. in copied blocks.
+     */
+    void setBlockSource(RS_BlockList* source) {
+        data.blockSource = source;
+        block = nullptr;
+    }
 
     virtual void update();
 
+    void draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset) override;
+
     QString getName() const {
         return data.name;
     }
@@ -189,6 +201,12 @@ public:
     friend std::ostream& operator << (std::ostream& os, const RS_Insert& i);
 
 protected:
+    /**
+     * @return true for the letters of texts, which are transformed in
+     * place instead of being regenerated from their font.
+     */
+    bool isLetter() const;
+
     RS_InsertData data;
 	mutable RS_Block* block;
 };
@@ -78,19 +78,19 @@ QList<RS_Layer*>::const_iterator RS_LayerList::end()const
  * @param notify Notify listeners.
  */
 void RS_LayerList::activate(const QString& name, bool notify) {
-    RS_DEBUG->print("RS_LayerList::activate: %s, notify: %d begin",
+    RS_DEBUG_PRINT_DEBUG("RS_LayerList::activate: %s, notify: %d begin",
                                     name.toLatin1().data(), notify);
 
     activate(find(name), notify);
     /*
     if (activeLayer==NULL) {
-        RS_DEBUG->print("activeLayer is NULL");
+        RS_DEBUG_PRINT_DEBUG("activeLayer is NULL");
 } else {
-        RS_DEBUG->print("activeLayer is %s", activeLayer->getName().latin1());
+        RS_DEBUG_PRINT_DEBUG("activeLayer is %s", activeLayer->getName().latin1());
 }
     */
 
-    RS_DEBUG->print("RS_LayerList::activate: %s end", name.toLatin1().data());
+    RS_DEBUG_PRINT_DEBUG("RS_LayerList::activate: %s end", name.toLatin1().data());
 }
 
 
@@ -101,13 +101,13 @@ void RS_LayerList::activate(const QString& name, bool notify) {
  * @param notify Notify listeners.
  */
 void RS_LayerList::activate(RS_Layer* layer, bool notify) {
-    RS_DEBUG->print("RS_LayerList::activate notify: %d begin", notify);
+    RS_DEBUG_PRINT_DEBUG("RS_LayerList::activate notify: %d begin", notify);
 
     /*if (layer) {
-        RS_DEBUG->print("RS_LayerList::activate: %s",
+        RS_DEBUG_PRINT_DEBUG("RS_LayerList::activate: %s",
                         layer->getName().latin1());
 } else {
-        RS_DEBUG->print("RS_LayerList::activate: NULL");
+        RS_DEBUG_PRINT_DEBUG("RS_LayerList::activate: NULL");
 }*/
 
     activeLayer = layer;
@@ -117,11 +117,11 @@ void RS_LayerList::activate(RS_Layer* layer, bool notify) {
            RS_LayerListListener* l = layerListListeners.at(i);
 
            l->layerActivated(activeLayer);
-		   RS_DEBUG->print("RS_LayerList::activate listener notified");
+		   RS_DEBUG_PRINT_DEBUG("RS_LayerList::activate listener notified");
        }
     }
 
-    RS_DEBUG->print("RS_LayerList::activate end");
+    RS_DEBUG_PRINT_DEBUG("RS_LayerList::activate end");
 }
 
 
@@ -144,7 +144,7 @@ void RS_LayerList::sort()
  * Listeners are notified.
  */
 void RS_LayerList::add(RS_Layer* layer) {
-    RS_DEBUG->print("RS_LayerList::addLayer()");
+    RS_DEBUG_PRINT_DEBUG("RS_LayerList::addLayer()");
 
     if (layer==NULL) {
         return;
@@ -193,7 +193,7 @@ void RS_LayerList::add(RS_Layer* layer) {
  * the list but before it gets deleted.
  */
 void RS_LayerList::remove(RS_Layer* layer) {
-    RS_DEBUG->print("RS_LayerList::removeLayer()");
+    RS_DEBUG_PRINT_DEBUG("RS_LayerList::removeLayer()");
     if (layer==NULL) {
         return;
     }
@@ -317,7 +317,7 @@ void RS_LayerList::toggle(const QString& name) {
 void RS_LayerList::toggle(RS_Layer* layer) {
 
     if (!layer) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_LayerList::toggle: nullptr layer");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_LayerList::toggle: nullptr layer");
         return;
     }
 
@@ -329,7 +329,7 @@ void RS_LayerList::toggle(RS_Layer* layer) {
     for (auto *i : layerListListeners) {
 
         if (!i) {
-            RS_DEBUG->print(RS_Debug::D_WARNING, "RS_LayerList::toggle: nullptr layer listener");
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_LayerList::toggle: nullptr layer listener");
             continue;
         }
 
@@ -487,6 +487,9 @@ std::ostream& operator << (std::ostream& os, RS_LayerList& l) {
  */
 void RS_LayerList::setModified(bool m) {
     modified = m;
+    if (m) {
+        ++revision;
+    }
 
     // Notify listeners
     for (auto l: layerListListeners) {
@@ -119,6 +119,14 @@ public:
     virtual bool isModified() const {
         return modified;
     }
+
+    /**
+     * @return Number of modifications of the layers, e.g. of their
+     * visibility or lock. Caches depending on the layers compare it.
+     */
+    unsigned long getRevision() const {
+        return revision;
+    }
     /**
      * @brief sort by layer names
      */
@@ -136,6 +144,8 @@ private:
     RS_Layer* activeLayer;
     /** Flag set if the layer list was modified and not yet saved. */
     bool modified;
+    //! counts modifications, see getRevision()
+    unsigned long revision = 0;
 };
 
 #endif
@@ -143,7 +143,7 @@ RS_Entity* RS_Leader::addVertex(const RS_Vector& v) {
  * To add entities use addVertex() instead.
  */
 void RS_Leader::addEntity(RS_Entity* entity) {
-    RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Leader::addEntity:"
+    RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_Leader::addEntity:"
                     " should never be called");
 
 	if (!entity) return;
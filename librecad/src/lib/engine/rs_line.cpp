@@ -569,51 +569,19 @@ void RS_Line::draw(RS_Painter* painter, RS_GraphicView* view, double& patternOff
         return;
     }
 
-    auto viewportRect = view->getViewRect();
-    RS_VectorSolutions endPoints(0);
-    endPoints.push_back(getStartpoint());
-    endPoints.push_back(getEndpoint());
-
-    RS_EntityContainer ec(nullptr);
-    ec.addRectangle(viewportRect.minP(), viewportRect.maxP());
-
-//    if (viewportRect.inArea(getStartpoint(), RS_TOLERANCE))
-//         endPoints.push_back(getStartpoint());
-//    if (viewportRect.inArea(getEndpoint(), RS_TOLERANCE))
-//         endPoints.push_back(getEndpoint());
-
-//    if (endPoints.size() < 2){
-//        RS_VectorSolutions vpIts;
-//        for(auto p: ec) {
-//            auto const sol=RS_Information::getIntersection(this, p, true);
-//            for (auto const& vp: sol) {
-//                if (vpIts.getClosestDistance(vp) <= RS_TOLERANCE * 10.)
-//                    continue;
-//                vpIts.push_back(vp);
-//            }
-//        }
-//        for (auto const& vp: vpIts) {
-//            if (endPoints.getClosestDistance(vp) <= RS_TOLERANCE * 10.)
-//                continue;
-//            endPoints.push_back(vp);
-//        }
-//    }
-
-//    if (endPoints.size()<2) return;
-
-    if ((endPoints[0] - getStartpoint()).squared() >
-            (endPoints[1] - getStartpoint()).squared() )
-    {
-        std::swap(endPoints[0],endPoints[1]);
-    }
-
-	RS_Vector pStart{view->toGui(endPoints.at(0))};
-	RS_Vector pEnd{view->toGui(endPoints.at(1))};
+	RS_Vector pStart{view->toGui(getStartpoint())};
+	RS_Vector pEnd{view->toGui(getEndpoint())};
     //    std::cout<<"draw line: "<<pStart<<" to "<<pEnd<<std::endl;
 	RS_Vector direction = pEnd-pStart;
 
 	if (isConstruction(true) && direction.squared() > RS_TOLERANCE){
         //extend line on a construction layer to fill the whole view
+        // the viewport border is only needed here, don't build it for
+        // every line drawn
+        auto viewportRect = view->getViewRect();
+        RS_EntityContainer ec(nullptr);
+        ec.addRectangle(viewportRect.minP(), viewportRect.maxP());
+
 		RS_VectorSolutions vpIts;
 		for(auto p: ec) {
             auto const sol=RS_Information::getIntersection(this, p, true);
@@ -669,7 +637,7 @@ void RS_Line::draw(RS_Painter* painter, RS_GraphicView* view, double& patternOff
     }
 	if (!pat) {
 //        patternOffset -= length;
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "RS_Line::draw: Invalid line pattern");
         painter->drawLine(pStart,pEnd);
         return;
@@ -687,7 +655,7 @@ void RS_Line::draw(RS_Painter* painter, RS_GraphicView* view, double& patternOff
     painter->setPen(pen);
 
 	if (pat->num <= 0) {
-		RS_DEBUG->print(RS_Debug::D_WARNING,"invalid line pattern for line, draw solid line instead");
+		RS_DEBUG_PRINT(RS_Debug::D_WARNING,"invalid line pattern for line, draw solid line instead");
 		painter->drawLine(view->toGui(getStartpoint()),
 						  view->toGui(getEndpoint()));
 		return;
@@ -226,7 +226,7 @@ int RS_MText::getNumberOfLines() {
  */
 void RS_MText::update()
 {
-    RS_DEBUG->print("RS_MText::update");
+    RS_DEBUG_PRINT_DEBUG("RS_MText::update");
 
     clear();
     if (isUndone()) {
@@ -418,12 +418,12 @@ void RS_MText::update()
             // One Letter:
             QString letterText {QString(data.text.at(i))};
             if (nullptr == font->findLetter( letterText)) {
-                RS_DEBUG->print("RS_MText::update: missing font for letter( %s ), replaced it with QChar(0xfffd)",
+                RS_DEBUG_PRINT_DEBUG("RS_MText::update: missing font for letter( %s ), replaced it with QChar(0xfffd)",
                                 qPrintable( letterText));
                 letterText = QChar( 0xfffd);
             }
 
-            RS_DEBUG->print("RS_MText::update: insert a letter at pos: %f/%f", letterPos.x, letterPos.y);
+            RS_DEBUG_PRINT_DEBUG("RS_MText::update: insert a letter at pos: %f/%f", letterPos.x, letterPos.y);
 
             RS_InsertData d( letterText,
                              letterPos,
@@ -440,7 +440,6 @@ void RS_MText::update()
             letter->setPen( RS_Pen( RS2::FlagInvalid));
             letter->setLayer( nullptr);
             letter->update();
-            letter->forcedCalculateBorders();
 
             letterWidth = RS_Vector( letter->getMax().x - letterPos.x, 0.0);
             if (0 > letterWidth.x) {
@@ -467,7 +466,7 @@ void RS_MText::update()
     usedTextHeight -= data.height * data.lineSpacingFactor * 5.0 / 3.0 - data.height;
     forcedCalculateBorders();
 
-    RS_DEBUG->print("RS_MText::update: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_MText::update: OK");
 }
 
 
@@ -484,7 +483,7 @@ void RS_MText::update()
 double RS_MText::updateAddLine(RS_EntityContainer* textLine, int lineCounter) {
     double ls =5.0/3.0;
 
-    RS_DEBUG->print("RS_MText::updateAddLine: width: %f", textLine->getSize().x);
+    RS_DEBUG_PRINT_DEBUG("RS_MText::updateAddLine: width: %f", textLine->getSize().x);
 
         //textLine->forcedCalculateBorders();
     //RS_DEBUG->print("RS_MText::updateAddLine: width 2: %f", textLine->getSize().x);
@@ -499,12 +498,12 @@ double RS_MText::updateAddLine(RS_EntityContainer* textLine, int lineCounter) {
     }
     RS_Vector textSize = textLine->getSize();
 
-        RS_DEBUG->print("RS_MText::updateAddLine: width 2: %f", textSize.x);
+        RS_DEBUG_PRINT_DEBUG("RS_MText::updateAddLine: width 2: %f", textSize.x);
 
     // Horizontal Align:
     switch (data.halign) {
     case RS_MTextData::HACenter:
-                RS_DEBUG->print("RS_MText::updateAddLine: move by: %f", -textSize.x/2.0);
+                RS_DEBUG_PRINT_DEBUG("RS_MText::updateAddLine: move by: %f", -textSize.x/2.0);
         textLine->move(RS_Vector(-textSize.x/2.0, 0.0));
         break;
 
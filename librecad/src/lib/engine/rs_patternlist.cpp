@@ -43,11 +43,29 @@ RS_PatternList::~RS_PatternList() = default;
 /**
  * Initializes the pattern list by creating empty RS_Pattern 
  * objects, one for each pattern that could be found.
+ *
+ * Like RS_FontList::init(), the files are listed in the background
+ * and the patterns are added on first access.
  */
 void RS_PatternList::init() {
     RS_DEBUG->print("RS_PatternList::initPatterns");
 
-	QStringList list = RS_SYSTEM->getPatternList();
+	QStringList const dirList = RS_SYSTEM->getDirectoryList("patterns");
+	scan = std::async(std::launch::async, [dirList]() {
+		return RS_System::listFiles(dirList, "dxf");
+	});
+}
+
+
+/**
+ * Adds the patterns listed by init(), waits for the list if needed.
+ */
+void RS_PatternList::addScannedPatterns() const {
+	if (!scan.valid()) {
+		return;
+	}
+
+	QStringList const list = scan.get();
 
 	patterns.clear();
 
@@ -74,6 +92,7 @@ RS_Pattern* RS_PatternList::requestPattern(const QString& name) {
     QString name2 = name.toLower();
 
 	RS_DEBUG->print("name2: %s", name2.toLatin1().data());
+	addScannedPatterns();
 	if (patterns.count(name2)) {
 		if (!patterns[name2]) {
 			RS_Pattern* p = new RS_Pattern(name2);
@@ -92,6 +111,7 @@ RS_Pattern* RS_PatternList::requestPattern(const QString& name) {
 	
 bool RS_PatternList::contains(const QString& name) const {
 
+	addScannedPatterns();
 	return patterns.count(name.toLower());
 
 }
@@ -103,6 +123,7 @@ bool RS_PatternList::contains(const QString& name) const {
 std::ostream& operator << (std::ostream& os, RS_PatternList& l) {
 
     os << "Patternlist: \n";
+	l.addScannedPatterns();
 	for (auto const& pa: l.patterns)
 		if (pa.second)
 			os<< *pa.second << '\n';
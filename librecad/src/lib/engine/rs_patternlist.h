@@ -28,11 +28,12 @@
 #ifndef RS_PATTERNLIST_H
 #define RS_PATTERNLIST_H
 
+#include<future>
 #include<map>
 #include<memory>
+#include<QStringList>
 
 class RS_Pattern;
-class QString;
 
 #define RS_PATTERNLIST RS_PatternList::instance()
 
@@ -61,20 +62,25 @@ public:
 	void init();
 
 	int countPatterns() const {
+		addScannedPatterns();
 		return patterns.size();
     }
 
 	//! \{ range based loop support
 	PTN_MAP::iterator begin() {
+		addScannedPatterns();
 		return patterns.begin();
 	}
 	PTN_MAP::const_iterator begin() const{
+		addScannedPatterns();
 		return patterns.begin();
 	}
 	PTN_MAP::iterator end() {
+		addScannedPatterns();
 		return patterns.end();
 	}
 	PTN_MAP::const_iterator end() const{
+		addScannedPatterns();
 		return patterns.end();
 	}
 	//! \}
@@ -87,8 +93,12 @@ public:
 
 
 private:
-    //! patterns in the graphic
-	PTN_MAP patterns;
+	void addScannedPatterns() const;
+
+	//! pattern files listed in the background, see init()
+	mutable std::future<QStringList> scan;
+    //! patterns in the graphic, filled on first access
+	mutable PTN_MAP patterns;
 };
 
 #endif
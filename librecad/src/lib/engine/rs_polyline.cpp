@@ -106,7 +106,7 @@ void RS_Polyline::removeLastVertex() {
 								data.endpoint = l->getEndpoint();
                         }
                         else {
-                                RS_DEBUG->print(RS_Debug::D_WARNING,
+                                RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                                         "RS_Polyline::removeLastVertex: "
                                         "polyline contains non-atomic entity");
                         }
@@ -214,7 +214,7 @@ RS_Entity* RS_Polyline::createVertex(const RS_Vector& v, double bulge, bool prep
 
 	RS_Entity* entity=nullptr;
 
-    RS_DEBUG->print("RS_Polyline::createVertex: %f/%f to %f/%f bulge: %f",
+    RS_DEBUG_PRINT_DEBUG("RS_Polyline::createVertex: %f/%f to %f/%f bulge: %f",
                     data.endpoint.x, data.endpoint.y, v.x, v.y, bulge);
 
     // create line for the polyline:
@@ -300,10 +300,10 @@ RS_Entity* RS_Polyline::createVertex(const RS_Vector& v, double bulge, bool prep
  * Ends polyline and adds the last entity if the polyline is closed
  */
 void RS_Polyline::endPolyline() {
-        RS_DEBUG->print("RS_Polyline::endPolyline");
+        RS_DEBUG_PRINT_DEBUG("RS_Polyline::endPolyline");
 
     if (isClosed()) {
-                RS_DEBUG->print("RS_Polyline::endPolyline: adding closing entity");
+                RS_DEBUG_PRINT_DEBUG("RS_Polyline::endPolyline: adding closing entity");
 
         // remove old closing entity:
 		if (closingEntity) {
@@ -427,7 +427,7 @@ void RS_Polyline::updateEndpoints() {
  * To add entities use addVertex() or addSegment() instead.
  */
 void RS_Polyline::addEntity(RS_Entity* /*entity*/) {
-    RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Polyline::addEntity:"
+    RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_Polyline::addEntity:"
 					" should never be called\n"
 					"use addVertex() or addSegment() instead"
 					);
@@ -101,7 +101,7 @@ RS_Vector RS_Solid::getCorner(int num) const
         return data.corner[num];
     }
 
-    RS_DEBUG->print(RS_Debug::D_WARNING, "Illegal corner requested from Solid");
+    RS_DEBUG_PRINT(RS_Debug::D_WARNING, "Illegal corner requested from Solid");
     return RS_Vector(false);
 }
 
@@ -27,6 +27,8 @@
 #include<iostream>
 #include<cmath>
 #include<numeric>
+#include<algorithm>
+#include<QPainterPath>
 
 #include "rs_spline.h"
 
@@ -83,23 +85,35 @@ RS_Entity* RS_Spline::clone() const{
 
 
 void RS_Spline::calculateBorders() {
-    /*minV = RS_Vector::minimum(data.startpoint, data.endpoint);
-    maxV = RS_Vector::maximum(data.startpoint, data.endpoint);
+    resetBorders();
+	for (RS_Vector const& vp: segmentPoints) {
+		minV = RS_Vector::minimum(vp, minV);
+		maxV = RS_Vector::maximum(vp, maxV);
+	}
+}
+
 
-    QList<RS_Vector>::iterator it;
-    for (it = data.controlPoints.begin();
-    it!=data.controlPoints.end(); ++it) {
 
-    minV = RS_Vector::minimum(*it, minV);
-    maxV = RS_Vector::maximum(*it, maxV);
+void RS_Spline::updateDirtyBorders() {
+	calculateBorders();
 }
-    */
+
+
+
+/**
+ * @return Estimated memory held by the spline, including its polygon.
+ */
+size_t RS_Spline::undoMemoryUsage() const {
+	return RS_EntityContainer::undoMemoryUsage()
+			+ (data.controlPoints.size() + segmentPoints.size()) * sizeof(RS_Vector)
+			+ data.knotslist.size() * sizeof(double);
 }
 
 
 void RS_Spline::setDegree(size_t deg) {
 	if (deg>=1 && deg<=3) {
 		data.degree = deg;
+		knots.clear();
 	}
 }
 
@@ -155,26 +169,27 @@ RS_Vector RS_Spline::getNearestSelectedRef( const RS_Vector& coord,
  */
 void RS_Spline::update() {
 
-    RS_DEBUG->print("RS_Spline::update");
+    RS_DEBUG_PRINT_DEBUG("RS_Spline::update");
 
-    clear();
+    segmentPoints.clear();
+    drawPoints.clear();
+    knots.clear();
+    resetBorders();
 
     if (isUndone()) {
         return;
     }
 
     if (data.degree<1 || data.degree>3) {
-        RS_DEBUG->print("RS_Spline::update: invalid degree: %d", data.degree);
+        RS_DEBUG_PRINT_DEBUG("RS_Spline::update: invalid degree: %d", data.degree);
         return;
     }
 
     if (data.controlPoints.size() < data.degree+1) {
-        RS_DEBUG->print("RS_Spline::update: not enough control points");
+        RS_DEBUG_PRINT_DEBUG("RS_Spline::update: not enough control points");
         return;
     }
 
-    resetBorders();
-
 	std::vector<RS_Vector> tControlPoints = data.controlPoints;
 
     if (data.closed) {
@@ -189,36 +204,25 @@ void RS_Spline::update() {
     // resolution:
 	const size_t  p1 = getGraphicVariableInt("$SPLINESEGS", 8) * npts;
 
-	std::vector<double> h(npts+1, 1.);
-	std::vector<RS_Vector> p(p1, {0., 0.});
+	segmentPoints.assign(p1, RS_Vector(0., 0.));
     if (data.closed) {
-		rbsplinu(npts,k,p1,tControlPoints,h,p);
+		rbsplinu(npts,k,p1,tControlPoints,segmentPoints);
     } else {
-		rbspline(npts,k,p1,tControlPoints,h,p);
+		rbspline(npts,k,p1,tControlPoints,segmentPoints);
     }
+	segmentPoints.shrink_to_fit();
 
-	RS_Vector prev{};
-	for (auto const& vp: p) {
-		if (prev.valid) {
-			RS_Line* line = new RS_Line{this, prev, vp};
-			line->setLayer(nullptr);
-			line->setPen(RS2::FlagInvalid);
-			addEntity(line);
-		}
-		prev = vp;
-		minV = RS_Vector::minimum(prev, minV);
-		maxV = RS_Vector::maximum(prev, maxV);
-	}
+	calculateBorders();
 }
 
 RS_Vector RS_Spline::getStartpoint() const {
-   if (data.closed) return RS_Vector(false);
-   return static_cast<RS_Line*>(const_cast<RS_Spline*>(this)->firstEntity())->getStartpoint();
+   if (data.closed || segmentPoints.empty()) return RS_Vector(false);
+   return segmentPoints.front();
 }
 
 RS_Vector RS_Spline::getEndpoint() const {
-   if (data.closed) return RS_Vector(false);
-   return static_cast<RS_Line*>(const_cast<RS_Spline*>(this)->lastEntity())->getEndpoint();
+   if (data.closed || segmentPoints.empty()) return RS_Vector(false);
+   return segmentPoints.back();
 }
 
 
@@ -255,16 +259,6 @@ RS_Vector RS_Spline::getNearestEndpoint(const RS_Vector& coord,
 
 
 
-/*
-// The default implementation of RS_EntityContainer is inaccurate but
-//   has to do for now..
-RS_Vector RS_Spline::getNearestPointOnEntity(const RS_Vector& coord,
-        bool onEntity, double* dist, RS_Entity** entity) {
-}
-*/
-
-
-
 RS_Vector RS_Spline::getNearestCenter(const RS_Vector& /*coord*/,
 									  double* dist) const{
 
@@ -302,11 +296,14 @@ RS_Vector RS_Spline::getNearestDist(double /*distance*/,
 
 
 void RS_Spline::move(const RS_Vector& offset) {
-    RS_EntityContainer::move(offset);
+    drawPoints.clear();
 	for (RS_Vector& vp: data.controlPoints) {
 		vp.move(offset);
     }
-//    update();
+	for (RS_Vector& vp: segmentPoints) {
+		vp.move(offset);
+	}
+	moveBorders(offset);
 }
 
 
@@ -318,11 +315,14 @@ void RS_Spline::rotate(const RS_Vector& center, const double& angle) {
 
 
 void RS_Spline::rotate(const RS_Vector& center, const RS_Vector& angleVector) {
-	RS_EntityContainer::rotate(center, angleVector);
+	drawPoints.clear();
 	for (RS_Vector& vp: data.controlPoints) {
 		vp.rotate(center, angleVector);
 	}
-//    update();
+	for (RS_Vector& vp: segmentPoints) {
+		vp.rotate(center, angleVector);
+	}
+	calculateBorders();
 }
 
 void RS_Spline::scale(const RS_Vector& center, const RS_Vector& factor) {
@@ -357,33 +357,55 @@ void RS_Spline::moveRef(const RS_Vector& ref, const RS_Vector& offset) {
 
 void RS_Spline::revertDirection() {
 	std::reverse(data.controlPoints.begin(), data.controlPoints.end());
+	update();
 }
 
 
 
 
+/**
+ * Solid splines are drawn from an adaptive tessellation of the curve, fine
+ * enough for the current zoom. Patterns are drawn along the polygon.
+ */
 void RS_Spline::draw(RS_Painter* painter, RS_GraphicView* view, double& /*patternOffset*/) {
 
-	if (!(painter && view)) {
+	if (!(painter && view) || segmentPoints.size() < 2) {
         return;
     }
+	if (isSelected() != painter->shouldDrawSelected()) {
+		return;
+	}
 
+	if (RS2::SolidLine == painter->getPen().getLineType()) {
 
-    RS_Entity* e=firstEntity(RS2::ResolveNone);
-	if (e) {
-        RS_Pen p=this->getPen(true);
-        e->setPen(p);
-        double patternOffset(0.0);
-        view->drawEntity(painter, e, patternOffset);
-        //RS_DEBUG->print("offset: %f\nlength was: %f", offset, e->getLength());
+		// half a pixel, the tessellation is reused until it is 4 times too fine
+		double const tolerance = 0.5 / view->toGuiDX(1.);
+		if (drawPoints.empty() || drawTolerance > tolerance
+				|| 4. * drawTolerance < tolerance) {
+			tessellate(tolerance);
+		}
 
-        e = nextEntity(RS2::ResolveNone);
-		while(e) {
-            view->drawEntityPlain(painter, e, patternOffset);
-            e = nextEntity(RS2::ResolveNone);
-            //RS_DEBUG->print("offset: %f\nlength was: %f", offset, e->getLength());
-        }
-    }
+		QPainterPath path;
+		RS_Vector vp = view->toGui(drawPoints.front());
+		path.moveTo(vp.x, vp.y);
+		for (size_t i = 1; i < drawPoints.size(); ++i) {
+			vp = view->toGui(drawPoints[i]);
+			path.lineTo(vp.x, vp.y);
+		}
+		painter->drawPath(path);
+		return;
+	}
+
+	// the pattern continues from one segment to the next
+	RS_Line line{segmentPoints[0], segmentPoints[1]};
+	line.setPen(getPen(true));
+	line.setSelected(isSelected());
+	double patternOffset = 0.;
+	for (size_t i = 1; i < segmentPoints.size(); ++i) {
+		line.setStartpoint(segmentPoints[i - 1]);
+		line.setEndpoint(segmentPoints[i]);
+		line.draw(painter, view, patternOffset);
+	}
 }
 
 
@@ -429,7 +451,7 @@ void RS_Spline::draw(RS_Painter* painter, RS_GraphicView* view) {
        b[i+1] = (*it).y;
        b[i+2] = 0.0;
 
-        RS_DEBUG->print("RS_Spline::draw: b[%d]: %f/%f", i, b[i], b[i+1]);
+        RS_DEBUG_PRINT_DEBUG("RS_Spline::draw: b[%d]: %f/%f", i, b[i], b[i+1]);
         i+=3;
    }
 
@@ -467,11 +489,23 @@ const std::vector<RS_Vector>& RS_Spline::getControlPoints() const{
 
 
 
+/**
+ * @return The points of the polygon approximating the spline. The polygon
+ * of a closed spline returns to its first point.
+ */
+const std::vector<RS_Vector>& RS_Spline::getSegmentPoints() const{
+    return segmentPoints;
+}
+
+
+
 /**
  * Appends the given point to the control points.
  */
 void RS_Spline::addControlPoint(const RS_Vector& v) {
 	data.controlPoints.push_back(v);
+	drawPoints.clear();
+	knots.clear();
 }
 
 
@@ -481,48 +515,59 @@ void RS_Spline::addControlPoint(const RS_Vector& v) {
  */
 void RS_Spline::removeLastControlPoint() {
     data.controlPoints.pop_back();
+    drawPoints.clear();
+    knots.clear();
 }
 
 //TODO: private interface cleanup; de Boor's Algorithm
 /**
  * Generates B-Spline open knot vector with multiplicity
- * equal to the order at the ends.
+ * equal to the order at the ends. The vector is kept until the
+ * control points change.
  */
-std::vector<double> RS_Spline::knot(size_t num, size_t order) const{
+const std::vector<double>& RS_Spline::knot(size_t num, size_t order) const{
+	if (knots.size() == num + order) {
+		return knots;
+	}
 	if (data.knotslist.size() == num + order) {
 		//use custom knot vector
-		return data.knotslist;
+		knots = data.knotslist;
+		return knots;
 	}
 
-	std::vector<double> knotVector(num + order, 0.);
+	knots.assign(num + order, 0.);
 	//use uniform knots
-	std::iota(knotVector.begin() + order, knotVector.begin() + num + 1, 1);
-	std::fill(knotVector.begin() + num + 1, knotVector.end(), knotVector[num]);
-	return knotVector;
+	std::iota(knots.begin() + order, knots.begin() + num + 1, 1);
+	std::fill(knots.begin() + num + 1, knots.end(), knots[num]);
+	return knots;
 }
 
 
 
 /**
- * Generates rational B-spline basis functions for an open knot vector.
+ * Generates the B-spline basis functions for the knot vector x. All
+ * weights are 1, so the rational basis functions are the nonrational
+ * ones normalized to a sum of 1.
+ *
+ * @return the basis functions in the first npts elements of a scratch
+ * buffer, which is overwritten by the next call.
  */
-namespace{
-std::vector<double> rbasis(int c, double t, int npts,
-                                      const std::vector<double>& x,
-                                      const std::vector<double>& h) {
+const std::vector<double>& RS_Spline::rbasis(size_t c, double t, size_t npts,
+                                             const std::vector<double>& x) const {
 
-	int const nplusc = npts + c;
+	size_t const nplusc = npts + c;
 
-	std::vector<double> temp(nplusc,0.);
+	basis.assign(nplusc, 0.);
+	std::vector<double>& temp = basis;
 
     // calculate the first order nonrational basis functions n[i]
-	for (int i = 0; i< nplusc-1; i++)
+	for (size_t i = 0; i< nplusc-1; i++)
 		if ((t >= x[i]) && (t < x[i+1])) temp[i] = 1;
 
     /* calculate the higher order nonrational basis functions */
 
-	for (int k = 2; k <= c; k++) {
-		for (int i = 0; i < nplusc-k; i++) {
+	for (size_t k = 2; k <= c; k++) {
+		for (size_t i = 0; i < nplusc-k; i++) {
 			// if the lower order basis function is zero skip the calculation
             if (temp[i] != 0)
 				temp[i] = ((t-x[i])*temp[i])/(x[i+k-1]-x[i]);
@@ -537,18 +582,15 @@ std::vector<double> rbasis(int c, double t, int npts,
 
     // calculate sum for denominator of rational basis functions
 	double sum = 0.;
-	for (int i = 0; i < npts; i++) {
-		sum += temp[i]*h[i];
+	for (size_t i = 0; i < npts; i++) {
+		sum += temp[i];
     }
 
-	std::vector<double> r(npts, 0);
-    // form rational basis functions and put in r vector
-	if (sum != 0) {
-		for (int i = 0; i < npts; i++)
-			r[i] = (temp[i]*h[i])/sum;
+    // form rational basis functions
+	for (size_t i = 0; i < npts; i++) {
+		temp[i] = sum != 0 ? temp[i] / sum : 0.;
 	}
-	return r;
-}
+	return temp;
 }
 
 
@@ -557,12 +599,11 @@ std::vector<double> rbasis(int c, double t, int npts,
  */
 void RS_Spline::rbspline(size_t npts, size_t k, size_t p1,
                          const std::vector<RS_Vector>& b,
-                         const std::vector<double>& h,
                          std::vector<RS_Vector>& p) const{
 	size_t const nplusc = npts + k;
 
 	// generate the open knot vector
-	auto const x = knot(npts, k);
+	auto const& x = knot(npts, k);
 
     // calculate the points on the rational B-spline curve
     double t {x[0]};
@@ -572,7 +613,7 @@ void RS_Spline::rbspline(size_t npts, size_t k, size_t p1,
 		if (x[nplusc-1] - t < 5e-6) t = x[nplusc-1];
 
         // generate the basis function for this value of t
-		auto const nbasis = rbasis(k, t, npts, x, h);
+		auto const& nbasis = rbasis(k, t, npts, x);
 
         // generate a point on the curve
 		for (size_t i = 0; i < npts; i++)
@@ -585,26 +626,33 @@ void RS_Spline::rbspline(size_t npts, size_t k, size_t p1,
 
 
 
-std::vector<double> RS_Spline::knotu(size_t num, size_t order) const{
+/**
+ * Generates the periodic knot vector of closed splines, kept until the
+ * control points change.
+ */
+const std::vector<double>& RS_Spline::knotu(size_t num, size_t order) const{
+	if (knots.size() == num + order) {
+		return knots;
+	}
 	if (data.knotslist.size() == num + order) {
 		//use custom knot vector
-		return data.knotslist;
+		knots = data.knotslist;
+		return knots;
 	}
-	std::vector<double> knotVector(num + order, 0.);
-	std::iota(knotVector.begin(), knotVector.end(), 0);
-	return knotVector;
+	knots.assign(num + order, 0.);
+	std::iota(knots.begin(), knots.end(), 0);
+	return knots;
 }
 
 
 
 void RS_Spline::rbsplinu(size_t npts, size_t k, size_t p1,
                          const std::vector<RS_Vector>& b,
-                         const std::vector<double>& h,
                          std::vector<RS_Vector>& p) const{
 	size_t const nplusc = npts + k;
 
 	/* generate the periodic knot vector */
-	std::vector<double> const x = knotu(npts, k);
+	auto const& x = knotu(npts, k);
 
     /*    calculate the points on the rational B-spline curve */
 	double t = k-1;
@@ -614,7 +662,7 @@ void RS_Spline::rbsplinu(size_t npts, size_t k, size_t p1,
 		if (x[nplusc-1] - t < 5e-6) t = x[nplusc-1];
 
 		/* generate the basis function for this value of t */
-		auto const nbasis = rbasis(k, t, npts, x, h);
+		auto const& nbasis = rbasis(k, t, npts, x);
 		/* generate a point on the curve, for x, y, z */
 		for (size_t i = 0; i < npts; i++)
 			vp += b[i] * nbasis[i];
@@ -625,6 +673,214 @@ void RS_Spline::rbsplinu(size_t npts, size_t k, size_t p1,
 }
 
 
+/**
+ * Evaluates the curve exactly.
+ *
+ * @param t curve parameter, 0 at the start and 1 at the end of the spline.
+ * @return the point on the spline, invalid if the spline can't be evaluated.
+ */
+RS_Vector RS_Spline::getPointAt(double t) const {
+	size_t const n = data.controlPoints.size();
+	size_t const k = data.degree + 1;
+	if (data.degree < 1 || data.degree > 3 || n < k) {
+		return RS_Vector(false);
+	}
+
+	// same parametrization as rbspline()/rbsplinu()
+	size_t const npts = data.closed ? n + data.degree : n;
+	auto const& x = data.closed ? knotu(npts, k) : knot(npts, k);
+	double u = 0.;
+	if (data.closed) {
+		u = (k - 1) + (npts - k + 1) * t;
+	} else {
+		u = x[0] + (x[npts + k - 1] - x[0]) * t;
+		if (x[npts + k - 1] - u < 5e-6) u = x[npts + k - 1];
+	}
+
+	auto const& nbasis = rbasis(k, u, npts, x);
+	RS_Vector p{0., 0.};
+	for (size_t i = 0; i < npts; i++) {
+		p += data.controlPoints[i % n] * nbasis[i];
+	}
+	return p;
+}
+
+
+
+/**
+ * The nearest segment of the polygon gives a first approximation, which
+ * is refined on the exact curve.
+ */
+RS_Vector RS_Spline::getNearestPointOnEntity(const RS_Vector& coord,
+		bool /*onEntity*/, double* dist, RS_Entity** entity) const {
+	if (entity) {
+		*entity = const_cast<RS_Spline*>(this);
+	}
+	if (dist) {
+		*dist = RS_MAXDOUBLE;
+	}
+	if (segmentPoints.empty()) {
+		return RS_Vector(false);
+	}
+
+	size_t index = 0;
+	RS_Vector ret = segmentPoints.front();
+	double minDist2 = (ret - coord).squared();
+	for (size_t i = 1; i < segmentPoints.size(); ++i) {
+		RS_Vector const& p0 = segmentPoints[i - 1];
+		RS_Vector const direction = segmentPoints[i] - p0;
+		double const a = direction.squared();
+		double s = a < RS_TOLERANCE2 ? 0. : RS_Vector::dotP(coord - p0, direction) / a;
+		s = std::min(1., std::max(0., s));
+		RS_Vector const vp = p0 + direction * s;
+		double const d2 = (vp - coord).squared();
+		if (d2 < minDist2) {
+			minDist2 = d2;
+			ret = vp;
+			index = i - 1;
+		}
+	}
+	if (dist) {
+		*dist = std::sqrt(minDist2);
+	}
+
+	// golden section search around the nearest segment:
+	double const segments = segmentPoints.size() - 1;
+	if (segments < 1.) {
+		return ret;
+	}
+	double a = std::max(0., (index - 1.) / segments);
+	double b = std::min(1., (index + 2.) / segments);
+	double const g = 0.5 * (std::sqrt(5.) - 1.);
+	double c = b - g * (b - a);
+	double d = a + g * (b - a);
+	double fc = (getPointAt(c) - coord).squared();
+	double fd = (getPointAt(d) - coord).squared();
+	for (int i = 0; i < 40; ++i) {
+		if (fc < fd) {
+			b = d; d = c; fd = fc;
+			c = b - g * (b - a);
+			fc = (getPointAt(c) - coord).squared();
+		} else {
+			a = c; c = d; fc = fd;
+			d = a + g * (b - a);
+			fd = (getPointAt(d) - coord).squared();
+		}
+	}
+
+	RS_Vector const vp = getPointAt(0.5 * (a + b));
+	double const d2 = (vp - coord).squared();
+	if (vp.valid && d2 < minDist2) {
+		ret = vp;
+		if (dist) {
+			*dist = std::sqrt(d2);
+		}
+	}
+	return ret;
+}
+
+
+
+double RS_Spline::getDistanceToPoint(const RS_Vector& coord,
+                                     RS_Entity** entity,
+                                     RS2::ResolveLevel /*level*/,
+                                     double /*solidDist*/) const {
+	double dist = RS_MAXDOUBLE;
+	getNearestPointOnEntity(coord, true, &dist, entity);
+	return dist;
+}
+
+
+
+/**
+ * @return Length of the polygon approximating the spline.
+ */
+double RS_Spline::getLength() const {
+	double ret = 0.;
+	for (size_t i = 1; i < segmentPoints.size(); ++i) {
+		ret += segmentPoints[i - 1].distanceTo(segmentPoints[i]);
+	}
+	return ret;
+}
+
+
+
+/**
+ * @return line integral \oint x dy along the polygon approximating the spline
+ */
+double RS_Spline::areaLineIntegral() const {
+	double ret = 0.;
+	for (size_t i = 1; i < segmentPoints.size(); ++i) {
+		RS_Vector const& p0 = segmentPoints[i - 1];
+		RS_Vector const& p1 = segmentPoints[i];
+		ret += 0.5 * (p1.y - p0.y) * (p0.x + p1.x);
+	}
+	return ret;
+}
+
+
+
+bool RS_Spline::hasEndpointsWithinWindow(const RS_Vector& v1, const RS_Vector& v2) {
+	for (RS_Vector const& vp: segmentPoints) {
+		if (vp.isInWindow(v1, v2)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
+/**
+ * Creates the points for drawing, adaptively, so no chord deviates more
+ * than tolerance from the curve.
+ */
+void RS_Spline::tessellate(double tolerance) const {
+	drawPoints.clear();
+	drawTolerance = tolerance;
+
+	RS_Vector prev = getPointAt(0.);
+	if (!prev.valid) {
+		return;
+	}
+	drawPoints.push_back(prev);
+
+	// start with spans at the control point resolution, so no wiggle is missed
+	size_t const spans = std::max<size_t>(4, 2 * data.controlPoints.size());
+	for (size_t i = 1; i <= spans; ++i) {
+		double const t = double(i) / spans;
+		RS_Vector const next = getPointAt(t);
+		subdivide(double(i - 1) / spans, prev, t, next, tolerance, 0);
+		prev = next;
+	}
+}
+
+
+
+void RS_Spline::subdivide(double t0, const RS_Vector& p0,
+                          double t1, const RS_Vector& p1,
+                          double tolerance, int depth) const {
+	double const tm = 0.5 * (t0 + t1);
+	RS_Vector const pm = getPointAt(tm);
+
+	// deviation of the curve from the chord, at the middle:
+	RS_Vector const chord = p1 - p0;
+	double const length = chord.magnitude();
+	double deviation = (pm - p0).magnitude();
+	if (length > RS_TOLERANCE) {
+		deviation = std::fabs(RS_Vector::crossP(pm - p0, chord).z) / length;
+	}
+
+	if (depth >= 10 || deviation <= tolerance) {
+		drawPoints.push_back(p1);
+		return;
+	}
+	subdivide(t0, p0, tm, pm, tolerance, depth + 1);
+	subdivide(tm, pm, t1, p1, tolerance, depth + 1);
+}
+
+
+
 /**
  * Dumps the spline's data to stdout.
  */
@@ -57,6 +57,10 @@ std::ostream& operator << (std::ostream& os, const RS_SplineData& ld);
 /**
  * Class for a spline entity.
  *
+ * The spline keeps no sub entities. The curve is approximated by a
+ * polygon of $SPLINESEGS points per control point, which is used for
+ * queries like intersections or the distance to a point.
+ *
  * @author Andrew Mustun
  */
 class RS_Spline : public RS_EntityContainer {
@@ -75,6 +79,15 @@ public:
 	bool isEdge() const override{
         return false;
     }
+	/** @return false, the spline has no sub entities */
+	bool isContainer() const override{
+		return false;
+	}
+	/** @return 1 */
+	unsigned countDeep() const override{
+		return 1;
+	}
+	size_t undoMemoryUsage() const override;
 
 	/** @return Copy of data that defines the spline. */
 	const RS_SplineData& getData() const {
@@ -120,8 +133,8 @@ public:
 
 	RS_Vector getNearestEndpoint(const RS_Vector& coord,
 										 double* dist = nullptr)const override;
-	//RS_Vector getNearestPointOnEntity(const RS_Vector& coord,
-	//        bool onEntity=true, double* dist = nullptr, RS_Entity** entity=nullptr);
+	RS_Vector getNearestPointOnEntity(const RS_Vector& coord,
+			bool onEntity=true, double* dist = nullptr, RS_Entity** entity=nullptr) const override;
 	RS_Vector getNearestCenter(const RS_Vector& coord,
 									   double* dist = nullptr)const override;
 	RS_Vector getNearestMiddle(const RS_Vector& coord,
@@ -130,6 +143,13 @@ public:
 	RS_Vector getNearestDist(double distance,
                                      const RS_Vector& coord,
 									 double* dist = nullptr)const override;
+	double getDistanceToPoint(const RS_Vector& coord,
+							  RS_Entity** entity = nullptr,
+							  RS2::ResolveLevel level = RS2::ResolveNone,
+							  double solidDist = RS_MAXDOUBLE) const override;
+	double getLength() const override;
+	double areaLineIntegral() const override;
+	bool hasEndpointsWithinWindow(const RS_Vector& v1, const RS_Vector& v2) override;
 
 		void addControlPoint(const RS_Vector& v);
 		void removeLastControlPoint();
@@ -145,23 +165,44 @@ public:
 
 		void draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset) override;
 		const std::vector<RS_Vector>& getControlPoints() const;
+		const std::vector<RS_Vector>& getSegmentPoints() const;
+		RS_Vector getPointAt(double t) const;
 
         friend std::ostream& operator << (std::ostream& os, const RS_Spline& l);
 
 		void calculateBorders() override;
 
+protected:
+		void updateDirtyBorders() override;
+
 private:
-		std::vector<double> knot(size_t num, size_t order) const;
+		const std::vector<double>& knot(size_t num, size_t order) const;
 		void rbspline(size_t npts, size_t k, size_t p1,
 		              const std::vector<RS_Vector>& b,
-		              const std::vector<double>& h,
 		              std::vector<RS_Vector>& p) const;
 
-		std::vector<double> knotu(size_t num, size_t order) const;
+		const std::vector<double>& knotu(size_t num, size_t order) const;
 		void rbsplinu(size_t npts, size_t k, size_t p1,
 		              const std::vector<RS_Vector>& b,
-		              const std::vector<double>& h,
 		              std::vector<RS_Vector>& p) const;
+		const std::vector<double>& rbasis(size_t c, double t, size_t npts,
+		                                  const std::vector<double>& x) const;
+
+		void tessellate(double tolerance) const;
+		void subdivide(double t0, const RS_Vector& p0,
+		               double t1, const RS_Vector& p1,
+		               double tolerance, int depth) const;
+
+		//! curve points for drawing, see tessellate()
+		mutable std::vector<RS_Vector> drawPoints;
+		//! flatness tolerance drawPoints were created with
+		mutable double drawTolerance = 0.;
+		//! polygon approximating the curve, see update()
+		std::vector<RS_Vector> segmentPoints;
+		//! knot vector, reused until the control points change
+		mutable std::vector<double> knots;
+		//! scratch buffer of the basis functions, see rbasis()
+		mutable std::vector<double> basis;
 
 protected:
 		RS_SplineData data;
@@ -516,13 +516,24 @@ QStringList RS_System::getFileList(const QString& subDirectory,
         RS_DEBUG->print("RS_System::getFileList: getCurrentDir %s ", getCurrentDir().toLatin1().data());
 
 
-    QStringList dirList = getDirectoryList(subDirectory);
+    return listFiles(getDirectoryList(subDirectory), fileExtension);
+}
+
+
+
+/**
+ * @return A list of absolute paths to the files with the given extension
+ * in the given directories. Doesn't use any settings, so it can be called
+ * from other threads.
+ */
+QStringList RS_System::listFiles(const QStringList& dirList,
+                                 const QString& fileExtension) {
 
     QStringList fileList;
     QString path;
     QDir dir;
 
-    for (QStringList::Iterator it = dirList.begin();
+    for (QStringList::const_iterator it = dirList.begin();
             it!=dirList.end();
             ++it ) {
 
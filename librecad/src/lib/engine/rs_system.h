@@ -166,6 +166,8 @@ public:
 
     QStringList getFileList(const QString& subDirectory,
                               const QString& fileExtension);
+    static QStringList listFiles(const QStringList& dirList,
+                                 const QString& fileExtension);
 							  
     QStringList getDirectoryList(const QString& subDirectory);
 							  
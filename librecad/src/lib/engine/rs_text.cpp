@@ -254,7 +254,7 @@ int RS_Text::getNumberOfLines() {
  */
 void RS_Text::update() {
 
-    RS_DEBUG->print("RS_Text::update");
+    RS_DEBUG_PRINT_DEBUG("RS_Text::update");
 
     clear();
 
@@ -290,10 +290,10 @@ void RS_Text::update() {
             // One Letter:
             QString letterText = QString(data.text.at(i));
             if (font->findLetter(letterText) == NULL) {
-                RS_DEBUG->print("RS_Text::update: missing font for letter( %s ), replaced it with QChar(0xfffd)",qPrintable(letterText));
+                RS_DEBUG_PRINT_DEBUG("RS_Text::update: missing font for letter( %s ), replaced it with QChar(0xfffd)",qPrintable(letterText));
                 letterText = QChar(0xfffd);
             }
-            RS_DEBUG->print("RS_Text::update: insert a "
+            RS_DEBUG_PRINT_DEBUG("RS_Text::update: insert a "
                             "letter at pos: %f/%f", letterPos.x, letterPos.y);
 
             RS_InsertData d(letterText,
@@ -308,7 +308,6 @@ void RS_Text::update() {
             letter->setPen(RS_Pen(RS2::FlagInvalid));
             letter->setLayer(NULL);
             letter->update();
-            letter->forcedCalculateBorders();
 
             letterWidth = RS_Vector(letter->getMax().x-letterPos.x, 0.0);
             if (letterWidth.x < 0)
@@ -329,7 +328,7 @@ void RS_Text::update() {
     }
     RS_Vector textSize = getSize();
 
-    RS_DEBUG->print("RS_Text::updateAddLine: width 2: %f", textSize.x);
+    RS_DEBUG_PRINT_DEBUG("RS_Text::updateAddLine: width 2: %f", textSize.x);
 
     // Vertical Align:
     double vSize = 9.0;
@@ -363,7 +362,7 @@ void RS_Text::update() {
         offset.move(RS_Vector(-textSize.x/2.0, -(vSize + textSize.y/2.0 + getMin().y) ));
         break;}
     case RS_TextData::HACenter:
-        RS_DEBUG->print("RS_Text::updateAddLine: move by: %f", -textSize.x/2.0);
+        RS_DEBUG_PRINT_DEBUG("RS_Text::updateAddLine: move by: %f", -textSize.x/2.0);
         offset.move(RS_Vector(-textSize.x/2.0, 0.0));
         break;
     case RS_TextData::HARight:
@@ -418,7 +417,7 @@ void RS_Text::update() {
 
     forcedCalculateBorders();
 
-    RS_DEBUG->print("RS_Text::update: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_Text::update: OK");
 }
 
 
@@ -29,13 +29,32 @@
 #include "qc_applicationwindow.h"
 #include "rs_undocycle.h"
 #include "rs_undo.h"
+#include "rs_settings.h"
 #include "rs_debug.h"
+#include "lc_trace.h"
+
+bool RS_Undo::limitsRead {false};
+size_t RS_Undo::maxSteps {0};
+size_t RS_Undo::maxMemory {0};
+
+/**
+ * Deletes the compact change records still owned by the undo list.
+ * Entities are owned by their containers and not touched here.
+ */
+RS_Undo::~RS_Undo()
+{
+    for (auto const& ref: undoableRefs) {
+        if (RS2::UndoableDelta == ref.first->undoRtti()) {
+            delete ref.first;
+        }
+    }
+}
 
 /**
  * @return Number of Cycles that can be undone.
  */
 int RS_Undo::countUndoCycles() {
-    RS_DEBUG->print("RS_Undo::countUndoCycles");
+    RS_DEBUG_PRINT_DEBUG("RS_Undo::countUndoCycles");
 
     return undoPointer+1;
 }
@@ -46,7 +65,7 @@ int RS_Undo::countUndoCycles() {
  * @return Number of Cycles that can be redone.
  */
 int RS_Undo::countRedoCycles() {
-    RS_DEBUG->print("RS_Undo::countRedoCycles");
+    RS_DEBUG_PRINT_DEBUG("RS_Undo::countRedoCycles");
 
     return undoList.size()-1-undoPointer;
 }
@@ -74,12 +93,129 @@ bool RS_Undo::hasUndoable()
  * on them deleted.
  */
 void RS_Undo::addUndoCycle(std::shared_ptr<RS_UndoCycle> const& i) {
-    RS_DEBUG->print("RS_Undo::addUndoCycle");
+    RS_DEBUG_PRINT_DEBUG("RS_Undo::addUndoCycle");
 
 //    undoList.insert(++undoPointer, i);
 	undoList.insert(undoList.begin() + (++undoPointer), i);
 
-    RS_DEBUG->print("RS_Undo::addUndoCycle: ok");
+    for (auto u: i->getUndoables()) {
+        UndoableRef& ref = undoableRefs[u];
+        if (0 == ref.cycles++) {
+            ref.memory = u->undoMemoryUsage();
+            undoMemory += ref.memory;
+        }
+    }
+
+    trimUndoList();
+
+    RS_DEBUG_PRINT_DEBUG("RS_Undo::addUndoCycle: ok");
+}
+
+
+
+/**
+ * Removes the undo cycles in range [first, last) from the list.
+ * Undoables which are not referenced by any remaining cycle
+ * are released.
+ */
+void RS_Undo::removeUndoCycles(size_t first, size_t last)
+{
+    std::vector<RS_Undoable*> released;
+    for (size_t i = first; i < last; ++i) {
+        for (auto u: undoList[i]->getUndoables()) {
+            auto it = undoableRefs.find(u);
+            if (undoableRefs.end() != it && 0 == --it->second.cycles) {
+                undoMemory -= it->second.memory;
+                undoableRefs.erase(it);
+                released.push_back(u);
+            }
+        }
+    }
+
+    undoList.erase(undoList.begin() + first, undoList.begin() + last);
+
+    for (auto u: released) {
+        releaseUndoable(u);
+    }
+}
+
+
+
+/**
+ * Frees an undoable which is no longer in the undo buffer.
+ * Change records are owned by the undo list and deleted,
+ * entities are only deleted when they are undone, i.e. invisible
+ * and not part of the drawing anymore.
+ */
+void RS_Undo::releaseUndoable(RS_Undoable* u)
+{
+    if (RS2::UndoableDelta == u->undoRtti()) {
+        delete u;
+    }
+    else if (u->isUndone()) {
+        removeUndoable(u);
+    }
+}
+
+
+
+/**
+ * Removes the oldest undo cycles until the history fits into
+ * the limits from the application settings.
+ * The most recent cycle is always kept.
+ */
+void RS_Undo::trimUndoList()
+{
+    if (!limitsRead) {
+        readLimits();
+    }
+
+    while (1 < undoList.size()
+           && 0 <= undoPointer
+           && ((0 < maxSteps && maxSteps < undoList.size())
+               || (0 < maxMemory && maxMemory < undoMemory))) {
+        removeUndoCycles( 0, 1);
+        --undoPointer;
+    }
+}
+
+
+
+void RS_Undo::setLimits(size_t steps, size_t memory)
+{
+    maxSteps = steps;
+    maxMemory = memory * 1024 * 1024;
+    limitsRead = true;
+}
+
+
+
+void RS_Undo::readLimits()
+{
+    RS_SETTINGS->beginGroup("/Defaults");
+    setLimits(static_cast<size_t>(RS_SETTINGS->readNumEntry("/MaxUndoSteps", 0)),
+              static_cast<size_t>(RS_SETTINGS->readNumEntry("/MaxUndoMemory", 256)));
+    RS_SETTINGS->endGroup();
+}
+
+
+
+/**
+ * @return Estimated memory in bytes held by the undo history.
+ */
+size_t RS_Undo::getUndoMemoryUsage() const
+{
+    return undoMemory;
+}
+
+
+
+/**
+ * @return Number of distinct undoables referenced by the undo history.
+ */
+size_t RS_Undo::countUndoables() const
+{
+    return undoableRefs.size();
 }
 
 
@@ -99,37 +235,7 @@ void RS_Undo::startUndoCycle()
     // if there are undo cycles behind undoPointer
     // remove obsolete entities and undoCycles
     if (undoList.size() > removePointer) {
-        // collect remaining undoables
-        std::list<RS_Undoable*> keep;
-        for (auto it = undoList.begin(); it != undoList.begin() + removePointer; ++it) {
-            for (auto u: (*it)->getUndoables()){
-                keep.push_back( u);
-            }
-        }
-        keep.unique();
-
-        // collect obsolete undoables
-        std::list<RS_Undoable*> obsolete;
-        for (auto it = undoList.begin() + removePointer; it != undoList.end(); ++it) {
-            for (auto u: (*it)->getUndoables()){
-                obsolete.push_back( u);
-            }
-        }
-        // unique() only works correct on sorted list!
-        obsolete.sort();
-        obsolete.unique();
-
-        // delete obsolte undoables which are not in keep list
-        for (auto it = obsolete.begin(); it != obsolete.end(); ++it) {
-            if (keep.end() == std::find( keep.begin(), keep.end(), *it)) {
-                removeUndoable( *it);
-            }
-        }
-
-        // clean up obsolete undoCycles
-        while (undoList.size() > removePointer) {
-            undoList.pop_back();
-        }
+        removeUndoCycles( removePointer, undoList.size());
     }
 
     // alloc new undoCycle
@@ -141,15 +247,15 @@ void RS_Undo::startUndoCycle()
  * Adds an undoable to the current undo cycle.
  */
 void RS_Undo::addUndoable(RS_Undoable* u) {
-    RS_DEBUG->print("RS_Undo::%s(): begin", __func__);
+    RS_DEBUG_PRINT_DEBUG("RS_Undo::%s(): begin", __func__);
 
     if( nullptr == currentCycle) {
-        RS_DEBUG->print( RS_Debug::D_CRITICAL, "RS_Undo::%s(): invalid currentCycle, possibly missing startUndoCycle()", __func__);
+        RS_DEBUG_PRINT( RS_Debug::D_CRITICAL, "RS_Undo::%s(): invalid currentCycle, possibly missing startUndoCycle()", __func__);
         return;
     }
 
     currentCycle->addUndoable(u);
-    RS_DEBUG->print("RS_Undo::%s(): end", __func__);
+    RS_DEBUG_PRINT_DEBUG("RS_Undo::%s(): end", __func__);
 }
 
 
@@ -159,6 +265,7 @@ void RS_Undo::addUndoable(RS_Undoable* u) {
  */
 void RS_Undo::endUndoCycle() 
 {
+    LC_TRACE_SCOPE("undo", "endUndoCycle");
     if (0 < refCount) {
         // compensate nested calls of start-/endUndoCycle()
         if( 0 < --refCount) {
@@ -167,7 +274,7 @@ void RS_Undo::endUndoCycle()
         }
     }
     else {
-        RS_DEBUG->print( RS_Debug::D_WARNING, "Warning: RS_Undo::endUndoCycle() called without previous startUndoCycle()  %d", refCount);
+        RS_DEBUG_PRINT( RS_Debug::D_WARNING, "Warning: RS_Undo::endUndoCycle() called without previous startUndoCycle()  %d", refCount);
         return;
     }
 
@@ -186,7 +293,8 @@ void RS_Undo::endUndoCycle()
  * Undoes the last undo cycle.
  */
 bool RS_Undo::undo() {
-    RS_DEBUG->print("RS_Undo::undo");
+    LC_TRACE_SCOPE("undo", "undo");
+    RS_DEBUG_PRINT_DEBUG("RS_Undo::undo");
 
 	if (undoPointer < 0) return false;
 
@@ -202,7 +310,8 @@ bool RS_Undo::undo() {
  * Redoes the undo cycle which was at last undone.
  */
 bool RS_Undo::redo() {
-    RS_DEBUG->print("RS_Undo::redo");
+    LC_TRACE_SCOPE("undo", "redo");
+    RS_DEBUG_PRINT_DEBUG("RS_Undo::redo");
 
 	if (undoPointer+1 < int(undoList.size())) {
 
@@ -224,12 +333,12 @@ bool RS_Undo::redo() {
 std::shared_ptr<RS_UndoCycle> RS_Undo::getUndoCycle() {
 		std::shared_ptr<RS_UndoCycle> ret;
 
-	RS_DEBUG->print("RS_Undo::getUndoCycle");
+	RS_DEBUG_PRINT_DEBUG("RS_Undo::getUndoCycle");
 
 	if ((undoPointer>=0) && (undoPointer < int(undoList.size()))) {
 		ret = undoList.at(undoPointer);
 	}
-	RS_DEBUG->print("RS_Undo::getUndoCycle: OK");
+	RS_DEBUG_PRINT_DEBUG("RS_Undo::getUndoCycle: OK");
 
 	return ret;
 }
@@ -243,7 +352,7 @@ std::shared_ptr<RS_UndoCycle> RS_Undo::getUndoCycle() {
  */
 /**
 std::shared_ptr<RS_UndoCycle> RS_Undo::getRedoCycle() {
-    RS_DEBUG->print("RS_Undo::getRedoCycle");
+    RS_DEBUG_PRINT_DEBUG("RS_Undo::getRedoCycle");
 
 	if ((undoPointer+1>=0) && (undoPointer+1 < int(undoList.size()))) {
         return undoList.at(undoPointer+1);
@@ -274,6 +383,8 @@ void RS_Undo::setGUIButtons() const
 std::ostream& operator << (std::ostream& os, RS_Undo& l) {
     os << "Undo List: " <<  "\n";
     os << " Pointer is at: " << l.undoPointer << "\n";
+    os << " Undoables: " << l.countUndoables()
+       << ", estimated memory: " << l.getUndoMemoryUsage() << " bytes\n";
 
 	for (int i = 0; i < int(l.undoList.size()); ++i) {
 
@@ -30,6 +30,7 @@
 #define RS_UNDO_H
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 class RS_UndoCycle;
@@ -44,7 +45,7 @@ class RS_Undoable;
  */
 class RS_Undo {
 public:
-	virtual ~RS_Undo() = default;
+	virtual ~RS_Undo();
 
     virtual bool undo();
     virtual bool redo();
@@ -67,12 +68,31 @@ public:
      */
     virtual void removeUndoable(RS_Undoable* u) = 0;
 
+    /**
+     * @return Estimated memory in bytes held by the undo history.
+     */
+    size_t getUndoMemoryUsage() const;
+
+    /**
+     * @return Number of distinct undoables referenced by the undo history.
+     */
+    size_t countUndoables() const;
+
     /**
 	  *\brief enable/disable redo/undo buttons in main application window
 	  *\author: Dongxu Li
       **/
 	void setGUIButtons() const;
 
+    /**
+     * Sets the limits of the undo history, 0 means unlimited.
+     * Until called, the limits are read once from the application settings.
+     *
+     * @param steps maximum number of undo cycles
+     * @param memory maximum estimated memory in MB
+     */
+    static void setLimits(size_t steps, size_t memory);
+
     friend std::ostream& operator << (std::ostream& os, RS_Undo& a);
 
     static bool test();
@@ -80,6 +100,11 @@ public:
 private:
 
 	void addUndoCycle(std::shared_ptr<RS_UndoCycle> const& i);
+	void removeUndoCycles(size_t first, size_t last);
+	void releaseUndoable(RS_Undoable* u);
+	void trimUndoList();
+	static void readLimits();
+
     //! List of undo list items. every item is something that can be undone.
 	std::vector<std::shared_ptr<RS_UndoCycle>> undoList;
 
@@ -97,6 +122,23 @@ private:
     std::shared_ptr<RS_UndoCycle> currentCycle {nullptr};
 
     int refCount {0}; ///< reference counter for nested start/end calls
+
+    /**
+     * Bookkeeping for every undoable in undoList: the number of cycles
+     * referring to it and its estimated memory at the time it was added.
+     * Undoables are released when no cycle refers to them anymore.
+     */
+    struct UndoableRef {
+        unsigned cycles {0};
+        size_t memory {0};
+    };
+    std::unordered_map<RS_Undoable*, UndoableRef> undoableRefs;
+
+    size_t undoMemory {0}; ///< sum of the memory estimates in undoableRefs
+
+    static bool limitsRead;
+    static size_t maxSteps;
+    static size_t maxMemory; ///< in bytes
 };
 
 
@@ -26,6 +26,7 @@
 #ifndef RS_UNDOABLE_H
 #define RS_UNDOABLE_H
 
+#include <cstddef>
 #include "rs.h"
 #include "rs_flags.h"
 
@@ -48,6 +49,14 @@ public:
         return RS2::UndoableUnknown;
     }
 
+	/**
+	 * @return Estimated number of bytes kept alive by this undoable.
+	 * Used by RS_Undo to enforce the undo memory limit.
+	 */
+	virtual size_t undoMemoryUsage() const {
+		return sizeof(RS_Undoable);
+	}
+
 	void changeUndoState();
 	void setUndoState(bool undone);
 	bool isUndone() const;
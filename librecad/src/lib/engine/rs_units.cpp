@@ -365,7 +365,7 @@ double RS_Units::convert(double val, RS2::Unit src, RS2::Unit dest) {
     if (getFactorToMM(dest)>0.0) {
         return (val*getFactorToMM(src))/getFactorToMM(dest);
     } else {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "RS_Units::convert: invalid factor");
         return val;
     }
@@ -431,7 +431,7 @@ QString RS_Units::formatLinear(double length, RS2::Unit unit,
         break;
 
     default:
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "RS_Units::formatLinear: Unknown format");
         ret = "";
         break;
@@ -635,7 +635,7 @@ QString RS_Units::formatFractional(double length, RS2::Unit /*unit*/,
             nominator = nominator / gcd;
             denominator = denominator / gcd;
         } else {
-            RS_DEBUG->print(RS_Debug::D_WARNING,
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                                 "RS_Units::formatFractional: invalid gcd");
             nominator = 0;
             denominator = 0;
@@ -687,7 +687,7 @@ QString RS_Units::formatAngle(double angle, RS2::AngleFormat format,
         value = RS_Math::rad2gra(angle);
         break;
     default:
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "RS_Units::formatAngle: Unknown Angle Unit");
         return "";
         break;
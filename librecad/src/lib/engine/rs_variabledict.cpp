@@ -69,10 +69,10 @@ void RS_VariableDict::clear()
 void RS_VariableDict::add(const QString& key,
                           const QString& value, int code)
 {
-    RS_DEBUG->print("RS_VariableDict::addVariable()");
+    RS_DEBUG_PRINT_DEBUG("RS_VariableDict::addVariable()");
 
     if (key.isEmpty()) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "RS_VariableDict::addVariable(): No empty keys allowed.");
         return;
     }
@@ -87,10 +87,10 @@ void RS_VariableDict::add(const QString& key,
  */
 void RS_VariableDict::add(const QString& key, int value, int code)
 {
-    RS_DEBUG->print("RS_VariableDict::addVariable()");
+    RS_DEBUG_PRINT_DEBUG("RS_VariableDict::addVariable()");
 
     if (key.isEmpty()) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "RS_VariableDict::addVariable(): No empty keys allowed.");
         return;
     }
@@ -105,10 +105,10 @@ void RS_VariableDict::add(const QString& key, int value, int code)
  */
 void RS_VariableDict::add(const QString& key, double value, int code)
 {
-    RS_DEBUG->print("RS_VariableDict::addVariable()");
+    RS_DEBUG_PRINT_DEBUG("RS_VariableDict::addVariable()");
 
     if (key.isEmpty()) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "RS_VariableDict::addVariable(): No empty keys allowed.");
         return;
     }
@@ -124,10 +124,10 @@ void RS_VariableDict::add(const QString& key, double value, int code)
 void RS_VariableDict::add(const QString& key,
                           const RS_Vector& value, int code)
 {
-    RS_DEBUG->print("RS_VariableDict::addVariable()");
+    RS_DEBUG_PRINT_DEBUG("RS_VariableDict::addVariable()");
 
     if (key.isEmpty()) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "RS_VariableDict::addVariable(): No empty keys allowed.");
         return;
     }
@@ -173,7 +173,7 @@ QString RS_VariableDict::getString(const QString& key, const QString& def) const
 {
     QString ret;
 
-    RS_DEBUG->print("RS_VariableDict::getString: key: '%s'", key.toLatin1().data());
+    RS_DEBUG_PRINT_DEBUG("RS_VariableDict::getString: key: '%s'", key.toLatin1().data());
 
 	auto i = variables.find(key);
     if (variables.end() != i && RS2::VariableString == i.value().getType()) {
@@ -257,7 +257,7 @@ void RS_VariableDict::addBlockNotification()
  */
 void RS_VariableDict::remove(const QString& key)
 {
-    RS_DEBUG->print("RS_VariableDict::removeVariable()");
+    RS_DEBUG_PRINT_DEBUG("RS_VariableDict::removeVariable()");
 
     // here the block is removed from the list but not deleted
     variables.remove(key);
@@ -38,6 +38,7 @@
 #include "rs_filterlff.h"
 #include "rs_filterdxfrw.h"
 #include "rs_debug.h"
+#include "lc_trace.h"
 
 /**
  * Calls the import method of the filter responsible for the format
@@ -50,6 +51,7 @@
  */
 bool RS_FileIO::fileImport(RS_Graphic& graphic, const QString& file,
         RS2::FormatType type) {
+    LC_TRACE_SCOPE("file", "fileImport");
 
     RS_DEBUG->print("Trying to import file '%s'...", file.toLatin1().data());
 
@@ -46,7 +46,7 @@
  */
 RS_FilterCXF::RS_FilterCXF() : RS_FilterInterface() {
 
-    RS_DEBUG->print("Setting up CXF filter...");
+    RS_DEBUG_PRINT_DEBUG("Setting up CXF filter...");
 }
 
 /**
@@ -58,7 +58,7 @@ RS_FilterCXF::RS_FilterCXF() : RS_FilterInterface() {
  * taken to be stored in a file.
  */
 bool RS_FilterCXF::fileImport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/) {
-    RS_DEBUG->print("CXF Filter: importing file '%s'...", file.toLatin1().data());
+    RS_DEBUG_PRINT_DEBUG("CXF Filter: importing file '%s'...", file.toLatin1().data());
 
     //this->graphic = &g;
     bool success = false;
@@ -69,7 +69,7 @@ bool RS_FilterCXF::fileImport(RS_Graphic& g, const QString& file, RS2::FormatTyp
     success = font.loadFont();
 
     if (success==false) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "Cannot open CXF file '%s'.", file.toLatin1().data());
 		return false;
     }
@@ -84,6 +84,7 @@ bool RS_FilterCXF::fileImport(RS_Graphic& g, const QString& file, RS2::FormatTyp
         g.addVariable("Encoding", font.getEncoding(), 0);
     }
 
+    font.generateAllFonts();
     RS_BlockList* letterList = font.getLetterList();
     for (unsigned i=0; i<font.countLetters(); ++i) {
         RS_Block* ch = font.letterAt(i);
@@ -117,20 +118,20 @@ bool RS_FilterCXF::fileImport(RS_Graphic& g, const QString& file, RS2::FormatTyp
  */
 bool RS_FilterCXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/) {
 
-    RS_DEBUG->print("CXF Filter: exporting file '%s'...", file.toLatin1().data());
+    RS_DEBUG_PRINT_DEBUG("CXF Filter: exporting file '%s'...", file.toLatin1().data());
 
     // crashes under windoze xp:
     //std::ofstream fout;
 
-    RS_DEBUG->print("RS_FilterCXF::fileExport: open");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterCXF::fileExport: open");
     //fout.open((const char*)file.toLocal8Bit());
     FILE* fp;
 
     if ((fp = fopen(file.toLocal8Bit(), "wt")) != NULL) {
 
-        RS_DEBUG->print("RS_FilterCXF::fileExport: open: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterCXF::fileExport: open: OK");
 
-        RS_DEBUG->print("RS_FilterCXF::fileExport: header");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterCXF::fileExport: header");
 
         // header:
         fprintf(fp, "# Format:            QCad II Font\n");
@@ -140,18 +141,18 @@ bool RS_FilterCXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
         fprintf(fp, "# Version:           %s\n",
                 (const char*)RS_SYSTEM->getAppVersion().toLocal8Bit());
 
-        RS_DEBUG->print("001");
+        RS_DEBUG_PRINT_DEBUG("001");
         QString ns = g.getVariableString("Names", "");
         if (!ns.isEmpty()) {
             QStringList names = ns.split(',');
-            RS_DEBUG->print("002");
+            RS_DEBUG_PRINT_DEBUG("002");
             for (int i = 0; i < names.size(); ++i) {
                 fprintf(fp, "# Name:              %s\n",
                         names.at(i).toLocal8Bit().data() );
              }
         }
 
-        RS_DEBUG->print("003");
+        RS_DEBUG_PRINT_DEBUG("003");
 
         QString es = g.getVariableString("Encoding", "");
         if (!es.isEmpty()) {
@@ -159,7 +160,7 @@ bool RS_FilterCXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
                     es.toLocal8Bit().data());
         }
 
-        RS_DEBUG->print("004a");
+        RS_DEBUG_PRINT_DEBUG("004a");
 
         fprintf(fp, "# LetterSpacing:     %f\n",
                 g.getVariableDouble("LetterSpacing", 3.0));
@@ -169,42 +170,42 @@ bool RS_FilterCXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
                 g.getVariableDouble("LineSpacingFactor", 1.0));
 
         QString sa = g.getVariableString("Authors", "");
-        RS_DEBUG->print("authors: %s", sa.toLocal8Bit().data());
+        RS_DEBUG_PRINT_DEBUG("authors: %s", sa.toLocal8Bit().data());
         if (!sa.isEmpty()) {
             QStringList authors = sa.split(',');
-            RS_DEBUG->print("006");
-            RS_DEBUG->print("count: %d", authors.count());
+            RS_DEBUG_PRINT_DEBUG("006");
+            RS_DEBUG_PRINT_DEBUG("count: %d", authors.count());
 
             QString a;
             for (QStringList::Iterator it2 = authors.begin();
                     it2!=authors.end(); ++it2) {
 
-                RS_DEBUG->print("006a");
+                RS_DEBUG_PRINT_DEBUG("006a");
                 a = QString(*it2);
-                RS_DEBUG->print("006b");
-                RS_DEBUG->print("string is: %s", a.toLatin1().data());
-                RS_DEBUG->print("006b0");
+                RS_DEBUG_PRINT_DEBUG("006b");
+                RS_DEBUG_PRINT_DEBUG("string is: %s", a.toLatin1().data());
+                RS_DEBUG_PRINT_DEBUG("006b0");
                 fprintf(fp, "# Author:            ");
-                RS_DEBUG->print("006b1");
+                RS_DEBUG_PRINT_DEBUG("006b1");
                 fprintf(fp, "%s\n", a.toLatin1().data());
                 //fout << "# Author:            " << a.ascii() << "\n";
             }
-            RS_DEBUG->print("007");
+            RS_DEBUG_PRINT_DEBUG("007");
         }
 
-        RS_DEBUG->print("RS_FilterCXF::fileExport: header: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterCXF::fileExport: header: OK");
 
-        RS_DEBUG->print("008");
+        RS_DEBUG_PRINT_DEBUG("008");
         // iterate through blocks (=letters of font)
         for (unsigned i=0; i<g.countBlocks(); ++i) {
             RS_Block* blk = g.blockAt(i);
 
-            RS_DEBUG->print("block: %d", i);
-            RS_DEBUG->print("001");
+            RS_DEBUG_PRINT_DEBUG("block: %d", i);
+            RS_DEBUG_PRINT_DEBUG("001");
 
             if (blk && !blk->isUndone()) {
-                RS_DEBUG->print("002");
-                RS_DEBUG->print("002a: %s",
+                RS_DEBUG_PRINT_DEBUG("002");
+                RS_DEBUG_PRINT_DEBUG("002a: %s",
                                 (blk->getName().toLocal8Bit().data()));
 
                 fprintf(fp, "\n%s\n",
@@ -218,7 +219,7 @@ bool RS_FilterCXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
 
                     if (!e->isUndone()) {
 
-                        RS_DEBUG->print("004");
+                        RS_DEBUG_PRINT_DEBUG("004");
 
                         // lines:
                         if (e->rtti()==RS2::EntityLine) {
@@ -253,19 +254,19 @@ bool RS_FilterCXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
                         else {}
                     }
 
-                    RS_DEBUG->print("005");
+                    RS_DEBUG_PRINT_DEBUG("005");
                 }
-                RS_DEBUG->print("006");
+                RS_DEBUG_PRINT_DEBUG("006");
             }
-            RS_DEBUG->print("007");
+            RS_DEBUG_PRINT_DEBUG("007");
         }
         //fout.close();
         fclose(fp);
-    	RS_DEBUG->print("CXF Filter: exporting file: OK");
+    	RS_DEBUG_PRINT_DEBUG("CXF Filter: exporting file: OK");
 		return true;
     }
 	else {
-    	RS_DEBUG->print("CXF Filter: exporting file failed");
+    	RS_DEBUG_PRINT_DEBUG("CXF Filter: exporting file failed");
 	}
 
 	return false;
@@ -1222,6 +1222,9 @@ bool RS_FilterDXF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
         exportVersion = DL_Codes::AC1015;
     }
 
+    // dimensions are written from their sub entities:
+    graphic->validateAllDimensions();
+
     //DL_WriterA* dw = dxf.out(file, VER_R12);
     DL_WriterA* dw = dxf.out((const char*)QFile::encodeName(file), exportVersion);
 
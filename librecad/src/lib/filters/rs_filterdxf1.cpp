@@ -55,7 +55,7 @@ RS_FilterDXF1::RS_FilterDXF1()
 		:RS_FilterInterface()
 		, graphic(nullptr)
 {
-	RS_DEBUG->print("Setting up DXF 1 filter...");
+	RS_DEBUG_PRINT_DEBUG("Setting up DXF 1 filter...");
 }
 
 /**
@@ -67,7 +67,7 @@ RS_FilterDXF1::RS_FilterDXF1()
  * taken to be stored in a file.
  */
 bool RS_FilterDXF1::fileImport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/) {
-    RS_DEBUG->print("DXF1 Filter: importing file '%s'...", file.toLatin1().data());
+    RS_DEBUG_PRINT_DEBUG("DXF1 Filter: importing file '%s'...", file.toLatin1().data());
 
 	this->graphic = &g;
 
@@ -88,7 +88,7 @@ bool RS_FilterDXF1::fileImport(RS_Graphic& g, const QString& file, RS2::FormatTy
 
 bool RS_FilterDXF1::fileExport(RS_Graphic& /*g*/, const QString& /*file*/,
 	RS2::FormatType /*type*/) {
-	RS_DEBUG->print(RS_Debug::D_WARNING,
+	RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 					"Exporting of QCad 1.x file not implemented");
 	return false;
 }
@@ -97,7 +97,7 @@ bool RS_FilterDXF1::fileExport(RS_Graphic& /*g*/, const QString& /*file*/,
  * Reads a dxf1 file from buffer.
  */
 bool RS_FilterDXF1::readFromBuffer() {
-    RS_DEBUG->print( "\nDXF: Read from buffer" );
+    RS_DEBUG_PRINT_DEBUG( "\nDXF: Read from buffer" );
 
     bool      ret;                    // returned value
     QString   dxfLine;                // A line in the dxf file
@@ -130,22 +130,22 @@ bool RS_FilterDXF1::readFromBuffer() {
     // Loaded graphics without unit information: load as unit less:
     //graphic->setUnit( None );
 
-    RS_DEBUG->print( "\nUnit set" );
+    RS_DEBUG_PRINT_DEBUG( "\nUnit set" );
 
     resetBufP();
 
     if(fBuf) {
 
-        RS_DEBUG->print( "\nBuffer OK" );
-        RS_DEBUG->print( "\nBuffer: " );
-        RS_DEBUG->print( fBuf );
+        RS_DEBUG_PRINT_DEBUG( "\nBuffer OK" );
+        RS_DEBUG_PRINT_DEBUG( "\nBuffer: " );
+        RS_DEBUG_PRINT_DEBUG( fBuf );
 
         do {
             dxfLine=getBufLine();
             pen = RS_Pen(RS_Color(RS2::FlagByLayer), RS2::WidthByLayer, RS2::LineByLayer);
 
-            RS_DEBUG->print( "\ndxfLine: " );
-            RS_DEBUG->print( dxfLine.toLatin1().data() );
+            RS_DEBUG_PRINT_DEBUG( "\ndxfLine: " );
+            RS_DEBUG_PRINT_DEBUG( dxfLine.toLatin1().data() );
 
             // $-Setting in the header of DXF found
             // RVT_PORT changed all occurenses of if (dxfline && ....) to if (dxfline.size() ......)
@@ -54,6 +54,7 @@
 #include "rs_graphicview.h"
 #include "rs_dialogfactory.h"
 #include "rs_math.h"
+#include "lc_trace.h"
 
 #ifdef DWGSUPPORT
 #include "libdwgr.h"
@@ -67,7 +68,7 @@
 RS_FilterDXFRW::RS_FilterDXFRW()
     :RS_FilterInterface(),DRW_Interface() {
 
-    RS_DEBUG->print("RS_FilterDXFRW::RS_FilterDXFRW()");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::RS_FilterDXFRW()");
 
 	currentContainer = nullptr;
 	graphic = nullptr;
@@ -83,14 +84,14 @@ RS_FilterDXFRW::RS_FilterDXFRW()
     fontList["armusic"] = "symusic";
 
 
-    RS_DEBUG->print("RS_FilterDXFRW::RS_FilterDXFRW(): OK");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::RS_FilterDXFRW(): OK");
 }
 
 /**
  * Destructor.
  */
 RS_FilterDXFRW::~RS_FilterDXFRW() {
-    RS_DEBUG->print("RS_FilterDXFRW::~RS_FilterDXFRW(): OK");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::~RS_FilterDXFRW(): OK");
 }
 
 
@@ -104,9 +105,9 @@ RS_FilterDXFRW::~RS_FilterDXFRW() {
  * taken to be stored in a file.
  */
 bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatType type) {
-    RS_DEBUG->print("RS_FilterDXFRW::fileImport");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::fileImport");
 
-    RS_DEBUG->print("DXFRW Filter: importing file '%s'...", (const char*)QFile::encodeName(file));
+    RS_DEBUG_PRINT_DEBUG("DXFRW Filter: importing file '%s'...", (const char*)QFile::encodeName(file));
 #ifndef DWGSUPPORT
     Q_UNUSED(type)
 #endif
@@ -128,16 +129,20 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatT
 #ifdef DWGSUPPORT
     if (type == RS2::FormatDWG) {
         dwgR dwgr(QFile::encodeName(file));
-        RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading DWG file");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::fileImport: reading DWG file");
         if (RS_DEBUG->getLevel()== RS_Debug::D_DEBUGGING)
             dwgr.setDebug(DRW::DEBUG);
-        bool success = dwgr.read(this, true);
-        RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading DWG file: OK");
+        bool success;
+        {
+            LC_TRACE_SCOPE("file", "read DWG");
+            success = dwgr.read(this, true);
+        }
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::fileImport: reading DWG file: OK");
         RS_DIALOGFACTORY->commandMessage(QObject::tr("Opened dwg file version %1.").arg(printDwgVersion(dwgr.getVersion())));
         int  lastError = dwgr.getError();
         if (success==false) {
             printDwgError(lastError);
-            RS_DEBUG->print(RS_Debug::D_WARNING,
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                             "Cannot open DWG file '%s'.", (const char*)QFile::encodeName(file));
             return false;
         }
@@ -145,13 +150,17 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatT
 #endif
         dxfRW dxfR(QFile::encodeName(file));
 
-        RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading file");
-        bool success = dxfR.read(this, true);
-        RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading file: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::fileImport: reading file");
+        bool success;
+        {
+            LC_TRACE_SCOPE("file", "read DXF");
+            success = dxfR.read(this, true);
+        }
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::fileImport: reading file: OK");
         //graphic->setAutoUpdateBorders(true);
 
         if (success==false) {
-            RS_DEBUG->print(RS_Debug::D_WARNING,
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                             "Cannot open DXF file '%s'.", (const char*)QFile::encodeName(file));
             return false;
         }
@@ -166,10 +175,13 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatT
         //require to notify
         graphic->getLayerList()->activate(cl, true);
     }
-    RS_DEBUG->print("RS_FilterDXFRW::fileImport: updating inserts");
-    graphic->updateInserts();
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::fileImport: updating inserts");
+    {
+        LC_TRACE_SCOPE("file", "update inserts");
+        graphic->updateInserts();
+    }
 
-    RS_DEBUG->print("RS_FilterDXFRW::fileImport OK");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::fileImport OK");
 
     return true;
 }
@@ -178,20 +190,20 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatT
  * Implementation of the method which handles layers.
  */
 void RS_FilterDXFRW::addLayer(const DRW_Layer &data) {
-    RS_DEBUG->print("RS_FilterDXF::addLayer");
-    RS_DEBUG->print("  adding layer: %s", data.name.c_str());
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addLayer");
+    RS_DEBUG_PRINT_DEBUG("  adding layer: %s", data.name.c_str());
 
-    RS_DEBUG->print("RS_FilterDXF::addLayer: creating layer");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addLayer: creating layer");
 
     QString name = QString::fromUtf8(data.name.c_str());
     if (name != "0" && graphic->findLayer(name)) {
         return;
     }
     RS_Layer* layer = new RS_Layer(name);
-    RS_DEBUG->print("RS_FilterDXF::addLayer: set pen");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addLayer: set pen");
     layer->setPen(attributesToPen(&data));
 
-    RS_DEBUG->print("RS_FilterDXF::addLayer: flags");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addLayer: flags");
     if (data.flags&0x01) {
         layer->freeze(true);
     }
@@ -202,7 +214,7 @@ void RS_FilterDXFRW::addLayer(const DRW_Layer &data) {
 
     //parse extended data to read construction flag
     if (!data.extData.empty()){
-        RS_DEBUG->print(RS_Debug::D_WARNING, "RS_FilterDXF::addLayer: layer %s have extended data", layer->getName().toStdString().c_str());
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_FilterDXF::addLayer: layer %s have extended data", layer->getName().toStdString().c_str());
         bool isLCdata = false;
         for (std::vector<DRW_Variant*>::const_iterator it=data.extData.begin(); it!=data.extData.end(); ++it){
             if ((*it)->code() == 1001){
@@ -223,18 +235,18 @@ void RS_FilterDXFRW::addLayer(const DRW_Layer &data) {
     }
 
     if (layer->isConstruction())
-        RS_DEBUG->print(RS_Debug::D_WARNING, "RS_FilterDXF::addLayer: layer %s is construction layer", layer->getName().toStdString().c_str());
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_FilterDXF::addLayer: layer %s is construction layer", layer->getName().toStdString().c_str());
 
-    RS_DEBUG->print("RS_FilterDXF::addLayer: add layer to graphic");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addLayer: add layer to graphic");
     graphic->addLayer(layer);
-    RS_DEBUG->print("RS_FilterDXF::addLayer: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addLayer: OK");
 }
 
 /**
  * Implementation of the method which handles dimension styles.
  */
 void RS_FilterDXFRW::addDimStyle(const DRW_Dimstyle& data){
-    RS_DEBUG->print("RS_FilterDXFRW::addLayer");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addLayer");
     QString dimstyle = graphic->getVariableString("$DIMSTYLE", "standard");
 
     if (QString::compare(data.name.c_str(), dimstyle, Qt::CaseInsensitive) == 0) {
@@ -282,9 +294,9 @@ void RS_FilterDXFRW::addVport(const DRW_Vport &data) {
  */
 void RS_FilterDXFRW::addBlock(const DRW_Block& data) {
 
-    RS_DEBUG->print("RS_FilterDXF::addBlock");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addBlock");
 
-    RS_DEBUG->print("  adding block: %s", data.name.c_str());
+    RS_DEBUG_PRINT_DEBUG("  adding block: %s", data.name.c_str());
 /*TODO correct handle of model-space*/
 
     QString name = QString::fromUtf8(data.name.c_str());
@@ -355,26 +367,26 @@ void RS_FilterDXFRW::addPoint(const DRW_Point& data) {
  * Implementation of the method which handles line entities.
  */
 void RS_FilterDXFRW::addLine(const DRW_Line& data) {
-    RS_DEBUG->print("RS_FilterDXF::addLine");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addLine");
 
     RS_Vector v1(data.basePoint.x, data.basePoint.y);
     RS_Vector v2(data.secPoint.x, data.secPoint.y);
 
-    RS_DEBUG->print("RS_FilterDXF::addLine: create line");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addLine: create line");
 
 	if (!currentContainer) {
-		RS_DEBUG->print("RS_FilterDXF::addLine: currentContainer is nullptr");
+		RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addLine: currentContainer is nullptr");
     }
 
 	RS_Line* entity = new RS_Line{currentContainer, {v1, v2}};
-    RS_DEBUG->print("RS_FilterDXF::addLine: set attributes");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addLine: set attributes");
     setEntityAttributes(entity, &data);
 
-    RS_DEBUG->print("RS_FilterDXF::addLine: add entity");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addLine: add entity");
 
 	if (currentContainer) currentContainer->addEntity(entity);
 
-    RS_DEBUG->print("RS_FilterDXF::addLine: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addLine: OK");
 }
 
 
@@ -382,27 +394,27 @@ void RS_FilterDXFRW::addLine(const DRW_Line& data) {
  * Implementation of the method which handles ray entities.
  */
 void RS_FilterDXFRW::addRay(const DRW_Ray& data) {
-    RS_DEBUG->print("RS_FilterDXF::addRay");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addRay");
 
 	RS_Vector v1{data.basePoint.x, data.basePoint.y};
 	RS_Vector v2{data.basePoint.x+data.secPoint.x,
 				data.basePoint.y+data.secPoint.y};
 
-    RS_DEBUG->print("RS_FilterDXF::addRay: create line");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addRay: create line");
 
 	if (!currentContainer) {
-		RS_DEBUG->print("RS_FilterDXF::addRay: currentContainer is nullptr");
+		RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addRay: currentContainer is nullptr");
     }
 
 	RS_Line* entity = new RS_Line{currentContainer, {v1, v2}};
-    RS_DEBUG->print("RS_FilterDXF::addRay: set attributes");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addRay: set attributes");
     setEntityAttributes(entity, &data);
 
-    RS_DEBUG->print("RS_FilterDXF::addRay: add entity");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addRay: add entity");
 
 	if (currentContainer) currentContainer->addEntity(entity);
 
-    RS_DEBUG->print("RS_FilterDXF::addRay: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addRay: OK");
 }
 
 
@@ -410,26 +422,26 @@ void RS_FilterDXFRW::addRay(const DRW_Ray& data) {
  * Implementation of the method which handles line entities.
  */
 void RS_FilterDXFRW::addXline(const DRW_Xline& data) {
-    RS_DEBUG->print("RS_FilterDXF::addXline");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addXline");
 
     RS_Vector v1(data.basePoint.x, data.basePoint.y);
     RS_Vector v2(data.basePoint.x+data.secPoint.x, data.basePoint.y+data.secPoint.y);
 
-    RS_DEBUG->print("RS_FilterDXF::addXline: create line");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addXline: create line");
 
 	if (!currentContainer) {
-		RS_DEBUG->print("RS_FilterDXF::addXline: currentContainer is nullptr");
+		RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addXline: currentContainer is nullptr");
     }
 
 	RS_Line* entity = new RS_Line{currentContainer, {v1, v2}};
-    RS_DEBUG->print("RS_FilterDXF::addXline: set attributes");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addXline: set attributes");
     setEntityAttributes(entity, &data);
 
-    RS_DEBUG->print("RS_FilterDXF::addXline: add entity");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addXline: add entity");
 
 	if (currentContainer) currentContainer->addEntity(entity);
 
-    RS_DEBUG->print("RS_FilterDXF::addXline: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addXline: OK");
 }
 
 
@@ -438,7 +450,7 @@ void RS_FilterDXFRW::addXline(const DRW_Xline& data) {
  * Implementation of the method which handles circle entities.
  */
 void RS_FilterDXFRW::addCircle(const DRW_Circle& data) {
-    RS_DEBUG->print("RS_FilterDXF::addCircle");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addCircle");
 
 	RS_Vector v{data.basePoint.x, data.basePoint.y};
 	RS_Circle* entity = new RS_Circle(currentContainer, {v, data.radious});
@@ -456,7 +468,7 @@ void RS_FilterDXFRW::addCircle(const DRW_Circle& data) {
  * @param angle2 End angle in deg (!)
  */
 void RS_FilterDXFRW::addArc(const DRW_Arc& data) {
-    RS_DEBUG->print("RS_FilterDXF::addArc");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addArc");
     RS_Vector v(data.basePoint.x, data.basePoint.y);
     RS_ArcData d(v, data.radious,
                  data.staangle,
@@ -477,7 +489,7 @@ void RS_FilterDXFRW::addArc(const DRW_Arc& data) {
  * @param angle2 End angle in rad (!)
  */
 void RS_FilterDXFRW::addEllipse(const DRW_Ellipse& data) {
-    RS_DEBUG->print("RS_FilterDXFRW::addEllipse");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addEllipse");
 
 	RS_Vector v1(data.basePoint.x, data.basePoint.y);
 	RS_Vector v2(data.secPoint.x, data.secPoint.y);
@@ -524,7 +536,7 @@ void RS_FilterDXFRW::addSolid(const DRW_Solid& data) {
  * Implementation of the method which handles lightweight polyline entities.
  */
 void RS_FilterDXFRW::addLWPolyline(const DRW_LWPolyline& data) {
-    RS_DEBUG->print("RS_FilterDXFRW::addLWPolyline");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addLWPolyline");
     if (data.vertlist.empty())
         return;
     RS_PolylineData d(RS_Vector{},
@@ -547,7 +559,7 @@ void RS_FilterDXFRW::addLWPolyline(const DRW_LWPolyline& data) {
  * Implementation of the method which handles polyline entities.
  */
 void RS_FilterDXFRW::addPolyline(const DRW_Polyline& data) {
-    RS_DEBUG->print("RS_FilterDXFRW::addPolyline");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addPolyline");
     if ( data.flags&0x10)
         return; //the polyline is a polygon mesh, not handled
 
@@ -577,7 +589,7 @@ void RS_FilterDXFRW::addPolyline(const DRW_Polyline& data) {
  * Implementation of the method which handles splines.
  */
 void RS_FilterDXFRW::addSpline(const DRW_Spline* data) {
-    RS_DEBUG->print("RS_FilterDXFRW::addSpline: degree: %d", data->degree);
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addSpline: degree: %d", data->degree);
 
 	if(data->degree == 2)
 	{
@@ -605,7 +617,7 @@ void RS_FilterDXFRW::addSpline(const DRW_Spline* data) {
 
         currentContainer->addEntity(spline);
     } else {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "RS_FilterDXF::addSpline: Invalid degree for spline: %d. "
                         "Accepted values are 1..3.", data->degree);
         return;
@@ -627,7 +639,7 @@ void RS_FilterDXFRW::addSpline(const DRW_Spline* data) {
  */
 void RS_FilterDXFRW::addInsert(const DRW_Insert& data) {
 
-    RS_DEBUG->print("RS_FilterDXF::addInsert");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addInsert");
 
     RS_Vector ip(data.basePoint.x, data.basePoint.y);
     RS_Vector sc(data.xscale, data.yscale);
@@ -641,7 +653,7 @@ void RS_FilterDXFRW::addInsert(const DRW_Insert& data) {
 					sp, nullptr, RS2::NoUpdate);
     RS_Insert* entity = new RS_Insert(currentContainer, d);
     setEntityAttributes(entity, &data);
-    RS_DEBUG->print("  id: %d", entity->getId());
+    RS_DEBUG_PRINT_DEBUG("  id: %d", entity->getId());
 //    entity->update();
     currentContainer->addEntity(entity);
 }
@@ -653,7 +665,7 @@ void RS_FilterDXFRW::addInsert(const DRW_Insert& data) {
  * multi texts (MTEXT).
  */
 void RS_FilterDXFRW::addMText(const DRW_MText& data) {
-    RS_DEBUG->print("RS_FilterDXF::addMText: %s", data.text.c_str());
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addMText: %s", data.text.c_str());
 
     RS_MTextData::VAlign valign;
     RS_MTextData::HAlign halign;
@@ -705,7 +717,7 @@ void RS_FilterDXFRW::addMText(const DRW_MText& data) {
         sty = fontList.value(sty, sty);
     }
 
-    RS_DEBUG->print("Text as unicode:");
+    RS_DEBUG_PRINT_DEBUG("Text as unicode:");
     RS_DEBUG->printUnicode(mtext);
     double interlin = data.interlin;
     double angle = data.angle*M_PI/180.;
@@ -752,7 +764,7 @@ void RS_FilterDXFRW::addMText(const DRW_MText& data) {
  * texts (TEXT).
  */
 void RS_FilterDXFRW::addText(const DRW_Text& data) {
-    RS_DEBUG->print("RS_FilterDXFRW::addText");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addText");
     RS_Vector refPoint = RS_Vector(data.basePoint.x, data.basePoint.y);;
     RS_Vector secPoint = RS_Vector(data.secPoint.x, data.secPoint.y);;
     double angle = data.angle;
@@ -791,7 +803,7 @@ void RS_FilterDXFRW::addText(const DRW_Text& data) {
         sty = fontList.value(sty, sty);
     }
 
-    RS_DEBUG->print("Text as unicode:");
+    RS_DEBUG_PRINT_DEBUG("Text as unicode:");
     RS_DEBUG->printUnicode(mtext);
 
     RS_TextData d(refPoint, secPoint, data.height, data.widthscale,
@@ -859,7 +871,7 @@ RS_DimensionData RS_FilterDXFRW::convDimensionData(const  DRW_Dimension* data) {
         sty = dimStyle;
     }
 
-    RS_DEBUG->print("Text as unicode:");
+    RS_DEBUG_PRINT_DEBUG("Text as unicode:");
     RS_DEBUG->printUnicode(t);
 
     // data needed to add the actual dimension entity
@@ -877,7 +889,7 @@ RS_DimensionData RS_FilterDXFRW::convDimensionData(const  DRW_Dimension* data) {
  * aligned dimensions (DIMENSION).
  */
 void RS_FilterDXFRW::addDimAlign(const DRW_DimAligned *data) {
-    RS_DEBUG->print("RS_FilterDXFRW::addDimAligned");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addDimAligned");
 
     RS_DimensionData dimensionData = convDimensionData((DRW_Dimension*)data);
 
@@ -890,7 +902,7 @@ void RS_FilterDXFRW::addDimAlign(const DRW_DimAligned *data) {
                             dimensionData, d);
     setEntityAttributes(entity, data);
     entity->updateDimPoint();
-    entity->update();
+    entity->invalidateDim();
     currentContainer->addEntity(entity);
 }
 
@@ -901,7 +913,7 @@ void RS_FilterDXFRW::addDimAlign(const DRW_DimAligned *data) {
  * linear dimensions (DIMENSION).
  */
 void RS_FilterDXFRW::addDimLinear(const DRW_DimLinear *data) {
-    RS_DEBUG->print("RS_FilterDXFRW::addDimLinear");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addDimLinear");
 
     RS_DimensionData dimensionData = convDimensionData((DRW_Dimension*)data);
 
@@ -914,7 +926,7 @@ void RS_FilterDXFRW::addDimLinear(const DRW_DimLinear *data) {
     RS_DimLinear* entity = new RS_DimLinear(currentContainer,
                                             dimensionData, d);
     setEntityAttributes(entity, data);
-    entity->update();
+    entity->invalidateDim();
     currentContainer->addEntity(entity);
 }
 
@@ -925,7 +937,7 @@ void RS_FilterDXFRW::addDimLinear(const DRW_DimLinear *data) {
  * radial dimensions (DIMENSION).
  */
 void RS_FilterDXFRW::addDimRadial(const DRW_DimRadial* data) {
-    RS_DEBUG->print("RS_FilterDXFRW::addDimRadial");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addDimRadial");
 
     RS_DimensionData dimensionData = convDimensionData((DRW_Dimension*)data);
     RS_Vector dp(data->getDiameterPoint().x, data->getDiameterPoint().y);
@@ -936,7 +948,7 @@ void RS_FilterDXFRW::addDimRadial(const DRW_DimRadial* data) {
                                             dimensionData, d);
 
     setEntityAttributes(entity, data);
-    entity->update();
+    entity->invalidateDim();
     currentContainer->addEntity(entity);
 }
 
@@ -947,7 +959,7 @@ void RS_FilterDXFRW::addDimRadial(const DRW_DimRadial* data) {
  * diametric dimensions (DIMENSION).
  */
 void RS_FilterDXFRW::addDimDiametric(const DRW_DimDiametric* data) {
-    RS_DEBUG->print("RS_FilterDXFRW::addDimDiametric");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addDimDiametric");
 
     RS_DimensionData dimensionData = convDimensionData((DRW_Dimension*)data);
     RS_Vector dp(data->getDiameter1Point().x, data->getDiameter1Point().y);
@@ -958,7 +970,7 @@ void RS_FilterDXFRW::addDimDiametric(const DRW_DimDiametric* data) {
                               dimensionData, d);
 
     setEntityAttributes(entity, data);
-    entity->update();
+    entity->invalidateDim();
     currentContainer->addEntity(entity);
 }
 
@@ -969,7 +981,7 @@ void RS_FilterDXFRW::addDimDiametric(const DRW_DimDiametric* data) {
  * angular dimensions (DIMENSION).
  */
 void RS_FilterDXFRW::addDimAngular(const DRW_DimAngular* data) {
-    RS_DEBUG->print("RS_FilterDXFRW::addDimAngular");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addDimAngular");
 
     RS_DimensionData dimensionData = convDimensionData(data);
     RS_Vector dp1(data->getFirstLine1().x, data->getFirstLine1().y);
@@ -983,7 +995,7 @@ void RS_FilterDXFRW::addDimAngular(const DRW_DimAngular* data) {
                             dimensionData, d);
 
     setEntityAttributes(entity, data);
-    entity->update();
+    entity->invalidateDim();
     currentContainer->addEntity(entity);
 }
 
@@ -994,7 +1006,7 @@ void RS_FilterDXFRW::addDimAngular(const DRW_DimAngular* data) {
  * angular dimensions (DIMENSION).
  */
 void RS_FilterDXFRW::addDimAngular3P(const DRW_DimAngular3p* data) {
-    RS_DEBUG->print("RS_FilterDXFRW::addDimAngular3P");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addDimAngular3P");
 
     RS_DimensionData dimensionData = convDimensionData(data);
     RS_Vector dp1(data->getFirstLine().x, data->getFirstLine().y);
@@ -1009,14 +1021,14 @@ void RS_FilterDXFRW::addDimAngular3P(const DRW_DimAngular3p* data) {
                             dimensionData, d);
 
     setEntityAttributes(entity, data);
-    entity->update();
+    entity->invalidateDim();
     currentContainer->addEntity(entity);
 }
 
 
 
 void RS_FilterDXFRW::addDimOrdinate(const DRW_DimOrdinate* /*data*/) {
-    RS_DEBUG->print("RS_FilterDXFRW::addDimOrdinate(const DL_DimensionData&, const DL_DimOrdinateData&) not yet implemented");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addDimOrdinate(const DL_DimensionData&, const DL_DimOrdinateData&) not yet implemented");
 }
 
 
@@ -1024,7 +1036,7 @@ void RS_FilterDXFRW::addDimOrdinate(const DRW_DimOrdinate* /*data*/) {
  * Implementation of the method which handles leader entities.
  */
 void RS_FilterDXFRW::addLeader(const DRW_Leader *data) {
-    RS_DEBUG->print("RS_FilterDXFRW::addDimLeader");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::addDimLeader");
     RS_LeaderData d(data->arrow!=0);
     RS_Leader* leader = new RS_Leader(currentContainer, d);
     setEntityAttributes(leader, data);
@@ -1043,7 +1055,7 @@ void RS_FilterDXFRW::addLeader(const DRW_Leader *data) {
  * Implementation of the method which handles hatch entities.
  */
 void RS_FilterDXFRW::addHatch(const DRW_Hatch *data) {
-    RS_DEBUG->print("RS_FilterDXF::addHatch()");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addHatch()");
     RS_Hatch* hatch;
     RS_EntityContainer* hatchLoop;
 
@@ -1154,12 +1166,12 @@ void RS_FilterDXFRW::addHatch(const DRW_Hatch *data) {
 
     }
 
-    RS_DEBUG->print("hatch->update()");
+    RS_DEBUG_PRINT_DEBUG("hatch->update()");
     if (hatch->validate()) {
         hatch->update();
     } else {
         graphic->removeEntity(hatch);
-        RS_DEBUG->print(RS_Debug::D_ERROR,
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR,
                     "RS_FilterDXFRW::endEntity(): updating hatch failed: invalid hatch area");
     }
 }
@@ -1169,7 +1181,7 @@ void RS_FilterDXFRW::addHatch(const DRW_Hatch *data) {
  * Implementation of the method which handles image entities.
  */
 void RS_FilterDXFRW::addImage(const DRW_Image *data) {
-    RS_DEBUG->print("RS_FilterDXF::addImage");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addImage");
 
     RS_Vector ip(data->basePoint.x, data->basePoint.y);
     RS_Vector uv(data->secPoint.x, data->secPoint.y);
@@ -1191,7 +1203,7 @@ void RS_FilterDXFRW::addImage(const DRW_Image *data) {
  * Implementation of the method which links image entities to image files.
  */
 void RS_FilterDXFRW::linkImage(const DRW_ImageDef *data) {
-    RS_DEBUG->print("RS_FilterDXFRW::linkImage");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::linkImage");
 
     int handle = data->handle;
     QString sfile(QString::fromUtf8(data->name.c_str()));
@@ -1202,20 +1214,20 @@ void RS_FilterDXFRW::linkImage(const DRW_ImageDef *data) {
 
     // first: absolute path:
     if (!fiBitmap.exists()) {
-        RS_DEBUG->print("File %s doesn't exist.",
+        RS_DEBUG_PRINT_DEBUG("File %s doesn't exist.",
                         (const char*)QFile::encodeName(sfile));
         // try relative path:
         QString f1 = fiDxf.absolutePath() + "/" + sfile;
         if (QFileInfo(f1).exists()) {
             sfile = f1;
         } else {
-            RS_DEBUG->print("File %s doesn't exist.", (const char*)QFile::encodeName(f1));
+            RS_DEBUG_PRINT_DEBUG("File %s doesn't exist.", (const char*)QFile::encodeName(f1));
             // try drawing path:
             QString f2 = fiDxf.absolutePath() + "/" + fiBitmap.fileName();
             if (QFileInfo(f2).exists()) {
                 sfile = f2;
             } else {
-                RS_DEBUG->print("File %s doesn't exist.", (const char*)QFile::encodeName(f2));
+                RS_DEBUG_PRINT_DEBUG("File %s doesn't exist.", (const char*)QFile::encodeName(f2));
             }
         }
     }
@@ -1227,7 +1239,7 @@ void RS_FilterDXFRW::linkImage(const DRW_ImageDef *data) {
             RS_Image* img = (RS_Image*)e;
             if (img->getHandle()==handle) {
                 img->setFile(sfile);
-                RS_DEBUG->print("image found: %s", (const char*)QFile::encodeName(img->getFile()));
+                RS_DEBUG_PRINT_DEBUG("image found: %s", (const char*)QFile::encodeName(img->getFile()));
                 img->update();
             }
         }
@@ -1242,14 +1254,14 @@ void RS_FilterDXFRW::linkImage(const DRW_ImageDef *data) {
                 RS_Image* img = (RS_Image*)e;
                 if (img->getHandle()==handle) {
                     img->setFile(sfile);
-                    RS_DEBUG->print("image in block found: %s",
+                    RS_DEBUG_PRINT_DEBUG("image in block found: %s",
                                     (const char*)QFile::encodeName(img->getFile()));
                     img->update();
                 }
             }
         }
     }
-    RS_DEBUG->print("linking image: OK");
+    RS_DEBUG_PRINT_DEBUG("linking image: OK");
 }
 
 using std::map;
@@ -1338,9 +1350,9 @@ void RS_FilterDXFRW::addHeader(const DRW_Header* data){
  */
 bool RS_FilterDXFRW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatType type) {
 
-    RS_DEBUG->print("RS_FilterDXFDW::fileExport: exporting file '%s'...",
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFDW::fileExport: exporting file '%s'...",
                     (const char*)QFile::encodeName(file));
-    RS_DEBUG->print("RS_FilterDXFDW::fileExport: file type '%d'", (int)type);
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFDW::fileExport: file type '%d'", (int)type);
 
     this->graphic = &g;
 
@@ -1349,7 +1361,7 @@ bool RS_FilterDXFRW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatT
 
     QString path = QFileInfo(file).absolutePath();
     if (QFileInfo(path).isWritable()==false) {
-        RS_DEBUG->print("RS_FilterDXFRW::fileExport: can't write file: "
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::fileExport: can't write file: "
                         "no permission");
         return false;
     }
@@ -1378,32 +1390,35 @@ bool RS_FilterDXFRW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatT
         exactColor = true;
     }
 
+    // dimension blocks are written from the sub entities of dimensions:
+    graphic->validateAllDimensions();
+
     dxfW = new dxfRW(QFile::encodeName(file));
     bool success = dxfW->write(this, exportVersion, false); //ascii
 //    bool success = dxf->write(this, exportVersion, true); //binary
     delete dxfW;
 
     if (!success) {
-        RS_DEBUG->print("RS_FilterDXFDW::fileExport: can't write file");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFDW::fileExport: can't write file");
         return false;
     }
 /*RLZ pte*/
-/*    RS_DEBUG->print("writing tables...");
+/*    RS_DEBUG_PRINT_DEBUG("writing tables...");
     dw->sectionTables();
     // VPORT:
     dxf.writeVPort(*dw);
     dw->tableEnd();
 
     // VIEW:
-    RS_DEBUG->print("writing views...");
+    RS_DEBUG_PRINT_DEBUG("writing views...");
     dxf.writeView(*dw);
 
     // UCS:
-    RS_DEBUG->print("writing ucs...");
+    RS_DEBUG_PRINT_DEBUG("writing ucs...");
     dxf.writeUcs(*dw);
 
     // Appid:
-    RS_DEBUG->print("writing appid...");
+    RS_DEBUG_PRINT_DEBUG("writing appid...");
     dw->tableAppid(1);
     writeAppid(*dw, "ACAD");
     dw->tableEnd();
@@ -1476,7 +1491,7 @@ void RS_FilterDXFRW::writeBlockRecords(){
     for (unsigned i = 0; i < graphic->countBlocks(); i++) {
         blk = graphic->blockAt(i);
         if (!blk->isUndone()){
-            RS_DEBUG->print("writing block record: %s", (const char*)blk->getName().toLocal8Bit());
+            RS_DEBUG_PRINT_DEBUG("writing block record: %s", (const char*)blk->getName().toLocal8Bit());
             dxfW->writeBlockRecord(blk->getName().toUtf8().data());
         }
     }
@@ -1512,7 +1527,7 @@ void RS_FilterDXFRW::writeBlocks() {
     for (unsigned i = 0; i < graphic->countBlocks(); i++) {
         blk = graphic->blockAt(i);
         if (!blk->isUndone()) {
-            RS_DEBUG->print("writing block: %s", (const char*)blk->getName().toLocal8Bit());
+            RS_DEBUG_PRINT_DEBUG("writing block: %s", (const char*)blk->getName().toLocal8Bit());
 
             DRW_Block block;
             block.name = blk->getName().toUtf8().data();
@@ -1868,7 +1883,7 @@ void RS_FilterDXFRW::writeLayers(){
         if( l->isConstruction()) {
             lay.extData.push_back(new DRW_Variant(1001, "LibreCad"));
             lay.extData.push_back(new DRW_Variant(1070, 1));
-            RS_DEBUG->print(RS_Debug::D_WARNING, "RS_FilterDXF::writeLayers: layer %s saved as construction layer", lay.name.c_str());
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_FilterDXF::writeLayers: layer %s saved as construction layer", lay.name.c_str());
         }
         dxfW->writeLayer(&lay);
     }
@@ -2232,7 +2247,7 @@ void RS_FilterDXFRW::writePolyline(RS_Polyline* p) {
 void RS_FilterDXFRW::writeSpline(RS_Spline *s) {
 
     if (s->getNumberOfControlPoints() < s->getDegree()+1) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_FilterDXF::writeSpline: "
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_FilterDXF::writeSpline: "
                         "Discarding spline: not enough control points given.");
         return;
     }
@@ -2240,17 +2255,15 @@ void RS_FilterDXFRW::writeSpline(RS_Spline *s) {
     // version 12 do not support Spline write as polyline
     if (version==1009) {
         DRW_Polyline pol;
-        RS_Entity* e;
-        for (e=s->firstEntity(RS2::ResolveNone);
-             e; e=s->nextEntity(RS2::ResolveNone)) {
-            pol.addVertex( DRW_Vertex(e->getStartpoint().x,
-                                      e->getStartpoint().y, 0.0, 0.0));
+        std::vector<RS_Vector> const& points = s->getSegmentPoints();
+        // the last point of a closed spline is the first one again
+        size_t const count = s->isClosed() && !points.empty()
+                ? points.size() - 1 : points.size();
+        for (size_t i = 0; i < count; ++i) {
+            pol.addVertex( DRW_Vertex(points[i].x, points[i].y, 0.0, 0.0));
         }
         if (s->isClosed()) {
             pol.flags = 1;
-        } else {
-            pol.addVertex( DRW_Vertex(s->getEndpoint().x,
-                                      s->getEndpoint().y, 0.0, 0.0));
         }
         getEntityAttributes(&pol, s);
         dxfW->writePolyline(&pol);
@@ -2666,7 +2679,7 @@ void RS_FilterDXFRW::writeDimension(RS_Dimension* d) {
  */
 void RS_FilterDXFRW::writeLeader(RS_Leader* l) {
     if (l->count()<=0)
-        RS_DEBUG->print(RS_Debug::D_WARNING, "dropping leader with no vertices");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING, "dropping leader with no vertices");
 
     DRW_Leader leader;
     getEntityAttributes(&leader, l);
@@ -2734,7 +2747,7 @@ void RS_FilterDXFRW::writeHatch(RS_Hatch * h) {
     }
 
     if (!writeIt) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "RS_FilterDXF::writeHatch: Dropping Hatch");
         return;
     }
@@ -2951,7 +2964,7 @@ void RS_FilterDXFRW::writeImage(RS_Image * i) {
  */
 void RS_FilterDXFRW::setEntityAttributes(RS_Entity* entity,
                                        const DRW_Entity* attrib) {
-    RS_DEBUG->print("RS_FilterDXF::setEntityAttributes");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::setEntityAttributes");
 
     RS_Pen pen;
     pen.setColor(Qt::black);
@@ -2981,7 +2994,7 @@ void RS_FilterDXFRW::setEntityAttributes(RS_Entity* entity,
     pen.setWidth(numberToWidth(attrib->lWeight));
 
     entity->setPen(pen);
-    RS_DEBUG->print("RS_FilterDXF::setEntityAttributes: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::setEntityAttributes: OK");
 }
 
 
@@ -3059,7 +3072,7 @@ RS_Color RS_FilterDXFRW::numberToColor(int num) {
                             DRW::dxfColors[num][1],
                             DRW::dxfColors[num][2]);
         } else {
-            RS_DEBUG->print(RS_Debug::D_WARNING,
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                                 "RS_FilterDXF::numberToColor: Invalid color number given.");
             return RS_Color(RS2::FlagByLayer);
         }
@@ -3129,7 +3142,7 @@ int RS_FilterDXFRW::colorToNumber(const RS_Color& col, int *rgb) {
 }
 
 void RS_FilterDXFRW::add3dFace(const DRW_3Dface& data) {
-    RS_DEBUG->print("RS_FilterDXFRW::add3dFace");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::add3dFace");
     RS_PolylineData d(RS_Vector(false),
                       RS_Vector(false),
                       !data.invisibleflag);
@@ -3149,7 +3162,7 @@ void RS_FilterDXFRW::add3dFace(const DRW_3Dface& data) {
 }
 
 void RS_FilterDXFRW::addComment(const char*) {
-    RS_DEBUG->print("RS_FilterDXF::addComment(const char*) not yet implemented.");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addComment(const char*) not yet implemented.");
 }
 
 
@@ -3944,51 +3957,51 @@ void RS_FilterDXFRW::printDwgError(int le){
     switch (le) {
     case DRW::BAD_UNKNOWN:
         RS_DIALOGFACTORY->commandMessage(QObject::tr("unknown error opening dwg file"));
-        RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_UNKNOWN");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::printDwgError: DRW::BAD_UNKNOWN");
         break;
     case DRW::BAD_OPEN:
         RS_DIALOGFACTORY->commandMessage(QObject::tr("can't open this dwg file"));
-        RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_OPEN");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::printDwgError: DRW::BAD_OPEN");
         break;
     case DRW::BAD_VERSION:
         RS_DIALOGFACTORY->commandMessage(QObject::tr("unsupported dwg version"));
-        RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_VERSION");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::printDwgError: DRW::BAD_VERSION");
         break;
     case DRW::BAD_READ_METADATA:
         RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading file metadata in dwg file"));
-        RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_FILE_HEADER");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_FILE_HEADER");
         break;
     case DRW::BAD_READ_FILE_HEADER:
         RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading file header in dwg file"));
-        RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_FILE_HEADER");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_FILE_HEADER");
         break;
     case DRW::BAD_READ_HEADER:
         RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading header vars in dwg file"));
-        RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_HEADER");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_HEADER");
         break;
     case DRW::BAD_READ_CLASSES:
         RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading classes in dwg file"));
-        RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_CLASSES");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_CLASSES");
         break;
     case DRW::BAD_READ_HANDLES:
         RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading offsets in dwg file"));
-        RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_OFFSETS");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_OFFSETS");
         break;
     case DRW::BAD_READ_TABLES:
         RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading tables in dwg file"));
-        RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_TABLES");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_TABLES");
         break;
     case DRW::BAD_READ_BLOCKS:
         RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading blocks in dwg file"));
-        RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_OFFSETS");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_OFFSETS");
         break;
     case DRW::BAD_READ_ENTITIES:
         RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading entities in dwg file"));
-        RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_ENTITIES");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_ENTITIES");
         break;
     case DRW::BAD_READ_OBJECTS:
         RS_DIALOGFACTORY->commandMessage(QObject::tr("error reading objects in dwg file"));
-        RS_DEBUG->print("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_OBJECTS");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterDXFRW::printDwgError: DRW::BAD_READ_OBJECTS");
         break;
     default:
         break;
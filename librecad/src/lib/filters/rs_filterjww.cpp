@@ -63,7 +63,7 @@
 RS_FilterJWW::RS_FilterJWW()
                 :RS_FilterInterface() {
 
-        RS_DEBUG->print("RS_FilterJWW::RS_FilterJWW()");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::RS_FilterJWW()");
 
         mtext = "";
 		polyline = nullptr;
@@ -76,15 +76,15 @@ RS_FilterJWW::RS_FilterJWW()
 		splinePoints = nullptr;
         //exportVersion = DL_Codes::VER_2002;
         //systemVariables.setAutoDelete(true);
-        RS_DEBUG->print("RS_FilterJWW::RS_FilterJWW(): OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::RS_FilterJWW(): OK");
 }
 
 /**
  * Destructor.
  */
 RS_FilterJWW::~RS_FilterJWW() {
-        RS_DEBUG->print("RS_FilterJWW::~RS_FilterJWW()");
-        RS_DEBUG->print("RS_FilterJWW::~RS_FilterJWW(): OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::~RS_FilterJWW()");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::~RS_FilterJWW(): OK");
 }
 
 
@@ -98,44 +98,44 @@ RS_FilterJWW::~RS_FilterJWW() {
  * taken to be stored in a file.
  */
 bool RS_FilterJWW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/) {
-        RS_DEBUG->print("RS_FilterJWW::fileImport");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileImport");
         //RS_DEBUG->timestamp();
 
-        RS_DEBUG->print("JWW Filter: importing file '%s'...", (const char*)QFile::encodeName(file));
+        RS_DEBUG_PRINT_DEBUG("JWW Filter: importing file '%s'...", (const char*)QFile::encodeName(file));
 
         graphic = &g;
         currentContainer = graphic;
         this->file = file;
 
-        RS_DEBUG->print("graphic->countLayers(): %d", graphic->countLayers());
+        RS_DEBUG_PRINT_DEBUG("graphic->countLayers(): %d", graphic->countLayers());
 
         //graphic->setAutoUpdateBorders(false);
-        RS_DEBUG->print("RS_FilterJWW::fileImport: reading file");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileImport: reading file");
         bool success = jww.in((const char*)QFile::encodeName(file), this);
-        RS_DEBUG->print("RS_FilterJWW::fileImport: reading file: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileImport: reading file: OK");
         //graphic->setAutoUpdateBorders(true);
 
         if (success==false) {
-                RS_DEBUG->print(RS_Debug::D_WARNING,
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                                                 "Cannot open JWW file '%s'.", (const char*)QFile::encodeName(file));
                 return false;
         }
 
-        RS_DEBUG->print("RS_FilterJWW::fileImport: adding variables");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileImport: adding variables");
 
         // add some variables that need to be there for JWW drawings:
         if (graphic->getVariableString("$DIMSTYLE", "").isEmpty()) {
-                RS_DEBUG->print("RS_FilterJWW::fileImport: adding DIMSTYLE");
+                RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileImport: adding DIMSTYLE");
                 graphic->addVariable("$DIMSTYLE", "Standard", 2);
-                RS_DEBUG->print("RS_FilterJWW::fileImport: adding DIMSTYLE: OK");
+                RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileImport: adding DIMSTYLE: OK");
         }
-        RS_DEBUG->print("RS_FilterJWW::fileImport: adding variables: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileImport: adding variables: OK");
 
-        RS_DEBUG->print("RS_FilterJWW::fileImport: updating inserts");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileImport: updating inserts");
         graphic->updateInserts();
-        RS_DEBUG->print("RS_FilterJWW::fileImport: updating inserts: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileImport: updating inserts: OK");
 
-        RS_DEBUG->print("RS_FilterJWW::fileImport OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileImport OK");
         //RS_DEBUG->timestamp();
 
         return true;
@@ -147,18 +147,18 @@ bool RS_FilterJWW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatTyp
  * Implementation of the method which handles layers.
  */
 void RS_FilterJWW::addLayer(const DL_LayerData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addLayer");
-        RS_DEBUG->print("  adding layer: %s", data.name.c_str());
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLayer");
+        RS_DEBUG_PRINT_DEBUG("  adding layer: %s", data.name.c_str());
 
-        RS_DEBUG->print("RS_FilterJWW::addLayer: creating layer");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLayer: creating layer");
 ////////////////////2006/06/05
         RS_Layer* layer = new RS_Layer(toNativeString(data.name.c_str(),getDXFEncoding()));
 ////////////////////
-        RS_DEBUG->print("RS_FilterJWW::addLayer: set pen");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLayer: set pen");
         layer->setPen(attributesToPen(attributes));
         //layer->setFlags(data.flags&0x07);
 
-        RS_DEBUG->print("RS_FilterJWW::addLayer: flags");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLayer: flags");
         if (data.flags&0x01) {
                 layer->freeze(true);
         }
@@ -166,9 +166,9 @@ void RS_FilterJWW::addLayer(const DL_LayerData& data) {
                 layer->lock(true);
         }
 
-        RS_DEBUG->print("RS_FilterJWW::addLayer: add layer to graphic");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLayer: add layer to graphic");
         graphic->addLayer(layer);
-        RS_DEBUG->print("RS_FilterJWW::addLayer: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLayer: OK");
 }
 
 
@@ -180,9 +180,9 @@ void RS_FilterJWW::addLayer(const DL_LayerData& data) {
  */
 void RS_FilterJWW::addBlock(const DL_BlockData& data) {
 
-        RS_DEBUG->print("RS_FilterJWW::addBlock");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addBlock");
 
-        RS_DEBUG->print("  adding block: %s", data.name.c_str());
+        RS_DEBUG_PRINT_DEBUG("  adding block: %s", data.name.c_str());
 
 
         // Prevent special blocks (paper_space, model_space) from being added:
@@ -259,26 +259,26 @@ void RS_FilterJWW::addPoint(const DL_PointData& data) {
  * Implementation of the method which handles line entities.
  */
 void RS_FilterJWW::addLine(const DL_LineData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addLine");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLine");
 
         RS_Vector v1(data.x1, data.y1);
         RS_Vector v2(data.x2, data.y2);
 
-        RS_DEBUG->print("RS_FilterJWW::addLine: create line");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLine: create line");
 
 		if (!currentContainer) {
-				RS_DEBUG->print("RS_FilterJWW::addLine: currentContainer is nullptr");
+				RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLine: currentContainer is nullptr");
         }
 
 		RS_Line* entity = new RS_Line{currentContainer, {v1, v2}};
-        RS_DEBUG->print("RS_FilterJWW::addLine: set attributes");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLine: set attributes");
         setEntityAttributes(entity, attributes);
 
-        RS_DEBUG->print("RS_FilterJWW::addLine: add entity");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLine: add entity");
 
         currentContainer->addEntity(entity);
 
-        RS_DEBUG->print("RS_FilterJWW::addLine: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLine: OK");
 }
 
 
@@ -290,7 +290,7 @@ void RS_FilterJWW::addLine(const DL_LineData& data) {
  * @param angle2 End angle in deg (!)
  */
 void RS_FilterJWW::addArc(const DL_ArcData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addArc");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addArc");
         //printf("LINE	 (%12.6f, %12.6f, %12.6f) (%12.6f, %12.6f, %12.6f)\n",
         //	   p1[0], p1[1], p1[2],
         //	   p2[0], p2[1], p2[2]);
@@ -314,7 +314,7 @@ void RS_FilterJWW::addArc(const DL_ArcData& data) {
  * @param angle2 End angle in rad (!)
  */
 void RS_FilterJWW::addEllipse(const DL_EllipseData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addEllipse");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addEllipse");
 
 		RS_Vector v1{data.cx, data.cy};
 		RS_Vector v2{data.mx, data.my};
@@ -336,7 +336,7 @@ void RS_FilterJWW::addEllipse(const DL_EllipseData& data) {
  * Implementation of the method which handles circle entities.
  */
 void RS_FilterJWW::addCircle(const DL_CircleData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addCircle");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addCircle");
         //printf("LINE	 (%12.6f, %12.6f, %12.6f) (%12.6f, %12.6f, %12.6f)\n",
         //	   p1[0], p1[1], p1[2],
         //	   p2[0], p2[1], p2[2]);
@@ -353,7 +353,7 @@ void RS_FilterJWW::addCircle(const DL_CircleData& data) {
  * Implementation of the method which handles polyline entities.
  */
 void RS_FilterJWW::addPolyline(const DL_PolylineData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addPolyline");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addPolyline");
         //RS_DEBUG->print("RS_FilterJWW::addPolyline()");
         RS_PolylineData d(RS_Vector(false),
                                           RS_Vector(false),
@@ -370,7 +370,7 @@ void RS_FilterJWW::addPolyline(const DL_PolylineData& data) {
  * Implementation of the method which handles polyline vertices.
  */
 void RS_FilterJWW::addVertex(const DL_VertexData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addVertex(): %f/%f bulge: %f",
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addVertex(): %f/%f bulge: %f",
                                         data.x, data.y, data.bulge);
 
         RS_Vector v(data.x, data.y);
@@ -386,7 +386,7 @@ void RS_FilterJWW::addVertex(const DL_VertexData& data) {
  * Implementation of the method which handles splines.
  */
 void RS_FilterJWW::addSpline(const DL_SplineData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addSpline: degree: %d", data.degree);
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addSpline: degree: %d", data.degree);
 
 	if(data.degree == 2)
 	{
@@ -406,7 +406,7 @@ void RS_FilterJWW::addSpline(const DL_SplineData& data) {
                 currentContainer->addEntity(spline);
 				splinePoints = nullptr;
         } else {
-                RS_DEBUG->print(RS_Debug::D_WARNING,
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "RS_FilterJWW::addSpline: Invalid degree for spline: %d. "
                         "Accepted values are 1..3.", data.degree);
         }
@@ -417,7 +417,7 @@ void RS_FilterJWW::addSpline(const DL_SplineData& data) {
  * Implementation of the method which handles spline control points.
  */
 void RS_FilterJWW::addControlPoint(const DL_ControlPointData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addControlPoint: %f/%f", data.x, data.y);
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addControlPoint: %f/%f", data.x, data.y);
 
         RS_Vector v(data.x, data.y);
 
@@ -438,7 +438,7 @@ void RS_FilterJWW::addControlPoint(const DL_ControlPointData& data) {
  */
 void RS_FilterJWW::addInsert(const DL_InsertData& data) {
 
-        RS_DEBUG->print("RS_FilterJWW::addInsert");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addInsert");
 
         if (QString(data.name.c_str()).left(3)=="A$C") {
                 return;
@@ -458,7 +458,7 @@ void RS_FilterJWW::addInsert(const DL_InsertData& data) {
                                         RS2::NoUpdate);
         RS_Insert* entity = new RS_Insert(currentContainer, d);
         setEntityAttributes(entity, attributes);
-        RS_DEBUG->print("  id: %d", entity->getId());
+        RS_DEBUG_PRINT_DEBUG("  id: %d", entity->getId());
         //entity->update();
         currentContainer->addEntity(entity);
 }
@@ -474,7 +474,7 @@ void RS_FilterJWW::addInsert(const DL_InsertData& data) {
  * chunks for MText entities.
  */
 void RS_FilterJWW::addMTextChunk(const char* text) {
-    RS_DEBUG->print("RS_FilterJWW::addMTextChunk: %s", text);
+    RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addMTextChunk: %s", text);
     mtext+=text;
 }
 
@@ -504,7 +504,7 @@ QString RS_FilterJWW::getDXFEncoding() {
  * multi texts (MTEXT).
  */
 void RS_FilterJWW::addMText(const DL_MTextData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addMText: %s", data.text.c_str());
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addMText: %s", data.text.c_str());
 
         RS_Vector ip(data.ipx, data.ipy);
         RS_MTextData::VAlign valign;
@@ -557,7 +557,7 @@ void RS_FilterJWW::addMText(const DL_MTextData& data) {
                 }
         }
 
-        RS_DEBUG->print("Text as unicode:");
+        RS_DEBUG_PRINT_DEBUG("Text as unicode:");
         RS_DEBUG->printUnicode(mtext);
 
         RS_MTextData d(ip, data.height, data.width,
@@ -582,7 +582,7 @@ void RS_FilterJWW::addMText(const DL_MTextData& data) {
  * texts (TEXT).
  */
 void RS_FilterJWW::addText(const DL_TextData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addText");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addText");
         int attachmentPoint;
         RS_Vector refPoint;
         double angle = data.angle;
@@ -716,7 +716,7 @@ RS_DimensionData RS_FilterJWW::convDimensionData(
                 sty = variables.getString("$DIMSTYLE", "Standard");
         }
 
-        RS_DEBUG->print("Text as unicode:");
+        RS_DEBUG_PRINT_DEBUG("Text as unicode:");
         RS_DEBUG->printUnicode(t);
 
         // data needed to add the actual dimension entity
@@ -735,7 +735,7 @@ RS_DimensionData RS_FilterJWW::convDimensionData(
  */
 void RS_FilterJWW::addDimAlign(const DL_DimensionData& data,
                                                            const DL_DimAlignedData& edata) {
-        RS_DEBUG->print("RS_FilterJWW::addDimAligned");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addDimAligned");
 
         RS_DimensionData dimensionData = convDimensionData(data);
 
@@ -759,7 +759,7 @@ void RS_FilterJWW::addDimAlign(const DL_DimensionData& data,
  */
 void RS_FilterJWW::addDimLinear(const DL_DimensionData& data,
                                                                 const DL_DimLinearData& edata) {
-        RS_DEBUG->print("RS_FilterJWW::addDimLinear");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addDimLinear");
 
         RS_DimensionData dimensionData = convDimensionData(data);
 
@@ -784,7 +784,7 @@ void RS_FilterJWW::addDimLinear(const DL_DimensionData& data,
  */
 void RS_FilterJWW::addDimRadial(const DL_DimensionData& data,
                                                                 const DL_DimRadialData& edata) {
-        RS_DEBUG->print("RS_FilterJWW::addDimRadial");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addDimRadial");
 
         RS_DimensionData dimensionData = convDimensionData(data);
         RS_Vector dp(edata.dpx, edata.dpy);
@@ -807,7 +807,7 @@ void RS_FilterJWW::addDimRadial(const DL_DimensionData& data,
  */
 void RS_FilterJWW::addDimDiametric(const DL_DimensionData& data,
                                                                    const DL_DimDiametricData& edata) {
-        RS_DEBUG->print("RS_FilterJWW::addDimDiametric");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addDimDiametric");
 
         RS_DimensionData dimensionData = convDimensionData(data);
         RS_Vector dp(edata.dpx, edata.dpy);
@@ -830,7 +830,7 @@ void RS_FilterJWW::addDimDiametric(const DL_DimensionData& data,
  */
 void RS_FilterJWW::addDimAngular(const DL_DimensionData& data,
                                                                  const DL_DimAngularData& edata) {
-        RS_DEBUG->print("RS_FilterJWW::addDimAngular");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addDimAngular");
 
         RS_DimensionData dimensionData = convDimensionData(data);
         RS_Vector dp1(edata.dpx1, edata.dpy1);
@@ -856,7 +856,7 @@ void RS_FilterJWW::addDimAngular(const DL_DimensionData& data,
  */
 void RS_FilterJWW::addDimAngular3P(const DL_DimensionData& data,
                                                                    const DL_DimAngular3PData& edata) {
-        RS_DEBUG->print("RS_FilterJWW::addDimAngular3P");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addDimAngular3P");
 
         RS_DimensionData dimensionData = convDimensionData(data);
         RS_Vector dp1(edata.dpx3, edata.dpy3);
@@ -881,7 +881,7 @@ void RS_FilterJWW::addDimAngular3P(const DL_DimensionData& data,
  * Implementation of the method which handles leader entities.
  */
 void RS_FilterJWW::addLeader(const DL_LeaderData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addDimLeader");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addDimLeader");
         //RS_DEBUG->print("RS_FilterJWW::addPolyline()");
         RS_LeaderData d(data.arrowHeadFlag==1);
         leader = new RS_Leader(currentContainer, d);
@@ -896,7 +896,7 @@ void RS_FilterJWW::addLeader(const DL_LeaderData& data) {
  * Implementation of the method which handles leader vertices.
  */
 void RS_FilterJWW::addLeaderVertex(const DL_LeaderVertexData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addLeaderVertex");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addLeaderVertex");
         //RS_DEBUG->print("RS_FilterJWW::addVertex() bulge: %f", bulge);
 
         RS_Vector v(data.x, data.y);
@@ -912,7 +912,7 @@ void RS_FilterJWW::addLeaderVertex(const DL_LeaderVertexData& data) {
  * Implementation of the method which handles hatch entities.
  */
 void RS_FilterJWW::addHatch(const DL_HatchData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addHatch()");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addHatch()");
 
         hatch = new RS_Hatch(currentContainer,
                                                  RS_HatchData(data.solid,
@@ -930,7 +930,7 @@ void RS_FilterJWW::addHatch(const DL_HatchData& data) {
  * Implementation of the method which handles hatch loops.
  */
 void RS_FilterJWW::addHatchLoop(const DL_HatchLoopData& /*data*/) {
-        RS_DEBUG->print("RS_FilterJWW::addHatchLoop()");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addHatchLoop()");
         if (hatch) {
                 hatchLoop = new RS_EntityContainer(hatch);
 				hatchLoop->setLayer(nullptr);
@@ -944,13 +944,13 @@ void RS_FilterJWW::addHatchLoop(const DL_HatchLoopData& /*data*/) {
  * Implementation of the method which handles hatch edge entities.
  */
 void RS_FilterJWW::addHatchEdge(const DL_HatchEdgeData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addHatchEdge()");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addHatchEdge()");
 
         if (hatchLoop) {
 				RS_Entity* e = nullptr;
                 switch (data.type) {
                 case 1:
-                        RS_DEBUG->print("RS_FilterJWW::addHatchEdge(): "
+                        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addHatchEdge(): "
                                                         "line: %f,%f %f,%f",
                                                         data.x1, data.y1, data.x2, data.y2);
 						e = new RS_Line{hatchLoop, {{data.x1, data.y1},
@@ -997,7 +997,7 @@ void RS_FilterJWW::addHatchEdge(const DL_HatchEdgeData& data) {
  * Implementation of the method which handles image entities.
  */
 void RS_FilterJWW::addImage(const DL_ImageData& data) {
-        RS_DEBUG->print("RS_FilterJWW::addImage");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::addImage");
 
         RS_Vector ip(data.ipx, data.ipy);
         RS_Vector uv(data.ux, data.uy);
@@ -1025,7 +1025,7 @@ void RS_FilterJWW::addImage(const DL_ImageData& data) {
  * Implementation of the method which links image entities to image files.
  */
 void RS_FilterJWW::linkImage(const DL_ImageDefData& data) {
-        RS_DEBUG->print("RS_FilterJWW::linkImage");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::linkImage");
 
 		int handle = QString(data.ref.c_str()).toInt(nullptr, 16);
         QString sfile(data.file.c_str());
@@ -1036,20 +1036,20 @@ void RS_FilterJWW::linkImage(const DL_ImageDefData& data) {
 
         // first: absolute path:
         if (!fiBitmap.exists()) {
-                RS_DEBUG->print("File %s doesn't exist.",
+                RS_DEBUG_PRINT_DEBUG("File %s doesn't exist.",
                                                 (const char*)QFile::encodeName(sfile));
                 // try relative path:
                 QString f1 = fiDxf.path() + "/" + sfile;
                 if (QFileInfo(f1).exists()) {
                         sfile = f1;
                 } else {
-                        RS_DEBUG->print("File %s doesn't exist.", (const char*)QFile::encodeName(f1));
+                        RS_DEBUG_PRINT_DEBUG("File %s doesn't exist.", (const char*)QFile::encodeName(f1));
                         // try drawing path:
                         QString f2 = fiDxf.path() + "/" + fiBitmap.fileName();
                         if (QFileInfo(f2).exists()) {
                                 sfile = f2;
                         } else {
-                                RS_DEBUG->print("File %s doesn't exist.", (const char*)QFile::encodeName(f2));
+                                RS_DEBUG_PRINT_DEBUG("File %s doesn't exist.", (const char*)QFile::encodeName(f2));
                         }
                 }
         }
@@ -1061,7 +1061,7 @@ void RS_FilterJWW::linkImage(const DL_ImageDefData& data) {
                         RS_Image* img = (RS_Image*)e;
                         if (img->getHandle()==handle) {
                                 img->setFile(sfile);
-                                RS_DEBUG->print("image found: %s", (const char*)QFile::encodeName(img->getFile()));
+                                RS_DEBUG_PRINT_DEBUG("image found: %s", (const char*)QFile::encodeName(img->getFile()));
                                 img->update();
                         }
                 }
@@ -1076,14 +1076,14 @@ void RS_FilterJWW::linkImage(const DL_ImageDefData& data) {
                                 RS_Image* img = (RS_Image*)e;
                                 if (img->getHandle()==handle) {
                                         img->setFile(sfile);
-                                        RS_DEBUG->print("image in block found: %s",
+                                        RS_DEBUG_PRINT_DEBUG("image in block found: %s",
                                                                         (const char*)QFile::encodeName(img->getFile()));
                                         img->update();
                                 }
                         }
                 }
         }
-        RS_DEBUG->print("linking image: OK");
+        RS_DEBUG_PRINT_DEBUG("linking image: OK");
 }
 
 
@@ -1092,17 +1092,17 @@ void RS_FilterJWW::linkImage(const DL_ImageDefData& data) {
  * Finishes a hatch entity.
  */
 void RS_FilterJWW::endEntity() {
-        RS_DEBUG->print("RS_FilterJWW::endEntity");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::endEntity");
 
         if (hatch) {
 
-                RS_DEBUG->print("hatch->update()");
+                RS_DEBUG_PRINT_DEBUG("hatch->update()");
 
                 if (hatch->validate()) {
                         hatch->update();
                 } else {
                         graphic->removeEntity(hatch);
-                        RS_DEBUG->print(RS_Debug::D_ERROR,
+                        RS_DEBUG_PRINT(RS_Debug::D_ERROR,
                                                         "RS_FilterJWW::endEntity(): updating hatch failed: invalid hatch area");
                 }
 				hatch=nullptr;
@@ -1110,13 +1110,13 @@ void RS_FilterJWW::endEntity() {
 }
 
 void RS_FilterJWW::add3dFace(const DL_3dFaceData& /*data*/) {
-    RS_DEBUG->print("RS_FilterDXF::add3dFace(const DL_3dFaceData& data) not yet implemented");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::add3dFace(const DL_3dFaceData& data) not yet implemented");
 }
 void RS_FilterJWW::addDimOrdinate(const DL_DimensionData&, const DL_DimOrdinateData&) {
-    RS_DEBUG->print("RS_FilterDXF::addDimOrdinate(const DL_DimensionData&, const DL_DimOrdinateData&) not yet implemented");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addDimOrdinate(const DL_DimensionData&, const DL_DimOrdinateData&) not yet implemented");
 }
 void RS_FilterJWW::addComment(const char*) {
-    RS_DEBUG->print("RS_FilterDXF::addComment(const char*) not yet implemented.");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::addComment(const char*) not yet implemented.");
 }
 
 /**
@@ -1124,7 +1124,7 @@ void RS_FilterJWW::addComment(const char*) {
  */
 void RS_FilterJWW::setVariableVector(const char* key,
                                                                          double v1, double v2, double v3, int code) {
-        RS_DEBUG->print("RS_FilterJWW::setVariableVector");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::setVariableVector");
 
         // update document's variable list:
         if (currentContainer->rtti()==RS2::EntityGraphic) {
@@ -1140,7 +1140,7 @@ void RS_FilterJWW::setVariableVector(const char* key,
  */
 void RS_FilterJWW::setVariableString(const char* key,
                                                                          const char* value, int code) {
-        RS_DEBUG->print("RS_FilterJWW::setVariableString");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::setVariableString");
 
         // update local JWW variable list:
         variables.add(QString(key), QString(value), code);
@@ -1158,7 +1158,7 @@ void RS_FilterJWW::setVariableString(const char* key,
  * Sets an int variable from the JWW file.
  */
 void RS_FilterJWW::setVariableInt(const char* key, int value, int code) {
-        RS_DEBUG->print("RS_FilterJWW::setVariableInt");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::setVariableInt");
 
         // update document's variable list:
         if (currentContainer->rtti()==RS2::EntityGraphic) {
@@ -1173,7 +1173,7 @@ void RS_FilterJWW::setVariableInt(const char* key, int value, int code) {
  * Sets a double variable from the JWW file.
  */
 void RS_FilterJWW::setVariableDouble(const char* key, double value, int code) {
-        RS_DEBUG->print("RS_FilterJWW::setVariableDouble");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::setVariableDouble");
 
         // update document's variable list:
         if (currentContainer->rtti()==RS2::EntityGraphic) {
@@ -1193,9 +1193,9 @@ void RS_FilterJWW::setVariableDouble(const char* key, double value, int code) {
  */
 bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatType type) {
 
-        RS_DEBUG->print("RS_FilterJWW::fileExport: exporting file '%s'...",
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileExport: exporting file '%s'...",
                                         (const char*)QFile::encodeName(file));
-        RS_DEBUG->print("RS_FilterJWW::fileExport: file type '%d'", (int)type);
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileExport: file type '%d'", (int)type);
 
         this->graphic = &g;
 
@@ -1204,7 +1204,7 @@ bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
 
         QString path = QFileInfo(file).path();
         if (QFileInfo(path).isWritable()==false) {
-                RS_DEBUG->print("RS_FilterJWW::fileExport: can't write file: "
+                RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileExport: can't write file: "
                                                 "no permission");
                 return false;
         }
@@ -1219,31 +1219,34 @@ bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
                 exportVersion = DL_Codes::AC1015;
         }
 
+        // dimensions are written from their sub entities:
+        graphic->validateAllDimensions();
+
         //DL_WriterA* dw = jww.out(file, VER_R12);
         DL_WriterA* dw = jww.out((const char*)QFile::encodeName(file), exportVersion);
 
 		if (!dw) {
-                RS_DEBUG->print("RS_FilterJWW::fileExport: can't write file");
+                RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileExport: can't write file");
                 return false;
         }
 
         // Header
-        RS_DEBUG->print("writing headers...");
+        RS_DEBUG_PRINT_DEBUG("writing headers...");
         jww.writeHeader(*dw);
 
         // Variables
-        RS_DEBUG->print("writing variables...");
+        RS_DEBUG_PRINT_DEBUG("writing variables...");
         writeVariables(*dw);
 
         // Section TABLES
-        RS_DEBUG->print("writing tables...");
+        RS_DEBUG_PRINT_DEBUG("writing tables...");
         dw->sectionTables();
 
         // VPORT:
         jww.writeVPort(*dw);
 
         // Line types:
-        RS_DEBUG->print("writing line types...");
+        RS_DEBUG_PRINT_DEBUG("writing line types...");
         int numLT = (int)RS2::BorderLineX2-(int)RS2::LineByBlock;
         if (type==RS2::FormatJWC) {
                 numLT-=2;
@@ -1257,7 +1260,7 @@ bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
         dw->tableEnd();
 
         // Layers:
-        RS_DEBUG->print("writing layers...");
+        RS_DEBUG_PRINT_DEBUG("writing layers...");
         dw->tableLayers(graphic->countLayers());
         for (unsigned i=0; i<graphic->countLayers(); ++i) {
                 RS_Layer* l = graphic->layerAt(i);
@@ -1266,25 +1269,25 @@ bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
         dw->tableEnd();
 
         // STYLE:
-        RS_DEBUG->print("writing styles...");
+        RS_DEBUG_PRINT_DEBUG("writing styles...");
         jww.writeStyle(*dw);
 
         // VIEW:
-        RS_DEBUG->print("writing views...");
+        RS_DEBUG_PRINT_DEBUG("writing views...");
         jww.writeView(*dw);
 
         // UCS:
-        RS_DEBUG->print("writing ucs...");
+        RS_DEBUG_PRINT_DEBUG("writing ucs...");
         jww.writeUcs(*dw);
 
         // Appid:
-        RS_DEBUG->print("writing appid...");
+        RS_DEBUG_PRINT_DEBUG("writing appid...");
         dw->tableAppid(1);
         writeAppid(*dw, "ACAD");
         dw->tableEnd();
 
         // DIMSTYLE:
-        RS_DEBUG->print("writing dim styles...");
+        RS_DEBUG_PRINT_DEBUG("writing dim styles...");
         jww.writeDimStyle(*dw,
                                           graphic->getVariableDouble("$DIMASZ", 2.5),
                                           graphic->getVariableDouble("$DIMEXE", 1.25),
@@ -1294,7 +1297,7 @@ bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
 
         // BLOCK_RECORD:
         if (type==RS2::FormatJWW) {
-                RS_DEBUG->print("writing block records...");
+                RS_DEBUG_PRINT_DEBUG("writing block records...");
                 jww.writeBlockRecord(*dw);
 
                 for (unsigned i=0; i<graphic->countBlocks(); ++i) {
@@ -1319,12 +1322,12 @@ bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
         }
 
         // end of tables:
-        RS_DEBUG->print("writing end of section TABLES...");
+        RS_DEBUG_PRINT_DEBUG("writing end of section TABLES...");
         dw->sectionEnd();
 
 
         // Section BLOCKS:
-        RS_DEBUG->print("writing blocks...");
+        RS_DEBUG_PRINT_DEBUG("writing blocks...");
         dw->sectionBlocks();
 
         if (type==RS2::FormatJWW) {
@@ -1354,7 +1357,7 @@ bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
 
 
         // Section ENTITIES:
-        RS_DEBUG->print("writing section ENTITIES...");
+        RS_DEBUG_PRINT_DEBUG("writing section ENTITIES...");
         dw->sectionEntities();
         for (RS_Entity* e=graphic->firstEntity(RS2::ResolveNone);
                         e;
@@ -1362,11 +1365,11 @@ bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
 
                 writeEntity(*dw, e);
         }
-        RS_DEBUG->print("writing end of section ENTITIES...");
+        RS_DEBUG_PRINT_DEBUG("writing end of section ENTITIES...");
         dw->sectionEnd();
 
         if (type==RS2::FormatJWW) {
-                RS_DEBUG->print("writing section OBJECTS...");
+                RS_DEBUG_PRINT_DEBUG("writing section OBJECTS...");
                 jww.writeObjects(*dw);
 
                 // IMAGEDEF's from images in entities and images in blocks
@@ -1398,22 +1401,22 @@ bool RS_FilterJWW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
                                 }
                         }
                 }
-                RS_DEBUG->print("writing end of section OBJECTS...");
+                RS_DEBUG_PRINT_DEBUG("writing end of section OBJECTS...");
                 jww.writeObjectsEnd(*dw);
         }
 
-        RS_DEBUG->print("writing EOF...");
+        RS_DEBUG_PRINT_DEBUG("writing EOF...");
         dw->dxfEOF();
 
 
-        RS_DEBUG->print("close..");
+        RS_DEBUG_PRINT_DEBUG("close..");
         dw->close();
 
         delete dw;
 
         // check if file was actually written (strange world of windoze xp):
         if (QFileInfo(file).exists()==false) {
-                RS_DEBUG->print("RS_FilterJWW::fileExport: file could not be written");
+                RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::fileExport: file could not be written");
                 return false;
         }
 
@@ -1492,12 +1495,12 @@ void RS_FilterJWW::writeVariables(DL_WriterA& dw) {
  */
 void RS_FilterJWW::writeLayer(DL_WriterA& dw, RS_Layer* l) {
 		if (!l) {
-                RS_DEBUG->print(RS_Debug::D_WARNING,
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_FilterJWW::writeLayer: layer is nullptr");
                 return;
         }
 
-        RS_DEBUG->print("RS_FilterJWW::writeLayer %s", l->getName().toLatin1().constData());
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::writeLayer %s", l->getName().toLatin1().constData());
 
         jww.writeLayer(
                 dw,
@@ -1509,7 +1512,7 @@ void RS_FilterJWW::writeLayer(DL_WriterA& dw, RS_Layer* l) {
                                           (const char*)lineTypeToName(
                                                   l->getPen().getLineType()).toLocal8Bit().data()));
 
-        RS_DEBUG->print("RS_FilterJWW::writeLayer end");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::writeLayer end");
 }
 
 
@@ -1541,12 +1544,12 @@ void RS_FilterJWW::writeAppid(DL_WriterA& dw, const char* appid) {
  */
 void RS_FilterJWW::writeBlock(DL_WriterA& dw, RS_Block* blk) {
 		if (!blk) {
-                RS_DEBUG->print(RS_Debug::D_WARNING,
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_FilterJWW::writeBlock: Block is nullptr");
                 return;
         }
 
-        RS_DEBUG->print("writing block: %s", (const char*)blk->getName().toLocal8Bit().data());
+        RS_DEBUG_PRINT_DEBUG("writing block: %s", (const char*)blk->getName().toLocal8Bit().data());
 
         jww.writeBlock(dw,
                                    DL_BlockData((const char*)blk->getName().toLocal8Bit().data(), 0,
@@ -1580,7 +1583,7 @@ void RS_FilterJWW::writeEntity(DL_WriterA& dw, RS_Entity* e,
 		if (!e || e->getFlag(RS2::FlagUndone)) {
                 return;
         }
-        RS_DEBUG->print("writing Entity");
+        RS_DEBUG_PRINT_DEBUG("writing Entity");
 
         switch (e->rtti()) {
         case RS2::EntityPoint:
@@ -1766,14 +1769,18 @@ void RS_FilterJWW::writeSpline(DL_WriterA& dw,
                                                            RS_Spline* s,
                                                            const DL_Attributes& attrib) {
 
-        // split spline into atomic entities for JWW R12:
+        // split spline into lines for JWW R12:
         if (jww.getVersion()==VER_R12) {
-                writeAtomicEntities(dw, s, attrib, RS2::ResolveNone);
+                std::vector<RS_Vector> const& points = s->getSegmentPoints();
+                for (size_t i = 1; i < points.size(); ++i) {
+                        RS_Line line{points[i - 1], points[i]};
+                        writeLine(dw, &line, attrib);
+                }
                 return;
         }
 
         if (s->getNumberOfControlPoints() < s->getDegree()+1) {
-                RS_DEBUG->print(RS_Debug::D_ERROR, "RS_FilterJWW::writeSpline: "
+                RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_FilterJWW::writeSpline: "
                                                 "Discarding spline: not enough control points given.");
                 return;
         }
@@ -2216,7 +2223,7 @@ void RS_FilterJWW::writeLeader(DL_WriterA& dw, RS_Leader* l,
                         }
                 }
         } else {
-                RS_DEBUG->print(RS_Debug::D_WARNING,
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "dropping leader with no vertices");
         }
 }
@@ -2249,7 +2256,7 @@ void RS_FilterJWW::writeHatch(DL_WriterA& dw, RS_Hatch* h,
         }
 
         if (!writeIt) {
-                RS_DEBUG->print(RS_Debug::D_WARNING,
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "RS_FilterJWW::writeHatch: Dropping Hatch");
         } else {
                 DL_HatchData data(h->countLoops(),
@@ -2471,7 +2478,7 @@ void RS_FilterJWW::writeImageDef(DL_WriterA& dw, RS_Image* i) {
  */
 void RS_FilterJWW::setEntityAttributes(RS_Entity* entity,
                                                                            const DL_Attributes& attrib) {
-        RS_DEBUG->print("RS_FilterJWW::setEntityAttributes");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::setEntityAttributes");
 
         RS_Pen pen;
         pen.setColor(Qt::black);
@@ -2513,7 +2520,7 @@ void RS_FilterJWW::setEntityAttributes(RS_Entity* entity,
         pen.setWidth(numberToWidth(attrib.getWidth()));
 
         entity->setPen(pen);
-        RS_DEBUG->print("RS_FilterJWW::setEntityAttributes: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterJWW::setEntityAttributes: OK");
 }
 
 
@@ -2645,7 +2652,7 @@ RS_Color RS_FilterJWW::numberToColor(int num, bool comp) {
                                                         (int)(dxfColors[num][1]*255),
                                                         (int)(dxfColors[num][2]*255));
                 } else {
-                        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                                 "RS_FilterJWW::numberToColor: Invalid color number given.");
                         return RS_Color(RS2::FlagByLayer);
                 }
@@ -3147,7 +3154,7 @@ QString RS_FilterJWW::toNativeString(const char* data, const QString& encoding)
     res = res.replace("}", "");
     res = res.replace("#curly#", "}");
 
-    RS_DEBUG->print("RS_FilterDXF::toNativeString:");
+    RS_DEBUG_PRINT_DEBUG("RS_FilterDXF::toNativeString:");
     RS_DEBUG->printUnicode(res);
     return res;
 }
@@ -46,7 +46,7 @@
  * Default constructor.
  */
 RS_FilterLFF::RS_FilterLFF() : RS_FilterInterface() {
-    RS_DEBUG->print("Setting up LFF filter...");
+    RS_DEBUG_PRINT_DEBUG("Setting up LFF filter...");
 }
 
 /**
@@ -58,7 +58,7 @@ RS_FilterLFF::RS_FilterLFF() : RS_FilterInterface() {
  * taken to be stored in a file.
  */
 bool RS_FilterLFF::fileImport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/) {
-    RS_DEBUG->print("LFF Filter: importing file '%s'...", file.toLatin1().data());
+    RS_DEBUG_PRINT_DEBUG("LFF Filter: importing file '%s'...", file.toLatin1().data());
 
     //this->graphic = &g;
     bool success = false;
@@ -69,7 +69,7 @@ bool RS_FilterLFF::fileImport(RS_Graphic& g, const QString& file, RS2::FormatTyp
     success = font.loadFont();
 
     if (success==false) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
                         "Cannot open LFF file '%s'.", file.toLatin1().data());
 		return false;
     }
@@ -130,8 +130,8 @@ QString clearZeros(double num, int prec){
  */
 bool RS_FilterLFF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/) {
 
-    RS_DEBUG->print("LFF Filter: exporting file '%s'...", file.toLatin1().data());
-    RS_DEBUG->print("RS_FilterLFF::fileExport: open");
+    RS_DEBUG_PRINT_DEBUG("LFF Filter: exporting file '%s'...", file.toLatin1().data());
+    RS_DEBUG_PRINT_DEBUG("RS_FilterLFF::fileExport: open");
 
     QFile f(file);
     QTextStream ts(&f);
@@ -139,9 +139,9 @@ bool RS_FilterLFF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
     if (f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
 
 
-        RS_DEBUG->print("RS_FilterLFF::fileExport: open: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterLFF::fileExport: open: OK");
 
-        RS_DEBUG->print("RS_FilterLFF::fileExport: header");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterLFF::fileExport: header");
 
         // header:
         ts << "# Format:            LibreCAD Font 1\n";
@@ -151,7 +151,7 @@ bool RS_FilterLFF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
         QString ns = g.getVariableString("Names", "");
         if (!ns.isEmpty()) {
             QStringList names = ns.split(',');
-            RS_DEBUG->print("002");
+            RS_DEBUG_PRINT_DEBUG("002");
             for (int i = 0; i < names.size(); ++i) {
                 ts << QString("# Name:              %1\n").arg(names.at(i));
             }
@@ -171,10 +171,10 @@ bool RS_FilterLFF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
         ts << QString("# Last modified:     %1\n").arg(dateline);
 
         QString sa = g.getVariableString("Authors", "");
-        RS_DEBUG->print("authors: %s", sa.toLocal8Bit().data());
+        RS_DEBUG_PRINT_DEBUG("authors: %s", sa.toLocal8Bit().data());
         if (!sa.isEmpty()) {
             QStringList authors = sa.split(',');
-            RS_DEBUG->print("count: %d", authors.count());
+            RS_DEBUG_PRINT_DEBUG("count: %d", authors.count());
 
             QString a;
             for (int i = 0; i < authors.size(); ++i) {
@@ -187,16 +187,16 @@ bool RS_FilterLFF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
         } else
             ts << "# License:           unknown\n";
 
-        RS_DEBUG->print("RS_FilterLFF::fileExport: header: OK");
+        RS_DEBUG_PRINT_DEBUG("RS_FilterLFF::fileExport: header: OK");
 
         // iterate through blocks (=letters of font)
         for (unsigned i=0; i<g.countBlocks(); ++i) {
             RS_Block* blk = g.blockAt(i);
 
-            RS_DEBUG->print("block: %d", i);
+            RS_DEBUG_PRINT_DEBUG("block: %d", i);
 
             if (blk && !blk->isUndone()) {
-                RS_DEBUG->print("002a: %s",
+                RS_DEBUG_PRINT_DEBUG("002a: %s",
                                 (blk->getName().toLocal8Bit().data()));
 
                 ts << QString("\n%1\n").arg(blk->getName());
@@ -262,11 +262,11 @@ bool RS_FilterLFF::fileExport(RS_Graphic& g, const QString& file, RS2::FormatTyp
             }
         }
         f.close();
-        RS_DEBUG->print("LFF Filter: exporting file: OK");
+        RS_DEBUG_PRINT_DEBUG("LFF Filter: exporting file: OK");
         return true;
     }
     else {
-        RS_DEBUG->print("LFF Filter: exporting file failed");
+        RS_DEBUG_PRINT_DEBUG("LFF Filter: exporting file failed");
     }
 
     return false;
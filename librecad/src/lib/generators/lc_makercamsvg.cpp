@@ -22,6 +22,7 @@
 **
 **********************************************************************/
 #include<cmath>
+#include <utility>
 #include "lc_makercamsvg.h"
 
 #include "lc_xmlwriterinterface.h"
@@ -61,6 +62,9 @@ namespace {
 const std::string NAMESPACE_URI_SVG = "http://www.w3.org/2000/svg";
 const std::string NAMESPACE_URI_LC = "http://www.librecad.org";
 const std::string NAMESPACE_URI_XLINK = "http://www.w3.org/1999/xlink";
+
+// Below the 8 decimals written, so merged ends look the same in the file.
+const double CONNECTION_TOLERANCE = 1.0e-9;
 }
 
 LC_MakerCamSVG::LC_MakerCamSVG(LC_XMLWriterInterface* xmlWriter,
@@ -71,7 +75,8 @@ LC_MakerCamSVG::LC_MakerCamSVG(LC_XMLWriterInterface* xmlWriter,
                                bool exportImages,
                                bool convertLineTypes,
                                double defaultElementWidth,
-                               double defaultDashLinePatternLength):
+                               double defaultDashLinePatternLength,
+                               bool mergeConnectedPaths):
   xmlWriter(xmlWriter)
   ,writeInvisibleLayers(writeInvisibleLayers)
   ,writeConstructionLayers(writeConstructionLayers)
@@ -81,6 +86,7 @@ LC_MakerCamSVG::LC_MakerCamSVG(LC_XMLWriterInterface* xmlWriter,
   ,convertLineTypes(convertLineTypes)
   ,defaultElementWidth(defaultElementWidth)
   ,defaultDashLinePatternLength(defaultDashLinePatternLength)
+  ,mergeConnectedPaths(mergeConnectedPaths)
 
   ,offset(0.,0.)
 {
@@ -91,7 +97,7 @@ bool LC_MakerCamSVG::generate(RS_Graphic* graphic) {
 
     write(graphic);
 
-    return true;
+    return xmlWriter->closeDocument();
 }
 
 std::string LC_MakerCamSVG::resultAsString() {
@@ -103,6 +109,8 @@ void LC_MakerCamSVG::write(RS_Graphic* graphic) {
 
     RS_DEBUG->print("RS_MakerCamSVG::write: Writing root node ...");
 
+    // dimensions are written from their sub entities:
+    graphic->validateDimensions();
     graphic->calculateBorders();
 
     min = graphic->getMin();
@@ -241,10 +249,92 @@ void LC_MakerCamSVG::writeEntities(RS_Document* document, RS_Layer* layer) {
 
             if (!(e->getFlag(RS2::FlagUndone))) {
 
-                writeEntity(e);
+                if (!mergeConnectedPaths || !appendToPath(e)) {
+
+                    writePath();
+                    writeEntity(e);
+                }
             }
         }
     }
+
+    writePath();
+}
+
+/**
+ * Appends a line or an arc to the pending path if it starts where the path
+ * ends, otherwise the pending path is written and a new one is started.
+ * Lines may be appended reversed, arcs only in their own direction.
+ *
+ * @return false if the entity can't be part of a path and has to be
+ *         written on its own
+ */
+bool LC_MakerCamSVG::appendToPath(RS_Entity* entity) {
+
+    bool isLine = entity->rtti() == RS2::EntityLine;
+
+    if (isLine) {
+
+        // baked dash/dot lines are paths of their own
+        if (convertLineTypes && RS2::SolidLine != entity->getPen().getLineType()) {
+            return false;
+        }
+    }
+    else if (entity->rtti() != RS2::EntityArc) {
+        return false;
+    }
+
+    RS_Vector startpoint = convertToSvg(entity->getStartpoint());
+    RS_Vector endpoint = convertToSvg(entity->getEndpoint());
+
+    if (!path.empty() && startpoint.distanceTo(pathEnd) > CONNECTION_TOLERANCE) {
+
+        if (isLine && endpoint.distanceTo(pathEnd) <= CONNECTION_TOLERANCE) {
+            std::swap(startpoint, endpoint);
+        }
+        else {
+            writePath();
+        }
+    }
+
+    if (path.empty()) {
+        path = svgPathMoveTo(startpoint);
+        pathStart = startpoint;
+    }
+
+    if (isLine) {
+        path += svgPathLineTo(endpoint);
+    }
+    else {
+        path += svgPathArc((RS_Arc*)entity);
+    }
+
+    pathEnd = endpoint;
+    pathSegments++;
+
+    return true;
+}
+
+void LC_MakerCamSVG::writePath() {
+
+    if (path.empty()) {
+        return;
+    }
+
+    RS_DEBUG->print("RS_MakerCamSVG::writePath: Writing %d connected entities as 'path'", pathSegments);
+
+    if (pathSegments > 1 && pathEnd.distanceTo(pathStart) <= CONNECTION_TOLERANCE) {
+        path += svgPathClose();
+    }
+
+    xmlWriter->addElement("path", NAMESPACE_URI_SVG);
+
+    xmlWriter->addAttribute("d", path);
+
+    xmlWriter->closeElement();
+
+    path.clear();
+    pathSegments = 0;
 }
 
 void LC_MakerCamSVG::writeEntity(RS_Entity* entity) {
@@ -774,9 +864,54 @@ std::vector<RS_Vector> LC_MakerCamSVG::calcQuadraticBezierPoints(const std::vect
     return bezier_points;
 }
 
+/**
+ * Same result as RS_Utility::doubleToString(value, 8), without the detour
+ * through QString. Numbers are formatted for every coordinate of the
+ * drawing, so this is worth doing by hand for all values which still fit
+ * into a long long with 8 decimals. Values right at a rounding tie of the
+ * 8th decimal may round the other way.
+ */
 std::string LC_MakerCamSVG::numXml(double value) {
 
-    return RS_Utility::doubleToString(value, 8).toStdString();
+    if (!(std::abs(value) < 9.0e10)) {
+        return RS_Utility::doubleToString(value, 8).toStdString();
+    }
+
+    long long scaled = std::llround(value * 1.0e8);
+    bool negative = scaled < 0;
+    unsigned long long integer = negative ? -scaled : scaled;
+    unsigned long long fraction = integer % 100000000ULL;
+    integer /= 100000000ULL;
+
+    // remove trailing zeros
+    int decimals = 8;
+    while (decimals > 0 && fraction % 10 == 0) {
+        fraction /= 10;
+        decimals--;
+    }
+
+    char buffer[32];
+    char* end = buffer + sizeof(buffer);
+    char* p = end;
+
+    if (decimals > 0) {
+        for (int i = 0; i < decimals; i++) {
+            *--p = '0' + fraction % 10;
+            fraction /= 10;
+        }
+        *--p = '.';
+    }
+
+    do {
+        *--p = '0' + integer % 10;
+        integer /= 10;
+    } while (integer > 0);
+
+    if (negative) {
+        *--p = '-';
+    }
+
+    return std::string(p, end);
 }
 
 std::string LC_MakerCamSVG::lengthXml(double value) const
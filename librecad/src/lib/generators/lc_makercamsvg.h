@@ -64,7 +64,8 @@ public:
                    bool exportImages = false,
                    bool convertLineTypes = false,
                    double defaultElementWidth = 1.0,
-                   double defaultDashLinePatternLength = 10.0);
+                   double defaultDashLinePatternLength = 10.0,
+                   bool mergeConnectedPaths = false);
 
 	~LC_MakerCamSVG() = default;
 
@@ -83,6 +84,9 @@ private:
     void writeEntities(RS_Document* document, RS_Layer* layer);
     void writeEntity(RS_Entity* entity);
 
+    bool appendToPath(RS_Entity* entity);
+    void writePath();
+
     void writeInsert(RS_Insert* insert);
     void writePoint(RS_Point* point);
     void writeLine(RS_Line* line);
@@ -137,6 +141,7 @@ private:
     bool convertLineTypes;
     double defaultElementWidth;
     double defaultDashLinePatternLength;
+    bool mergeConnectedPaths;
 
     RS_Vector min;
     RS_Vector max;
@@ -149,6 +154,14 @@ private:
      */
     double lengthFactor;
 
+    /**
+     * @brief path connected lines and arcs not yet written,
+     * used with mergeConnectedPaths
+     */
+    std::string path;
+    RS_Vector pathStart;
+    RS_Vector pathEnd;
+    int pathSegments {0};
 };
 
 #endif
@@ -38,6 +38,9 @@ public:
 
     virtual void closeElement() = 0;
 
+    /** Ends the document. @return false if writing it failed. */
+    virtual bool closeDocument() = 0;
+
     virtual std::string documentAsString() = 0;
 
 	LC_XMLWriterInterface() = default;
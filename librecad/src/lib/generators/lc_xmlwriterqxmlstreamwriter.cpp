@@ -21,6 +21,7 @@
 **
 **********************************************************************/
 
+#include <QFile>
 #include <QXmlStreamWriter>
 #include "lc_xmlwriterqxmlstreamwriter.h"
 
@@ -33,6 +34,16 @@ LC_XMLWriterQXmlStreamWriter::LC_XMLWriterQXmlStreamWriter():
 	xmlWriter->setCodec("UTF-8");
 }
 
+LC_XMLWriterQXmlStreamWriter::LC_XMLWriterQXmlStreamWriter(const QString& fileName):
+	file(new QFile(fileName))
+{
+	// the writer fails on a file which can't be opened, see closeDocument()
+	file->open(QIODevice::WriteOnly | QIODevice::Truncate);
+	xmlWriter.reset(new QXmlStreamWriter(file.get()));
+	xmlWriter->setAutoFormatting(true);
+	xmlWriter->setCodec("UTF-8");
+}
+
 LC_XMLWriterQXmlStreamWriter::~LC_XMLWriterQXmlStreamWriter() = default;
 
 void LC_XMLWriterQXmlStreamWriter::createRootElement(const std::string &name, const std::string &namespace_uri) {
@@ -57,8 +68,22 @@ void LC_XMLWriterQXmlStreamWriter::closeElement() {
     xmlWriter->writeEndElement();
 }
 
+bool LC_XMLWriterQXmlStreamWriter::closeDocument() {
+    if (!closed) {
+        xmlWriter->writeEndDocument();
+        closed = true;
+
+        if (file) {
+            writeOk = file->isOpen() && !xmlWriter->hasError() && file->flush();
+            file->close();
+        }
+    }
+
+    return writeOk;
+}
+
 std::string LC_XMLWriterQXmlStreamWriter::documentAsString() {
-    xmlWriter->writeEndDocument();
+    closeDocument();
 
     return xml.toStdString();
 }
@@ -28,11 +28,18 @@
 #include <memory>
 #include "lc_xmlwriterinterface.h"
 
+class QFile;
 class QXmlStreamWriter;
 
 class LC_XMLWriterQXmlStreamWriter : public LC_XMLWriterInterface {
 public:
+	/** Builds the document in memory, see documentAsString(). */
 	LC_XMLWriterQXmlStreamWriter();
+	/**
+	 * Streams the document to the file fileName through the buffer of QFile,
+	 * documentAsString() is empty then.
+	 */
+	explicit LC_XMLWriterQXmlStreamWriter(const QString& fileName);
 
 	~LC_XMLWriterQXmlStreamWriter();
 
@@ -46,13 +53,18 @@ public:
 
     void closeElement();
 
+    bool closeDocument();
+
     std::string documentAsString();
 
 private:
 
+	std::unique_ptr<QFile> file;
 	std::unique_ptr<QXmlStreamWriter> xmlWriter;
 
     QString xml;
+    bool closed = false;
+    bool writeOk = true;
 };
 
 #endif
@@ -50,17 +50,17 @@ RS_EventHandler::RS_EventHandler(QObject* parent) : QObject(parent)
  * Destructor.
  */
 RS_EventHandler::~RS_EventHandler() {
-    RS_DEBUG->print("RS_EventHandler::~RS_EventHandler");
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::~RS_EventHandler");
 	delete defaultAction;
 	defaultAction = nullptr;
 
-    RS_DEBUG->print("RS_EventHandler::~RS_EventHandler: Deleting all actions..");
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::~RS_EventHandler: Deleting all actions..");
     for(auto a: currentActions){
         delete a;
     }
     currentActions.clear();
-    RS_DEBUG->print("RS_EventHandler::~RS_EventHandler: Deleting all actions..: OK");
-    RS_DEBUG->print("RS_EventHandler::~RS_EventHandler: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::~RS_EventHandler: Deleting all actions..: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::~RS_EventHandler: OK");
 }
 
 
@@ -101,7 +101,7 @@ void RS_EventHandler::mousePressEvent(QMouseEvent* e) {
             defaultAction->mousePressEvent(e);
             e->accept();
         } else {
-            RS_DEBUG->print("currently no action defined");
+            RS_DEBUG_PRINT_DEBUG("currently no action defined");
             e->ignore();
         }
     }
@@ -116,7 +116,7 @@ void RS_EventHandler::mouseReleaseEvent(QMouseEvent* e) {
     if(hasAction()){
         //    if (actionIndex>=0 && currentActions[actionIndex] &&
         //            !currentActions[actionIndex]->isFinished()) {
-        RS_DEBUG->print("call action %s",
+        RS_DEBUG_PRINT_DEBUG("call action %s",
                         currentActions.last()->getName().toLatin1().data());
 
         currentActions.last()->mouseReleaseEvent(e);
@@ -223,7 +223,7 @@ void RS_EventHandler::keyReleaseEvent(QKeyEvent* e) {
  * Handles command line events.
  */
 void RS_EventHandler::commandEvent(RS_CommandEvent* e) {
-    RS_DEBUG->print("RS_EventHandler::commandEvent");
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::commandEvent");
     QString cmd = e->getCommand();
 
     if (coordinateInputEnabled) {
@@ -234,18 +234,18 @@ void RS_EventHandler::commandEvent(RS_CommandEvent* e) {
                 if (cmd.contains(',') && cmd.at(0)!='@') {
 
                     int commaPos = cmd.indexOf(',');
-                    RS_DEBUG->print("RS_EventHandler::commandEvent: 001");
+                    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::commandEvent: 001");
                     bool ok1, ok2;
-                    RS_DEBUG->print("RS_EventHandler::commandEvent: 002");
+                    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::commandEvent: 002");
                     double x = RS_Math::eval(cmd.left(commaPos), &ok1);
-                    RS_DEBUG->print("RS_EventHandler::commandEvent: 003a");
+                    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::commandEvent: 003a");
                     double y = RS_Math::eval(cmd.mid(commaPos+1), &ok2);
-                    RS_DEBUG->print("RS_EventHandler::commandEvent: 004");
+                    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::commandEvent: 004");
 
                     if (ok1 && ok2) {
-                        RS_DEBUG->print("RS_EventHandler::commandEvent: 005");
+                        RS_DEBUG_PRINT_DEBUG("RS_EventHandler::commandEvent: 005");
                         RS_CoordinateEvent ce(RS_Vector(x,y));
-                        RS_DEBUG->print("RS_EventHandler::commandEvent: 006");
+                        RS_DEBUG_PRINT_DEBUG("RS_EventHandler::commandEvent: 006");
 						currentActions.last()->coordinateEvent(&ce);
 					} else
 						RS_DIALOGFACTORY->commandMessage(
@@ -328,7 +328,7 @@ void RS_EventHandler::commandEvent(RS_CommandEvent* e) {
         }
     }
 
-    RS_DEBUG->print("RS_EventHandler::commandEvent: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::commandEvent: OK");
 }
 
 
@@ -392,7 +392,7 @@ void RS_EventHandler::setDefaultAction(RS_ActionInterface* action) {
  * Sets the current action.
  */
 void RS_EventHandler::setCurrentAction(RS_ActionInterface* action) {
-    RS_DEBUG->print("RS_EventHandler::setCurrentAction");
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::setCurrentAction");
     if (action==NULL) {
         return;
     }
@@ -432,26 +432,26 @@ void RS_EventHandler::setCurrentAction(RS_ActionInterface* action) {
 
     // Set current action:
     currentActions.push_back(action);
-    RS_DEBUG->print("RS_EventHandler::setCurrentAction: current action is: %s",
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::setCurrentAction: current action is: %s",
                     currentActions.last()->getName().toLatin1().data());
 
     // Initialisation of our new action:
-    RS_DEBUG->print("RS_EventHandler::setCurrentAction: init current action");
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::setCurrentAction: init current action");
     action->init();
     // ## new:
     if (action->isFinished()==false) {
-        RS_DEBUG->print("RS_EventHandler::setCurrentAction: show options");
+        RS_DEBUG_PRINT_DEBUG("RS_EventHandler::setCurrentAction: show options");
         currentActions.last()->showOptions();
-        RS_DEBUG->print("RS_EventHandler::setCurrentAction: set predecessor");
+        RS_DEBUG_PRINT_DEBUG("RS_EventHandler::setCurrentAction: set predecessor");
         action->setPredecessor(predecessor);
     }
 
-    RS_DEBUG->print("RS_EventHandler::setCurrentAction: cleaning up..");
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::setCurrentAction: cleaning up..");
     cleanUp();
 
-    RS_DEBUG->print("RS_EventHandler::setCurrentAction: debugging actions");
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::setCurrentAction: debugging actions");
     debugActions();
-    RS_DEBUG->print("RS_GraphicView::setCurrentAction: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_GraphicView::setCurrentAction: OK");
     if (q_action)
         q_action->setChecked(true);
 }
@@ -488,7 +488,7 @@ void RS_EventHandler::killSelectActions() {
  */
 void RS_EventHandler::killAllActions()
 {
-	RS_DEBUG->print(__FILE__ ": %s: line %d: begin\n", __func__, __LINE__);
+	RS_DEBUG_PRINT_DEBUG(__FILE__ ": %s: line %d: begin\n", __func__, __LINE__);
 
     if (q_action)
     {
@@ -504,7 +504,7 @@ void RS_EventHandler::killAllActions()
 		}
 	}
 
-	RS_DEBUG->print(__FILE__ ": %s: line %d: begin\n", __func__, __LINE__);
+	RS_DEBUG_PRINT_DEBUG(__FILE__ ": %s: line %d: begin\n", __func__, __LINE__);
 	defaultAction->init(0);
 }
 
@@ -536,7 +536,7 @@ bool RS_EventHandler::hasAction()
  * Garbage collector for actions.
  */
 void RS_EventHandler::cleanUp() {
-    RS_DEBUG->print("RS_EventHandler::cleanUp");
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::cleanUp");
 
     for (auto it=currentActions.begin(); it != currentActions.end();)
     {
@@ -557,7 +557,7 @@ void RS_EventHandler::cleanUp() {
             defaultAction->showOptions();
         }
     }
-    RS_DEBUG->print("RS_EventHandler::cleanUp: OK");
+    RS_DEBUG_PRINT_DEBUG("RS_EventHandler::cleanUp: OK");
 }
 
 
@@ -597,13 +597,13 @@ void RS_EventHandler::setSnapRestriction(RS2::SnapRestriction sr) {
 
 void RS_EventHandler::debugActions() const{
     //        std::cout<<"action queue size=:"<<currentActions.size()<<std::endl;
-    RS_DEBUG->print("---");
+    RS_DEBUG_PRINT_DEBUG("---");
     for(int i=0;i<currentActions.size();++i){
 
         if (i == currentActions.size() - 1 ) {
-            RS_DEBUG->print("Current");
+            RS_DEBUG_PRINT_DEBUG("Current");
         }
-        RS_DEBUG->print("Action %03d: %s [%s]",
+        RS_DEBUG_PRINT_DEBUG("Action %03d: %s [%s]",
                         i, currentActions.at(i)->getName().toLatin1().data(),
                         currentActions.at(i)->isFinished() ? "finished" : "active");
     }
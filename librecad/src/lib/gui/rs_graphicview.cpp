@@ -49,11 +49,54 @@
 #include "rs_layer.h"
 #include "rs_math.h"
 #include "rs_debug.h"
+#include "lc_trace.h"
 
 #ifdef EMU_C99
 #include "emu_c99.h"
 #endif
 
+namespace {
+/**
+ * @return name of the entity type in traces
+ */
+const char* traceName(RS2::EntityType t) {
+	switch (t) {
+	case RS2::EntityContainer: return "Container";
+	case RS2::EntityBlock: return "Block";
+	case RS2::EntityFontChar: return "FontChar";
+	case RS2::EntityInsert: return "Insert";
+	case RS2::EntityGraphic: return "Graphic";
+	case RS2::EntityPoint: return "Point";
+	case RS2::EntityLine: return "Line";
+	case RS2::EntityPolyline: return "Polyline";
+	case RS2::EntityVertex: return "Vertex";
+	case RS2::EntityArc: return "Arc";
+	case RS2::EntityCircle: return "Circle";
+	case RS2::EntityEllipse: return "Ellipse";
+	case RS2::EntityHyperbola: return "Hyperbola";
+	case RS2::EntitySolid: return "Solid";
+	case RS2::EntityConstructionLine: return "ConstructionLine";
+	case RS2::EntityMText: return "MText";
+	case RS2::EntityText: return "Text";
+	case RS2::EntityDimAligned: return "DimAligned";
+	case RS2::EntityDimLinear: return "DimLinear";
+	case RS2::EntityDimRadial: return "DimRadial";
+	case RS2::EntityDimDiametric: return "DimDiametric";
+	case RS2::EntityDimAngular: return "DimAngular";
+	case RS2::EntityDimLeader: return "DimLeader";
+	case RS2::EntityHatch: return "Hatch";
+	case RS2::EntityImage: return "Image";
+	case RS2::EntitySpline: return "Spline";
+	case RS2::EntitySplinePoints: return "SplinePoints";
+	case RS2::EntityOverlayBox: return "OverlayBox";
+	case RS2::EntityPreview: return "Preview";
+	case RS2::EntityPattern: return "Pattern";
+	case RS2::EntityOverlayLine: return "OverlayLine";
+	default: return "Unknown";
+	}
+}
+}
+
 /**
  * Constructor.
  */
@@ -250,11 +293,11 @@ RS_ActionInterface* RS_GraphicView::getCurrentAction() {
  * Sets the current action of the event handler.
  */
 void RS_GraphicView::setCurrentAction(RS_ActionInterface* action) {
-    RS_DEBUG->print("RS_GraphicView::setCurrentAction");
+    RS_DEBUG_PRINT_DEBUG("RS_GraphicView::setCurrentAction");
 	if (eventHandler) {
 		eventHandler->setCurrentAction(action);
 	}
-	RS_DEBUG->print("RS_GraphicView::setCurrentAction: OK");
+	RS_DEBUG_PRINT_DEBUG("RS_GraphicView::setCurrentAction: OK");
 }
 
 
@@ -338,7 +381,7 @@ void RS_GraphicView::disableCoordinateInput() {
 void RS_GraphicView::zoomIn(double f, const RS_Vector& center) {
 
 	if (f<1.0e-6) {
-		RS_DEBUG->print(RS_Debug::D_WARNING,
+		RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_GraphicView::zoomIn: invalid factor");
 		return;
 	}
@@ -396,7 +439,7 @@ void RS_GraphicView::zoomInY(double f) {
  */
 void RS_GraphicView::zoomOut(double f, const RS_Vector& center) {
 	if (f<1.0e-6) {
-		RS_DEBUG->print(RS_Debug::D_WARNING,
+		RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_GraphicView::zoomOut: invalid factor");
 		return;
 	}
@@ -410,7 +453,7 @@ void RS_GraphicView::zoomOut(double f, const RS_Vector& center) {
  */
 void RS_GraphicView::zoomOutX(double f) {
 	if (f<1.0e-6) {
-		RS_DEBUG->print(RS_Debug::D_WARNING,
+		RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_GraphicView::zoomOutX: invalid factor");
 		return;
 	}
@@ -429,7 +472,7 @@ void RS_GraphicView::zoomOutX(double f) {
  */
 void RS_GraphicView::zoomOutY(double f) {
 	if (f<1.0e-6) {
-		RS_DEBUG->print(RS_Debug::D_WARNING,
+		RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_GraphicView::zoomOutY: invalid factor");
 		return;
 	}
@@ -451,7 +494,7 @@ void RS_GraphicView::zoomOutY(double f) {
 #include <iostream>
 void RS_GraphicView::zoomAuto(bool axis, bool keepAspectRatio) {
 
-	RS_DEBUG->print("RS_GraphicView::zoomAuto");
+	RS_DEBUG_PRINT_DEBUG("RS_GraphicView::zoomAuto");
 
 
 	if (container) {
@@ -485,7 +528,7 @@ void RS_GraphicView::zoomAuto(bool axis, bool keepAspectRatio) {
 		}
 		//    std::cout<<"0: fx= "<<fx<<"\tfy="<<fy<<std::endl;
 
-		RS_DEBUG->print("f: %f/%f", fx, fy);
+		RS_DEBUG_PRINT_DEBUG("f: %f/%f", fx, fy);
 
 		switch(fFlags){
 		case 1:
@@ -504,7 +547,7 @@ void RS_GraphicView::zoomAuto(bool axis, bool keepAspectRatio) {
 		}
 		//    std::cout<<"1: fx= "<<fx<<"\tfy="<<fy<<std::endl;
 
-		RS_DEBUG->print("f: %f/%f", fx, fy);
+		RS_DEBUG_PRINT_DEBUG("f: %f/%f", fx, fy);
 		//exclude invalid factors
 		fFlags=0;
 		if (fx<RS_TOLERANCE||fx>RS_MAXDOUBLE) {
@@ -521,7 +564,7 @@ void RS_GraphicView::zoomAuto(bool axis, bool keepAspectRatio) {
 		setFactorX(fx);
 		setFactorY(fy);
 
-		RS_DEBUG->print("f: %f/%f", fx, fy);
+		RS_DEBUG_PRINT_DEBUG("f: %f/%f", fx, fy);
 
 
 		//        RS_DEBUG->print("adjustZoomControls");
@@ -537,7 +580,7 @@ void RS_GraphicView::zoomAuto(bool axis, bool keepAspectRatio) {
 
 		redraw();
 	}
-	RS_DEBUG->print("RS_GraphicView::zoomAuto OK");
+	RS_DEBUG_PRINT_DEBUG("RS_GraphicView::zoomAuto OK");
 }
 
 
@@ -547,7 +590,7 @@ void RS_GraphicView::zoomAuto(bool axis, bool keepAspectRatio) {
  */
 void RS_GraphicView::zoomPrevious() {
 
-	RS_DEBUG->print("RS_GraphicView::zoomPrevious");
+	RS_DEBUG_PRINT_DEBUG("RS_GraphicView::zoomPrevious");
 
 	if (container) {
 		restoreView();
@@ -670,7 +713,7 @@ void RS_GraphicView::zoomAutoY(bool axis) {
 			//    updateGrid();
 
 		}
-		RS_DEBUG->print("Auto zoom y ok");
+		RS_DEBUG_PRINT_DEBUG("Auto zoom y ok");
 	}
 }
 
@@ -806,7 +849,7 @@ void RS_GraphicView::zoomScroll(RS2::Direction direction) {
  */
 void RS_GraphicView::zoomPage() {
 
-	RS_DEBUG->print("RS_GraphicView::zoomPage");
+	RS_DEBUG_PRINT_DEBUG("RS_GraphicView::zoomPage");
 	if (!container) {
 		return;
 	}
@@ -832,11 +875,11 @@ void RS_GraphicView::zoomPage() {
 		fy = 1.0;
 	}
 
-	RS_DEBUG->print("f: %f/%f", fx, fy);
+	RS_DEBUG_PRINT_DEBUG("f: %f/%f", fx, fy);
 
 	fx = fy = std::min(fx, fy);
 
-	RS_DEBUG->print("f: %f/%f", fx, fy);
+	RS_DEBUG_PRINT_DEBUG("f: %f/%f", fx, fy);
 
 	if (fx<RS_TOLERANCE) {
 		fx=fy=1.0;
@@ -845,7 +888,7 @@ void RS_GraphicView::zoomPage() {
 	setFactorX(fx);
 	setFactorY(fy);
 
-	RS_DEBUG->print("f: %f/%f", fx, fy);
+	RS_DEBUG_PRINT_DEBUG("f: %f/%f", fx, fy);
 
 	centerOffsetX();
 	centerOffsetY();
@@ -862,7 +905,7 @@ void RS_GraphicView::zoomPage() {
  * Draws the entities within the given range.
  */
 void RS_GraphicView::drawWindow_DEPRECATED(RS_Vector v1, RS_Vector v2) {
-	RS_DEBUG->print("RS_GraphicView::drawWindow() begin");
+	RS_DEBUG_PRINT_DEBUG("RS_GraphicView::drawWindow() begin");
 	if (container) {
 		for(auto se: *container){
 			if (se->isInWindow(v1, v2)) {
@@ -870,7 +913,7 @@ void RS_GraphicView::drawWindow_DEPRECATED(RS_Vector v1, RS_Vector v2) {
 			}
 		}
 	}
-	RS_DEBUG->print("RS_GraphicView::drawWindow() end");
+	RS_DEBUG_PRINT_DEBUG("RS_GraphicView::drawWindow() end");
 }
 
 /**
@@ -879,6 +922,7 @@ void RS_GraphicView::drawWindow_DEPRECATED(RS_Vector v1, RS_Vector v2) {
  *
  */
 void RS_GraphicView::drawLayer1(RS_Painter *painter) {
+	LC_TRACE_SCOPE("paint", "grid layer");
 
 	// drawing paper border:
 	if (isPrintPreview()) {
@@ -927,6 +971,8 @@ void RS_GraphicView::drawLayer1(RS_Painter *painter) {
 
 void RS_GraphicView::drawLayer2(RS_Painter *painter)
 {
+	LC_TRACE_SCOPE("paint", "drawing layer");
+
 	drawEntity(painter, container);	//	Draw all entities.
 
 	//	If not in print preview, draw the absolute zero reference.
@@ -937,6 +983,7 @@ void RS_GraphicView::drawLayer2(RS_Painter *painter)
 
 
 void RS_GraphicView::drawLayer3(RS_Painter *painter) {
+	LC_TRACE_SCOPE("paint", "overlay layer");
 	// drawing zero points:
 	if (!isPrintPreview()) {
 		drawRelativeZero(painter);
@@ -1072,7 +1119,7 @@ void RS_GraphicView::setPenForEntity(RS_Painter *painter,RS_Entity *e)
  * @param db Double buffering on (recommended) / off
  */
 void RS_GraphicView::drawEntity(RS_Entity* /*e*/, double& /*patternOffset*/) {
-	RS_DEBUG->print("RS_GraphicView::drawEntity(RS_Entity*,patternOffset) not supported anymore");
+	RS_DEBUG_PRINT_DEBUG("RS_GraphicView::drawEntity(RS_Entity*,patternOffset) not supported anymore");
 	// RVT_PORT this needs to be optimized
 	// One way to do is to send a RS2::RedrawSelected, then the draw routine will only draw all selected entities
 	// Dis-advantage is that we still need to iterate over all entities, but
@@ -1081,7 +1128,7 @@ void RS_GraphicView::drawEntity(RS_Entity* /*e*/, double& /*patternOffset*/) {
 	redraw(RS2::RedrawDrawing);
 }
 void RS_GraphicView::drawEntity(RS_Entity* /*e*/ /*patternOffset*/) {
-	RS_DEBUG->print("RS_GraphicView::drawEntity(RS_Entity*,patternOffset) not supported anymore");
+	RS_DEBUG_PRINT_DEBUG("RS_GraphicView::drawEntity(RS_Entity*,patternOffset) not supported anymore");
 	// RVT_PORT this needs to be optimized
 	// One way to do is to send a RS2::RedrawSelected, then the draw routine will only draw all selected entities
 	// Dis-advantage is that we still need to iterate over all entities, but
@@ -1121,6 +1168,21 @@ void RS_GraphicView::drawEntity(RS_Painter *painter, RS_Entity* e, double& patte
         return;
     }
 
+    // test if the entity is on the printed page. Construction lines, which
+    // fill the whole view, are not printed, so lines are culled too. The
+    // margin is half of the widest line weight, whose pen may reach the page.
+    if (isPrinting() && e->rtti() != RS2::EntityGraphic) {
+        double margin = 0.5 * RS2::Width23 / 100.0 * painter->getDpmm();
+        if (toGuiX(e->getMax().x) < -margin
+                || toGuiX(e->getMin().x) > getWidth() + margin
+                || toGuiY(e->getMin().y) < -margin
+                || toGuiY(e->getMax().y) > getHeight() + margin) {
+            return;
+        }
+    }
+
+	LC_TRACE_SCOPE("draw", traceName(e->rtti()));
+
 	// set pen (color):
 	setPenForEntity(painter, e );
 
@@ -1209,7 +1271,7 @@ void RS_GraphicView::drawEntityPlain(RS_Painter *painter, RS_Entity* e) {
 void RS_GraphicView::deleteEntity(RS_Entity* e) {
 
 	// RVT_PORT When we delete a single entity, we can do this but we need to remove this then also from containerEntities
-	RS_DEBUG->print("RS_GraphicView::deleteEntity will for now redraw the whole screen instead of just deleting the entity");
+	RS_DEBUG_PRINT_DEBUG("RS_GraphicView::deleteEntity will for now redraw the whole screen instead of just deleting the entity");
 	setDeleteMode(true);
 	drawEntity(e);
 	setDeleteMode(false);
@@ -1454,11 +1516,7 @@ void RS_GraphicView::drawGrid(RS_Painter *painter) {
 	//painter->setPen(Qt::gray);
 	painter->setPen(gridColor);
 
-	//grid->updatePointArray();
-	auto const& pts = grid->getPoints();
-	for(auto const& v: pts){
-		painter->drawGridPoint(toGui(v));
-	}
+	painter->drawGridPoints(toGui(grid->getBaseGrid()), grid->getGuiPoints());
 
 	// draw grid info:
 	//painter->setPen(Qt::white);
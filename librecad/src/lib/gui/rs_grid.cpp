@@ -51,7 +51,25 @@ const double minimumGridWidth=1.0e-8;
 RS_Grid::RS_Grid(RS_GraphicView* graphicView)
     :graphicView(graphicView)
     ,baseGrid(false)
-{}
+    ,guiNumberX(0)
+    ,guiNumberY(0)
+    ,guiCell(false)
+    ,guiIsometric(false)
+{
+	loadSettings();
+}
+
+void RS_Grid::loadSettings() {
+	RS_SETTINGS->beginGroup("/Appearance");
+	scaleGrid = (bool)RS_SETTINGS->readNumEntry("/ScaleGrid", 1);
+	minGridSpacing = RS_SETTINGS->readNumEntry("/MinGridSpacing", 10);
+	// used without a drawing:
+	defaultIsometric = (bool)RS_SETTINGS->readNumEntry("/IsometricGrid", 0);
+	defaultCrosshairType=static_cast<RS2::CrosshairType>(RS_SETTINGS->readNumEntry("/CrosshairType",0));
+	defaultGrid.x = RS_SETTINGS->readEntry("/GridSpacingX",QString("-1")).toDouble();
+	defaultGrid.y = RS_SETTINGS->readEntry("/GridSpacingY",QString("-1")).toDouble();
+	RS_SETTINGS->endGroup();
+}
 
 /**
  * find the closest grid point
@@ -81,9 +99,6 @@ void RS_Grid::updatePointArray() {
 
 	RS_Graphic* graphic = graphicView->getGraphic();
 
-	// auto scale grid?
-	RS_SETTINGS->beginGroup("/Appearance");
-	bool scaleGrid = (bool)RS_SETTINGS->readNumEntry("/ScaleGrid", 1);
 	// get grid setting
 	RS_Vector userGrid;
 	if (graphic) {
@@ -93,17 +108,13 @@ void RS_Grid::updatePointArray() {
 		userGrid = graphic->getVariableVector("$GRIDUNIT",
 											 RS_Vector(-1.0, -1.0));
 	}else {
-		isometric = (bool)RS_SETTINGS->readNumEntry("/IsometricGrid", 0);
-		crosshairType=static_cast<RS2::CrosshairType>(RS_SETTINGS->readNumEntry("/CrosshairType",0));
-		userGrid.x = RS_SETTINGS->readEntry("/GridSpacingX",QString("-1")).toDouble();
-		userGrid.y = RS_SETTINGS->readEntry("/GridSpacingY",QString("-1")).toDouble();
+		isometric = defaultIsometric;
+		crosshairType = defaultCrosshairType;
+		userGrid = defaultGrid;
 	}
-	int minGridSpacing = RS_SETTINGS->readNumEntry("/MinGridSpacing", 10);
-	RS_SETTINGS->endGroup();
 
 	// std::cout<<"Grid userGrid="<<userGrid<<std::endl;
 
-	pt.clear();
 	metaX.clear();
 	metaY.clear();
 
@@ -176,6 +187,8 @@ void RS_Grid::updatePointArray() {
 		}
 
 		// RS_DEBUG->print("RS_Grid::update: 015");
+	} else {
+		guiPoints.clear();
 	}
 
 	// RS_DEBUG->print("RS_Grid::update: OK");
@@ -381,20 +394,13 @@ void RS_Grid::createOrthogonalGrid(LC_Rect const& rect, RS_Vector const& gridWid
 
 	// create grid array:
 
-	if (number<=0 || number>maxGridPoints) return;
-
-	pt.resize(number);
-
-	int i=0;
-	RS_Vector bp0(baseGrid);
-	for (int y=0; y<numberY; ++y) {
-		RS_Vector bp1(bp0);
-		for (int x=0; x<numberX; ++x) {
-			pt[i++] = bp1;
-			bp1.x += gridWidth.x;
-		}
-		bp0.y += gridWidth.y;
+	if (number<=0 || number>maxGridPoints) {
+		guiPoints.clear();
+		return;
 	}
+
+	createGuiPoints(numberX, numberY,
+					{graphicView->toGuiDX(gridWidth.x), graphicView->toGuiDY(gridWidth.y)});
 	// find meta grid boundaries
 	if (metaGridWidth.x>minimumGridWidth && metaGridWidth.y>minimumGridWidth &&
 			graphicView->toGuiDX(metaGridWidth.x)>2 &&
@@ -444,27 +450,17 @@ void RS_Grid::createIsometricGrid(LC_Rect const& rect, RS_Vector const& gridWidt
 	int numberY = (RS_Math::round((top-bottom) / gridWidth.y) + 1);
 	double dx=sqrt(3.)*gridWidth.y;
 	cellV.set(fabs(dx),fabs(gridWidth.y));
-	double hdx=0.5*dx;
-	double hdy=0.5*gridWidth.y;
 	int numberX = (RS_Math::round((right-left) / dx) + 1);
 	int number = 2*numberX*numberY;
 	baseGrid.set(left+remainder(-left,dx),bottom+remainder(-bottom,fabs(gridWidth.y)));
 
-	if (number<=0 || number>maxGridPoints) return;
-
-	pt.resize(number);
-
-	int i=0;
-	RS_Vector bp0(baseGrid),dbp1(hdx,hdy);
-	for (int y=0; y<numberY; ++y) {
-		RS_Vector bp1(bp0);
-		for (int x=0; x<numberX; ++x) {
-			pt[i++] = bp1;
-			pt[i++] = bp1+dbp1;
-			bp1.x += dx;
-		}
-		bp0.y += gridWidth.y;
+	if (number<=0 || number>maxGridPoints) {
+		guiPoints.clear();
+		return;
 	}
+
+	createGuiPoints(numberX, numberY,
+					{graphicView->toGuiDX(dx), graphicView->toGuiDY(gridWidth.y)});
 	//find metaGrid
 	if (metaGridWidth.y>minimumGridWidth &&
 			graphicView->toGuiDY(metaGridWidth.y)>2) {
@@ -492,12 +488,45 @@ void RS_Grid::createIsometricGrid(LC_Rect const& rect, RS_Vector const& gridWidt
 	}
 }
 
+/**
+ * Creates the grid points in pixels, relative to the base grid point.
+ * They only depend on the number of points and the cell size, so panning
+ * reuses them.
+ */
+void RS_Grid::createGuiPoints(int numberX, int numberY, RS_Vector const& guiCell)
+{
+	if (!guiPoints.isEmpty() && numberX == guiNumberX && numberY == guiNumberY
+			&& guiCell == this->guiCell && isometric == guiIsometric)
+		return;
+	guiNumberX = numberX;
+	guiNumberY = numberY;
+	this->guiCell = guiCell;
+	guiIsometric = isometric;
+
+	guiPoints.clear();
+	guiPoints.reserve(isometric ? 2*numberX*numberY : numberX*numberY);
+	//screen y is downwards
+	for (int y=0; y<numberY; ++y) {
+		double const py = - y*guiCell.y;
+		for (int x=0; x<numberX; ++x) {
+			double const px = x*guiCell.x;
+			guiPoints << QPointF(px, py);
+			if (isometric)
+				guiPoints << QPointF(px + 0.5*guiCell.x, py - 0.5*guiCell.y);
+		}
+	}
+}
+
 QString RS_Grid::getInfo() const{
 	return QString("%1 / %2").arg(spacing).arg(metaSpacing);
 }
 
-std::vector<RS_Vector> const& RS_Grid::getPoints() const{
-	return pt;
+QPolygonF const& RS_Grid::getGuiPoints() const{
+	return guiPoints;
+}
+
+RS_Vector const& RS_Grid::getBaseGrid() const{
+	return baseGrid;
 }
 
 std::vector<double> const& RS_Grid::getMetaX() const{
@@ -28,6 +28,7 @@
 #ifndef RS_GRID_H
 #define RS_GRID_H
 
+#include <QPolygonF>
 #include "rs_vector.h"
 
 class RS_GraphicView;
@@ -52,12 +53,20 @@ class RS_Grid
 public:
 	RS_Grid(RS_GraphicView* graphicView);
 
+	/**
+	 * Reads the grid settings, call after they changed.
+	 */
+	void loadSettings();
 	void updatePointArray();
 
 	/**
-		 * @return Array of all visible grid points.
+		 * @return All visible grid points, in pixels relative to getBaseGrid().
+		 */
+	QPolygonF const& getGuiPoints() const;
+	/**
+		 * @return The left-bottom grid point.
 		 */
-	std::vector<RS_Vector> const& getPoints() const;
+	RS_Vector const& getBaseGrid() const;
 
 	/**
 	* \brief the closest grid point
@@ -100,6 +109,7 @@ private:
 	//! \{ \brief create grid points
 	void createOrthogonalGrid(LC_Rect const& rect, RS_Vector const& gridWidth);
 	void createIsometricGrid(LC_Rect const& rect, RS_Vector const& gridWidth);
+	void createGuiPoints(int numberX, int numberY, RS_Vector const& guiCell);
 	//! \}
 
 	//! \{ \brief determine grid width
@@ -115,8 +125,22 @@ private:
 	//! Current meta grid spacing
 	double metaSpacing;
 
-	//! Pointer to array of grid points
-	std::vector<RS_Vector> pt;
+	//! \{ settings, see loadSettings()
+	bool scaleGrid;
+	int minGridSpacing;
+	bool defaultIsometric;
+	RS2::CrosshairType defaultCrosshairType;
+	RS_Vector defaultGrid;
+	//! \}
+
+	//! Grid points in pixels, relative to baseGrid
+	QPolygonF guiPoints;
+	//! \{ layout guiPoints were created for, reused until it changes
+	int guiNumberX;
+	int guiNumberY;
+	RS_Vector guiCell;
+	bool guiIsometric;
+	//! \}
 	RS_Vector baseGrid; // the left-bottom grid point
 	RS_Vector cellV;// (dx,dy)
 	RS_Vector metaGridWidth;
@@ -146,6 +146,15 @@ void RS_Painter::drawRect(const RS_Vector& p1, const RS_Vector& p2) {
 //    drawLine(RS_Vector(p1.x, p2.y), RS_Vector(p1.x, p1.y));
 }
 
+/**
+ * Draws grid points, given in pixels relative to origin.
+ */
+void RS_Painter::drawGridPoints(const RS_Vector& origin, const QPolygonF& points) {
+    for (const QPointF& p: points) {
+        drawGridPoint(origin + RS_Vector(p.x(), p.y()));
+    }
+}
+
 void RS_Painter::drawHandle(const RS_Vector& p, const RS_Color& c, int size) {
     if (size<0) {
         size = 2;
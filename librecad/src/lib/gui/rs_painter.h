@@ -84,6 +84,7 @@ public:
     virtual void lineTo(int x, int y) = 0;
 
     virtual void drawGridPoint(const RS_Vector& p) = 0;
+    virtual void drawGridPoints(const RS_Vector& origin, const QPolygonF& points);
     virtual void drawPoint(const RS_Vector& p) = 0;
     virtual void drawLine(const RS_Vector& p1, const RS_Vector& p2) = 0;
     virtual void drawRect(const RS_Vector& p1, const RS_Vector& p2);
@@ -112,6 +112,18 @@ void RS_PainterQt::drawGridPoint(const RS_Vector& p) {
 
 
 
+/**
+ * Draws all grid points in one call.
+ */
+void RS_PainterQt::drawGridPoints(const RS_Vector& origin, const QPolygonF& points) {
+    QPainter::save();
+    QPainter::translate(toScreenX(origin.x), toScreenY(origin.y));
+    QPainter::drawPoints(points);
+    QPainter::restore();
+}
+
+
+
 /**
  * Draws a point at (x1, y1).
  */
@@ -293,7 +305,7 @@ void RS_PainterQt::drawArc(const RS_Vector& cp, double radius,
 void RS_PainterQt::drawArcMac(const RS_Vector& cp, double radius,
                            double a1, double a2,
                            bool reversed) {
-        RS_DEBUG->print("RS_PainterQt::drawArcMac");
+        RS_DEBUG_PRINT_DEBUG("RS_PainterQt::drawArcMac");
     if(radius<=0.5) {
         drawGridPoint(cp);
     } else {
@@ -47,6 +47,7 @@ public:
     virtual void moveTo(int x, int y);
     virtual void lineTo(int x, int y);
     virtual void drawGridPoint(const RS_Vector& p);
+    virtual void drawGridPoints(const RS_Vector& origin, const QPolygonF& points);
     virtual void drawPoint(const RS_Vector& p);
     virtual void drawLine(const RS_Vector& p1, const RS_Vector& p2);
     //virtual void drawRect(const RS_Vector& p1, const RS_Vector& p2);
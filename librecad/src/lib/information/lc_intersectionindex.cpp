@@ -0,0 +1,510 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include "lc_intersectionindex.h"
+#include "lc_entityiterator.h"
+#include "lc_rect.h"
+#include "rs_document.h"
+#include "rs_information.h"
+#include "rs_math.h"
+#include "rs_debug.h"
+
+namespace {
+/** Entities covering more cells are kept in the list of large entities. */
+const int maxCellsPerEntity = 256;
+
+bool sameVector(const RS_Vector& v1, const RS_Vector& v2)
+{
+    return v1.valid == v2.valid
+        && (!v1.valid || (v1.x == v2.x && v1.y == v2.y));
+}
+
+bool isValidBox(const RS_Vector& min, const RS_Vector& max)
+{
+    return min.valid && max.valid
+        && min.x <= max.x && min.y <= max.y
+        && max.x - min.x < RS_MAXDOUBLE && max.y - min.y < RS_MAXDOUBLE;
+}
+}
+
+bool LC_IntersectionIndex::Signature::operator ==(const Signature& other) const
+{
+    return id == other.id
+        && rtti == other.rtti
+        && construction == other.construction
+        && sameVector( min, other.min)
+        && sameVector( max, other.max)
+        && sameVector( start, other.start)
+        && sameVector( end, other.end)
+        && sameVector( center, other.center);
+}
+
+LC_IntersectionIndex::LC_IntersectionIndex(RS_Document& document) :
+    document( document)
+{
+}
+
+/**
+ * Same as RS_Information::getIntersection(), but the result is taken
+ * from the cache when both entities are part of the indexed document.
+ */
+RS_VectorSolutions LC_IntersectionIndex::getIntersection(RS_Entity* e1, RS_Entity* e2,
+                                                         bool onEntities)
+{
+    validate();
+
+    auto item1 = items.find( e1);
+    auto item2 = items.find( e2);
+    if (items.end() == item1 || items.end() == item2 || e1 == e2) {
+        return RS_Information::getIntersection( e1, e2, onEntities);
+    }
+
+    auto& cache = item1->solutions[onEntities ? 1 : 0];
+    auto cached = cache.constFind( e2);
+    if (cache.constEnd() != cached) {
+        return *cached;
+    }
+
+    RS_VectorSolutions sol = RS_Information::getIntersection( e1, e2, onEntities);
+    cache.insert( e2, sol);
+    item2->dependents.insert( e1);
+
+    return sol;
+}
+
+/**
+ * Returns the intersection of entity with any other visible entity of
+ * the document, which is closest to coord. Only entities with
+ * overlapping bounding boxes are intersected.
+ *
+ * @param dist Set to the distance between coord and the intersection,
+ *             if one was found.
+ */
+RS_Vector LC_IntersectionIndex::getNearestIntersection(RS_Entity* entity,
+                                                       const RS_Vector& coord,
+                                                       double* dist)
+{
+    validate();
+
+    double minDist = RS_MAXDOUBLE;
+    double curDist = RS_MAXDOUBLE;
+    RS_Vector closestPoint(false);
+
+    Item query;
+    auto found = items.constFind( entity);
+    if (items.constEnd() != found) {
+        query.signature = found->signature;
+        query.minCol = found->minCol;
+        query.minRow = found->minRow;
+        query.maxCol = found->maxCol;
+        query.maxRow = found->maxRow;
+    }
+    else {
+        query.signature = signatureOf( entity);
+        cellRange( query);
+    }
+
+    for (RS_Entity* en : candidates( query)) {
+        if (en == entity
+            || en->getParent()->ignoredSnap()
+            || !isVisible( en)) {
+            continue;
+        }
+
+        RS_VectorSolutions sol = getIntersection( entity, en, true);
+        RS_Vector point = sol.getClosest( coord, &curDist, nullptr);
+        if (0 < sol.getNumber() && curDist < minDist) {
+            closestPoint = point;
+            minDist = curDist;
+        }
+    }
+
+    if (dist && closestPoint.valid) {
+        *dist = minDist;
+    }
+
+    return closestPoint;
+}
+
+/**
+ * Drops the entity and its cached solutions from the index. Containers
+ * drop all entities they resolve to, the document drops the whole index.
+ * Dropped entities which are still part of the document are inserted
+ * again with the next query.
+ */
+void LC_IntersectionIndex::invalidate(RS_Entity* e)
+{
+    if (!built || nullptr == e) {
+        return;
+    }
+
+    if (e == &document) {
+        clear();
+        return;
+    }
+
+    if (!e->isContainer()) {
+        stale = drop( e) || stale;
+        return;
+    }
+
+    LC_EntityIterator it( *static_cast<RS_EntityContainer*>(e), RS2::ResolveAllButTextImage);
+    for (RS_Entity* child = it.first(); child; child = it.next()) {
+        stale = drop( child) || stale;
+    }
+}
+
+/**
+ * Drops the index and all cached solutions, the next query rebuilds it.
+ */
+void LC_IntersectionIndex::clear()
+{
+    items.clear();
+    cells.clear();
+    large.clear();
+    built = false;
+}
+
+/**
+ * Brings the index up to date with the document.
+ *
+ * Nothing is done as long as the document revision is unchanged and no
+ * entity was invalidated meanwhile. Previews and other containers outside
+ * of the document don't cause updates. Otherwise the document is compared
+ * to the index: new and changed entities are (re)inserted, entities which
+ * are gone are removed without touching the dangling pointers.
+ * When the number of entities changed a lot, the grid is rebuilt
+ * to adjust the cell size.
+ */
+void LC_IntersectionIndex::validate()
+{
+    if (built && !stale && document.getRevision() == revision) {
+        return;
+    }
+
+    // dimensions are regenerated lazily, index their current children:
+    document.validateDimensions();
+
+    if (!built) {
+        rebuild();
+        return;
+    }
+
+    revision = document.getRevision();
+    stale = false;
+
+    for (auto& item : items) {
+        item.seen = false;
+    }
+
+    int count = 0;
+    LC_EntityIterator it( document, RS2::ResolveAllButTextImage);
+    for (RS_Entity* e = it.first(); e; e = it.next()) {
+        Signature signature = signatureOf( e);
+        if (!isValidBox( signature.min, signature.max)) {
+            continue;
+        }
+
+        ++count;
+        auto found = items.find( e);
+        if (items.end() == found) {
+            Item& item = items[e];
+            item.signature = signature;
+            item.seen = true;
+            insert( e, item);
+            continue;
+        }
+
+        found->seen = true;
+        if (found->signature != signature) {
+            remove( e, *found);
+            found->signature = signature;
+            insert( e, *found);
+        }
+    }
+
+    for (auto item = items.begin(); item != items.end(); ) {
+        if (item->seen) {
+            ++item;
+            continue;
+        }
+        remove( item.key(), *item);
+        item = items.erase( item);
+    }
+
+    if (count > 2 * builtCount + 64 || 2 * count + 64 < builtCount) {
+        rebuild();
+    }
+}
+
+/**
+ * Builds the grid from scratch, choosing the cell size so that
+ * an evenly spread drawing has about one entity per cell.
+ */
+void LC_IntersectionIndex::rebuild()
+{
+    RS_DEBUG_PRINT_DEBUG("LC_IntersectionIndex::rebuild");
+
+    clear();
+    revision = document.getRevision();
+    stale = false;
+
+    std::vector<std::pair<RS_Entity*, Signature>> entities;
+    RS_Vector min( RS_MAXDOUBLE, RS_MAXDOUBLE);
+    RS_Vector max( RS_MINDOUBLE, RS_MINDOUBLE);
+    LC_EntityIterator it( document, RS2::ResolveAllButTextImage);
+    for (RS_Entity* e = it.first(); e; e = it.next()) {
+        Signature signature = signatureOf( e);
+        if (!isValidBox( signature.min, signature.max)) {
+            continue;
+        }
+
+        min = RS_Vector::minimum( min, signature.min);
+        max = RS_Vector::maximum( max, signature.max);
+        entities.emplace_back( e, signature);
+    }
+
+    builtCount = static_cast<int>(entities.size());
+    built = true;
+    if (entities.empty()) {
+        origin = RS_Vector( 0., 0.);
+        cellSize = 1.;
+        return;
+    }
+
+    RS_Vector size = max - min;
+    double area = size.x * size.y;
+    origin = min;
+    cellSize = 0. < area
+             ? std::sqrt( area / builtCount)
+             : std::max( size.x, size.y) / builtCount;
+    if (cellSize <= RS_TOLERANCE) {
+        cellSize = 1.;
+    }
+
+    items.reserve( builtCount);
+    for (auto& entity : entities) {
+        Item& item = items[entity.first];
+        item.signature = entity.second;
+        insert( entity.first, item);
+    }
+}
+
+/**
+ * Adds the entity to the cells covered by its bounding box.
+ */
+void LC_IntersectionIndex::insert(RS_Entity* e, Item& item)
+{
+    cellRange( item);
+    if (item.maxCol < item.minCol) {
+        large.push_back( e);
+        return;
+    }
+
+    for (int col = item.minCol; col <= item.maxCol; ++col) {
+        for (int row = item.minRow; row <= item.maxRow; ++row) {
+            cells[cellKey( col, row)].push_back( e);
+        }
+    }
+}
+
+/**
+ * Removes the entity from its cells and drops its cached solutions.
+ * The entity itself is not accessed, it may already be deleted.
+ */
+void LC_IntersectionIndex::remove(RS_Entity* e, Item& item)
+{
+    dropSolutions( e, item);
+
+    if (item.maxCol < item.minCol) {
+        large.erase( std::remove( large.begin(), large.end(), e), large.end());
+        return;
+    }
+
+    for (int col = item.minCol; col <= item.maxCol; ++col) {
+        for (int row = item.minRow; row <= item.maxRow; ++row) {
+            auto cell = cells.find( cellKey( col, row));
+            if (cells.end() == cell) {
+                continue;
+            }
+            cell->erase( std::remove( cell->begin(), cell->end(), e), cell->end());
+            if (cell->empty()) {
+                cells.erase( cell);
+            }
+        }
+    }
+}
+
+/**
+ * Removes the entity from the index, if it is indexed.
+ *
+ * @return true if the entity was indexed.
+ */
+bool LC_IntersectionIndex::drop(RS_Entity* e)
+{
+    auto item = items.find( e);
+    if (items.end() == item) {
+        return false;
+    }
+
+    remove( e, *item);
+    items.erase( item);
+    return true;
+}
+
+/**
+ * Removes all cached solutions of the entity, including those cached
+ * by other entities with this one.
+ */
+void LC_IntersectionIndex::dropSolutions(RS_Entity* e, Item& item)
+{
+    for (auto& solutions : item.solutions) {
+        for (auto partner = solutions.constBegin(); partner != solutions.constEnd(); ++partner) {
+            auto other = items.find( partner.key());
+            if (items.end() != other) {
+                other->dependents.remove( e);
+            }
+        }
+        solutions.clear();
+    }
+
+    for (RS_Entity* dependent : item.dependents) {
+        auto other = items.find( dependent);
+        if (items.end() != other) {
+            other->solutions[0].remove( e);
+            other->solutions[1].remove( e);
+        }
+    }
+    item.dependents.clear();
+}
+
+/**
+ * Sets the cell range of the item from its bounding box. Construction
+ * entities, which are infinite, and entities covering too many cells
+ * get an empty range, they are treated as large entities.
+ */
+void LC_IntersectionIndex::cellRange(Item& item) const
+{
+    item.minCol = 0;
+    item.minRow = 0;
+    item.maxCol = -1;
+    item.maxRow = -1;
+    if (item.signature.construction) {
+        return;
+    }
+
+    double minCol = std::floor( (item.signature.min.x - origin.x) / cellSize);
+    double minRow = std::floor( (item.signature.min.y - origin.y) / cellSize);
+    double maxCol = std::floor( (item.signature.max.x - origin.x) / cellSize);
+    double maxRow = std::floor( (item.signature.max.y - origin.y) / cellSize);
+    if ((maxCol - minCol + 1.) * (maxRow - minRow + 1.) > maxCellsPerEntity
+        || std::fabs( minCol) > 1.0e9 || std::fabs( minRow) > 1.0e9
+        || std::fabs( maxCol) > 1.0e9 || std::fabs( maxRow) > 1.0e9) {
+        return;
+    }
+
+    item.minCol = static_cast<int>(minCol);
+    item.minRow = static_cast<int>(minRow);
+    item.maxCol = static_cast<int>(maxCol);
+    item.maxRow = static_cast<int>(maxRow);
+}
+
+/**
+ * @return Indexed entities which may intersect the queried item,
+ * each one only once.
+ */
+std::vector<RS_Entity*> LC_IntersectionIndex::candidates(const Item& query) const
+{
+    std::vector<RS_Entity*> ret;
+    if (query.maxCol < query.minCol) {
+        // large or infinite entity: test all
+        ret.reserve( items.size());
+        for (auto item = items.constBegin(); item != items.constEnd(); ++item) {
+            ret.push_back( item.key());
+        }
+        return ret;
+    }
+
+    LC_Rect const box {query.signature.min, query.signature.max};
+    QSet<RS_Entity*> found;
+    for (int col = query.minCol; col <= query.maxCol; ++col) {
+        for (int row = query.minRow; row <= query.maxRow; ++row) {
+            auto cell = cells.constFind( cellKey( col, row));
+            if (cells.constEnd() == cell) {
+                continue;
+            }
+            for (RS_Entity* e : *cell) {
+                if (found.contains( e)) {
+                    continue;
+                }
+                found.insert( e);
+                const Signature& signature = items.constFind( e)->signature;
+                if (box.intersects( LC_Rect {signature.min, signature.max}, RS_TOLERANCE)) {
+                    ret.push_back( e);
+                }
+            }
+        }
+    }
+
+    ret.insert( ret.end(), large.begin(), large.end());
+
+    return ret;
+}
+
+LC_IntersectionIndex::Signature LC_IntersectionIndex::signatureOf(const RS_Entity* e) const
+{
+    Signature signature;
+    signature.id = e->getId();
+    signature.rtti = e->rtti();
+    signature.construction = e->isConstruction();
+    signature.min = e->getMin();
+    signature.max = e->getMax();
+    signature.start = e->getStartpoint();
+    signature.end = e->getEndpoint();
+    signature.center = e->getCenter();
+
+    return signature;
+}
+
+/**
+ * @return true, if the entity and all its parents up to the document
+ * are visible.
+ */
+bool LC_IntersectionIndex::isVisible(const RS_Entity* e) const
+{
+    for (; e && e != &document; e = e->getParent()) {
+        if (!e->isVisible()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+qint64 LC_IntersectionIndex::cellKey(int col, int row)
+{
+    return (static_cast<qint64>(col) << 32) ^ static_cast<quint32>(row);
+}
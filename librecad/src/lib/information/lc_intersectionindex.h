@@ -0,0 +1,128 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#ifndef LC_INTERSECTIONINDEX_H
+#define LC_INTERSECTIONINDEX_H
+
+#include <vector>
+#include <QHash>
+#include <QSet>
+#include "rs_vector.h"
+
+class RS_Document;
+class RS_Entity;
+
+/**
+ * Spatial index and result cache for entity intersections of a document.
+ *
+ * The bounding boxes of all entities (resolved like
+ * RS_EntityContainer::getNearestIntersection() does) are hashed into
+ * a uniform grid, so only entities with overlapping boxes are handed to
+ * RS_Information::getIntersection(). Solutions are cached per entity pair,
+ * repeated queries for the same pair don't solve ellipse, spline or
+ * quadratic equations again.
+ *
+ * The index is built on the first query. Later queries update it
+ * incrementally after the document revision changed, which adding and
+ * removing entities at any depth, undo cycles and setModified() do: only
+ * entities which were added, removed or changed since the last query are
+ * rehashed and only their cached pairs are dropped. Entities which are
+ * changed in place, removed or deleted are dropped explicitly with
+ * invalidate(), see RS_Document::invalidateIntersections().
+ *
+ * The index belongs to the GUI thread like the document it indexes.
+ */
+class LC_IntersectionIndex
+{
+public:
+    explicit LC_IntersectionIndex(RS_Document& document);
+
+    RS_VectorSolutions getIntersection(RS_Entity* e1, RS_Entity* e2,
+                                       bool onEntities = false);
+    RS_Vector getNearestIntersection(RS_Entity* entity, const RS_Vector& coord,
+                                     double* dist = nullptr);
+
+    void invalidate(RS_Entity* e);
+    void clear();
+
+private:
+    /** Geometry summary to find entities changed in place. */
+    struct Signature {
+        unsigned long id {0};
+        int rtti {0};
+        bool construction {false};
+        RS_Vector min;
+        RS_Vector max;
+        RS_Vector start;
+        RS_Vector end;
+        RS_Vector center;
+
+        bool operator ==(const Signature& other) const;
+        bool operator !=(const Signature& other) const {
+            return !(*this == other);
+        }
+    };
+
+    struct Item {
+        Signature signature;
+        /** Cell range of the bounding box, empty for large entities. */
+        int minCol {0};
+        int minRow {0};
+        int maxCol {-1};
+        int maxRow {-1};
+        /** Cached solutions with other entities, [0] in the plane, [1] on entities. */
+        QHash<RS_Entity*, RS_VectorSolutions> solutions[2];
+        /** Entities which cached a solution with this one. */
+        QSet<RS_Entity*> dependents;
+        bool seen {false};
+    };
+
+    void validate();
+    void rebuild();
+    void insert(RS_Entity* e, Item& item);
+    void remove(RS_Entity* e, Item& item);
+    bool drop(RS_Entity* e);
+    void dropSolutions(RS_Entity* e, Item& item);
+    void cellRange(Item& item) const;
+    std::vector<RS_Entity*> candidates(const Item& query) const;
+    Signature signatureOf(const RS_Entity* e) const;
+    bool isVisible(const RS_Entity* e) const;
+    static qint64 cellKey(int col, int row);
+
+    RS_Document& document;
+    QHash<RS_Entity*, Item> items;
+    QHash<qint64, std::vector<RS_Entity*>> cells;
+    /** Entities spanning too many cells, tested against every query. */
+    std::vector<RS_Entity*> large;
+
+    RS_Vector origin;
+    double cellSize {0.};
+    int builtCount {0};
+    bool built {false};
+    /** Entities were dropped by invalidate() since the last update. */
+    bool stale {false};
+    unsigned long revision {0};
+};
+
+#endif // LC_INTERSECTIONINDEX_H
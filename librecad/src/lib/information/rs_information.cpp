@@ -25,6 +25,8 @@
 **
 **********************************************************************/
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include "rs_information.h"
 #include "rs_entitycontainer.h"
@@ -36,12 +38,206 @@
 #include "rs_ellipse.h"
 #include "rs_line.h"
 #include "rs_polyline.h"
+#include "rs_spline.h"
 #include "lc_quadratic.h"
 #include "lc_splinepoints.h"
 #include "rs_math.h"
 #include "lc_rect.h"
+#include "lc_entityiterator.h"
 #include "rs_debug.h"
 
+namespace {
+/** Tolerance for points on entities, same as in getIntersection() */
+const double onEntityTolerance = 1.0e-4;
+/** Intersections with nearly parallel tangent directions are tangent points */
+const double tangentTolerance = std::sqrt(onEntityTolerance) * onEntityTolerance;
+/**
+ * Closed-form results within this distance of a decision taken by
+ * getIntersection(), e.g. whether a point is on an entity, are solved
+ * again with getIntersection().
+ */
+const double decisionBand = 1.0e-3 * onEntityTolerance;
+/** Relative size of cross products and discriminants, which are degenerate */
+const double degenerateBand = 1.0e-8;
+
+/**
+ * Bounding boxes of candidates in structure of arrays layout, so the
+ * rejection loop runs over contiguous doubles and can be vectorized
+ * by the compiler.
+ */
+struct BoxBatch {
+    std::vector<size_t> index;
+    std::vector<double> minX, minY, maxX, maxY;
+
+    size_t size() const {
+        return index.size();
+    }
+};
+
+/**
+ * Lines intersected with the entity line, in structure of arrays layout.
+ * Start point and direction, u and v are the parameters of the
+ * intersection on the entity line and on the candidate.
+ */
+struct LineBatch {
+    std::vector<size_t> index;
+    std::vector<double> x, y, dx, dy;
+    std::vector<double> div, u, v;
+
+    size_t size() const {
+        return index.size();
+    }
+};
+
+/**
+ * Circles and arcs intersected with the entity line, in structure of
+ * arrays layout. b and disc are the half linear coefficient and the
+ * discriminant of the quadratic equation in the line parameter.
+ */
+struct CircleBatch {
+    std::vector<size_t> index;
+    std::vector<RS_Arc const*> arc;
+    std::vector<double> x, y, r;
+    std::vector<double> b, c, disc, scale;
+
+    size_t size() const {
+        return index.size();
+    }
+};
+
+/**
+ * @return true, if getIntersection() would intersect the quadratic forms
+ * of the entity line and the candidate, without special cases.
+ */
+bool isBatchable(RS_Entity const* entity, RS_Entity const* candidate)
+{
+    if (entity->getId() == candidate->getId()) {
+        return false;
+    }
+    switch (candidate->rtti()) {
+    case RS2::EntityLine:
+        return candidate->getEndpoint().distanceTo(candidate->getStartpoint()) >= RS_TOLERANCE;
+    case RS2::EntityCircle:
+    case RS2::EntityArc:
+        // points close to the center count as on the entity
+        return candidate->getRadius() > 2. * onEntityTolerance;
+    default:
+        return false;
+    }
+}
+
+/**
+ * The tangent test of filterIntersections(), shared with the batch.
+ */
+double tangentMeasure(RS_Vector const& direction1, RS_Vector const& direction2)
+{
+    return fabs(fabs(direction1.dotP(direction2)) - sqrt(direction1.squared()*direction2.squared()));
+}
+
+/**
+ * On-entity test of getIntersection() for the point at parameter t of a
+ * line: its distance to the line segment must not exceed the tolerance.
+ * @return 1 on the line, 0 off the line, -1 too close to the tolerance
+ */
+int onLine(double t, double length)
+{
+    double const beyond = (t < 0. ? -t : t - 1.) * length;
+    if (beyond <= onEntityTolerance - decisionBand) {
+        return 1;
+    }
+    return beyond < onEntityTolerance + decisionBand ? -1 : 0;
+}
+
+/**
+ * On-entity test of getIntersection() for a point on the circle of an
+ * arc, see RS_Arc::getNearestPointOnEntity().
+ * @return 1 on the arc, 0 off the arc, -1 too close to the tolerance
+ */
+int onArc(RS_Arc const* arc, RS_Vector const& vp)
+{
+    double const toEnd = std::min(vp.distanceTo(arc->getStartpoint()),
+                                  vp.distanceTo(arc->getEndpoint()));
+    if (toEnd <= onEntityTolerance - decisionBand) {
+        return 1;
+    }
+    if (toEnd < onEntityTolerance + decisionBand) {
+        return -1;
+    }
+    return RS_Math::isAngleBetween((vp - arc->getCenter()).angle(),
+                                   arc->getAngle1(), arc->getAngle2(),
+                                   arc->isReversed()) ? 1 : 0;
+}
+
+/**
+ * Keeps the solutions on both entities, if onEntities is true, and
+ * sets the tangent flag of the result. The last step of
+ * getIntersection(), shared with getIntersections().
+ */
+RS_VectorSolutions filterIntersections(RS_Entity const* e1, RS_Entity const* e2,
+                                       RS_VectorSolutions const& ret, bool onEntities)
+{
+    const double tol = onEntityTolerance;
+
+    RS_VectorSolutions ret2;
+	for(const RS_Vector& vp: ret){
+		if (!vp.valid) continue;
+		if (onEntities) {
+            //ignore intersections not on entity
+            if (!(
+                        (e1->isConstruction(true) || e1->isPointOnEntity(vp, tol)) &&
+                        (e2->isConstruction(true) || e2->isPointOnEntity(vp, tol))
+                        )
+                    ) {
+//				std::cout<<"Ignored intersection "<<vp<<std::endl;
+//				std::cout<<"because: e1->isPointOnEntity(ret.get(i), tol)="<<e1->isPointOnEntity(vp, tol)
+//					<<"\t(e2->isPointOnEntity(ret.get(i), tol)="<<e2->isPointOnEntity(vp, tol)<<std::endl;
+                continue;
+            }
+        }
+        // need to test whether the intersection is tangential
+		RS_Vector direction1=e1->getTangentDirection(vp);
+		RS_Vector direction2=e2->getTangentDirection(vp);
+        if( direction1.valid && direction2.valid && tangentMeasure(direction1, direction2) < tangentTolerance )
+            ret2.setTangent(true);
+        //TODO, make the following tangential test, nearest test work for all entity types
+
+//        RS_Entity   *lpLine = nullptr,
+//                    *lpCircle = nullptr;
+//        if( RS2::EntityLine == e1->rtti() && RS2::EntityCircle == e2->rtti()) {
+//            lpLine = e1;
+//            lpCircle = e2;
+//        }
+//        else if( RS2::EntityCircle == e1->rtti() && RS2::EntityLine == e2->rtti()) {
+//            lpLine = e2;
+//            lpCircle = e1;
+//        }
+//        if( nullptr != lpLine && nullptr != lpCircle) {
+//            double dist = 0.0;
+//            RS_Vector nearest = lpLine->getNearestPointOnEntity( lpCircle->getCenter(), false, &dist);
+
+//            // special case: line touches circle tangent
+//            if( nearest.valid && fabs( dist - lpCircle->getRadius()) < tol) {
+//                ret.set(i,nearest);
+//                ret2.setTangent(true);
+//            }
+//        }
+        ret2.push_back(vp);
+    }
+
+    return ret2;
+}
+
+void appendHits(RS_VectorSolutions const& sol, size_t candidate,
+                std::vector<RS_Information::IntersectionHit>& hits)
+{
+    for (RS_Vector const& vp: sol) {
+        if (vp.valid) {
+            hits.push_back({vp, candidate, sol.isTangent()});
+        }
+    }
+}
+}
+
 /**
  * Default constructor.
  *
@@ -113,8 +309,8 @@ bool RS_Information::isTrimmable(RS_Entity* e1, RS_Entity* e2) {
                 RS_Polyline* pl = static_cast<RS_Polyline *>(e1->getParent());
                 int idx1 = pl->findEntity(e1);
                 int idx2 = pl->findEntity(e2);
-                RS_DEBUG->print("RS_Information::isTrimmable: "
-                                "idx1: %d, idx2: %d", idx1, idx2);
+                RS_DEBUG_PRINT_DEBUG("RS_Information::isTrimmable: "
+                                     "idx1: %d, idx2: %d", idx1, idx2);
                 if (abs(idx1-idx2)==1 ||
 					(pl->isClosed() && abs(idx1-idx2)==int(pl->count()-1))) {
                     // directly following entities
@@ -219,14 +415,13 @@ RS_VectorSolutions RS_Information::getIntersection(RS_Entity const* e1,
 		RS_Entity const* e2, bool onEntities) {
 
     RS_VectorSolutions ret;
-    const double tol = 1.0e-4;
 
 	if (!(e1 && e2) ) {
-		RS_DEBUG->print("RS_Information::getIntersection() for nullptr entities");
+		RS_DEBUG_PRINT_DEBUG("RS_Information::getIntersection() for nullptr entities");
         return ret;
     }
     if (e1->getId() == e2->getId()) {
-        RS_DEBUG->print("RS_Information::getIntersection() of the same entity");
+        RS_DEBUG_PRINT_DEBUG("RS_Information::getIntersection() of the same entity");
         return ret;
     }
 
@@ -248,15 +443,12 @@ RS_VectorSolutions RS_Information::getIntersection(RS_Entity const* e1,
 		}
 	}
 
-    //avoid intersections between line segments the same spline
-    /* ToDo: 24 Aug 2011, Dongxu Li, if rtti() is not defined for the parent, the following check for splines may still cause segfault */
-	if ( e1->getParent() && e1->getParent() == e2->getParent()) {
-        if ( e1->getParent()->rtti()==RS2::EntitySpline ) {
-            //do not calculate intersections from neighboring lines of a spline
-            if ( abs(e1->getParent()->findEntity(e1) - e1->getParent()->findEntity(e2)) <= 1 ) {
-                return ret;
-            }
-        }
+    // splines are intersected along the polygon approximating them
+    if (e1->rtti() == RS2::EntitySpline) {
+        return getIntersectionSpline(static_cast<RS_Spline const*>(e1), e2, onEntities);
+    }
+    if (e2->rtti() == RS2::EntitySpline) {
+        return getIntersectionSpline(static_cast<RS_Spline const*>(e2), e1, onEntities);
     }
 
 	if(e1->rtti() == RS2::EntitySplinePoints || e2->rtti() == RS2::EntitySplinePoints)
@@ -282,53 +474,272 @@ RS_VectorSolutions RS_Information::getIntersection(RS_Entity const* e1,
 			ret=LC_Quadratic::getIntersection(qf1,qf2);
 		}
 	}
-    RS_VectorSolutions ret2;
-	for(const RS_Vector& vp: ret){
-		if (!vp.valid) continue;
-		if (onEntities) {
-            //ignore intersections not on entity
-            if (!(
-                        (e1->isConstruction(true) || e1->isPointOnEntity(vp, tol)) &&
-                        (e2->isConstruction(true) || e2->isPointOnEntity(vp, tol))
-                        )
-                    ) {
-//				std::cout<<"Ignored intersection "<<vp<<std::endl;
-//				std::cout<<"because: e1->isPointOnEntity(ret.get(i), tol)="<<e1->isPointOnEntity(vp, tol)
-//					<<"\t(e2->isPointOnEntity(ret.get(i), tol)="<<e2->isPointOnEntity(vp, tol)<<std::endl;
+    return filterIntersections(e1, e2, ret, onEntities);
+}
+
+
+
+/**
+ * Intersects the segments of the polygon approximating the spline with
+ * the other entity. Only points on the spline are returned, onEntities
+ * applies to the other entity.
+ */
+RS_VectorSolutions RS_Information::getIntersectionSpline(RS_Spline const* spline,
+		RS_Entity const* other, bool onEntities) {
+
+    RS_VectorSolutions ret;
+    const double tol = 1.0e-4;
+
+    std::vector<RS_Vector> const& points = spline->getSegmentPoints();
+    if (points.size() < 2) {
+        return ret;
+    }
+
+    RS_Line segment{points[0], points[1]};
+    for (size_t i = 1; i < points.size(); ++i) {
+        segment.setStartpoint(points[i - 1]);
+        segment.setEndpoint(points[i]);
+
+        RS_VectorSolutions const sol = getIntersection(&segment, other, onEntities);
+        for (RS_Vector const& vp: sol) {
+            // points shared by neighbouring segments are found twice
+            if (!segment.isPointOnEntity(vp, tol) || ret.getClosestDistance(vp) <= tol) {
                 continue;
             }
+            ret.push_back(vp);
         }
-        // need to test whether the intersection is tangential
-		RS_Vector direction1=e1->getTangentDirection(vp);
-		RS_Vector direction2=e2->getTangentDirection(vp);
-        if( direction1.valid && direction2.valid && fabs(fabs(direction1.dotP(direction2)) - sqrt(direction1.squared()*direction2.squared())) < sqrt(tol)*tol )
-            ret2.setTangent(true);
-        //TODO, make the following tangential test, nearest test work for all entity types
+        if (sol.isTangent()) {
+            ret.setTangent(true);
+        }
+    }
 
-//        RS_Entity   *lpLine = nullptr,
-//                    *lpCircle = nullptr;
-//        if( RS2::EntityLine == e1->rtti() && RS2::EntityCircle == e2->rtti()) {
-//            lpLine = e1;
-//            lpCircle = e2;
-//        }
-//        else if( RS2::EntityCircle == e1->rtti() && RS2::EntityLine == e2->rtti()) {
-//            lpLine = e2;
-//            lpCircle = e1;
-//        }
-//        if( nullptr != lpLine && nullptr != lpCircle) {
-//            double dist = 0.0;
-//            RS_Vector nearest = lpLine->getNearestPointOnEntity( lpCircle->getCenter(), false, &dist);
+    return ret;
+}
 
-//            // special case: line touches circle tangent
-//            if( nearest.valid && fabs( dist - lpCircle->getRadius()) < tol) {
-//                ret.set(i,nearest);
-//                ret2.setTangent(true);
-//            }
-//        }
-        ret2.push_back(vp);
+
+
+/**
+ * Intersects one entity with a number of candidates at once.
+ *
+ * The results are the same as calling getIntersection() for every
+ * candidate, up to rounding. For a line, the bounding boxes of all
+ * lines, circles and arcs are checked in one pass and the intersections
+ * are solved in closed form over structure of arrays batches, without
+ * dispatching and allocating solutions for every pair. Pairs which are
+ * nearly parallel or tangent, or whose intersections are close to the
+ * end of an entity by the on-entity tolerance, are solved again with
+ * getIntersection() to take the same decisions. All other pairs use
+ * getIntersection().
+ *
+ * @param hits Buffer for the results, new hits are appended ordered by
+ *        candidate. The caller can reuse it to avoid allocations.
+ * @return Number of appended hits.
+ */
+size_t RS_Information::getIntersections(RS_Entity const* entity,
+        std::vector<RS_Entity*> const& candidates,
+        std::vector<IntersectionHit>& hits,
+        bool onEntities) {
+
+    size_t const first = hits.size();
+    if (!entity) {
+        return 0;
     }
 
-    return ret2;
+    RS_Vector const p1 = entity->getStartpoint();
+    RS_Vector const d1 = entity->getEndpoint() - p1;
+    double const len1 = d1.magnitude();
+    if (RS2::EntityLine != entity->rtti() || len1 < RS_TOLERANCE) {
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (candidates[i]) {
+                appendHits( getIntersection( entity, candidates[i], onEntities), i, hits);
+            }
+        }
+        return hits.size() - first;
+    }
+
+    // the same bounding box check as in getIntersection()
+    bool const checkBoxes = onEntities && !entity->isConstruction();
+    LC_Rect const rect1{entity->getMin(), entity->getMax()};
+
+    BoxBatch boxes;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        RS_Entity const* c = candidates[i];
+        if (!c) {
+            continue;
+        }
+        if (!isBatchable( entity, c)) {
+            appendHits( getIntersection( entity, c, onEntities), i, hits);
+            continue;
+        }
+
+        boxes.index.push_back( i);
+        if (checkBoxes && !c->isConstruction()) {
+            LC_Rect const rect2{c->getMin(), c->getMax()};
+            boxes.minX.push_back( rect2.minP().x);
+            boxes.minY.push_back( rect2.minP().y);
+            boxes.maxX.push_back( rect2.maxP().x);
+            boxes.maxY.push_back( rect2.maxP().y);
+        }
+        else {
+            boxes.minX.push_back( -RS_MAXDOUBLE);
+            boxes.minY.push_back( -RS_MAXDOUBLE);
+            boxes.maxX.push_back( RS_MAXDOUBLE);
+            boxes.maxY.push_back( RS_MAXDOUBLE);
+        }
+    }
+
+    // LC_Rect::intersects() with RS_TOLERANCE
+    size_t const n = boxes.size();
+    double const minX = rect1.minP().x;
+    double const minY = rect1.minP().y;
+    double const maxX = rect1.maxP().x + RS_TOLERANCE;
+    double const maxY = rect1.maxP().y + RS_TOLERANCE;
+    std::vector<char> overlaps( n);
+    for (size_t j = 0; j < n; ++j) {
+        overlaps[j] = maxX >= boxes.minX[j]
+                && maxY >= boxes.minY[j]
+                && boxes.maxX[j] + RS_TOLERANCE >= minX
+                && boxes.maxY[j] + RS_TOLERANCE >= minY;
+    }
+
+    LineBatch lines;
+    CircleBatch circles;
+    for (size_t j = 0; j < n; ++j) {
+        if (!overlaps[j]) {
+            continue;
+        }
+        RS_Entity const* c = candidates[boxes.index[j]];
+        if (RS2::EntityLine == c->rtti()) {
+            RS_Vector const p3 = c->getStartpoint();
+            RS_Vector const d2 = c->getEndpoint() - p3;
+            lines.index.push_back( boxes.index[j]);
+            lines.x.push_back( p3.x);
+            lines.y.push_back( p3.y);
+            lines.dx.push_back( d2.x);
+            lines.dy.push_back( d2.y);
+        }
+        else {
+            RS_Vector const center = c->getCenter();
+            circles.index.push_back( boxes.index[j]);
+            circles.arc.push_back( RS2::EntityArc == c->rtti()
+                                   ? static_cast<RS_Arc const*>(c) : nullptr);
+            circles.x.push_back( center.x);
+            circles.y.push_back( center.y);
+            circles.r.push_back( c->getRadius());
+        }
+    }
+
+    bool const limited1 = onEntities && !entity->isConstruction(true);
+
+    // line - line: p1 + u d1 == p3 + v d2
+    size_t const nLines = lines.size();
+    lines.div.resize( nLines);
+    lines.u.resize( nLines);
+    lines.v.resize( nLines);
+    for (size_t j = 0; j < nLines; ++j) {
+        double const ex = lines.x[j] - p1.x;
+        double const ey = lines.y[j] - p1.y;
+        double const div = d1.x * lines.dy[j] - d1.y * lines.dx[j];
+        double const safeDiv = 0. != div ? div : 1.;
+        lines.div[j] = div;
+        lines.u[j] = (ex * lines.dy[j] - ey * lines.dx[j]) / safeDiv;
+        lines.v[j] = (ex * d1.y - ey * d1.x) / safeDiv;
+    }
+    for (size_t j = 0; j < nLines; ++j) {
+        RS_Entity const* c = candidates[lines.index[j]];
+        RS_Vector const d2{lines.dx[j], lines.dy[j]};
+        double const len2 = d2.magnitude();
+        int on = 1;
+        if (fabs( lines.div[j]) <= degenerateBand * len1 * len2) {
+            on = -1;
+        }
+        if (1 == on && limited1) {
+            on = onLine( lines.u[j], len1);
+        }
+        if (1 == on && onEntities && !c->isConstruction(true)) {
+            on = onLine( lines.v[j], len2);
+        }
+        if (on < 0) {
+            appendHits( getIntersection( entity, c, onEntities), lines.index[j], hits);
+        }
+        else if (on > 0) {
+            hits.push_back( {p1 + d1 * lines.u[j], lines.index[j],
+                             tangentMeasure( d1, d2) < tangentTolerance});
+        }
+    }
+
+    // line - circle: |p1 + t d1 - center|^2 == r^2, with
+    // t^2 squared1 + 2 t b + c == 0
+    size_t const nCircles = circles.size();
+    double const squared1 = d1.squared();
+    circles.b.resize( nCircles);
+    circles.c.resize( nCircles);
+    circles.disc.resize( nCircles);
+    circles.scale.resize( nCircles);
+    for (size_t j = 0; j < nCircles; ++j) {
+        double const ex = p1.x - circles.x[j];
+        double const ey = p1.y - circles.y[j];
+        double const e2 = ex * ex + ey * ey;
+        double const r2 = circles.r[j] * circles.r[j];
+        double const b = ex * d1.x + ey * d1.y;
+        circles.b[j] = b;
+        circles.c[j] = e2 - r2;
+        circles.disc[j] = b * b - squared1 * (e2 - r2);
+        circles.scale[j] = b * b + squared1 * (e2 + r2);
+    }
+    for (size_t j = 0; j < nCircles; ++j) {
+        RS_Entity const* c = candidates[circles.index[j]];
+        double const disc = circles.disc[j];
+        int on = fabs( disc) <= degenerateBand * circles.scale[j] ? -1 : 1;
+        if (1 == on && disc < 0.) {
+            continue;
+        }
+
+        // roots without loss of significance
+        RS_Vector const center{circles.x[j], circles.y[j]};
+        double const root = std::sqrt( std::max( disc, 0.));
+        double const q = -(circles.b[j] + (circles.b[j] < 0. ? -root : root));
+        double const t[2] = {q / squared1, circles.c[j] / q};
+        RS_Vector hit[2];
+        size_t count = 0;
+        bool tangent = false;
+        for (int k = 0; k < 2 && 0 <= on; ++k) {
+            RS_Vector const vp = p1 + d1 * t[k];
+            int onEntity = limited1 ? onLine( t[k], len1) : 1;
+            if (1 == onEntity && onEntities && circles.arc[j] && !c->isConstruction(true)) {
+                onEntity = onArc( circles.arc[j], vp);
+            }
+            if (onEntity < 0) {
+                on = -1;
+                break;
+            }
+            if (0 == onEntity) {
+                continue;
+            }
+            RS_Vector const radial = vp - center;
+            double const measure = tangentMeasure( d1, RS_Vector{-radial.y, radial.x});
+            if (fabs( measure - tangentTolerance) <= 0.01 * tangentTolerance) {
+                on = -1;
+                break;
+            }
+            tangent = tangent || measure < tangentTolerance;
+            hit[count++] = vp;
+        }
+        if (on < 0) {
+            appendHits( getIntersection( entity, c, onEntities), circles.index[j], hits);
+            continue;
+        }
+        for (size_t k = 0; k < count; ++k) {
+            hits.push_back( {hit[k], circles.index[j], tangent});
+        }
+    }
+
+    std::stable_sort( hits.begin() + first, hits.end(),
+                      [](IntersectionHit const& a, IntersectionHit const& b) {
+        return a.candidate < b.candidate;
+    });
+
+    return hits.size() - first;
 }
 
 
@@ -342,7 +753,7 @@ RS_VectorSolutions RS_Information::getIntersectionLineLine(RS_Line* e1,
     RS_VectorSolutions ret;
 
 	if (!(e1 && e2)) {
-		RS_DEBUG->print("RS_Information::getIntersectionLineLin() for nullptr entities");
+		RS_DEBUG_PRINT_DEBUG("RS_Information::getIntersectionLineLin() for nullptr entities");
         return ret;
     }
 
@@ -718,7 +1129,7 @@ RS_VectorSolutions RS_Information::getIntersectionEllipseLine(RS_Line* line,
 
 //    std::cout<<"RS_Information::getIntersectionEllipseLine(): d="<<d<<std::endl;
     if (d < - 1.e3*RS_TOLERANCE*sqrt(RS_TOLERANCE)) {
-        RS_DEBUG->print("RS_Information::getIntersectionLineEllipse: outside 0");
+        RS_DEBUG_PRINT_DEBUG("RS_Information::getIntersectionLineEllipse: outside 0");
         return ret;
     }
     if( d < 0. ) d=0.;
@@ -736,7 +1147,7 @@ RS_VectorSolutions RS_Information::getIntersectionEllipseLine(RS_Line* line,
     ret.rotate(center, angleVector);
 //    std::cout<<"found Ellipse-Line intersections: "<<ret.getNumber()<<std::endl;
 //    std::cout<<ret<<std::endl;
-    RS_DEBUG->print("RS_Information::getIntersectionEllipseLine(): done");
+    RS_DEBUG_PRINT_DEBUG("RS_Information::getIntersectionEllipseLine(): done");
     return ret;
 }
 
@@ -755,7 +1166,7 @@ bool RS_Information::isPointInsideContour(const RS_Vector& point,
         RS_EntityContainer* contour, bool* onContour) {
 
 	if (!contour) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_Information::isPointInsideContour: contour is nullptr");
         return false;
     }
@@ -771,6 +1182,11 @@ bool RS_Information::isPointInsideContour(const RS_Vector& point,
     int counter;
     int tries = 0;
     double rayAngle = 0.0;
+    std::vector<RS_Entity*> entities;
+    LC_EntityIterator(*contour, RS2::ResolveAll).visit([&entities](RS_Entity* e) {
+        entities.push_back(e);
+    });
+    std::vector<IntersectionHit> hits;
     do {
         sure = true;
 
@@ -778,18 +1194,25 @@ bool RS_Information::isPointInsideContour(const RS_Vector& point,
 		RS_Vector v = RS_Vector::polar(width*10.0, rayAngle);
 		RS_Line ray{point, point+v};
         counter = 0;
-        RS_VectorSolutions sol;
 
 		if (onContour) {
             *onContour = false;
         }
 
-        for (RS_Entity* e = contour->firstEntity(RS2::ResolveAll);
-				e;
-                e = contour->nextEntity(RS2::ResolveAll)) {
-
-            // intersection(s) from ray with contour entity:
-            sol = RS_Information::getIntersection(&ray, e, true);
+        // intersection(s) from ray with all contour entities:
+        hits.clear();
+        getIntersections(&ray, entities, hits, true);
+
+        for (size_t k = 0; k < hits.size(); ) {
+            RS_Entity* e = entities[hits[k].candidate];
+            RS_VectorSolutions sol;
+            for (size_t candidate = hits[k].candidate;
+                 k < hits.size() && hits[k].candidate == candidate; ++k) {
+                sol.push_back(hits[k].point);
+                if (hits[k].tangent) {
+                    sol.setTangent(true);
+                }
+            }
 
             for (int i=0; i<=1; ++i) {
                 RS_Vector p = sol.get(i);
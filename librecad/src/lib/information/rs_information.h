@@ -27,16 +27,17 @@
 #ifndef RS_INFORMATION_H
 #define RS_INFORMATION_H
 
+#include <vector>
 #include "rs.h"
+#include "rs_vector.h"
 
 class RS_Ellipse;
 class RS_Entity;
 class RS_EntityContainer;
-class RS_Vector;
-class RS_VectorSolutions;
 class RS_Arc;
 class RS_Circle;
 class RS_Line;
+class RS_Spline;
 
 /**
  * Class for getting information about entities. This includes
@@ -70,6 +71,21 @@ public:
 			RS_Entity const* e2,
             bool onEntities = false);
 
+    /**
+     * One intersection found by getIntersections().
+     */
+    struct IntersectionHit {
+        RS_Vector point;
+        /** Index of the intersected entity in the candidates. */
+        size_t candidate;
+        bool tangent;
+    };
+
+    static size_t getIntersections(RS_Entity const* entity,
+            std::vector<RS_Entity*> const& candidates,
+            std::vector<IntersectionHit>& hits,
+            bool onEntities = true);
+
     static RS_VectorSolutions getIntersectionLineLine(RS_Line* e1,
             RS_Line* e2);
 
@@ -79,6 +95,9 @@ public:
 	static RS_VectorSolutions getIntersectionArcArc(RS_Entity const* e1,
 			RS_Entity const* e2);
 
+	static RS_VectorSolutions getIntersectionSpline(RS_Spline const* spline,
+			RS_Entity const* other, bool onEntities);
+
 	static RS_VectorSolutions getIntersectionEllipseEllipse(
 			RS_Ellipse const* e1,
 			RS_Ellipse const* e2);
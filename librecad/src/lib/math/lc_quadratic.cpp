@@ -25,6 +25,7 @@
 **********************************************************************/
 
 #include <cfloat>
+#include <iostream>
 #include <QDebug>
 #include "rs_math.h"
 #include "rs_information.h"
@@ -43,40 +44,11 @@
  * Constructor.
  */
 
-LC_Quadratic::LC_Quadratic():
-    m_mQuad(2,2),
-    m_vLinear(2),
-	m_bValid(false)
+LC_Quadratic::LC_Quadratic()
 {}
 
-LC_Quadratic::LC_Quadratic(const LC_Quadratic& lc0):
-  m_bIsQuadratic(lc0.isQuadratic())
-  ,m_bValid(lc0)
-{
-    if(m_bValid==false) return;
-  if(m_bIsQuadratic) m_mQuad=lc0.getQuad();
-  m_vLinear=lc0.getLinear();
-  m_dConst=lc0.m_dConst;
-}
-
-LC_Quadratic& LC_Quadratic::operator = (const LC_Quadratic& lc0)
-{
-    if(lc0.isQuadratic()){
-        m_mQuad.resize(2,2,false);
-        m_mQuad=lc0.getQuad();
-    }
-    m_vLinear.resize(2);
-    m_vLinear=lc0.getLinear();
-    m_dConst=lc0.m_dConst;
-    m_bIsQuadratic=lc0.isQuadratic();
-	m_bValid=lc0.m_bValid;
-    return *this;
-}
 
-
-LC_Quadratic::LC_Quadratic(std::vector<double> ce):
-    m_mQuad(2,2),
-    m_vLinear(2)
+LC_Quadratic::LC_Quadratic(std::vector<double> ce)
 {
     if(ce.size()==6){
         //quadratic
@@ -109,9 +81,7 @@ LC_Quadratic::LC_Quadratic(std::vector<double> ce):
 *@return, a path of center tangential circles which pass the point
 */
 LC_Quadratic::LC_Quadratic(const RS_AtomicEntity* circle, const RS_Vector& point)
-    : m_mQuad(2,2)
-    ,m_vLinear(2)
-    ,m_bIsQuadratic(true)
+    : m_bIsQuadratic(true)
     ,m_bValid(true)
 {
 	if(circle==nullptr) {
@@ -235,22 +205,22 @@ bool LC_Quadratic::operator != (bool valid) const
 	return m_bValid != valid;
 }
 
-boost::numeric::ublas::vector<double>& LC_Quadratic::getLinear()
+LC_Quadratic::Vector& LC_Quadratic::getLinear()
 {
 	return m_vLinear;
 }
 
-const boost::numeric::ublas::vector<double>& LC_Quadratic::getLinear() const
+const LC_Quadratic::Vector& LC_Quadratic::getLinear() const
 {
 	return m_vLinear;
 }
 
-boost::numeric::ublas::matrix<double>& LC_Quadratic::getQuad()
+LC_Quadratic::Matrix& LC_Quadratic::getQuad()
 {
 	return m_mQuad;
 }
 
-const boost::numeric::ublas::matrix<double>& LC_Quadratic::getQuad() const
+const LC_Quadratic::Matrix& LC_Quadratic::getQuad() const
 {
 	return m_mQuad;
 }
@@ -269,10 +239,7 @@ double& LC_Quadratic::constTerm()
   of this two given entities*/
 LC_Quadratic::LC_Quadratic(const RS_AtomicEntity* circle0,
                            const RS_AtomicEntity* circle1,
-                           bool mirror):
-    m_mQuad(2,2)
-    ,m_vLinear(2)
-    ,m_bValid(false)
+                           bool mirror)
 {
 //    DEBUG_HEADER
 
@@ -439,13 +406,11 @@ LC_Quadratic LC_Quadratic::move(const RS_Vector& v)
 
 LC_Quadratic LC_Quadratic::rotate(const double& angle)
 {
-    using namespace boost::numeric::ublas;
-	auto m=rotationMatrix(angle);
-	auto t=trans(m);
-    m_vLinear = prod(t, m_vLinear);
+	auto const m=rotationMatrix(angle);
+	auto const t=m.transposed();
+    m_vLinear = t * m_vLinear;
     if(m_bIsQuadratic){
-        m_mQuad=prod(m_mQuad,m);
-        m_mQuad=prod(t, m_mQuad);
+        m_mQuad = t * (m_mQuad * m);
     }
     return *this;
 }
@@ -491,14 +456,11 @@ RS_VectorSolutions LC_Quadratic::getIntersection(const LC_Quadratic& l1, const L
 	}
     if(p1->isQuadratic()==false){
         //two lines
-		std::vector<std::vector<double> > ce(2,std::vector<double>(3,0.));
-        ce[0][0]=p1->m_vLinear(0);
-        ce[0][1]=p1->m_vLinear(1);
-        ce[0][2]=-p1->m_dConst;
-        ce[1][0]=p2->m_vLinear(0);
-        ce[1][1]=p2->m_vLinear(1);
-        ce[1][2]=-p2->m_dConst;
-		std::vector<double> sn(2,0.);
+		std::array<std::array<double, 3>, 2> ce{{
+				{{p1->m_vLinear(0), p1->m_vLinear(1), -p1->m_dConst}},
+				{{p2->m_vLinear(0), p2->m_vLinear(1), -p2->m_dConst}}
+			}};
+		std::array<double, 2> sn;
         if(RS_Math::linearSolver(ce,sn)){
             ret.push_back(RS_Vector(sn[0],sn[1]));
         }
@@ -508,36 +470,21 @@ RS_VectorSolutions LC_Quadratic::getIntersection(const LC_Quadratic& l1, const L
         //one line, one quadratic
         //avoid division by zero
         if(fabs(p2->m_vLinear(0))+DBL_EPSILON<fabs(p2->m_vLinear(1))){
-            ret=getIntersection(p1->flipXY(),p2->flipXY()).flipXY();
-//            for(size_t j=0;j<ret.size();j++){
-//                DEBUG_HEADER
-//                std::cout<<j<<": ("<<ret[j].x<<", "<< ret[j].y<<")"<<std::endl;
-//            }
-            return ret;
+            return getIntersection(p1->flipXY(),p2->flipXY()).flipXY();
         }
-        std::vector<std::vector<double> >  ce(0);
 		if(fabs(p2->m_vLinear(1))<RS_TOLERANCE){
             const double angle=0.25*M_PI;
             LC_Quadratic p11(*p1);
             LC_Quadratic p22(*p2);
-            ce.push_back(p11.rotate(angle).getCoefficients());
-            ce.push_back(p22.rotate(angle).getCoefficients());
-            ret=RS_Math::simultaneousQuadraticSolverMixed(ce);
+            p11.rotate(angle);
+            p22.rotate(angle);
+            ret=RS_Math::simultaneousQuadraticSolverMixed(p22.linearCoefficients(),
+                                                          p11.quadraticCoefficients());
             ret.rotate(-angle);
-//            for(size_t j=0;j<ret.size();j++){
-//                DEBUG_HEADER
-//                std::cout<<j<<": ("<<ret[j].x<<", "<< ret[j].y<<")"<<std::endl;
-//            }
             return ret;
         }
-        ce.push_back(p1->getCoefficients());
-        ce.push_back(p2->getCoefficients());
-        ret=RS_Math::simultaneousQuadraticSolverMixed(ce);
-//        for(size_t j=0;j<ret.size();j++){
-//            DEBUG_HEADER
-//            std::cout<<j<<": ("<<ret[j].x<<", "<< ret[j].y<<")"<<std::endl;
-//        }
-        return ret;
+        return RS_Math::simultaneousQuadraticSolverMixed(p2->linearCoefficients(),
+                                                         p1->quadraticCoefficients());
     }
     if( fabs(p1->m_mQuad(0,0))<RS_TOLERANCE && fabs(p1->m_mQuad(0,1))<RS_TOLERANCE
             &&
@@ -545,42 +492,28 @@ RS_VectorSolutions LC_Quadratic::getIntersection(const LC_Quadratic& l1, const L
             ){
         if(fabs(p1->m_mQuad(1,1))<RS_TOLERANCE && fabs(p2->m_mQuad(1,1))<RS_TOLERANCE){
             //linear
-            std::vector<double> ce(0);
-            ce.push_back(p1->m_vLinear(0));
-            ce.push_back(p1->m_vLinear(1));
-            ce.push_back(p1->m_dConst);
-            LC_Quadratic lc10(ce);
-            ce.clear();
-            ce.push_back(p2->m_vLinear(0));
-            ce.push_back(p2->m_vLinear(1));
-            ce.push_back(p2->m_dConst);
-            LC_Quadratic lc11(ce);
+            LC_Quadratic lc10;
+            lc10.m_vLinear=p1->m_vLinear;
+            lc10.m_dConst=p1->m_dConst;
+            lc10.m_bValid=true;
+            LC_Quadratic lc11;
+            lc11.m_vLinear=p2->m_vLinear;
+            lc11.m_dConst=p2->m_dConst;
+            lc11.m_bValid=true;
             return getIntersection(lc10,lc11);
         }
         return getIntersection(p1->flipXY(),p2->flipXY()).flipXY();
     }
-    std::vector<std::vector<double> >  ce(0);
-    ce.push_back(p1->getCoefficients());
-    ce.push_back(p2->getCoefficients());
     if(RS_DEBUG->getLevel()>=RS_Debug::D_INFORMATIONAL){
         DEBUG_HEADER
         std::cout<<*p1<<std::endl;
         std::cout<<*p2<<std::endl;
     }
-	auto sol= RS_Math::simultaneousQuadraticSolverFull(ce);
-    bool valid= sol.size()>0;
-	for(auto & v: sol){
-		if(v.magnitude()>=RS_MAXDOUBLE){
-            valid=false;
-            break;
-        }
-    }
-    if(valid) return sol;
-    ce.clear();
-	ce.push_back(p1->getCoefficients());
-	ce.push_back(p2->getCoefficients());
-    sol=RS_Math::simultaneousQuadraticSolverFull(ce);
-    ret.clear();
+	std::array<std::array<double, 6>, 2> const ce{{
+			p1->quadraticCoefficients(),
+			p2->quadraticCoefficients()
+		}};
+	auto const sol= RS_Math::simultaneousQuadraticSolverFull(ce);
 	for(auto const& v: sol){
 		if(v.magnitude()<=RS_MAXDOUBLE){
 			ret.push_back(v);
@@ -593,20 +526,30 @@ RS_VectorSolutions LC_Quadratic::getIntersection(const LC_Quadratic& l1, const L
     return ret;
 }
 
+/** coefficients of a quadratic form, in the order of RS_Math::simultaneousQuadraticSolverFull() */
+std::array<double, 6> LC_Quadratic::quadraticCoefficients() const
+{
+    return {{m_mQuad(0,0), m_mQuad(0,1)+m_mQuad(1,0), m_mQuad(1,1),
+             m_vLinear(0), m_vLinear(1), m_dConst}};
+}
+
+/** coefficients of a linear form: l0 x + l1 y + l2 */
+std::array<double, 3> LC_Quadratic::linearCoefficients() const
+{
+    return {{m_vLinear(0), m_vLinear(1), m_dConst}};
+}
+
 /**
    rotation matrix:
 
    cos x, sin x
    -sin x, cos x
    */
-boost::numeric::ublas::matrix<double>  LC_Quadratic::rotationMatrix(const double& angle)
+LC_Quadratic::Matrix LC_Quadratic::rotationMatrix(const double& angle)
 {
-    boost::numeric::ublas::matrix<double> ret(2,2);
-    ret(0,0)=cos(angle);
-    ret(0,1)=sin(angle);
-    ret(1,0)=-ret(0,1);
-    ret(1,1)=ret(0,0);
-    return ret;
+    double const c=cos(angle);
+    double const s=sin(angle);
+    return {c, s, -s, c};
 }
 
 
@@ -26,9 +26,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #define LC_QUADRATIC_H
 
 
+#include <array>
 #include "rs_vector.h"
-#include <boost/numeric/ublas/matrix.hpp>
-#include <boost/numeric/ublas/io.hpp>
 
 class RS_VectorSolutions;
 class RS_AtomicEntity;
@@ -41,9 +40,51 @@ class RS_AtomicEntity;
  */
 class LC_Quadratic {
 public:
+	/** fixed size vector of the linear terms */
+	class Vector {
+	public:
+		constexpr Vector(double v0 = 0., double v1 = 0.):
+			v{v0, v1}
+		{}
+		double& operator () (size_t i) {
+			return v[i];
+		}
+		constexpr double operator () (size_t i) const {
+			return v[i];
+		}
+	private:
+		double v[2];
+	};
+
+	/** fixed size 2x2 matrix of the quadratic terms */
+	class Matrix {
+	public:
+		constexpr Matrix(double m00 = 0., double m01 = 0., double m10 = 0., double m11 = 0.):
+			m{{m00, m01}, {m10, m11}}
+		{}
+		double& operator () (size_t i, size_t j) {
+			return m[i][j];
+		}
+		constexpr double operator () (size_t i, size_t j) const {
+			return m[i][j];
+		}
+		constexpr Matrix transposed() const {
+			return {m[0][0], m[1][0], m[0][1], m[1][1]};
+		}
+		constexpr Matrix operator * (const Matrix& o) const {
+			return {m[0][0]*o.m[0][0] + m[0][1]*o.m[1][0], m[0][0]*o.m[0][1] + m[0][1]*o.m[1][1],
+					m[1][0]*o.m[0][0] + m[1][1]*o.m[1][0], m[1][0]*o.m[0][1] + m[1][1]*o.m[1][1]};
+		}
+		constexpr Vector operator * (const Vector& o) const {
+			return {m[0][0]*o(0) + m[0][1]*o(1), m[1][0]*o(0) + m[1][1]*o(1)};
+		}
+	private:
+		double m[2][2];
+	};
+
     explicit LC_Quadratic();
-    LC_Quadratic(const LC_Quadratic& lc0);
-    LC_Quadratic& operator = (const LC_Quadratic& lc0);
+    LC_Quadratic(const LC_Quadratic& lc0) = default;
+    LC_Quadratic& operator = (const LC_Quadratic& lc0) = default;
 	/** \brief construct a ellipse or hyperbola as the path of center of tangent circles
       passing the point */
     LC_Quadratic(const RS_AtomicEntity* circle, const RS_Vector& point);
@@ -85,30 +126,35 @@ public:
 	bool operator == (bool valid) const;
 	bool operator != (bool valid) const;
 
-	boost::numeric::ublas::vector<double>& getLinear();
-	 const boost::numeric::ublas::vector<double>& getLinear() const;
-	 boost::numeric::ublas::matrix<double>& getQuad();
-	 const boost::numeric::ublas::matrix<double>& getQuad() const;
+	Vector& getLinear();
+	const Vector& getLinear() const;
+	Matrix& getQuad();
+	const Matrix& getQuad() const;
 	 double const& constTerm()const;
 	 double& constTerm();
 
     /** switch x,y coordinates */
     LC_Quadratic flipXY(void) const;
     /** the matrix of rotation by angle **/
-    static boost::numeric::ublas::matrix<double> rotationMatrix(const double& angle);
+    static Matrix rotationMatrix(const double& angle);
 
     static RS_VectorSolutions getIntersection(const LC_Quadratic& l1, const LC_Quadratic& l2);
 
     friend std::ostream& operator << (std::ostream& os, const LC_Quadratic& l);
 
 private:
+    /** coefficients in the order of getCoefficients() for a quadratic form */
+    std::array<double, 6> quadraticCoefficients() const;
+    /** coefficients in the order of getCoefficients() for a linear form */
+    std::array<double, 3> linearCoefficients() const;
+
     // the equation form: {x, y}.m_mQuad.{{x},{y}} + m_vLinear.{{x},{y}}+m_dConst=0
-    boost::numeric::ublas::matrix<double> m_mQuad;
-    boost::numeric::ublas::vector<double> m_vLinear;
-    double m_dConst;
-    bool m_bIsQuadratic;
+    Matrix m_mQuad;
+    Vector m_vLinear;
+    double m_dConst {0.};
+    bool m_bIsQuadratic {false};
     /** whether this quadratic form is valid */
-    bool m_bValid;
+    bool m_bValid {false};
 };
 
 
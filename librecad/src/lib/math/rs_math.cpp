@@ -23,9 +23,6 @@
 ** This copyright notice MUST APPEAR in all copies of the script!
 **
 **********************************************************************/
-#include <boost/numeric/ublas/matrix.hpp>
-#include <boost/numeric/ublas/io.hpp>
-#include <boost/numeric/ublas/lu.hpp>
 #include <boost/math/special_functions/ellint_2.hpp>
 
 #include <cmath>
@@ -46,6 +43,136 @@
 
 namespace {
 constexpr double m_piX2 = M_PI*2; //2*PI
+
+/**
+ * Up to two real roots of a quadratic equation, kept on the stack
+ */
+class QuadraticRoots {
+public:
+	size_t size() const {
+		return count;
+	}
+	double operator [] (size_t i) const {
+		return roots[i];
+	}
+	double* begin() {
+		return roots;
+	}
+	double* end() {
+		return roots + count;
+	}
+	const double* begin() const {
+		return roots;
+	}
+	const double* end() const {
+		return roots + count;
+	}
+	void push_back(double x) {
+		roots[count++] = x;
+	}
+	double front() const {
+		return roots[0];
+	}
+private:
+	double roots[2] {0., 0.};
+	size_t count {0};
+};
+
+/**
+ * Real roots of x^2 + p x + q = 0, see RS_Math::quadraticSolver()
+ */
+QuadraticRoots quadraticRoots(double p, double q)
+{
+    QuadraticRoots ans;
+	using LDouble = long double;
+	LDouble const b = -0.5L * p;
+	LDouble const c = q;
+	// x^2 -2 b x + c=0
+	// (x - b)^2 = b^2 - c
+	// b^2 >= fabs(c)
+	// x = b \pm b sqrt(1. - c/(b^2))
+	LDouble const b2= b * b;
+	LDouble const discriminant= b2 - c;
+	LDouble const fc = std::abs(c);
+
+	//TODO, fine tune to tolerance level
+	LDouble const TOL = 1e-24L;
+
+	if (discriminant < 0.L)
+		//negative discriminant, no real root
+		return ans;
+
+	//find the radical
+	LDouble r;
+
+	// given |p| >= |q|
+	// sqrt(p^2 \pm q^2) = p sqrt(1 \pm q^2/p^2)
+	if (b2 >= fc)
+		r = std::abs(b) * std::sqrt(1.L - c/b2);
+	else
+		// c is negative, because b2 - c is non-negative
+		r = std::sqrt(fc) * std::sqrt(1.L + b2/fc);
+
+	if (r >= TOL*std::abs(b)) {
+		//two roots
+		if (b >= 0.L)
+			//since both (b,r)>=0, avoid (b - r) loss of significance
+			ans.push_back(b + r);
+		else
+			//since b<0, r>=0, avoid (b + r) loss of significance
+			ans.push_back(b - r);
+
+		//Vieta's formulas for the second root
+		ans.push_back(c/ans.front());
+	} else
+		//multiple roots
+		ans.push_back(b);
+	return ans;
+}
+
+/**
+ * Gauss-Jordan elimination with partial pivoting, shared by the
+ * RS_Math::linearSolver() overloads.
+ *
+ * @param mt0 augmented matrix of mSize rows, overwritten
+ * @param sn holds the solution, must have mSize elements
+ */
+template <class Matrix, class Solution>
+bool gaussJordan(Matrix& mt0, size_t mSize, Solution& sn)
+{
+	for(size_t i=0;i<mSize;++i){
+		size_t imax(i);
+        double cmax(fabs(mt0[i][i]));
+		for(size_t j=i+1;j<mSize;++j) {
+            if(fabs(mt0[j][i]) > cmax ) {
+                imax=j;
+                cmax=fabs(mt0[j][i]);
+            }
+        }
+        if(cmax<RS_TOLERANCE2) return false; //singular matrix
+        if(imax != i) {//move the line with largest absolute value at column i to row i, to avoid division by zero
+            std::swap(mt0[i],mt0[imax]);
+		}
+		for(size_t k=i+1;k<=mSize;++k) { //normalize the i-th row
+            mt0[i][k] /= mt0[i][i];
+        }
+		mt0[i][i]=1.;
+		for(size_t j=0;j<mSize;++j) {//Gauss-Jordan
+            if(j != i ) {
+				double& a = mt0[j][i];
+				for(size_t k=i+1;k<=mSize;++k) {
+					mt0[j][k] -= mt0[i][k]*a;
+                }
+				a=0.;
+            }
+		}
+    }
+	for(size_t i=0;i<mSize;++i) {
+        sn[i]=mt0[i][mSize];
+    }
+
+    return true;
+}
 }
 
 /**
@@ -498,52 +625,9 @@ std::vector<double> RS_Math::quadraticSolver(const std::vector<double>& ce)
 //quadratic solver for
 // x^2 + ce[0] x + ce[1] =0
 {
-    std::vector<double> ans(0,0.);
-	if (ce.size() != 2) return ans;
-	using LDouble = long double;
-	LDouble const b = -0.5L * ce[0];
-	LDouble const c = ce[1];
-	// x^2 -2 b x + c=0
-	// (x - b)^2 = b^2 - c
-	// b^2 >= fabs(c)
-	// x = b \pm b sqrt(1. - c/(b^2))
-	LDouble const b2= b * b;
-	LDouble const discriminant= b2 - c;
-	LDouble const fc = std::abs(c);
-
-	//TODO, fine tune to tolerance level
-	LDouble const TOL = 1e-24L;
-
-	if (discriminant < 0.L)
-		//negative discriminant, no real root
-		return ans;
-
-	//find the radical
-	LDouble r;
-
-	// given |p| >= |q|
-	// sqrt(p^2 \pm q^2) = p sqrt(1 \pm q^2/p^2)
-	if (b2 >= fc)
-		r = std::abs(b) * std::sqrt(1.L - c/b2);
-	else
-		// c is negative, because b2 - c is non-negative
-		r = std::sqrt(fc) * std::sqrt(1.L + b2/fc);
-
-	if (r >= TOL*std::abs(b)) {
-		//two roots
-		if (b >= 0.L)
-			//since both (b,r)>=0, avoid (b - r) loss of significance
-			ans.push_back(b + r);
-		else
-			//since b<0, r>=0, avoid (b + r) loss of significance
-			ans.push_back(b - r);
-
-		//Vieta's formulas for the second root
-		ans.push_back(c/ans.front());
-	} else
-		//multiple roots
-		ans.push_back(b);
-	return ans;
+	if (ce.size() != 2) return {};
+	auto const r=quadraticRoots(ce[0], ce[1]);
+	return {r.begin(), r.end()};
 }
 
 
@@ -581,10 +665,7 @@ std::vector<double> RS_Math::cubicSolver(const std::vector<double>& ce)
     }
     //std::cout<<"discriminant="<<discriminant<<std::endl;
     if(discriminant>0) {
-        std::vector<double> ce2(2,0.);
-        ce2[0]=q;
-        ce2[1]=-1./27*p*p*p;
-		auto r=quadraticSolver(ce2);
+		auto r=quadraticRoots(q, -1./27*p*p*p);
         if ( r.size()==0 ) { //should not happen
 			std::cerr<<__FILE__<<" : "<<__func__<<" : line"<<__LINE__<<" :cubicSolver()::Error cubicSolver("<<ce[0]<<' '<<ce[1]<<' '<<ce[2]<<")\n";
         }
@@ -729,29 +810,20 @@ std::vector<double> RS_Math::quarticSolver(const std::vector<double>& ce)
             return ans;
         }
         double sqrtz0=sqrt(r3[0]);
-        std::vector<double> ce2(2,0.);
-        ce2[0]=	-sqrtz0;
-        ce2[1]=0.5*(p+r3[0])+0.5*q/sqrtz0;
-        auto r1=quadraticSolver(ce2);
+        auto r1=quadraticRoots(-sqrtz0, 0.5*(p+r3[0])+0.5*q/sqrtz0);
         if (r1.size()==0 ) {
-            ce2[0]=	sqrtz0;
-            ce2[1]=0.5*(p+r3[0])-0.5*q/sqrtz0;
-            r1=quadraticSolver(ce2);
+            r1=quadraticRoots(sqrtz0, 0.5*(p+r3[0])-0.5*q/sqrtz0);
         }
 		for(auto& x: r1){
 			x -= shift;
 		}
-        return r1;
+        return {r1.begin(), r1.end()};
     }
     if ( r3[0]> 0. && r3[1] > 0. ) {
         double sqrtz0=sqrt(r3[0]);
-        std::vector<double> ce2(2,0.);
-        ce2[0]=	-sqrtz0;
-        ce2[1]=0.5*(p+r3[0])+0.5*q/sqrtz0;
-        ans=quadraticSolver(ce2);
-        ce2[0]=	sqrtz0;
-        ce2[1]=0.5*(p+r3[0])-0.5*q/sqrtz0;
-		auto r1=quadraticSolver(ce2);
+		auto const r0=quadraticRoots(-sqrtz0, 0.5*(p+r3[0])+0.5*q/sqrtz0);
+		auto const r1=quadraticRoots(sqrtz0, 0.5*(p+r3[0])-0.5*q/sqrtz0);
+		ans.assign(r0.begin(), r0.end());
 		std::copy(r1.begin(),r1.end(),std::back_inserter(ans));
 		for(auto& x: ans){
 			x -= shift;
@@ -855,92 +927,14 @@ bool RS_Math::linearSolver(const std::vector<std::vector<double> >& mt, std::vec
 }))
 		return false;
     sn.resize(mSize);//to hold the solution
-#if false
-    boost::numeric::ublas::matrix<double> bm (mSize, mSize);
-    boost::numeric::ublas::vector<double> bs(mSize);
-
-    for(int i=0;i<mSize;i++) {
-        for(int j=0;j<mSize;j++) {
-            bm(i,j)=mt[i][j];
-        }
-        bs(i)=mt[i][mSize];
-    }
-    //solve the linear equation set by LU decomposition in boost ublas
-
-    if ( boost::numeric::ublas::lu_factorize<boost::numeric::ublas::matrix<double> >(bm) ) {
-		std::cout<<__FILE__<<" : "<<__func__<<" : line "<<__LINE__<<std::endl;
-        std::cout<<" linear solver failed"<<std::endl;
-        //        RS_DEBUG->print(RS_Debug::D_WARNING, "linear solver failed");
-        return false;
-    }
-
-    boost::numeric::ublas:: triangular_matrix<double, boost::numeric::ublas::unit_lower>
-            lm = boost::numeric::ublas::triangular_adaptor< boost::numeric::ublas::matrix<double>,  boost::numeric::ublas::unit_lower>(bm);
-    boost::numeric::ublas:: triangular_matrix<double,  boost::numeric::ublas::upper>
-            um =  boost::numeric::ublas::triangular_adaptor< boost::numeric::ublas::matrix<double>,  boost::numeric::ublas::upper>(bm);
-    ;
-    boost::numeric::ublas::inplace_solve(lm,bs, boost::numeric::ublas::lower_tag());
-    boost::numeric::ublas::inplace_solve(um,bs, boost::numeric::ublas::upper_tag());
-    for(int i=0;i<mSize;i++){
-        sn[i]=bs(i);
-    }
-    //    std::cout<<"dn="<<dn<<std::endl;
-    //    data.center.set(-0.5*dn(1)/dn(0),-0.5*dn(3)/dn(2)); // center
-    //    double d(1.+0.25*(dn(1)*dn(1)/dn(0)+dn(3)*dn(3)/dn(2)));
-    //    if(fabs(dn(0))<RS_TOLERANCE2
-    //            ||fabs(dn(2))<RS_TOLERANCE2
-    //            ||d/dn(0)<RS_TOLERANCE2
-    //            ||d/dn(2)<RS_TOLERANCE2
-    //            ) {
-    //        //ellipse not defined
-    //        return false;
-    //    }
-    //    d=sqrt(d/dn(0));
-    //    data.majorP.set(d,0.);
-    //    data.ratio=sqrt(dn(0)/dn(2));
-#else
     // solve the linear equation by Gauss-Jordan elimination
 	std::vector<std::vector<double> > mt0(mt); //copy the matrix;
-	for(size_t i=0;i<mSize;++i){
-		size_t imax(i);
-        double cmax(fabs(mt0[i][i]));
-		for(size_t j=i+1;j<mSize;++j) {
-            if(fabs(mt0[j][i]) > cmax ) {
-                imax=j;
-                cmax=fabs(mt0[j][i]);
-            }
-        }
-        if(cmax<RS_TOLERANCE2) return false; //singular matrix
-        if(imax != i) {//move the line with largest absolute value at column i to row i, to avoid division by zero
-            std::swap(mt0[i],mt0[imax]);
-		}
-		for(size_t k=i+1;k<=mSize;++k) { //normalize the i-th row
-            mt0[i][k] /= mt0[i][i];
-        }
-		mt0[i][i]=1.;
-		for(size_t j=0;j<mSize;++j) {//Gauss-Jordan
-            if(j != i ) {
-				double& a = mt0[j][i];
-				for(size_t k=i+1;k<=mSize;++k) {
-					mt0[j][k] -= mt0[i][k]*a;
-                }
-				a=0.;
-            }
-		}
-		//output gauss-jordan results for debugging
-//		std::cout<<"========"<<i<<"==========\n";
-//		for(auto v0: mt0){
-//			for(auto v1:v0)
-//				std::cout<<v1<<'\t';
-//			std::cout<<std::endl;
-//		}
-    }
-	for(size_t i=0;i<mSize;++i) {
-        sn[i]=mt0[i][mSize];
-    }
-#endif
+	return gaussJordan(mt0, mSize, sn);
+}
 
-    return true;
+bool RS_Math::linearSolver(const std::array<std::array<double, 3>, 2>& mt, std::array<double, 2>& sn){
+	std::array<std::array<double, 3>, 2> mt0(mt); //copy the matrix;
+	return gaussJordan(mt0, mt0.size(), sn);
 }
 
 /**
@@ -1007,12 +1001,20 @@ RS_VectorSolutions RS_Math::simultaneousQuadraticSolver(const std::vector<double
   */
 RS_VectorSolutions RS_Math::simultaneousQuadraticSolverFull(const std::vector<std::vector<double> >& m)
 {
-    RS_VectorSolutions ret;
-    if(m.size()!=2)  return ret;
+    if(m.size()!=2)  return {};
     if( m[0].size() ==3 || m[1].size()==3 ){
         return simultaneousQuadraticSolverMixed(m);
     }
-    if(m[0].size()!=6 || m[1].size()!=6) return ret;
+    if(m[0].size()!=6 || m[1].size()!=6) return {};
+    std::array<std::array<double, 6>, 2> m0;
+    std::copy(m[0].begin(), m[0].end(), m0[0].begin());
+    std::copy(m[1].begin(), m[1].end(), m0[1].begin());
+    return simultaneousQuadraticSolverFull(m0);
+}
+
+RS_VectorSolutions RS_Math::simultaneousQuadraticSolverFull(const std::array<std::array<double, 6>, 2>& m)
+{
+    RS_VectorSolutions ret;
     /** eliminate x, quartic equation of y **/
     auto& a=m[0][0];
     auto& b=m[0][1];
@@ -1087,7 +1089,7 @@ RS_VectorSolutions RS_Math::simultaneousQuadraticSolverFull(const std::vector<st
     if (roots.size()==0 ) { // no intersection found
         return ret;
     }
-    std::vector<double> ce(0,0.);
+    std::array<double, 3> ce;
 
     for(size_t i0=0;i0<roots.size();i0++){
         if(RS_DEBUG->getLevel()>=RS_Debug::D_INFORMATIONAL){
@@ -1097,7 +1099,6 @@ RS_VectorSolutions RS_Math::simultaneousQuadraticSolverFull(const std::vector<st
         /*
           Collect[Eliminate[{ a*x^2 + b*x*y+c*y^2+d*x+e*y+f==0,g*x^2+h*x*y+i*y^2+j*x+k*y+l==0},x],y]
           */
-        ce.resize(3);
         ce[0]=a;
         ce[1]=b*roots[i0]+d;
         ce[2]=c*roots[i0]*roots[i0]+e*roots[i0]+f;
@@ -1114,12 +1115,9 @@ RS_VectorSolutions RS_Math::simultaneousQuadraticSolverFull(const std::vector<st
         if(fabs(ce[0])<1e-75 && fabs(ce[1])<1e-75) continue;
 
         if(fabs(a)>1e-75){
-            std::vector<double> ce2(2,0.);
-            ce2[0]=ce[1]/ce[0];
-            ce2[1]=ce[2]/ce[0];
 //                DEBUG_HEADER
-//                        std::cout<<"x^2 +("<<ce2[0]<<")*x+("<<ce2[1]<<")==0"<<std::endl;
-			auto xRoots=quadraticSolver(ce2);
+//                        std::cout<<"x^2 +("<<ce[1]/ce[0]<<")*x+("<<ce[2]/ce[0]<<")==0"<<std::endl;
+			auto xRoots=quadraticRoots(ce[1]/ce[0], ce[2]/ce[0]);
             for(size_t j0=0;j0<xRoots.size();j0++){
 //                DEBUG_HEADER
 //                std::cout<<"x="<<xRoots[j0]<<std::endl;
@@ -1148,32 +1146,43 @@ RS_VectorSolutions RS_Math::simultaneousQuadraticSolverMixed(const std::vector<s
     }
     if(p1->size()==3) {
             //linear
-			std::vector<double> sn(2,0.);
-			std::vector<std::vector<double> > ce;
-			ce.push_back(m[0]);
-			ce.push_back(m[1]);
-            ce[0][2]=-ce[0][2];
-            ce[1][2]=-ce[1][2];
+			std::array<double, 2> sn;
+			std::array<std::array<double, 3>, 2> ce{{
+					{{m[0][0], m[0][1], -m[0][2]}},
+					{{m[1][0], m[1][1], -m[1][2]}}
+				}};
             if( RS_Math::linearSolver(ce,sn)) ret.push_back(RS_Vector(sn[0],sn[1]));
             return ret;
     }
+    if(p0->size()!=3 || p1->size()!=6) return ret;
+    std::array<double, 3> l;
+    std::array<double, 6> q;
+    std::copy(p0->begin(), p0->end(), l.begin());
+    std::copy(p1->begin(), p1->end(), q.begin());
+    return simultaneousQuadraticSolverMixed(l, q);
+}
+
+RS_VectorSolutions RS_Math::simultaneousQuadraticSolverMixed(const std::array<double, 3>& l,
+															 const std::array<double, 6>& q)
+{
+    RS_VectorSolutions ret;
 //    DEBUG_HEADER
 //    std::cout<<"p0: size="<<p0->size()<<"\n Solve[{("<< p0->at(0)<<")*x + ("<<p0->at(1)<<")*y + ("<<p0->at(2)<<")==0,";
 //    std::cout<<"("<< p1->at(0)<<")*x^2 + ("<<p1->at(1)<<")*x*y + ("<<p1->at(2)<<")*y^2 + ("<<p1->at(3)<<")*x +("<<p1->at(4)<<")*y+("
 //            <<p1->at(5)<<")==0},{x,y}]"<<std::endl;
-    const double& a=p0->at(0);
-    const double& b=p0->at(1);
-    const double& c=p0->at(2);
-    const double& d=p1->at(0);
-    const double& e=p1->at(1);
-    const double& f=p1->at(2);
-    const double& g=p1->at(3);
-    const double& h=p1->at(4);
-    const double& i=p1->at(5);
+    const double& a=l[0];
+    const double& b=l[1];
+    const double& c=l[2];
+    const double& d=q[0];
+    const double& e=q[1];
+    const double& f=q[2];
+    const double& g=q[3];
+    const double& h=q[4];
+    const double& i=q[5];
     /**
       y (2 b c d-a c e)-a c g+c^2 d = y^2 (a^2 (-f)+a b e-b^2 d)+y (a b g-a^2 h)+a^2 (-i)
       */
-    std::vector<double> ce(3,0.);
+    std::array<double, 3> ce;
 	const double& a2=a*a;
 	const double& b2=b*b;
 	const double& c2=c*c;
@@ -1182,14 +1191,11 @@ RS_VectorSolutions RS_Math::simultaneousQuadraticSolverMixed(const std::vector<s
     ce[2]=a*c*g-c2*d-a2*i;
 //    DEBUG_HEADER
 //    std::cout<<"("<<ce[0]<<") y^2 + ("<<ce[1]<<") y + ("<<ce[2]<<")==0"<<std::endl;
-    std::vector<double> roots(0,0.);
+    QuadraticRoots roots;
     if( fabs(ce[1])>RS_TOLERANCE15 && fabs(ce[0]/ce[1])<RS_TOLERANCE15){
         roots.push_back( - ce[2]/ce[1]);
     }else{
-        std::vector<double> ce2(2,0.);
-        ce2[0]=ce[1]/ce[0];
-        ce2[1]=ce[2]/ce[0];
-        roots=quadraticSolver(ce2);
+        roots=quadraticRoots(ce[1]/ce[0], ce[2]/ce[0]);
     }
 //    for(size_t i=0;i<roots.size();i++){
 //    std::cout<<"x="<<roots.at(i)<<std::endl;
@@ -1200,7 +1206,7 @@ RS_VectorSolutions RS_Math::simultaneousQuadraticSolverMixed(const std::vector<s
         return RS_VectorSolutions();
     }
     for(size_t i=0;i<roots.size();i++){
-        ret.push_back(RS_Vector(-(b*roots.at(i)+c)/a,roots.at(i)));
+        ret.push_back(RS_Vector(-(b*roots[i]+c)/a,roots[i]));
 //        std::cout<<ret.at(ret.size()-1).x<<", "<<ret.at(ret.size()-1).y<<std::endl;
     }
 
@@ -1214,6 +1220,15 @@ RS_VectorSolutions RS_Math::simultaneousQuadraticSolverMixed(const std::vector<s
   *@return true, for a valid solution
   **/
 bool RS_Math::simultaneousQuadraticVerify(const std::vector<std::vector<double> >& m, RS_Vector& v)
+{
+	if(m.size()!=2 || m[0].size()!=6 || m[1].size()!=6) return false;
+	std::array<std::array<double, 6>, 2> m0;
+	std::copy(m[0].begin(), m[0].end(), m0[0].begin());
+	std::copy(m[1].begin(), m[1].end(), m0[1].begin());
+	return simultaneousQuadraticVerify(m0, v);
+}
+
+bool RS_Math::simultaneousQuadraticVerify(const std::array<std::array<double, 6>, 2>& m, RS_Vector& v)
 {
 	RS_Vector v0=v;
 	auto& a=m[0][0];
@@ -1250,8 +1265,8 @@ bool RS_Math::simultaneousQuadraticVerify(const std::vector<std::vector<double>
 			if(amax0<fabs(terms0[i])) amax0=fabs(terms0[i]);
 			sum0 += terms0[i];
 		}
-		std::vector<std::vector<double>> nrCe;
-		nrCe.push_back(std::vector<double>{px, py, sum0});
+		std::array<std::array<double, 3>, 2> nrCe;
+		nrCe[0]={{px, py, sum0}};
 		px=2.*g*x+h*y+j;
 		py=h*x+2.*i*y+k;
 		sum1=0.;
@@ -1259,8 +1274,8 @@ bool RS_Math::simultaneousQuadraticVerify(const std::vector<std::vector<double>
 			if(amax1<fabs(terms0[i])) amax1=fabs(terms0[i]);
 			sum1 += terms0[i];
 		}
-		nrCe.push_back(std::vector<double>{px, py, sum1});
-		std::vector<double> dn;
+		nrCe[1]={{px, py, sum1}};
+		std::array<double, 2> dn;
 		bool ret=linearSolver(nrCe, dn);
 //		DEBUG_HEADER
 //		qDebug()<<"i0="<<i0<<"\tf=("<<sum0<<','<<sum1<<")\tdn=("<<dn[0]<<","<<dn[1]<<")";
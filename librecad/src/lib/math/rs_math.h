@@ -27,6 +27,7 @@
 #ifndef RS_MATH_H
 #define RS_MATH_H
 
+#include <array>
 #include <vector>
 #include <string>
 
@@ -105,6 +106,8 @@ public:
 	  *@author: Dongxu Li
       */
 	static bool linearSolver(const std::vector<std::vector<double> >& m, std::vector<double>& sn);
+	/** \brief linearSolver for two unknowns on fixed size arrays, doesn't allocate */
+	static bool linearSolver(const std::array<std::array<double, 3>, 2>& m, std::array<double, 2>& sn);
 
     /** solver quadratic simultaneous equations of a set of two **/
     /* solve the following quadratic simultaneous equations,
@@ -128,7 +131,14 @@ public:
       *@return a RS_VectorSolutions contains real roots (x,y)
       */
     static RS_VectorSolutions simultaneousQuadraticSolverFull(const std::vector<std::vector<double> >& m);
+    static RS_VectorSolutions simultaneousQuadraticSolverFull(const std::array<std::array<double, 6>, 2>& m);
     static RS_VectorSolutions simultaneousQuadraticSolverMixed(const std::vector<std::vector<double> >& m);
+	/** \brief simultaneousQuadraticSolverMixed of a linear equation
+	  * l0 x + l1 y + l2 = 0 and a quadratic equation in the order of
+	  * simultaneousQuadraticSolverFull()
+	  */
+	static RS_VectorSolutions simultaneousQuadraticSolverMixed(const std::array<double, 3>& l,
+															   const std::array<double, 6>& q);
 
 	/** \brief verify simultaneousQuadraticVerify a solution for simultaneousQuadratic
 	  *@param m the coefficient matrix
@@ -136,6 +146,7 @@ public:
       *@return true, for a valid solution
       **/
 	static bool simultaneousQuadraticVerify(const std::vector<std::vector<double> >& m, RS_Vector& v);
+	static bool simultaneousQuadraticVerify(const std::array<std::array<double, 6>, 2>& m, RS_Vector& v);
     /** wrapper for elliptic integral **/
     /**
      * wrapper of elliptic integral of the second type, Legendre form
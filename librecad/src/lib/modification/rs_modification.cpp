@@ -40,12 +40,16 @@
 #include "rs_polyline.h"
 #include "rs_mtext.h"
 #include "rs_text.h"
+#include "rs_dimension.h"
 #include "rs_layer.h"
 #include "lc_splinepoints.h"
+#include "rs_spline.h"
 #include "rs_math.h"
 #include "rs_debug.h"
 #include "rs_dialogfactory.h"
 #include "lc_undosection.h"
+#include "lc_undodelta.h"
+#include "lc_intersectionindex.h"
 
 #ifdef EMU_C99
 #include "emu_c99.h"
@@ -91,10 +95,10 @@ RS_Modification::RS_Modification(RS_EntityContainer& container,
  */
 void RS_Modification::remove() {
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::remove");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::remove");
 
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::remove: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::remove: no valid container");
         return;
     }
 
@@ -106,13 +110,13 @@ void RS_Modification::remove() {
             e->changeUndoState();
             undo.addUndoable(e);
         } else {
-            RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Modification::remove: no valid container is selected");
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_Modification::remove: no valid container is selected");
         }
     }
 
     graphicView->redraw(RS2::RedrawDrawing);
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::remove: OK");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::remove: OK");
 }
 
 
@@ -122,10 +126,10 @@ void RS_Modification::remove() {
  */
 void RS_Modification::revertDirection() {
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::revertDirection");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::revertDirection");
 
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::revertDirection: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::revertDirection: no valid container");
 		return;
 	}
 
@@ -136,7 +140,7 @@ void RS_Modification::revertDirection() {
 			ec->revertDirection();
 			addList.push_back(ec);
         } else {
-        RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Modification::revertDirection: no valid container is selected");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_Modification::revertDirection: no valid container is selected");
         }
 	}
 
@@ -144,7 +148,7 @@ void RS_Modification::revertDirection() {
     deselectOriginals(true);
 	addNewEntities(addList);
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::revertDirection: OK");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::revertDirection: OK");
 }
 
 
@@ -152,127 +156,117 @@ void RS_Modification::revertDirection() {
 /**
  * Changes the attributes of container sub-entities. Recursive
  */
-bool RS_Modification::changeAttributes(RS_AttributesData& data, RS_EntityContainer* container, std::vector<RS_Entity*> addList) {
+bool RS_Modification::changeAttributes(RS_AttributesData& data, RS_EntityContainer* container, LC_UndoAttributes* delta) {
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::changeAttributes");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::changeAttributes");
 
     if (!container) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::changeAttributes: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::changeAttributes: no valid container");
         return false;
     }
 
     for(auto e: *container) {
 
         if (!e) {
-            RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::changeAttributes: nullptr in container");
+            RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::changeAttributes: nullptr in container");
             return false;
         }
 
-        e->setSelected(false);
-        RS_Pen pen = e->getPen(false);
+        changeEntityAttributes(data, e, delta);
+    }
 
-        if (data.changeLayer==true) {
-            e->setLayer(data.layer);
-        }
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::changeAttributes: OK");
+    return true;
+}
 
-        if (data.changeColor==true) {
-            pen.setColor(data.pen.getColor());
-        }
-        if (data.changeLineType==true) {
-            pen.setLineType(data.pen.getLineType());
-        }
-        if (data.changeWidth==true) {
-            pen.setWidth(data.pen.getWidth());
-        }
-        e->setPen(pen);
 
-        if (e->isContainer()) {
-            if (e->rtti() == RS2::EntityInsert) {
-                RS_Block* eb = static_cast<RS_Insert*>(e)->getBlockForInsert();
-                changeAttributes(data, (RS_EntityContainer*)eb, addList);
-            } else {
-                changeAttributes(data, (RS_EntityContainer*)e, addList);
+
+/**
+ * Changes the attributes of a single entity and its sub-entities,
+ * for inserts the entities of their block.
+ * The previous attributes are recorded in delta for undo, if given.
+ */
+void RS_Modification::changeEntityAttributes(RS_AttributesData& data, RS_Entity* e, LC_UndoAttributes* delta) {
+
+    e->setSelected(false);
+    RS_Pen oldPen = e->getPen(false);
+    RS_Layer* oldLayer = e->getLayer(false);
+    RS_Pen pen = oldPen;
+
+    if (data.changeLayer==true) {
+        e->setLayer(data.layer);
+    }
+
+    if (data.changeColor==true) {
+        pen.setColor(data.pen.getColor());
+    }
+    if (data.changeLineType==true) {
+        pen.setLineType(data.pen.getLineType());
+    }
+    if (data.changeWidth==true) {
+        pen.setWidth(data.pen.getWidth());
+    }
+    e->setPen(pen);
+
+    if (delta) {
+        delta->addChange(e, oldPen, oldLayer);
+    }
+
+    if (e->isContainer()) {
+        if (e->rtti() == RS2::EntityInsert) {
+            RS_Block* eb = static_cast<RS_Insert*>(e)->getBlockForInsert();
+            if (eb) {
+                changeAttributes(data, eb, delta);
             }
+        } else {
+            changeAttributes(data, static_cast<RS_EntityContainer*>(e), delta);
         }
-        e->update();
     }
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::changeAttributes: OK");
-    return true;
+    e->update();
 }
 
 
 
 /**
  * Changes the attributes of all selected
+ *
+ * Only the changed pens and layers are recorded for undo
+ * (LC_UndoAttributes), the entities are modified in place.
  */
 bool RS_Modification::changeAttributes(RS_AttributesData& data) {
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::changeAttributes");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::changeAttributes");
 
     if (!container) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::changeAttributes: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::changeAttributes: no valid container");
         return false;
     }
 
-    LC_UndoSection  undo(document);
-    std::vector<RS_Entity*> addList;
+    LC_UndoSection  undo(document, handleUndo);
+    LC_UndoAttributes* delta = (document && handleUndo) ? new LC_UndoAttributes() : nullptr;
 
     for(auto e: *container) {
-//        for (unsigned i=0; i<container->count(); ++i) {
-//        RS_Entity* e = container->entityAt(i);
         if (e && e->isSelected()) {
-
-            e->setSelected(false);
-            RS_Pen pen = e->getPen(false);
-
-            if (data.changeLayer==true) {
-                e->setLayer(data.layer);
-            }
-
-            if (data.changeColor==true) {
-                pen.setColor(data.pen.getColor());
-            }
-            if (data.changeLineType==true) {
-                pen.setLineType(data.pen.getLineType());
-            }
-            if (data.changeWidth==true) {
-                pen.setWidth(data.pen.getWidth());
-            }
-            e->setPen(pen);
-
-            if (e->isContainer()) {
-                if (e->rtti() == RS2::EntityInsert) {
-                    RS_Block* eb = static_cast<RS_Insert*>(e)->getBlockForInsert();
-                    changeAttributes(data, (RS_EntityContainer*)eb, addList);
-                } else {
-                    changeAttributes(data, (RS_EntityContainer*)e, addList);
-                }
-            }
-
-            e->update();
-
-            //if (data.useCurrentLayer) {
-            //    ec->setLayerToActive();
-            //}
-            //if (data.useCurrentAttributes) {
-            //    ec->setPenToActive();
-            //}
-            //if (ec->rtti()==RS2::EntityInsert) {
-            //    ((RS_Insert*)ec)->update();
-            //}
+            changeEntityAttributes(data, e, delta);
         } else {
-            RS_DEBUG->print(RS_Debug::D_NOTICE, "RS_Modification::changeAttributes: no valid container is selected");
+            RS_DEBUG_PRINT(RS_Debug::D_NOTICE, "RS_Modification::changeAttributes: no valid container is selected");
         }
     }
 
-    deselectOriginals(true);
+    if (delta) {
+        if (delta->isEmpty()) {
+            delete delta;
+        } else {
+            undo.addUndoable(delta);
+        }
+    }
 
     if (graphicView) {
         graphicView->redraw(RS2::RedrawDrawing);
     }
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::changeAttributes: OK");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::changeAttributes: OK");
     return true;
 }
 
@@ -289,10 +283,10 @@ bool RS_Modification::changeAttributes(RS_AttributesData& data) {
  */
 void RS_Modification::copy(const RS_Vector& ref, const bool cut) {
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copy");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copy");
 
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::copy: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::copy: no valid container");
         return;
     }
 
@@ -313,11 +307,11 @@ void RS_Modification::copy(const RS_Vector& ref, const bool cut) {
         if (e && e->isSelected()) {
             copyEntity(e, ref, cut);
         } else {
-            RS_DEBUG->print(RS_Debug::D_NOTICE, "RS_Modification::copy: no valid container is selected");
+            RS_DEBUG_PRINT(RS_Debug::D_NOTICE, "RS_Modification::copy: no valid container is selected");
         }
     }
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copy: OK");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copy: OK");
 }
 
 
@@ -333,15 +327,15 @@ void RS_Modification::copy(const RS_Vector& ref, const bool cut) {
  */
 void RS_Modification::copyEntity(RS_Entity* e, const RS_Vector& ref, const bool cut) {
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyEntity");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyEntity");
 
     if (!e || !e->isSelected()) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::copyEntity: no entity is selected");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::copyEntity: no entity is selected");
         return;
     }
 
     // add entity to clipboard:
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyEntity: to clipboard: %d/%d", e->getId(), e->rtti());
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyEntity: to clipboard: %d/%d", e->getId(), e->rtti());
     RS_Entity* c = e->clone();
     c->move(-ref);
 
@@ -354,7 +348,7 @@ void RS_Modification::copyEntity(RS_Entity* e, const RS_Vector& ref, const bool
 
     if (cut) {
         LC_UndoSection undo( document);
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyEntity: cut ID/flag: %d/%d", e->getId(), e->rtti());
+        RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyEntity: cut ID/flag: %d/%d", e->getId(), e->rtti());
         e->changeUndoState();
         undo.addUndoable(e);
 
@@ -364,7 +358,7 @@ void RS_Modification::copyEntity(RS_Entity* e, const RS_Vector& ref, const bool
         }
         e->setSelected(false);
     } else {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyEntity: delete in view ID/flag: %d/%d", e->getId(), e->rtti());
+        RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyEntity: delete in view ID/flag: %d/%d", e->getId(), e->rtti());
         // delete entity in graphic view:
         if (graphicView) {
             graphicView->deleteEntity(e);
@@ -375,7 +369,7 @@ void RS_Modification::copyEntity(RS_Entity* e, const RS_Vector& ref, const bool
         }
     }
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyEntity: OK");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyEntity: OK");
 }
 
 
@@ -385,17 +379,17 @@ void RS_Modification::copyEntity(RS_Entity* e, const RS_Vector& ref, const bool
  */
 void RS_Modification::copyLayers(RS_Entity* e) {
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyLayers");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyLayers");
 
 	if (!e) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::copyLayers: no entity is selected");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::copyLayers: no entity is selected");
         return;
     }
 
     // add layer(s) of the entity insert can also be into any layer
     RS_Layer* l = e->getLayer();
     if (!l) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::copyLayers: no valid layer found");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::copyLayers: no valid layer found");
         return;
     }
 
@@ -406,10 +400,10 @@ void RS_Modification::copyLayers(RS_Entity* e) {
     // special handling of inserts:
     if (e->rtti()==RS2::EntityInsert) {
         // insert: add layer(s) of subentities:
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyLayers: copy insert entity ID/flag layers: %d/%d", e->getId(), e->rtti());
+        RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyLayers: copy insert entity ID/flag layers: %d/%d", e->getId(), e->rtti());
         RS_Block* b = ((RS_Insert*)e)->getBlockForInsert();
         if (!b) {
-            RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::copyLayers: could not find block for insert entity");
+            RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::copyLayers: could not find block for insert entity");
             return;
         }
         for(auto e2: *b) {
@@ -418,10 +412,10 @@ void RS_Modification::copyLayers(RS_Entity* e) {
             copyLayers(e2);
         }
     } else {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyLayers: skip noninsert entity");
+        RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyLayers: skip noninsert entity");
     }
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyLayers: OK");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyLayers: OK");
 }
 
 
@@ -431,41 +425,41 @@ void RS_Modification::copyLayers(RS_Entity* e) {
  */
 void RS_Modification::copyBlocks(RS_Entity* e) {
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks");
 
 	if (!e) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::copyBlocks: no entity to process");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::copyBlocks: no entity to process");
         return;
     }
 
     // add block of the entity only if it's an insert
     if (e->rtti()!=RS2::EntityInsert) {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: skip non-insert entity");
+        RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: skip non-insert entity");
         return;
     }
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: get insert entity ID/flag block: %d/%d", e->getId(), e->rtti());
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: get insert entity ID/flag block: %d/%d", e->getId(), e->rtti());
     RS_Block* b = ((RS_Insert*)e)->getBlockForInsert();
     if (!b) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::copyBlocks: could not find block for insert entity");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::copyBlocks: could not find block for insert entity");
         return;
     }
     // add block of an insert
     QString bn = b->getName();
     if (!RS_CLIPBOARD->hasBlock(bn)) {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: add block name: %s", bn.toLatin1().data());
+        RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: add block name: %s", bn.toLatin1().data());
         RS_CLIPBOARD->addBlock((RS_Block*)b->clone());
     }
     //find insert into insert
     for(auto e2: *b) {
         //call copyBlocks only if entity are insert
         if (e2->rtti()==RS2::EntityInsert) {
-            RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: process insert-into-insert blocks for %d/%d", e2->getId(), e2->rtti());
+            RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: process insert-into-insert blocks for %d/%d", e2->getId(), e2->rtti());
             copyBlocks(e2);
         }
     }
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: OK");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::copyBlocks: OK");
 }
 
 
@@ -481,10 +475,10 @@ void RS_Modification::copyBlocks(RS_Entity* e) {
  */
 void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
 
-    RS_DEBUG->print(RS_Debug::D_INFORMATIONAL, "RS_Modification::paste");
+    RS_DEBUG_PRINT(RS_Debug::D_INFORMATIONAL, "RS_Modification::paste");
 
 	if (!graphic) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::paste: graphic is nullptr");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::paste: graphic is nullptr");
         return;
     }
 
@@ -494,7 +488,7 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
     RS_Vector vfactor = RS_Vector(factor, factor);
     // select source for paste
 	if (!source) {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::paste: add graphic source from clipboard");
+        RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::paste: add graphic source from clipboard");
         source = RS_CLIPBOARD->getGraphic();
         // graphics from the clipboard need to be scaled. From the part lib not:
         RS2::Unit sourceUnit = source->getUnit();
@@ -502,9 +496,9 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
         factor = RS_Units::convert(1.0, sourceUnit, targetUnit);
         vfactor = RS_Vector(factor, factor);
     } else {
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::paste: add graphic source from parts library");
+        RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::paste: add graphic source from parts library");
     }
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::paste: pasting scale factor: %d", factor);
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::paste: pasting scale factor: %d", factor);
 
     // default insertion point for container
     RS_Vector ip = data.insertionPoint;
@@ -514,7 +508,7 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
 
     // insert absent layers from source to graphic
     if (!pasteLayers(source)) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::paste: unable to copy due to absence of needed layers");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::paste: unable to copy due to absence of needed layers");
         return;
     }
 
@@ -523,17 +517,17 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
     auto a_layer = source->getActiveLayer();
     if (!a_layer)
     {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::paste: copy wasn't properly finalized");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::paste: copy wasn't properly finalized");
         return;
     }
     QString ln = a_layer->getName();
     RS_Layer* l = graphic->getLayerList()->find(ln);
     */
     if (!l) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::paste: unable to select layer to paste in");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::paste: unable to select layer to paste in");
         return;
     }
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::paste: selected layer: %s", l->getName().toLatin1().data());
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::paste: selected layer: %s", l->getName().toLatin1().data());
     graphic->activateLayer(l);
 
     // hash for renaming duplicated blocks
@@ -547,7 +541,7 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
     QString name_new = name_old;
     if (graphic->findBlock(name_old)) {
         name_new = graphic->getBlockList()->newName(name_old);
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::paste: paste block name: %s", name_new.toLatin1().data());
+        RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::paste: paste block name: %s", name_new.toLatin1().data());
     }
     blocksDict[name_old] = name_new;
 
@@ -566,18 +560,18 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
     graphic->addEntity(i);
 
     // copy sub- blocks, inserts and entities from source to the paste block
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::paste: copy content to the paste block");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::paste: copy content to the paste block");
     for(auto e: * static_cast<RS_EntityContainer*>(source)) {
 
         if (!e) {
-            RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Modification::paste: nullptr entity in source");
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_Modification::paste: nullptr entity in source");
             continue;
         }
 
         // paste subcontainers
         if (e->rtti() == RS2::EntityInsert) {
             if (!pasteContainer(e, b, blocksDict, RS_Vector(0.0, 0.0))) {
-                RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::paste: unable to paste due to subcontainer paste error");
+                RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::paste: unable to paste due to subcontainer paste error");
                 return;
             }
             // clear selection due to the following processing of selected entities
@@ -585,7 +579,7 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
         } else {
             // paste individual entities including Polylines, etc.
             if (!pasteEntity(e, b)) {
-                RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::paste: unable to paste due to entity paste error");
+                RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::paste: unable to paste due to entity paste error");
                 return;
             }
             // clear selection due to the following processing of selected entities
@@ -613,7 +607,7 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
     }
 
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::paste: OK");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::paste: OK");
 }
 
 
@@ -624,10 +618,10 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
  **/
 bool RS_Modification::pasteLayers(RS_Graphic* source) {
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers");
 
     if (!source) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteLayers: no valid graphic found");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::pasteLayers: no valid graphic found");
         return false;
     }
 
@@ -635,7 +629,7 @@ bool RS_Modification::pasteLayers(RS_Graphic* source) {
     for(RS_Layer* l: *lrs) {
 
         if(!l) {
-            RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Modification::pasteLayers: nullptr layer in source");
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING, "RS_Modification::pasteLayers: nullptr layer in source");
             continue;
         }
 
@@ -643,11 +637,11 @@ bool RS_Modification::pasteLayers(RS_Graphic* source) {
         QString ln = l->getName();
         if (!graphic->findLayer(ln)) {
             graphic->addLayer(l->clone());
-            RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers: layer added: %s", ln.toLatin1().data());
+            RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers: layer added: %s", ln.toLatin1().data());
         }
     }
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers: OK");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers: OK");
     return true;
 }
 
@@ -659,10 +653,10 @@ bool RS_Modification::pasteLayers(RS_Graphic* source) {
  **/
 bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* container, QHash<QString, QString>blocksDict, RS_Vector insertionPoint) {
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert");
 
     if (!entity || entity->rtti() != RS2::EntityInsert) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: no container to process");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: no container to process");
         return false;
     }
 
@@ -670,21 +664,21 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
     // get block for this insert object
     RS_Block* ib = i->getBlockForInsert();
     if (!ib) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: no block to process");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: no block to process");
         return false;
     }
     // get name for this insert object
     QString name_old = ib->getName();
     QString name_new = name_old;
     if (name_old != i->getName()) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: block and insert names don't coincide");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: block and insert names don't coincide");
         return false;
     }
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: processing container: %s", name_old.toLatin1().data());
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: processing container: %s", name_old.toLatin1().data());
     // rename if needed
     if (graphic->findBlock(name_old)) {
         name_new = graphic->getBlockList()->newName(name_old);
-        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: new block name: %s", name_new.toLatin1().data());
+        RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: new block name: %s", name_new.toLatin1().data());
     }
     blocksDict[name_old] = name_new;
     // make new block in the destination
@@ -702,10 +696,10 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
     QString ln = entity->getLayer()->getName();
     RS_Layer* l = graphic->getLayerList()->find(ln);
     if (!l) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to select layer to paste in");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to select layer to paste in");
         return false;
     }
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: selected layer: %s", l->getName().toLatin1().data());
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: selected layer: %s", l->getName().toLatin1().data());
     ic->setLayer(l);
     ic->setPen(entity->getPen(false));
 
@@ -716,23 +710,23 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
     }
 
     // copy content of block/insert to destination
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: copy content to the subcontainer");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: copy content to the subcontainer");
     for(auto* e: *i) {
 
         if(!e) {
-            RS_DEBUG->print(RS_Debug::D_NOTICE, "RS_Modification::pasteInsert: nullptr entity in block");
+            RS_DEBUG_PRINT(RS_Debug::D_NOTICE, "RS_Modification::pasteInsert: nullptr entity in block");
             continue;
         }
 
         if (e->rtti() == RS2::EntityInsert) {
-            RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: process sub-insert for %s", ((RS_Insert*)e)->getName().toLatin1().data());
+            RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: process sub-insert for %s", ((RS_Insert*)e)->getName().toLatin1().data());
             if (!pasteContainer(e, (RS_EntityContainer*)bc, blocksDict, ip)) {
-                RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to paste entity to sub-insert");
+                RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to paste entity to sub-insert");
                 return false;
             }
         } else {
             if (!pasteEntity(e, (RS_EntityContainer*)bc)) {
-                RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to paste entity");
+                RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to paste entity");
                 return false;
             }
         }
@@ -741,7 +735,7 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
     ic->update();
     ic->setSelected(false);
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: OK");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: OK");
     return true;
 }
 
@@ -753,25 +747,25 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
  **/
 bool RS_Modification::pasteEntity(RS_Entity* entity, RS_EntityContainer* container) {
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteEntity");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteEntity");
 
     if (!entity) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteEntity: no entity to process");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::pasteEntity: no entity to process");
         return false;
     }
 
     // create entity copy to paste
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteEntity ID/flag: %d/%d", entity->getId(), entity->rtti());
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteEntity ID/flag: %d/%d", entity->getId(), entity->rtti());
     RS_Entity* e = entity->clone();
 
     // set the same layer in clone as in source
     QString ln = entity->getLayer()->getName();
     RS_Layer* l = graphic->getLayerList()->find(ln);
     if (!l) {
-        RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to select layer to paste in");
+        RS_DEBUG_PRINT(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to select layer to paste in");
         return false;
     }
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: selected layer: %s", l->getName().toLatin1().data());
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: selected layer: %s", l->getName().toLatin1().data());
     e->setLayer(l);
     e->setPen(entity->getPen(false));
 
@@ -781,7 +775,7 @@ bool RS_Modification::pasteEntity(RS_Entity* entity, RS_EntityContainer* contain
     container->addEntity(e);
     e->setSelected(false);
 
-    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteEntity: OK");
+    RS_DEBUG_PRINT(RS_Debug::D_DEBUGGING, "RS_Modification::pasteEntity: OK");
     return true;
 }
 
@@ -813,8 +807,8 @@ bool RS_Modification::splitPolyline(RS_Polyline& polyline,
                                     RS_Polyline** polyline2) const {
 
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::splitPolyline: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::splitPolyline: no valid container");
         return false;
     }
 
@@ -905,17 +899,17 @@ bool RS_Modification::splitPolyline(RS_Polyline& polyline,
 RS_Polyline* RS_Modification::addPolylineNode(RS_Polyline& polyline,
         const RS_AtomicEntity& segment,
         const RS_Vector& node) {
-    RS_DEBUG->print("RS_Modification::addPolylineNode");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::addPolylineNode");
 
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::addPolylineNode: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::addPolylineNode: no valid container");
 		return nullptr;
     }
 
     if (segment.getParent()!=&polyline) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::addPolylineNode: segment not part of the polyline");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::addPolylineNode: segment not part of the polyline");
 		return nullptr;
     }
 
@@ -934,16 +928,16 @@ RS_Polyline* RS_Modification::addPolylineNode(RS_Polyline& polyline,
             RS_AtomicEntity* ae = (RS_AtomicEntity*)e;
             double bulge = 0.0;
             if (ae->rtti()==RS2::EntityArc) {
-                RS_DEBUG->print("RS_Modification::addPolylineNode: arc segment");
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::addPolylineNode: arc segment");
                 bulge = ((RS_Arc*)ae)->getBulge();
             } else {
-                RS_DEBUG->print("RS_Modification::addPolylineNode: line segment");
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::addPolylineNode: line segment");
                 bulge = 0.0;
             }
 
             if (first) {
-                RS_DEBUG->print("RS_Modification::addPolylineNode: first segment: %f/%f",
-                                ae->getStartpoint().x, ae->getStartpoint().y);
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::addPolylineNode: first segment: %f/%f",
+                                     ae->getStartpoint().x, ae->getStartpoint().y);
 
                 newPolyline->setNextBulge(bulge);
                 newPolyline->addVertex(ae->getStartpoint());
@@ -952,24 +946,24 @@ RS_Polyline* RS_Modification::addPolylineNode(RS_Polyline& polyline,
 
             // segment to split:
             if (ae==&segment) {
-                RS_DEBUG->print("RS_Modification::addPolylineNode: split segment found");
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::addPolylineNode: split segment found");
 
-                RS_DEBUG->print("RS_Modification::addPolylineNode: node: %f/%f",
-                                node.x, node.y);
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::addPolylineNode: node: %f/%f",
+                                     node.x, node.y);
 
                 newPolyline->setNextBulge(0.0);
                 newPolyline->addVertex(node);
 
-                RS_DEBUG->print("RS_Modification::addPolylineNode: after node: %f/%f",
-                                ae->getEndpoint().x, ae->getEndpoint().y);
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::addPolylineNode: after node: %f/%f",
+                                     ae->getEndpoint().x, ae->getEndpoint().y);
 
 				if (ae!=lastEntity || !polyline.isClosed()) {
                     newPolyline->setNextBulge(0.0);
                     newPolyline->addVertex(ae->getEndpoint());
                 }
             } else {
-                RS_DEBUG->print("RS_Modification::addPolylineNode: normal vertex found: %f/%f",
-                                ae->getEndpoint().x, ae->getEndpoint().y);
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::addPolylineNode: normal vertex found: %f/%f",
+                                     ae->getEndpoint().x, ae->getEndpoint().y);
 
 				if (ae!=lastEntity || !polyline.isClosed()) {
                     newPolyline->setNextBulge(bulge);
@@ -977,8 +971,8 @@ RS_Polyline* RS_Modification::addPolylineNode(RS_Polyline& polyline,
                 }
             }
         } else {
-            RS_DEBUG->print(RS_Debug::D_WARNING,
-                            "RS_Modification::addPolylineNode: Polyline contains non-atomic entities");
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                           "RS_Modification::addPolylineNode: Polyline contains non-atomic entities");
         }
     }
 
@@ -1017,17 +1011,17 @@ RS_Polyline* RS_Modification::addPolylineNode(RS_Polyline& polyline,
 RS_Polyline* RS_Modification::deletePolylineNode(RS_Polyline& polyline,
         const RS_Vector& node) {
 
-    RS_DEBUG->print("RS_Modification::deletePolylineNode");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNode");
 
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::addPolylineNode: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::addPolylineNode: no valid container");
 		return nullptr;
     }
 
 	if (!node.valid) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::deletePolylineNode: node not valid");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::deletePolylineNode: node not valid");
 		return nullptr;
     }
 
@@ -1069,10 +1063,10 @@ RS_Polyline* RS_Modification::deletePolylineNode(RS_Polyline& polyline,
             RS_AtomicEntity* ae = (RS_AtomicEntity*)e;
             double bulge = 0.0;
             if (ae->rtti()==RS2::EntityArc) {
-                RS_DEBUG->print("RS_Modification::deletePolylineNode: arc segment");
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNode: arc segment");
                 bulge = ((RS_Arc*)ae)->getBulge();
             } else {
-                RS_DEBUG->print("RS_Modification::deletePolylineNode: line segment");
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNode: line segment");
                 bulge = 0.0;
             }
 
@@ -1083,8 +1077,8 @@ RS_Polyline* RS_Modification::deletePolylineNode(RS_Polyline& polyline,
 
             // first vertex (startpoint)
             if (first && node.distanceTo(ae->getStartpoint())>1.0e-6) {
-                RS_DEBUG->print("RS_Modification::deletePolylineNode: first node: %f/%f",
-                                ae->getStartpoint().x, ae->getStartpoint().y);
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNode: first node: %f/%f",
+                                     ae->getStartpoint().x, ae->getStartpoint().y);
 
                 newPolyline->setNextBulge(bulge);
                 newPolyline->addVertex(ae->getStartpoint());
@@ -1093,8 +1087,8 @@ RS_Polyline* RS_Modification::deletePolylineNode(RS_Polyline& polyline,
 
             // normal node (not deleted):
             if (first==false && node.distanceTo(ae->getEndpoint())>1.0e-6) {
-                RS_DEBUG->print("RS_Modification::deletePolylineNode: normal vertex found: %f/%f",
-                                ae->getEndpoint().x, ae->getEndpoint().y);
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNode: normal vertex found: %f/%f",
+                                     ae->getEndpoint().x, ae->getEndpoint().y);
                 if (lastDropped) {
                     //bulge = 0.0;
                 }
@@ -1105,17 +1099,17 @@ RS_Polyline* RS_Modification::deletePolylineNode(RS_Polyline& polyline,
 
             // drop deleted node:
             else {
-                RS_DEBUG->print("RS_Modification::deletePolylineNode: deleting vertex: %f/%f",
-                                ae->getEndpoint().x, ae->getEndpoint().y);
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNode: deleting vertex: %f/%f",
+                                     ae->getEndpoint().x, ae->getEndpoint().y);
                 lastDropped = true;
             }
         } else {
-            RS_DEBUG->print(RS_Debug::D_WARNING,
-                            "RS_Modification::deletePolylineNode: Polyline contains non-atomic entities");
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                           "RS_Modification::deletePolylineNode: Polyline contains non-atomic entities");
         }
     }
 
-    RS_DEBUG->print("RS_Modification::deletePolylineNode: ending polyline");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNode: ending polyline");
     newPolyline->setNextBulge(polyline.getClosingBulge());
     newPolyline->endPolyline();
 
@@ -1123,14 +1117,14 @@ RS_Polyline* RS_Modification::deletePolylineNode(RS_Polyline& polyline,
     //}
 
     // add new polyline:
-    RS_DEBUG->print("RS_Modification::deletePolylineNode: adding new polyline");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNode: adding new polyline");
     container->addEntity(newPolyline);
     if (graphicView) {
         graphicView->deleteEntity(&polyline);
         graphicView->drawEntity(newPolyline);
     }
 
-    RS_DEBUG->print("RS_Modification::deletePolylineNode: handling undo");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNode: handling undo");
     if (handleUndo) {
         LC_UndoSection undo( document);
 
@@ -1157,23 +1151,23 @@ RS_Polyline* RS_Modification::deletePolylineNode(RS_Polyline& polyline,
 RS_Polyline* RS_Modification::deletePolylineNodesBetween(RS_Polyline& polyline,
         RS_AtomicEntity& segment, const RS_Vector& node1, const RS_Vector& node2) {
     Q_UNUSED(segment);
-    RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween");
 
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::addPolylineNodesBetween: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::addPolylineNodesBetween: no valid container");
 		return nullptr;
     }
 
     if (node1.valid==false || node2.valid==false) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::deletePolylineNodesBetween: node not valid");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::deletePolylineNodesBetween: node not valid");
 		return nullptr;
     }
 
     if (node1.distanceTo(node2)<1.0e-6) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::deletePolylineNodesBetween: nodes are identical");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::deletePolylineNodesBetween: nodes are identical");
 		return nullptr;
     }
 
@@ -1188,8 +1182,8 @@ RS_Polyline* RS_Modification::deletePolylineNodesBetween(RS_Polyline& polyline,
                     (node2.distanceTo(ae->getStartpoint())<1.0e-6 &&
                      node1.distanceTo(ae->getEndpoint())<1.0e-6)) {
 
-                RS_DEBUG->print(RS_Debug::D_WARNING,
-                                "RS_Modification::deletePolylineNodesBetween: nothing to delete");
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                               "RS_Modification::deletePolylineNodesBetween: nothing to delete");
 				return nullptr;
             }
         }
@@ -1265,31 +1259,31 @@ RS_Polyline* RS_Modification::deletePolylineNodesBetween(RS_Polyline& polyline,
 	double bulge = 0.0;
 	for(auto e: polyline){
 
-        RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: entity: %d", i++);
-        RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: removing: %d", (int)removing);
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: entity: %d", i++);
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: removing: %d", (int)removing);
 
         if (e->isAtomic()) {
             RS_AtomicEntity* ae = (RS_AtomicEntity*)e;
             if (ae->rtti()==RS2::EntityArc) {
-                RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: arc segment");
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: arc segment");
                 bulge = ((RS_Arc*)ae)->getBulge();
             } else {
-                RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: line segment");
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: line segment");
                 bulge = 0.0;
             }
 
             // last entity is closing entity and will be added below with endPolyline()
             if (e==lastEntity && polyline.isClosed()) {
-                RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: "
-                                "dropping last vertex of closed polyline");
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: "
+                                     "dropping last vertex of closed polyline");
                 continue;
             }
 
             // first vertex (startpoint)
             if (first) {
                 if (!removing) {
-                    RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: first node: %f/%f",
-                                    ae->getStartpoint().x, ae->getStartpoint().y);
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: first node: %f/%f",
+                                         ae->getStartpoint().x, ae->getStartpoint().y);
                     newPolyline->setNextBulge(bulge);
                     newPolyline->addVertex(ae->getStartpoint());
                     first = false;
@@ -1300,9 +1294,9 @@ RS_Polyline* RS_Modification::deletePolylineNodesBetween(RS_Polyline& polyline,
             if (removing==true &&
                     (node1.distanceTo(ae->getEndpoint())<1.0e-6 ||
                      node2.distanceTo(ae->getEndpoint())<1.0e-6)) {
-                RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: "
-                                "stop removing at: %f/%f",
-                                ae->getEndpoint().x, ae->getEndpoint().y);
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: "
+                                     "stop removing at: %f/%f",
+                                     ae->getEndpoint().x, ae->getEndpoint().y);
                 removing = false;
                 done = true;
                 if (first==false) {
@@ -1312,9 +1306,9 @@ RS_Polyline* RS_Modification::deletePolylineNodesBetween(RS_Polyline& polyline,
 
             // normal node (not deleted):
             if (removing==false && (done==false || deleteStart==false)) {
-                RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: "
-                                "normal vertex found: %f/%f",
-                                ae->getEndpoint().x, ae->getEndpoint().y);
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: "
+                                     "normal vertex found: %f/%f",
+                                     ae->getEndpoint().x, ae->getEndpoint().y);
                 if (nextIsStraight) {
                     bulge = 0.0;
                     nextIsStraight = false;
@@ -1325,18 +1319,18 @@ RS_Polyline* RS_Modification::deletePolylineNodesBetween(RS_Polyline& polyline,
 
             // drop deleted node:
             else {
-                RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: "
-                                "deleting vertex: %f/%f",
-                                ae->getEndpoint().x, ae->getEndpoint().y);
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: "
+                                     "deleting vertex: %f/%f",
+                                     ae->getEndpoint().x, ae->getEndpoint().y);
             }
 
             // start to remove nodes from now on:
             if (done==false && removing==false &&
                     (node1.distanceTo(ae->getEndpoint())<1.0e-6 ||
                      node2.distanceTo(ae->getEndpoint())<1.0e-6)) {
-                RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: "
-                                "start removing at: %f/%f",
-                                ae->getEndpoint().x, ae->getEndpoint().y);
+                RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: "
+                                     "start removing at: %f/%f",
+                                     ae->getEndpoint().x, ae->getEndpoint().y);
                 removing = true;
             }
 
@@ -1344,24 +1338,24 @@ RS_Polyline* RS_Modification::deletePolylineNodesBetween(RS_Polyline& polyline,
                 done=false;
             }
         } else {
-            RS_DEBUG->print(RS_Debug::D_WARNING,
-                            "RS_Modification::deletePolylineNodesBetween: Polyline contains non-atomic entities");
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                           "RS_Modification::deletePolylineNodesBetween: Polyline contains non-atomic entities");
         }
     }
 
-    RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: ending polyline");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: ending polyline");
     newPolyline->setNextBulge(polyline.getClosingBulge());
     newPolyline->endPolyline();
 
     // add new polyline:
-    RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: adding new polyline");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: adding new polyline");
     container->addEntity(newPolyline);
     if (graphicView) {
         graphicView->deleteEntity(&polyline);
         graphicView->drawEntity(newPolyline);
     }
 
-    RS_DEBUG->print("RS_Modification::deletePolylineNodesBetween: handling undo");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::deletePolylineNodesBetween: handling undo");
     if (handleUndo) {
         LC_UndoSection undo( document);
 
@@ -1391,23 +1385,23 @@ RS_Polyline* RS_Modification::polylineTrim(RS_Polyline& polyline,
         RS_AtomicEntity& segment1,
         RS_AtomicEntity& segment2) {
 
-    RS_DEBUG->print("RS_Modification::polylineTrim");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim");
 
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::addPolylineNodesBetween: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::addPolylineNodesBetween: no valid container");
 		return nullptr;
     }
 
     if (segment1.getParent()!=&polyline || segment2.getParent()!=&polyline) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::polylineTrim: segments not in polyline");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::polylineTrim: segments not in polyline");
 		return nullptr;
     }
 
     if (&segment1==&segment2) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::polylineTrim: segments are identical");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::polylineTrim: segments are identical");
 		return nullptr;
     }
 
@@ -1415,8 +1409,8 @@ RS_Polyline* RS_Modification::polylineTrim(RS_Polyline& polyline,
     sol = RS_Information::getIntersection(&segment1, &segment2, false);
 
     if (sol.getNumber()==0) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::polylineTrim: segments cannot be trimmed");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::polylineTrim: segments cannot be trimmed");
 		return nullptr;
     }
 
@@ -1454,24 +1448,24 @@ RS_Polyline* RS_Modification::polylineTrim(RS_Polyline& polyline,
                 RS_AtomicEntity* ae = (RS_AtomicEntity*)e;
                 double bulge = 0.0;
                 if (ae->rtti()==RS2::EntityArc) {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: arc segment");
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: arc segment");
                     bulge = ((RS_Arc*)ae)->getBulge();
                 } else {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: line segment");
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: line segment");
                     bulge = 0.0;
                 }
 
                 // last entity is closing entity and will be added below with endPolyline()
                 if (e==lastEntity && polyline.isClosed()) {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: "
-                                    "dropping last vertex of closed polyline");
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: "
+                                         "dropping last vertex of closed polyline");
                     continue;
                 }
 
                 // first vertex (startpoint)
                 if (first) {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: first node: %f/%f",
-                                    ae->getStartpoint().x, ae->getStartpoint().y);
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: first node: %f/%f",
+                                         ae->getStartpoint().x, ae->getStartpoint().y);
 
                     newPolyline->setNextBulge(bulge);
                     newPolyline->addVertex(ae->getStartpoint());
@@ -1480,9 +1474,9 @@ RS_Polyline* RS_Modification::polylineTrim(RS_Polyline& polyline,
 
                 // trim and start removing nodes:
 				if (!removing && (ae==&segment1 || ae==&segment2)) {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: "
-                                    "start removing at trim point %f/%f",
-                                    sol.get(0).x, sol.get(0).y);
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: "
+                                         "start removing at trim point %f/%f",
+                                         sol.get(0).x, sol.get(0).y);
                     newPolyline->setNextBulge(0.0);
                     newPolyline->addVertex(sol.get(0));
                     removing = true;
@@ -1491,15 +1485,15 @@ RS_Polyline* RS_Modification::polylineTrim(RS_Polyline& polyline,
 
                 // stop removing nodes:
 				else if (removing && (ae==&segment1 || ae==&segment2)) {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: stop removing at: %f/%f",
-                                    ae->getEndpoint().x, ae->getEndpoint().y);
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: stop removing at: %f/%f",
+                                         ae->getEndpoint().x, ae->getEndpoint().y);
                     removing = false;
                 }
 
                 // normal node (not deleted):
 				if (!removing) {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: normal vertex found: %f/%f",
-                                    ae->getEndpoint().x, ae->getEndpoint().y);
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: normal vertex found: %f/%f",
+                                         ae->getEndpoint().x, ae->getEndpoint().y);
                     if (nextIsStraight) {
                         newPolyline->setNextBulge(0.0);
                         nextIsStraight = false;
@@ -1509,8 +1503,8 @@ RS_Polyline* RS_Modification::polylineTrim(RS_Polyline& polyline,
                     newPolyline->addVertex(ae->getEndpoint());
                 }
             } else {
-                RS_DEBUG->print(RS_Debug::D_WARNING,
-                                "RS_Modification::polylineTrim: Polyline contains non-atomic entities");
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                               "RS_Modification::polylineTrim: Polyline contains non-atomic entities");
             }
         }
     }
@@ -1528,25 +1522,25 @@ RS_Polyline* RS_Modification::polylineTrim(RS_Polyline& polyline,
                 RS_AtomicEntity* ae = (RS_AtomicEntity*)e;
                 double bulge = 0.0;
                 if (ae->rtti()==RS2::EntityArc) {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: arc segment");
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: arc segment");
                     bulge = ((RS_Arc*)ae)->getBulge();
                 } else {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: line segment");
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: line segment");
                     bulge = 0.0;
                 }
 
                 // last entity is closing entity and will be added below with endPolyline()
                 if (e==lastEntity && polyline.isClosed()) {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: "
-                                    "dropping last vertex of closed polyline");
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: "
+                                         "dropping last vertex of closed polyline");
                     continue;
                 }
 
                 // trim and stop removing nodes:
                 if (removing==true && (ae==&segment1 || ae==&segment2)) {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: "
-                                    "stop removing at trim point %f/%f",
-                                    sol.get(0).x, sol.get(0).y);
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: "
+                                         "stop removing at trim point %f/%f",
+                                         sol.get(0).x, sol.get(0).y);
                     newPolyline->setNextBulge(0.0);
                     // start of new polyline:
                     newPolyline->addVertex(sol.get(0));
@@ -1556,8 +1550,8 @@ RS_Polyline* RS_Modification::polylineTrim(RS_Polyline& polyline,
 
                 // start removing nodes again:
                 else if (removing==false && (ae==&segment1 || ae==&segment2)) {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: start removing at: %f/%f",
-                                    ae->getEndpoint().x, ae->getEndpoint().y);
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: start removing at: %f/%f",
+                                         ae->getEndpoint().x, ae->getEndpoint().y);
                     newPolyline->setNextBulge(0.0);
                     // start of new polyline:
                     newPolyline->addVertex(sol.get(0));
@@ -1566,8 +1560,8 @@ RS_Polyline* RS_Modification::polylineTrim(RS_Polyline& polyline,
 
                 // normal node (not deleted):
                 if (removing==false) {
-                    RS_DEBUG->print("RS_Modification::polylineTrim: normal vertex found: %f/%f",
-                                    ae->getEndpoint().x, ae->getEndpoint().y);
+                    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: normal vertex found: %f/%f",
+                                         ae->getEndpoint().x, ae->getEndpoint().y);
                     if (nextIsStraight) {
                         newPolyline->setNextBulge(0.0);
                         nextIsStraight = false;
@@ -1577,25 +1571,25 @@ RS_Polyline* RS_Modification::polylineTrim(RS_Polyline& polyline,
                     newPolyline->addVertex(ae->getEndpoint());
                 }
             } else {
-                RS_DEBUG->print(RS_Debug::D_WARNING,
-                                "RS_Modification::polylineTrim: Polyline contains non-atomic entities");
+                RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                               "RS_Modification::polylineTrim: Polyline contains non-atomic entities");
             }
         }
     }
 
-    RS_DEBUG->print("RS_Modification::polylineTrim: ending polyline");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: ending polyline");
     newPolyline->setNextBulge(polyline.getClosingBulge());
     newPolyline->endPolyline();
 
     // add new polyline:
-    RS_DEBUG->print("RS_Modification::polylineTrim: adding new polyline");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: adding new polyline");
     container->addEntity(newPolyline);
     if (graphicView) {
         graphicView->deleteEntity(&polyline);
         graphicView->drawEntity(newPolyline);
     }
 
-    RS_DEBUG->print("RS_Modification::polylineTrim: handling undo");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::polylineTrim: handling undo");
     if (handleUndo) {
         LC_UndoSection undo( document);
 
@@ -1616,11 +1610,18 @@ RS_Polyline* RS_Modification::polylineTrim(RS_Polyline& polyline,
  */
 bool RS_Modification::move(RS_MoveData& data) {
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::move: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::move: no valid container");
         return false;
     }
 
+    if (isInPlaceTransform(data.number, data.useCurrentLayer, data.useCurrentAttributes)) {
+        LC_UndoTransform* transform = new LC_UndoTransform(container);
+        transform->move(data.offset);
+        // since 2.0.4.0: keep selection
+        return transformSelected(transform, true);
+    }
+
 	std::vector<RS_Entity*> addList;
 
     // Create new entities
@@ -1666,8 +1667,8 @@ bool RS_Modification::move(RS_MoveData& data) {
  */
 bool RS_Modification::offset(const RS_OffsetData& data) {
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::offset: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::offset: no valid container");
         return false;
     }
 
@@ -1719,11 +1720,17 @@ bool RS_Modification::offset(const RS_OffsetData& data) {
  */
 bool RS_Modification::rotate(RS_RotateData& data) {
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::rotate: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::rotate: no valid container");
         return false;
     }
 
+    if (isInPlaceTransform(data.number, data.useCurrentLayer, data.useCurrentAttributes)) {
+        LC_UndoTransform* transform = new LC_UndoTransform(container);
+        transform->rotate(data.center, data.angle);
+        return transformSelected(transform, false);
+    }
+
 	std::vector<RS_Entity*> addList;
 
     // Create new entities
@@ -1768,11 +1775,21 @@ bool RS_Modification::rotate(RS_RotateData& data) {
  */
 bool RS_Modification::scale(RS_ScaleData& data) {
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::scale: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::scale: no valid container");
         return false;
     }
 
+    // non-isotropic scaling replaces circles and arcs by ellipses,
+    // a scale factor of zero is not invertible
+    if (isInPlaceTransform(data.number, data.useCurrentLayer, data.useCurrentAttributes)
+            && fabs(data.factor.x - data.factor.y) <= RS_TOLERANCE
+            && fabs(data.factor.x) > RS_TOLERANCE) {
+        LC_UndoTransform* transform = new LC_UndoTransform(container);
+        transform->scale(data.referencePoint, data.factor);
+        return transformSelected(transform, false);
+    }
+
 	std::vector<RS_Entity*> selectedList,addList;
 
 	for(auto ec: *container){
@@ -1847,11 +1864,17 @@ bool RS_Modification::scale(RS_ScaleData& data) {
  */
 bool RS_Modification::mirror(RS_MirrorData& data) {
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::mirror: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::mirror: no valid container");
         return false;
     }
 
+    if (isInPlaceTransform(data.copy ? 1 : 0, data.useCurrentLayer, data.useCurrentAttributes)) {
+        LC_UndoTransform* transform = new LC_UndoTransform(container);
+        transform->mirror(data.axisPoint1, data.axisPoint2);
+        return transformSelected(transform, false);
+    }
+
 	std::vector<RS_Entity*> addList;
 
     // Create new entities
@@ -1895,11 +1918,21 @@ bool RS_Modification::mirror(RS_MirrorData& data) {
  */
 bool RS_Modification::rotate2(RS_Rotate2Data& data) {
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::rotate2: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::rotate2: no valid container");
         return false;
     }
 
+    if (isInPlaceTransform(data.number, data.useCurrentLayer, data.useCurrentAttributes)) {
+        RS_Vector center2 = data.center2;
+        center2.rotate(data.center1, data.angle1);
+
+        LC_UndoTransform* transform = new LC_UndoTransform(container);
+        transform->rotate(data.center1, data.angle1);
+        transform->rotate(center2, data.angle2);
+        return transformSelected(transform, false);
+    }
+
 	std::vector<RS_Entity*> addList;
 
     // Create new entities
@@ -1948,11 +1981,18 @@ bool RS_Modification::rotate2(RS_Rotate2Data& data) {
  */
 bool RS_Modification::moveRotate(RS_MoveRotateData& data) {
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::moveRotate: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::moveRotate: no valid container");
         return false;
     }
 
+    if (isInPlaceTransform(data.number, data.useCurrentLayer, data.useCurrentAttributes)) {
+        LC_UndoTransform* transform = new LC_UndoTransform(container);
+        transform->move(data.offset);
+        transform->rotate(data.referencePoint + data.offset, data.angle);
+        return transformSelected(transform, false);
+    }
+
 	std::vector<RS_Entity*> addList;
 
     // Create new entities
@@ -1993,6 +2033,61 @@ bool RS_Modification::moveRotate(RS_MoveRotateData& data) {
 
 
 
+/**
+ * @return true, when a modification can transform the selected entities
+ * in place instead of replacing them by transformed clones.
+ * This is the case when no copies are requested and the attributes
+ * of the entities are not changed.
+ */
+bool RS_Modification::isInPlaceTransform(int number, bool useCurrentLayer, bool useCurrentAttributes) const
+{
+    return 0 == number && !useCurrentLayer && !useCurrentAttributes;
+}
+
+
+
+/**
+ * Applies the transformation to all selected entities in place.
+ * Only the transformation steps and the entity set are recorded
+ * for undo, no entities are cloned.
+ *
+ * @param transform Transformation, ownership is taken.
+ * @param keepSelection true: entities stay selected.
+ */
+bool RS_Modification::transformSelected(LC_UndoTransform* transform, bool keepSelection)
+{
+    for (auto e: *container) {
+        if (e && e->isSelected()) {
+            if (!keepSelection) {
+                e->setSelected(false);
+            }
+            transform->addEntity(e);
+        }
+    }
+
+    if (transform->isEmpty()) {
+        delete transform;
+        return false;
+    }
+
+    transform->apply(false);
+
+    if (handleUndo && document) {
+        LC_UndoSection undo( document);
+        undo.addUndoable(transform);
+    } else {
+        delete transform;
+    }
+
+    if (graphicView) {
+        graphicView->redraw(RS2::RedrawDrawing);
+    }
+
+    return true;
+}
+
+
+
 /**
  * Deselects all selected entities and removes them if remove is true;
  *
@@ -2089,21 +2184,25 @@ bool RS_Modification::trim(const RS_Vector& trimCoord,
                            bool both) {
 
 	if (!(trimEntity && limitEntity)) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_Modification::trim: At least one entity is nullptr");
         return false;
     }
 
     if (both && !limitEntity->isAtomic()) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::trim: limitEntity is not atomic");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::trim: limitEntity is not atomic");
     }
     if(trimEntity->isLocked()|| !trimEntity->isVisible()) return false;
 
+    // cached intersections of the document, if there is one:
+    LC_IntersectionIndex* index = document ? document->getIntersectionIndex() : nullptr;
+
     RS_VectorSolutions sol;
-    if (limitEntity->isAtomic()) {
+    if (limitEntity->isAtomic() || limitEntity->rtti() == RS2::EntitySpline) {
         // intersection(s) of the two entities:
-        sol = RS_Information::getIntersection(trimEntity, limitEntity, false);
+        sol = index ? index->getIntersection(trimEntity, limitEntity, false)
+                    : RS_Information::getIntersection(trimEntity, limitEntity, false);
     } else if (limitEntity->isContainer()) {
         RS_EntityContainer* ec = (RS_EntityContainer*)limitEntity;
 
@@ -2116,8 +2215,9 @@ bool RS_Modification::trim(const RS_Vector& trimCoord,
 
             if (e) {
 
-                RS_VectorSolutions s2 = RS_Information::getIntersection(trimEntity,
-                                        e, false);
+                RS_VectorSolutions s2 = index ? index->getIntersection(trimEntity, e, false)
+                                              : RS_Information::getIntersection(trimEntity,
+                                                                                e, false);
 
                 if (s2.hasValid()) {
 					for (const RS_Vector& vp: s2){
@@ -2203,13 +2303,13 @@ bool RS_Modification::trim(const RS_Vector& trimCoord,
     } else {
 		is = sol.getClosest(limitCoord, nullptr, &ind);
 		//sol.getClosest(limitCoord, nullptr, &ind);
-        RS_DEBUG->print("RS_Modification::trim: limitCoord: %f/%f", limitCoord.x, limitCoord.y);
-        RS_DEBUG->print("RS_Modification::trim: sol.get(0): %f/%f", sol.get(0).x, sol.get(0).y);
-        RS_DEBUG->print("RS_Modification::trim: sol.get(1): %f/%f", sol.get(1).x, sol.get(1).y);
-        RS_DEBUG->print("RS_Modification::trim: ind: %d", ind);
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::trim: limitCoord: %f/%f", limitCoord.x, limitCoord.y);
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::trim: sol.get(0): %f/%f", sol.get(0).x, sol.get(0).y);
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::trim: sol.get(1): %f/%f", sol.get(1).x, sol.get(1).y);
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::trim: ind: %d", ind);
         is2 = sol.get(ind==0 ? 1 : 0);
         //RS_Vector is2 = sol.get(ind);
-        RS_DEBUG->print("RS_Modification::trim: is2: %f/%f", is2.x, is2.y);
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::trim: is2: %f/%f", is2.x, is2.y);
 
     }
 
@@ -2306,7 +2406,7 @@ bool RS_Modification::trimAmount(const RS_Vector& trimCoord,
                                  double dist) {
 
 	if (!trimEntity) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_Modification::trimAmount: Entity is nullptr");
         return false;
     }
@@ -2360,23 +2460,23 @@ bool RS_Modification::cut(const RS_Vector& cutCoord,
 #endif
 
 	if (!cutEntity) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_Modification::cut: Entity is nullptr");
         return false;
     }
     if(cutEntity->isLocked() || ! cutEntity->isVisible()) return false;
 
     if (!cutCoord.valid) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::cut: Point invalid.");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::cut: Point invalid.");
         return false;
     }
 
     // cut point is at endpoint of entity:
     if (cutCoord.distanceTo(cutEntity->getStartpoint())<RS_TOLERANCE ||
             cutCoord.distanceTo(cutEntity->getEndpoint())<RS_TOLERANCE) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::cut: Cutting point on endpoint");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::cut: Cutting point on endpoint");
         return false;
     }
 
@@ -2491,8 +2591,8 @@ bool RS_Modification::stretch(const RS_Vector& firstCorner,
                               const RS_Vector& offset) {
 
     if (!offset.valid) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::stretch: Offset invalid");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::stretch: Offset invalid");
         return false;
     }
 
@@ -2537,10 +2637,10 @@ bool RS_Modification::bevel(const RS_Vector& coord1, RS_AtomicEntity* entity1,
                             const RS_Vector& coord2, RS_AtomicEntity* entity2,
                             RS_BevelData& data) {
 
-    RS_DEBUG->print("RS_Modification::bevel");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::bevel");
 
 	if (!(entity1 && entity2)) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_Modification::bevel: At least one entity is nullptr");
         return false;
     }
@@ -2556,10 +2656,10 @@ bool RS_Modification::bevel(const RS_Vector& coord1, RS_AtomicEntity* entity1,
     // find out whether we're bevelling within a polyline:
     if (entity1->getParent() &&
             entity1->getParent()->rtti()==RS2::EntityPolyline) {
-        RS_DEBUG->print("RS_Modification::bevel: trimming polyline segments");
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::bevel: trimming polyline segments");
         if (entity1->getParent()!=entity2->getParent()) {
-            RS_DEBUG->print(RS_Debug::D_WARNING,
-                            "RS_Modification::bevel: entities not in the same polyline");
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                           "RS_Modification::bevel: entities not in the same polyline");
             return false;
         }
         //TODO: check if entity1 & entity2 are lines.
@@ -2587,7 +2687,7 @@ bool RS_Modification::bevel(const RS_Vector& coord1, RS_AtomicEntity* entity1,
 //        isClosedPolyline = ((RS_Polyline*)entity1)->isClosed();
     }
 
-    RS_DEBUG->print("RS_Modification::bevel: getting intersection");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::bevel: getting intersection");
 
     RS_VectorSolutions sol =
         RS_Information::getIntersection(entity1, entity2, false);
@@ -2624,7 +2724,7 @@ bool RS_Modification::bevel(const RS_Vector& coord1, RS_AtomicEntity* entity1,
     }
 
     // trim entities to intersection
-    RS_DEBUG->print("RS_Modification::bevel: trim entities to intersection 01");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::bevel: trim entities to intersection 01");
     bool start1 = false;
     RS_Vector is = sol.getClosest(coord2);
     RS2::Ending ending1 = trimmed1->getTrimPoint(coord1, is);
@@ -2641,7 +2741,7 @@ bool RS_Modification::bevel(const RS_Vector& coord1, RS_AtomicEntity* entity1,
         break;
     }
 
-    RS_DEBUG->print("RS_Modification::bevel: trim entities to intersection 02");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::bevel: trim entities to intersection 02");
     bool start2 = false;
     is = sol.getClosest(coord1);
     RS2::Ending ending2 = trimmed2->getTrimPoint(coord2, is);
@@ -2661,12 +2761,12 @@ bool RS_Modification::bevel(const RS_Vector& coord1, RS_AtomicEntity* entity1,
 
 
     // find definitive bevel points
-    RS_DEBUG->print("RS_Modification::bevel: find definitive bevel points");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::bevel: find definitive bevel points");
     RS_Vector bp1 = trimmed1->getNearestDist(data.length1, start1);
     RS_Vector bp2 = trimmed2->getNearestDist(data.length2, start2);
 
     // final trim:
-    RS_DEBUG->print("RS_Modification::bevel: final trim");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::bevel: final trim");
 	if (data.trim) {
         switch (ending1) {
         case RS2::EndingStart:
@@ -2705,7 +2805,7 @@ bool RS_Modification::bevel(const RS_Vector& coord1, RS_AtomicEntity* entity1,
 
 
     // add bevel line:
-    RS_DEBUG->print("RS_Modification::bevel: add bevel line");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::bevel: add bevel line");
 	RS_Line* bevel = new RS_Line{baseContainer, {bp1, bp2}};
 
 	if (!isPolyline) {
@@ -2757,7 +2857,7 @@ bool RS_Modification::bevel(const RS_Vector& coord1, RS_AtomicEntity* entity1,
         }
     }
 
-    RS_DEBUG->print("RS_Modification::bevel: handling undo");
+    RS_DEBUG_PRINT_DEBUG("RS_Modification::bevel: handling undo");
 
     if (handleUndo) {
 		if (!isPolyline && data.trim) {
@@ -2776,10 +2876,10 @@ bool RS_Modification::bevel(const RS_Vector& coord1, RS_AtomicEntity* entity1,
     }
 //Do not delete trimmed* if are part of a polyline
 	if (!(data.trim || isPolyline)) {
-        RS_DEBUG->print("RS_Modification::bevel: delete trimmed elements");
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::bevel: delete trimmed elements");
         delete trimmed1;
         delete trimmed2;
-        RS_DEBUG->print("RS_Modification::bevel: delete trimmed elements: ok");
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::bevel: delete trimmed elements: ok");
     }
 
     return true;
@@ -2804,7 +2904,7 @@ bool RS_Modification::round(const RS_Vector& coord,
                             RS_RoundData& data) {
 
 	if (!(entity1 && entity2)) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
 						"RS_Modification::round: At least one entity is nullptr");
         return false;
     }
@@ -2821,9 +2921,9 @@ bool RS_Modification::round(const RS_Vector& coord,
             entity1->getParent()->rtti()==RS2::EntityPolyline) {
 
         if (entity1->getParent()!=entity2->getParent()) {
-            RS_DEBUG->print(RS_Debug::D_WARNING,
-                            "RS_Modification::round: entities not in "
-                            "the same polyline");
+            RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                           "RS_Modification::round: entities not in "
+                           "the same polyline");
             return false;
         }
 
@@ -2951,11 +3051,11 @@ bool RS_Modification::round(const RS_Vector& coord,
         arc->setLayer(baseContainer->getLayer());
         arc->setPen(baseContainer->getPen());
 
-        RS_DEBUG->print("RS_Modification::round: idx1<idx2: %d", (int)(idx1<idx2));
-        RS_DEBUG->print("RS_Modification::round: idx1!=0: %d", (int)(idx1!=0));
-        RS_DEBUG->print("RS_Modification::round: idx2==0: %d", (int)(idx2==0));
-        RS_DEBUG->print("RS_Modification::round: idx1==(int)baseContainer->count()-1: %d",
-                        (int)(idx1==(int)baseContainer->count()-1));
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::round: idx1<idx2: %d", (int)(idx1<idx2));
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::round: idx1!=0: %d", (int)(idx1!=0));
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::round: idx2==0: %d", (int)(idx2==0));
+        RS_DEBUG_PRINT_DEBUG("RS_Modification::round: idx1==(int)baseContainer->count()-1: %d",
+                             (int)(idx1==(int)baseContainer->count()-1));
 
         bool insertAfter1 = ((idx1<idx2 && idx1!=0) ||(idx1==0 && idx2==1) ||
                             (idx2==0 && idx1==(int)baseContainer->count()-1));
@@ -3070,8 +3170,8 @@ static void update_exploded_children_recursively(
 bool RS_Modification::explode(const bool remove /*= true*/)
 {
     if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::explode: no valid container for addinge entities");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::explode: no valid container for addinge entities");
         return false;
     }
 	if (container->isLocked() || ! container->isVisible()) return false;
@@ -3083,7 +3183,22 @@ bool RS_Modification::explode(const bool remove /*= true*/)
         //RS_Entity* e = container->entityAt(i);
 
         if (e && e->isSelected()) {
-            if (e->isContainer()) {
+            if (e->rtti() == RS2::EntitySpline) {
+                // splines have no sub entities, they are exploded into
+                // the segments of the polygon approximating them:
+                RS_Spline* spline = static_cast<RS_Spline*>(e);
+                std::vector<RS_Vector> const& points = spline->getSegmentPoints();
+                for (size_t i = 1; i < points.size(); ++i) {
+                    RS_Line* line = new RS_Line{container, points[i - 1], points[i]};
+                    line->setLayer(spline->getLayer());
+                    line->setPen(spline->getPen(false));
+                    addList.push_back(line);
+                }
+            } else if (e->isContainer()) {
+
+                if (RS_Information::isDimension(e->rtti())) {
+                    static_cast<RS_Dimension*>(e)->validateDim();
+                }
 
                 // add entities from container:
                 RS_EntityContainer* ec = (RS_EntityContainer*)e;
@@ -3184,8 +3299,8 @@ bool RS_Modification::explode(const bool remove /*= true*/)
 
 bool RS_Modification::explodeTextIntoLetters() {
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::explodeTextIntoLetters: no valid container for addinge entities");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::explodeTextIntoLetters: no valid container for addinge entities");
         return false;
     }
     if(container->isLocked() || ! container->isVisible()) return false;
@@ -3328,8 +3443,8 @@ bool RS_Modification::explodeTextIntoLetters(RS_Text* text, std::vector<RS_Entit
  */
 bool RS_Modification::moveRef(RS_MoveRefData& data) {
 	if (!container) {
-        RS_DEBUG->print(RS_Debug::D_WARNING,
-                        "RS_Modification::moveRef: no valid container");
+        RS_DEBUG_PRINT(RS_Debug::D_WARNING,
+                       "RS_Modification::moveRef: no valid container");
         return false;
     }
     if(container->isLocked() || ! container->isVisible()) return false;
@@ -40,6 +40,8 @@ class RS_Polyline;
 class RS_Document;
 class RS_Graphic;
 class RS_GraphicView;
+class LC_UndoAttributes;
+class LC_UndoTransform;
 
 /**
  * Holds the data needed for move modifications.
@@ -230,7 +232,7 @@ public:
 	void remove();
 	void revertDirection();
 	bool changeAttributes(RS_AttributesData& data);
-    bool changeAttributes(RS_AttributesData& data, RS_EntityContainer* container, std::vector<RS_Entity*> addList);
+    bool changeAttributes(RS_AttributesData& data, RS_EntityContainer* container, LC_UndoAttributes* delta = nullptr);
 
         void copy(const RS_Vector& ref, const bool cut);
 private:
@@ -292,6 +294,9 @@ public:
                                 RS_AtomicEntity& segment2);
 
 private:
+    void changeEntityAttributes(RS_AttributesData& data, RS_Entity* e, LC_UndoAttributes* delta);
+    bool isInPlaceTransform(int number, bool useCurrentLayer, bool useCurrentAttributes) const;
+    bool transformSelected(LC_UndoTransform* transform, bool keepSelection);
     void deselectOriginals(bool remove);
 	void addNewEntities(std::vector<RS_Entity*>& addList);
 	bool explodeTextIntoLetters(RS_MText* text, std::vector<RS_Entity*>& addList);
@@ -28,10 +28,12 @@
 
 #include "rs_line.h"
 #include "rs_information.h"
+#include "rs_dimension.h"
 #include "rs_polyline.h"
 #include "rs_entity.h"
 #include "rs_graphic.h"
 #include "rs_layer.h"
+#include "lc_entityiterator.h"
 
 
 
@@ -152,50 +154,49 @@ void RS_Selection::selectIntersected(const RS_Vector& v1, const RS_Vector& v2,
                                      bool select) {
 
 	RS_Line line{v1, v2};
-    bool inters;
 
+    // collect visible entities and the contents of containers / groups,
+    // to intersect them with the line in one batch:
+    std::vector<RS_Entity*> visible;
+    std::vector<RS_Entity*> candidates;
+    std::vector<size_t> owner;
 	for(auto e: *container){
-    //for (unsigned i=0; i<container->count(); ++i) {
-        //RS_Entity* e = container->entityAt(i);
-
         if (e && e->isVisible()) {
-
-            inters = false;
-
-            // select containers / groups:
+            if (RS_Information::isDimension(e->rtti())) {
+                static_cast<RS_Dimension*>(e)->validateDim();
+            }
             if (e->isContainer()) {
-                RS_EntityContainer* ec = (RS_EntityContainer*)e;
-
-                for (RS_Entity* e2=ec->firstEntity(RS2::ResolveAll); e2;
-                        e2=ec->nextEntity(RS2::ResolveAll)) {
-
-                    RS_VectorSolutions sol =
-                        RS_Information::getIntersection(&line, e2, true);
-
-                    if (sol.hasValid()) {
-                        inters = true;
-                    }
+                LC_EntityIterator it(*static_cast<RS_EntityContainer*>(e), RS2::ResolveAll);
+                for (RS_Entity* e2 = it.first(); e2; e2 = it.next()) {
+                    candidates.push_back(e2);
+                    owner.push_back(visible.size());
                 }
             } else {
+                candidates.push_back(e);
+                owner.push_back(visible.size());
+            }
+            visible.push_back(e);
+        }
+    }
 
-                RS_VectorSolutions sol =
-                    RS_Information::getIntersection(&line, e, true);
+    std::vector<RS_Information::IntersectionHit> hits;
+    RS_Information::getIntersections(&line, candidates, hits, true);
+    std::vector<bool> intersected(visible.size(), false);
+    for (const RS_Information::IntersectionHit& hit: hits) {
+        intersected[owner[hit.candidate]] = true;
+    }
 
-                if (sol.hasValid()) {
-                    inters = true;
-                }
+    for (size_t i = 0; i < visible.size(); ++i) {
+        if (intersected[i]) {
+            RS_Entity* e = visible[i];
+            if (graphicView) {
+                graphicView->deleteEntity(e);
             }
 
-            if (inters) {
-                if (graphicView) {
-                    graphicView->deleteEntity(e);
-                }
-
-                e->setSelected(select);
+            e->setSelected(select);
 
-                if (graphicView) {
-                    graphicView->drawEntity(e);
-                }
+            if (graphicView) {
+                graphicView->drawEntity(e);
             }
         }
     }
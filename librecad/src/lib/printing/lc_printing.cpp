@@ -23,6 +23,10 @@
 **********************************************************************/
 
 #include "lc_printing.h"
+#include "lc_printpainter.h"
+#include "rs_graphic.h"
+#include "rs_staticgraphicview.h"
+#include "rs_units.h"
 
 QPrinter::PageSize LC_Printing::rsToQtPaperFormat(RS2::PaperFormat f)
 {
@@ -107,3 +111,28 @@ QPrinter::PageSize LC_Printing::rsToQtPaperFormat(RS2::PaperFormat f)
             return QPrinter::NPageSize;
     }
 }
+
+void LC_Printing::drawPage(RS_Graphic* graphic, QPrinter& printer,
+                           LC_PrintPainter& painter)
+{
+    RS_StaticGraphicView gv(printer.width(), printer.height(), &painter);
+    gv.setPrinting(true);
+    gv.setBorders(0,0,0,0);
+
+    double fx = (double) printer.width() / printer.widthMM()
+                * RS_Units::getFactorToMM(graphic->getUnit());
+    double fy = (double) printer.height() / printer.heightMM()
+                * RS_Units::getFactorToMM(graphic->getUnit());
+
+    double f = (fx + fy) / 2.0;
+
+    double scale = graphic->getPaperScale();
+
+    gv.setOffset((int)(graphic->getPaperInsertionBase().x * f),
+                 (int)(graphic->getPaperInsertionBase().y * f));
+    gv.setFactor(f*scale);
+    gv.setContainer(graphic);
+    gv.drawEntity(&painter, graphic);
+
+    painter.flush();
+}
@@ -4,9 +4,20 @@
 #include <QPrinter>
 #include "rs.h"
 
+class RS_Graphic;
+class LC_PrintPainter;
+
 namespace LC_Printing
 {
     QPrinter::PageSize rsToQtPaperFormat(RS2::PaperFormat f);
+
+    /**
+     * Draws the printable entities of graphic on the current page of
+     * printer, at the paper scale and insertion base of the drawing.
+     * Entities which are off the page aren't drawn. All of the page is
+     * drawn when this returns, so the printer can start a new page.
+     */
+    void drawPage(RS_Graphic* graphic, QPrinter& printer, LC_PrintPainter& painter);
 }
 
 #endif // LC_PRINTING_H
@@ -0,0 +1,298 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include "lc_printpainter.h"
+
+
+LC_PrintPainter::LC_PrintPainter(QPaintDevice* pd)
+    : RS_PainterQt(pd) {}
+
+
+LC_PrintPainter::~LC_PrintPainter()
+{
+    if (isActive())
+        flush();
+}
+
+
+void LC_PrintPainter::flush()
+{
+    if (path.isEmpty())
+        return;
+
+    // the path is an outline only, it must not be filled
+    QPen currentPen = pen();
+    QBrush currentBrush = QPainter::brush();
+
+    QPainter::setPen(pathPen);
+    QPainter::setBrush(Qt::NoBrush);
+    QPainter::drawPath(path);
+    QPainter::setPen(currentPen);
+    QPainter::setBrush(currentBrush);
+
+    path = QPainterPath();
+}
+
+
+bool LC_PrintPainter::end()
+{
+    flush();
+    return QPainter::end();
+}
+
+
+void LC_PrintPainter::beginOutline()
+{
+    if (!path.isEmpty()
+            && (pen() != pathPen || path.elementCount() >= MaxElements))
+        flush();
+
+    if (path.isEmpty())
+        pathPen = pen();
+}
+
+
+/**
+ * Adds a polyline to the path, connected to the previous one if it starts
+ * where that ended.
+ */
+void LC_PrintPainter::addPolyline(const QPolygon& pa)
+{
+    if (pa.isEmpty())
+        return;
+
+    beginOutline();
+
+    if (path.isEmpty() || path.currentPosition() != QPointF(pa.first()))
+        path.moveTo(pa.first());
+    if (pa.size() == 1)
+        path.lineTo(pa.first());
+    for (int i = 1; i < pa.size(); ++i)
+        path.lineTo(pa.at(i));
+}
+
+
+void LC_PrintPainter::moveTo(int x, int y)
+{
+    rememberX = x;
+    rememberY = y;
+}
+
+
+void LC_PrintPainter::lineTo(int x, int y)
+{
+    QPolygon pa;
+    pa << QPoint(rememberX, rememberY) << QPoint(x, y);
+    addPolyline(pa);
+    rememberX = x;
+    rememberY = y;
+}
+
+
+void LC_PrintPainter::drawGridPoint(const RS_Vector& p)
+{
+    flush();
+    RS_PainterQt::drawGridPoint(p);
+}
+
+
+void LC_PrintPainter::drawGridPoints(const RS_Vector& origin,
+                                     const QPolygonF& points)
+{
+    flush();
+    RS_PainterQt::drawGridPoints(origin, points);
+}
+
+
+void LC_PrintPainter::drawPoint(const RS_Vector& p)
+{
+    QPolygon pa;
+    pa << QPoint(toScreenX(p.x-1), toScreenY(p.y))
+       << QPoint(toScreenX(p.x+1), toScreenY(p.y));
+    addPolyline(pa);
+
+    pa.clear();
+    pa << QPoint(toScreenX(p.x), toScreenY(p.y-1))
+       << QPoint(toScreenX(p.x), toScreenY(p.y+1));
+    addPolyline(pa);
+}
+
+
+void LC_PrintPainter::drawLine(const RS_Vector& p1, const RS_Vector& p2)
+{
+    QPolygon pa;
+    pa << QPoint(toScreenX(p1.x), toScreenY(p1.y))
+       << QPoint(toScreenX(p2.x), toScreenY(p2.y));
+    addPolyline(pa);
+}
+
+
+void LC_PrintPainter::fillRect(const QRectF& rectangle, const RS_Color& color)
+{
+    flush();
+    RS_PainterQt::fillRect(rectangle, color);
+}
+
+
+void LC_PrintPainter::fillRect(const QRectF& rectangle, const QBrush& brush)
+{
+    flush();
+    RS_PainterQt::fillRect(rectangle, brush);
+}
+
+
+void LC_PrintPainter::drawArc(const RS_Vector& cp, double radius,
+                              double a1, double a2,
+                              const RS_Vector& p1, const RS_Vector& p2,
+                              bool reversed)
+{
+    flush();
+    RS_PainterQt::drawArc(cp, radius, a1, a2, p1, p2, reversed);
+}
+
+
+void LC_PrintPainter::drawArc(const RS_Vector& cp, double radius,
+                              double a1, double a2,
+                              bool reversed)
+{
+    if (radius <= 0.5) {
+        drawGridPoint(cp);
+        return;
+    }
+
+    QPolygon pa;
+    createArc(pa, cp, radius, a1, a2, reversed);
+    addPolyline(pa);
+}
+
+
+void LC_PrintPainter::drawArcMac(const RS_Vector& cp, double radius,
+                                 double a1, double a2,
+                                 bool reversed)
+{
+    flush();
+    RS_PainterQt::drawArcMac(cp, radius, a1, a2, reversed);
+}
+
+
+void LC_PrintPainter::drawCircle(const RS_Vector& cp, double radius)
+{
+    // a filled circle isn't an outline
+    if (QPainter::brush().style() != Qt::NoBrush) {
+        flush();
+        RS_PainterQt::drawCircle(cp, radius);
+        return;
+    }
+
+    beginOutline();
+    path.addEllipse(QPointF(cp.x, cp.y), radius, radius);
+}
+
+
+void LC_PrintPainter::drawEllipse(const RS_Vector& cp,
+                                  double radius1, double radius2,
+                                  double angle,
+                                  double a1, double a2,
+                                  bool reversed)
+{
+    QPolygon pa;
+    createEllipse(pa, cp, radius1, radius2, angle, a1, a2, reversed);
+    addPolyline(pa);
+}
+
+
+void LC_PrintPainter::drawImg(QImage& img, const RS_Vector& pos,
+                              double angle, const RS_Vector& factor)
+{
+    flush();
+    RS_PainterQt::drawImg(img, pos, angle, factor);
+}
+
+
+void LC_PrintPainter::drawTextH(int x1, int y1, int x2, int y2,
+                                const QString& text)
+{
+    flush();
+    RS_PainterQt::drawTextH(x1, y1, x2, y2, text);
+}
+
+
+void LC_PrintPainter::drawTextV(int x1, int y1, int x2, int y2,
+                                const QString& text)
+{
+    flush();
+    RS_PainterQt::drawTextV(x1, y1, x2, y2, text);
+}
+
+
+void LC_PrintPainter::fillRect(int x1, int y1, int w, int h,
+                               const RS_Color& col)
+{
+    flush();
+    RS_PainterQt::fillRect(x1, y1, w, h, col);
+}
+
+
+void LC_PrintPainter::fillTriangle(const RS_Vector& p1,
+                                   const RS_Vector& p2,
+                                   const RS_Vector& p3)
+{
+    flush();
+    RS_PainterQt::fillTriangle(p1, p2, p3);
+}
+
+
+void LC_PrintPainter::drawPolygon(const QPolygon& a, Qt::FillRule rule)
+{
+    flush();
+    RS_PainterQt::drawPolygon(a, rule);
+}
+
+
+void LC_PrintPainter::drawPath(const QPainterPath& p)
+{
+    flush();
+    RS_PainterQt::drawPath(p);
+}
+
+
+void LC_PrintPainter::erase()
+{
+    flush();
+    RS_PainterQt::erase();
+}
+
+
+void LC_PrintPainter::setClipRect(int x, int y, int w, int h)
+{
+    flush();
+    RS_PainterQt::setClipRect(x, y, w, h);
+}
+
+
+void LC_PrintPainter::resetClipping()
+{
+    flush();
+    RS_PainterQt::resetClipping();
+}
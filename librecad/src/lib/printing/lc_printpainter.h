@@ -0,0 +1,108 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_PRINTPAINTER_H
+#define LC_PRINTPAINTER_H
+
+#include <QPainterPath>
+
+#include "rs_painterqt.h"
+
+/**
+ * Painter for printers and PDF files.
+ *
+ * Lines, arcs, circles and ellipses drawn with the same pen are collected
+ * in one QPainterPath, which is handed to the print engine as a whole when
+ * the pen changes, when anything else is drawn, or at the end. So the
+ * engine writes one path per pen instead of one per line segment, which
+ * keeps PDF files small and fast to write.
+ *
+ * end() must be called on this class, not on QPainter, to draw the last path.
+ */
+class LC_PrintPainter: public RS_PainterQt {
+
+public:
+    LC_PrintPainter(QPaintDevice* pd);
+    virtual ~LC_PrintPainter();
+
+    /** Draws the collected path. */
+    void flush();
+    bool end();
+
+    virtual void moveTo(int x, int y);
+    virtual void lineTo(int x, int y);
+    virtual void drawGridPoint(const RS_Vector& p);
+    virtual void drawGridPoints(const RS_Vector& origin, const QPolygonF& points);
+    virtual void drawPoint(const RS_Vector& p);
+    virtual void drawLine(const RS_Vector& p1, const RS_Vector& p2);
+    virtual void fillRect(const QRectF& rectangle, const RS_Color& color);
+    virtual void fillRect(const QRectF& rectangle, const QBrush& brush);
+    virtual void drawArc(const RS_Vector& cp, double radius,
+                         double a1, double a2,
+                         const RS_Vector& p1, const RS_Vector& p2,
+                         bool reversed);
+    virtual void drawArc(const RS_Vector& cp, double radius,
+                         double a1, double a2,
+                         bool reversed);
+    virtual void drawArcMac(const RS_Vector& cp, double radius,
+                            double a1, double a2,
+                            bool reversed);
+    virtual void drawCircle(const RS_Vector& cp, double radius);
+    virtual void drawEllipse(const RS_Vector& cp,
+                             double radius1, double radius2,
+                             double angle,
+                             double a1, double a2,
+                             bool reversed);
+    virtual void drawImg(QImage& img, const RS_Vector& pos,
+                         double angle, const RS_Vector& factor);
+    virtual void drawTextH(int x1, int y1, int x2, int y2,
+                           const QString& text);
+    virtual void drawTextV(int x1, int y1, int x2, int y2,
+                           const QString& text);
+    virtual void fillRect(int x1, int y1, int w, int h,
+                          const RS_Color& col);
+    virtual void fillTriangle(const RS_Vector& p1,
+                              const RS_Vector& p2,
+                              const RS_Vector& p3);
+    virtual void drawPolygon(const QPolygon& a, Qt::FillRule rule=Qt::WindingFill);
+    virtual void drawPath(const QPainterPath& p);
+    virtual void erase();
+
+    virtual void setClipRect(int x, int y, int w, int h);
+    virtual void resetClipping();
+
+private:
+    /** Prepares the path for an outline drawn with the current pen. */
+    void beginOutline();
+    void addPolyline(const QPolygon& pa);
+
+    /** Maximum number of path elements, before the path is drawn. */
+    static const int MaxElements = 4096;
+
+    QPainterPath path;
+    /** Pen of the collected path. */
+    QPen pathPen;
+};
+
+#endif // LC_PRINTPAINTER_H
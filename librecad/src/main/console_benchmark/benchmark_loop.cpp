@@ -0,0 +1,426 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+#include <QtCore>
+#include <QImage>
+#include <QMouseEvent>
+
+#include "rs.h"
+#include "rs_arc.h"
+#include "rs_block.h"
+#include "rs_circle.h"
+#include "rs_graphic.h"
+#include "rs_hatch.h"
+#include "rs_insert.h"
+#include "rs_line.h"
+#include "rs_math.h"
+#include "rs_painterqt.h"
+#include "rs_selection.h"
+#include "rs_snapper.h"
+#include "rs_staticgraphicview.h"
+#include "rs_text.h"
+#include "lc_undosection.h"
+
+#include "benchmark_loop.h"
+
+
+namespace {
+
+/**
+ * Random numbers which are the same on every platform. The distributions
+ * of the standard library are implementation defined, the engine is not.
+ */
+class SyntheticRandom {
+public:
+    explicit SyntheticRandom(quint32 seed) : engine(seed) {}
+
+    /** @return a value in [min, max). */
+    double uniform(double min, double max) {
+        return min + (max - min) * (engine() / 4294967296.0);
+    }
+
+    RS_Vector point(double extent) {
+        double x = uniform(0., extent);
+        return RS_Vector(x, uniform(0., extent));
+    }
+
+private:
+    std::mt19937 engine;
+};
+
+
+const char* const SymbolBlock = "bench_symbol";
+const char* const GroupBlock = "bench_group";
+
+
+void addToDrawing(RS_Graphic* graphic, RS_Entity* e)
+{
+    e->setLayerToActive();
+    e->setPenToActive();
+    graphic->addEntity(e);
+}
+
+
+/**
+ * Adds a block with a square, a circle and an arc, and a block with four
+ * inserts of it, so inserts of the second block are nested two levels deep.
+ */
+void addBlocks(RS_Graphic* graphic)
+{
+    RS_Block* symbol = new RS_Block(graphic,
+        RS_BlockData(SymbolBlock, RS_Vector(0., 0.), false));
+    symbol->addRectangle(RS_Vector(0., 0.), RS_Vector(1., 1.));
+    symbol->addEntity(new RS_Circle(symbol,
+        RS_CircleData(RS_Vector(0.5, 0.5), 0.4)));
+    symbol->addEntity(new RS_Arc(symbol,
+        RS_ArcData(RS_Vector(0.5, 0.5), 0.25, 0., M_PI, false)));
+    graphic->addBlock(symbol);
+
+    RS_Block* group = new RS_Block(graphic,
+        RS_BlockData(GroupBlock, RS_Vector(0., 0.), false));
+    for (int i = 0; i < 4; i++) {
+        group->addEntity(new RS_Insert(group,
+            RS_InsertData(SymbolBlock, RS_Vector(2. * (i % 2), 2. * (i / 2)),
+                          RS_Vector(1., 1.), i * M_PI_2, 1, 1,
+                          RS_Vector(0., 0.), graphic->getBlockList(),
+                          RS2::NoUpdate)));
+    }
+    group->addEntity(new RS_Line(group, RS_Vector(0., 0.), RS_Vector(3., 3.)));
+    graphic->addBlock(group);
+}
+
+
+/**
+ * Generates a drawing of about scale entities, counting those in inserts.
+ * The same scale and seed always give the same drawing.
+ */
+std::unique_ptr<RS_Graphic> generateDrawing(int scale, quint32 seed)
+{
+    std::unique_ptr<RS_Graphic> graphic(new RS_Graphic());
+    graphic->newDoc();
+    addBlocks(graphic.get());
+
+    SyntheticRandom random(seed + scale);
+    double extent = 10. * std::sqrt(double(scale));
+
+    for (int i = 0; i < scale / 2; i++) {
+        RS_Vector start = random.point(extent);
+        RS_Vector end = start + RS_Vector::polar(random.uniform(0.5, 5.),
+                                                 random.uniform(0., 2. * M_PI));
+        addToDrawing(graphic.get(), new RS_Line(graphic.get(), start, end));
+    }
+
+    for (int i = 0; i < scale / 4; i++) {
+        RS_Vector center = random.point(extent);
+        double radius = random.uniform(0.2, 3.);
+        double a1 = random.uniform(0., 2. * M_PI);
+        double a2 = random.uniform(0., 2. * M_PI);
+        addToDrawing(graphic.get(), new RS_Arc(graphic.get(),
+            RS_ArcData(center, radius, a1, a2, false)));
+    }
+
+    for (int i = 0; i < std::max(1, scale / 50); i++) {
+        RS_Vector pos = random.point(extent);
+        double height = random.uniform(0.5, 2.);
+        double angle = random.uniform(0., 2. * M_PI);
+        RS_Text* text = new RS_Text(graphic.get(),
+            RS_TextData(pos, pos, height, 1., RS_TextData::VABaseline,
+                        RS_TextData::HALeft, RS_TextData::None,
+                        QString("Text %1").arg(i), "standard", angle,
+                        RS2::NoUpdate));
+        addToDrawing(graphic.get(), text);
+        text->update();
+    }
+
+    for (int i = 0; i < std::max(1, scale / 500); i++) {
+        RS_Vector corner = random.point(extent);
+        RS_Vector size(random.uniform(2., 10.), random.uniform(2., 10.));
+        RS_Hatch* hatch = new RS_Hatch(graphic.get(),
+            RS_HatchData(false, 0.5, random.uniform(0., M_PI), "ANSI31"));
+        RS_EntityContainer* loop = new RS_EntityContainer(hatch);
+        loop->setPen(RS_Pen(RS2::FlagInvalid));
+        loop->addRectangle(corner, corner + size);
+        hatch->addEntity(loop);
+        addToDrawing(graphic.get(), hatch);
+        hatch->update();
+    }
+
+    for (int i = 0; i < std::max(1, scale / 100); i++) {
+        RS_Vector pos = random.point(extent);
+        double angle = random.uniform(0., 2. * M_PI);
+        addToDrawing(graphic.get(), new RS_Insert(graphic.get(),
+            RS_InsertData(GroupBlock, pos, RS_Vector(1., 1.), angle, 1, 1,
+                          RS_Vector(0., 0.), nullptr, RS2::Update)));
+    }
+
+    graphic->calculateBorders();
+    graphic->setModified(false);
+
+    return graphic;
+}
+
+}
+
+
+void BenchmarkLoop::run()
+{
+    QTemporaryDir tmpDir;
+
+    if (!tmpDir.isValid()) {
+        qDebug() << "ERROR: Cannot create a temporary directory";
+        failures++;
+    } else {
+        for (int scale : params.scales) {
+            if (!runScale(scale, tmpDir.path()))
+                failures++;
+        }
+    }
+
+    if (!writeResults())
+        failures++;
+
+    emit finished();
+}
+
+
+bool BenchmarkLoop::runScale(int scale, const QString& tmpDir)
+{
+    bool ok = true;
+
+    std::unique_ptr<RS_Graphic> graphic = generateDrawing(scale, params.seed);
+    int entities = graphic->countDeep();
+
+    qDebug() << "Scale" << scale << ":" << entities << "entities";
+
+    ok &= measure("generate", scale, entities, [this, scale]() {
+        return generateDrawing(scale, params.seed)->count() > 0;
+    });
+
+    QString dxfFile = QString("%1/bench_%2.dxf").arg(tmpDir).arg(scale);
+
+    // The file is needed for loading, so it's saved even if not measured.
+    if (!graphic->saveAs(dxfFile, RS2::FormatDXFRW, true)) {
+        qDebug() << "ERROR: Cannot write" << dxfFile;
+        return false;
+    }
+
+    ok &= measure("save", scale, entities, [&graphic, &dxfFile]() {
+        return graphic->saveAs(dxfFile, RS2::FormatDXFRW, true);
+    });
+
+    ok &= measure("load", scale, entities, [&dxfFile]() -> bool {
+        RS_Graphic loaded;
+        return loaded.open(dxfFile, RS2::FormatUnknown) && loaded.count() > 0;
+    });
+
+    // Every run draws with the same zoom, the one showing all of the drawing.
+    RS_StaticGraphicView zoomView(params.viewSize.width(),
+                                  params.viewSize.height(), nullptr);
+    zoomView.setContainer(graphic.get());
+    zoomView.zoomAuto(false);
+
+    ok &= measure("redraw", scale, entities, [this, &graphic, &zoomView]() -> bool {
+        QImage image(params.viewSize, QImage::Format_RGB32);
+        RS_PainterQt painter(&image);
+        painter.setBackground(Qt::white);
+        painter.eraseRect(0, 0, image.width(), image.height());
+
+        RS_StaticGraphicView gv(image.width(), image.height(), &painter);
+        gv.setContainer(graphic.get());
+        gv.setFactorX(zoomView.getFactor().x);
+        gv.setFactorY(zoomView.getFactor().y);
+        gv.setOffset(zoomView.getOffsetX(), zoomView.getOffsetY());
+        gv.drawEntity(&painter, gv.getContainer());
+
+        return painter.end();
+    });
+
+    // Query points and windows spread over the drawing, the same every run.
+    SyntheticRandom random(params.seed);
+    RS_Vector min = graphic->getMin();
+    RS_Vector size = graphic->getSize();
+    double extent = std::max(size.x, size.y);
+
+    std::vector<RS_Vector> queries;
+    for (int i = 0; i < params.queries; i++)
+        queries.push_back(min + random.point(extent));
+
+    // Snaps like the cursor of an action does, in the zoom of the redraws.
+    RS_SnapMode snapMode;
+    snapMode.snapEndpoint = true;
+    snapMode.snapIntersection = true;
+    snapMode.snapOnEntity = true;
+    RS_Snapper snapper(*graphic, zoomView);
+    snapper.init();
+    snapper.setSnapMode(snapMode);
+
+    std::vector<QPointF> cursors;
+    for (const RS_Vector& q : queries)
+        cursors.push_back(QPointF(zoomView.toGuiX(q.x), zoomView.toGuiY(q.y)));
+
+    ok &= measure("snap", scale, entities, [&snapper, &cursors]() -> bool {
+        bool snapOk = true;
+        for (const QPointF& cursor : cursors) {
+            QMouseEvent e(QEvent::MouseMove, cursor,
+                          Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+            snapOk &= snapper.snapPoint(&e).valid;
+        }
+        return snapOk;
+    });
+
+    std::vector<std::pair<RS_Vector, RS_Vector>> windows;
+    for (int i = 0; i < params.windows; i++) {
+        RS_Vector corner = min + random.point(extent);
+        windows.push_back(std::make_pair(corner,
+            corner + RS_Vector(0.1 * extent, 0.1 * extent)));
+    }
+
+    ok &= measure("select_window", scale, entities, [&graphic, &windows]() -> bool {
+        RS_Selection selection(*graphic);
+        for (const auto& w : windows)
+            selection.selectWindow(w.first, w.second, true, false);
+        selection.deselectAll();
+        return true;
+    });
+
+    std::vector<RS_Hatch*> hatches;
+    for (RS_Entity* e : *graphic) {
+        if (e->rtti() == RS2::EntityHatch)
+            hatches.push_back(static_cast<RS_Hatch*>(e));
+    }
+
+    ok &= measure("hatch", scale, entities, [&hatches]() -> bool {
+        bool hatchOk = true;
+        for (RS_Hatch* h : hatches) {
+            h->update();
+            hatchOk &= h->getUpdateError() == RS_Hatch::HATCH_OK;
+        }
+        return hatchOk;
+    });
+
+    // One undo cycle deleting every second entity, undone and redone.
+    // Runs last, as it leaves half of the drawing deleted.
+    if (isSelected("undo_redo")) {
+        LC_UndoSection undo(graphic.get());
+        int i = 0;
+        for (RS_Entity* e : *graphic) {
+            if (i++ % 2 == 0) {
+                e->changeUndoState();
+                undo.addUndoable(e);
+            }
+        }
+    }
+
+    ok &= measure("undo_redo", scale, entities, [&graphic]() {
+        return graphic->undo() && graphic->redo();
+    });
+
+    return ok;
+}
+
+
+bool BenchmarkLoop::isSelected(const QString& benchmark) const
+{
+    return params.only.isEmpty() || params.only.contains(benchmark);
+}
+
+
+bool BenchmarkLoop::measure(const QString& benchmark, int scale,
+    int entities, const std::function<bool()>& job)
+{
+    if (!isSelected(benchmark))
+        return true;
+
+    bool ok = true;
+    std::vector<double> times;
+    QJsonArray runs;
+
+    for (int i = 0; i < params.repeat && ok; i++) {
+        QElapsedTimer timer;
+        timer.start();
+        ok = job();
+        double ms = timer.nsecsElapsed() / 1.0e6;
+        times.push_back(ms);
+        runs.append(ms);
+    }
+
+    std::sort(times.begin(), times.end());
+    double sum = 0.;
+    for (double t : times)
+        sum += t;
+
+    size_t n = times.size();
+    double median = n % 2 ? times[n / 2] : 0.5 * (times[n / 2 - 1] + times[n / 2]);
+
+    QJsonObject result;
+    result["benchmark"] = benchmark;
+    result["scale"] = scale;
+    result["entities"] = entities;
+    result["ok"] = ok;
+    result["runs_ms"] = runs;
+    result["min_ms"] = times.front();
+    result["median_ms"] = median;
+    result["mean_ms"] = sum / n;
+    results.append(result);
+
+    qDebug() << "  " << benchmark << (ok ? "median" : "FAILED, median")
+             << median << "ms";
+
+    return ok;
+}
+
+
+bool BenchmarkLoop::writeResults()
+{
+    QJsonObject report;
+    report["version"] = QCoreApplication::applicationVersion();
+    report["qt"] = QString(qVersion());
+    report["seed"] = (qint64) params.seed;
+    report["repeat"] = params.repeat;
+    report["view_width"] = params.viewSize.width();
+    report["view_height"] = params.viewSize.height();
+    report["queries"] = params.queries;
+    report["windows"] = params.windows;
+    report["results"] = results;
+
+    QByteArray json = QJsonDocument(report).toJson();
+
+    if (params.outFile.isEmpty()) {
+        QFile out;
+        return out.open(stdout, QIODevice::WriteOnly) && out.write(json) >= 0;
+    }
+
+    QFile file(params.outFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "ERROR: Cannot write" << params.outFile;
+        return false;
+    }
+    file.write(json);
+
+    return true;
+}
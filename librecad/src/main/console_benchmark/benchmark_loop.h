@@ -0,0 +1,92 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+#ifndef BENCHMARK_LOOP_H
+#define BENCHMARK_LOOP_H
+
+#include <functional>
+#include <QtCore>
+#include <QSize>
+
+
+struct BenchmarkParams {
+        QList<int> scales {1000, 10000, 100000}; // Entities per drawing.
+        QStringList only;        // Benchmarks to run, all if empty.
+        int repeat = 5;          // Timed runs of every benchmark.
+        quint32 seed = 1;        // Seed of the synthetic drawings.
+        QSize viewSize {1920, 1080};
+        int queries = 200;       // Snap queries per run.
+        int windows = 50;        // Selection windows per run.
+        QString outFile;         // JSON results, stdout if empty.
+};
+
+
+/**
+ * Runs the benchmarks on synthetic drawings without showing any window.
+ *
+ * For every scale a drawing of lines, arcs, texts, hatches and nested
+ * block inserts is generated from a fixed seed, so all runs with the same
+ * parameters measure the same work. Every benchmark is timed params.repeat
+ * times, the results are written as JSON.
+ */
+class BenchmarkLoop : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    BenchmarkLoop(BenchmarkParams& params, QObject* parent=0) :
+        QObject(parent) {
+        this->params = params;
+    };
+
+    int failedCount() const { return failures; }
+
+public slots:
+
+    void run();
+
+signals:
+
+    void finished();
+
+private:
+
+    BenchmarkParams params;
+    int failures = 0;
+    QJsonArray results;
+
+    bool runScale(int scale, const QString& tmpDir);
+
+    bool isSelected(const QString& benchmark) const;
+    /**
+     * Times params.repeat runs of job and adds them to the results.
+     * @return false if a run of job failed.
+     */
+    bool measure(const QString& benchmark, int scale, int entities,
+                 const std::function<bool()>& job);
+
+    bool writeResults();
+};
+
+#endif
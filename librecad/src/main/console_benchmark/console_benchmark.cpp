@@ -0,0 +1,176 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <QtCore>
+#include <QCoreApplication>
+#include <QApplication>
+
+#include "rs_debug.h"
+#include "rs_fontlist.h"
+#include "rs_patternlist.h"
+#include "rs_settings.h"
+#include "rs_system.h"
+
+#include "main.h"
+
+#include "console_benchmark.h"
+#include "benchmark_loop.h"
+
+
+static const QStringList benchmarkNames = QStringList()
+    << "generate" << "save" << "load" << "redraw" << "snap"
+    << "select_window" << "hatch" << "undo_redo";
+
+
+int console_benchmark(int argc, char* argv[])
+{
+    RS_DEBUG->setLevel(RS_Debug::D_NOTHING);
+
+    // Nothing is shown, so don't require a display. An explicitly
+    // selected platform plugin is still respected.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    QCoreApplication::setOrganizationName("LibreCAD");
+    QCoreApplication::setApplicationName("LibreCAD");
+    QCoreApplication::setApplicationVersion(XSTR(LC_VERSION));
+
+    QFileInfo prgInfo(QFile::decodeName(argv[0]));
+    QString prgDir(prgInfo.absolutePath());
+    RS_SETTINGS->init(app.organizationName(), app.applicationName());
+    RS_SYSTEM->init(app.applicationName(), app.applicationVersion(),
+        XSTR(QC_APPDIR), prgDir);
+
+    QCommandLineParser parser;
+
+    QString appDesc;
+    QString librecad;
+    if (prgInfo.baseName() != "benchmark") {
+        librecad = prgInfo.filePath();
+        appDesc = "\nbenchmark usage: " + prgInfo.filePath()
+            + " benchmark [options]\n";
+    }
+    appDesc += "\nMeasure loading, saving, drawing and editing of synthetic";
+    appDesc += "\ndrawings without a display. The drawings are generated from";
+    appDesc += "\na fixed seed, so the same options always measure the same work.";
+    appDesc += "\nThe results are written as JSON.";
+    appDesc += "\n\nBenchmarks: " + benchmarkNames.join(", ");
+    appDesc += "\n\n";
+    appDesc += "Examples:\n\n";
+    appDesc += "  " + librecad + " benchmark -o before.json";
+    appDesc += "    -- run all benchmarks at the default scales.\n";
+    appDesc += "\n";
+    appDesc += "  " + librecad + " benchmark -s 50000 -b redraw,snap -r 10";
+    appDesc += "    -- time 10 redraws and snap runs of a drawing with"
+               " 50000 entities.";
+    parser.setApplicationDescription(appDesc);
+
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption scalesOpt(QStringList() << "s" << "scales",
+        "Comma separated numbers of entities per drawing"
+        " (default 1000,10000,100000).", "list");
+    parser.addOption(scalesOpt);
+
+    QCommandLineOption onlyOpt(QStringList() << "b" << "benchmarks",
+        "Comma separated benchmarks to run (default all).", "list");
+    parser.addOption(onlyOpt);
+
+    QCommandLineOption repeatOpt(QStringList() << "r" << "repeat",
+        "Timed runs of every benchmark (default 5).", "integer");
+    parser.addOption(repeatOpt);
+
+    QCommandLineOption seedOpt(QStringList() << "seed",
+        "Seed of the synthetic drawings (default 1).", "integer");
+    parser.addOption(seedOpt);
+
+    QCommandLineOption outFileOpt(QStringList() << "o" << "outfile",
+        "Output JSON file (default standard output).", "file");
+    parser.addOption(outFileOpt);
+
+    parser.process(app);
+
+    BenchmarkParams params;
+
+    if (parser.isSet(scalesOpt)) {
+        params.scales.clear();
+        for (auto s : parser.value(scalesOpt).split(',')) {
+            bool ok;
+            int scale = s.toInt(&ok);
+            if (!ok || scale <= 0) {
+                qDebug() << "ERROR: Bad scale" << s;
+                return EXIT_FAILURE;
+            }
+            params.scales.append(scale);
+        }
+    }
+
+    if (parser.isSet(onlyOpt)) {
+        params.only = parser.value(onlyOpt).split(',');
+        for (auto b : params.only) {
+            if (!benchmarkNames.contains(b)) {
+                qDebug() << "ERROR: Unknown benchmark" << b;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    if (parser.isSet(repeatOpt)) {
+        bool ok;
+        params.repeat = parser.value(repeatOpt).toInt(&ok);
+        if (!ok || params.repeat <= 0) {
+            qDebug() << "ERROR: Bad repeat count" << parser.value(repeatOpt);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (parser.isSet(seedOpt)) {
+        bool ok;
+        params.seed = parser.value(seedOpt).toUInt(&ok);
+        if (!ok) {
+            qDebug() << "ERROR: Bad seed" << parser.value(seedOpt);
+            return EXIT_FAILURE;
+        }
+    }
+
+    params.outFile = parser.value(outFileOpt);
+
+    RS_FONTLIST->init();
+    RS_PATTERNLIST->init();
+
+    BenchmarkLoop *loop = new BenchmarkLoop(params, &app);
+
+    QObject::connect(loop, SIGNAL(finished()), &app, SLOT(quit()));
+
+    QTimer::singleShot(0, loop, SLOT(run()));
+
+    int ret = app.exec();
+
+    if (ret == EXIT_SUCCESS && loop->failedCount() > 0)
+        ret = EXIT_FAILURE;
+
+    return ret;
+}
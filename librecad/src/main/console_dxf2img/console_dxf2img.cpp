@@ -0,0 +1,242 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <QtCore>
+#include <QCoreApplication>
+#include <QApplication>
+#include <QImageWriter>
+
+#include "rs_debug.h"
+#include "rs_fontlist.h"
+#include "rs_patternlist.h"
+#include "rs_settings.h"
+#include "rs_system.h"
+
+#include "main.h"
+
+#include "console_dxf2img.h"
+#include "img_export_loop.h"
+
+
+static QSize parseSizeArg(QString, const QSize&);
+
+
+int console_dxf2img(int argc, char* argv[])
+{
+    RS_DEBUG->setLevel(RS_Debug::D_NOTHING);
+
+    // Nothing is shown, so don't require a display. An explicitly
+    // selected platform plugin is still respected.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    QCoreApplication::setOrganizationName("LibreCAD");
+    QCoreApplication::setApplicationName("LibreCAD");
+    QCoreApplication::setApplicationVersion(XSTR(LC_VERSION));
+
+    QFileInfo prgInfo(QFile::decodeName(argv[0]));
+    QString prgDir(prgInfo.absolutePath());
+    RS_SETTINGS->init(app.organizationName(), app.applicationName());
+    RS_SYSTEM->init(app.applicationName(), app.applicationVersion(),
+        XSTR(QC_APPDIR), prgDir);
+
+    // Called either as "librecad dxf2png ..." or through a link "dxf2png".
+    QString tool = prgInfo.baseName();
+    if (tool != "dxf2png" && tool != "dxf2svg" && argc > 1)
+        tool = QString(argv[1]);
+
+    QCommandLineParser parser;
+
+    QString appDesc;
+    QString librecad;
+    if (prgInfo.baseName() != tool) {
+        librecad = prgInfo.filePath();
+        appDesc = "\n" + tool + " usage: " + prgInfo.filePath()
+            + " " + tool + " [options] <dxf_files>\n";
+    }
+    appDesc += "\nExport a bunch of DXF files to images without a display.";
+    appDesc += "\nRaster images larger than the tile size are written as";
+    appDesc += "\none file per tile and a <name>.tiles.json index.";
+    appDesc += "\n\n";
+    appDesc += "Examples:\n\n";
+    appDesc += "  " + librecad + " dxf2png -s 30000x20000 -j 8 plan.dxf";
+    appDesc += "    -- render plan.dxf in tiles using 8 worker processes.\n";
+    appDesc += "\n";
+    appDesc += "  " + librecad + " dxf2svg -s 1920x1080 *.dxf";
+    appDesc += "    -- export all dxf files to svg files with the same names.";
+    parser.setApplicationDescription(appDesc);
+
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption sizeOpt(QStringList() << "s" << "size",
+        "Image size (Width x Height) in pixels.", "WxH");
+    parser.addOption(sizeOpt);
+
+    QCommandLineOption borderOpt(QStringList() << "b" << "border",
+        "Border around the drawing in pixels.", "integer");
+    parser.addOption(borderOpt);
+
+    QCommandLineOption blackOpt(QStringList() << "black",
+        "Black background.");
+    parser.addOption(blackOpt);
+
+    QCommandLineOption monoOpt(QStringList() << "m" << "monochrome",
+        "Export monochrome (black/white).");
+    parser.addOption(monoOpt);
+
+    QCommandLineOption formatOpt(QStringList() << "f" << "format",
+        "Image format, e.g. png, jpg, bmp, tiff or svg.", "format");
+    parser.addOption(formatOpt);
+
+    QCommandLineOption tileSizeOpt(QStringList() << "l" << "tile-size",
+        "Maximum tile width and height in pixels (0 = no tiles).", "integer");
+    parser.addOption(tileSizeOpt);
+
+    QCommandLineOption jobsOpt(QStringList() << "j" << "jobs",
+        "Number of worker processes rendering tiles"
+        " (0 = number of CPU cores).", "integer");
+    parser.addOption(jobsOpt);
+
+    QCommandLineOption tilesOpt(QStringList() << "tiles",
+        "Only render the given tiles, without index (used by workers).",
+        "first:last");
+    parser.addOption(tilesOpt);
+
+    QCommandLineOption outDirOpt(QStringList() << "t" << "directory",
+        "Target output directory.", "path");
+    parser.addOption(outDirOpt);
+
+    parser.addPositionalArgument("<dxf_files>", "Input DXF file(s)");
+
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+
+    if (args.isEmpty() || (args.size() == 1 && args[0] == tool))
+        parser.showHelp(EXIT_FAILURE);
+
+    ImgExportParams params;
+
+    params.format = tool == "dxf2svg" ? "svg" : "png";
+    if (parser.isSet(formatOpt))
+        params.format = parser.value(formatOpt).toLower();
+
+    if (params.format != "svg"
+            && !QImageWriter::supportedImageFormats().contains(
+                params.format.toLatin1())) {
+        qDebug() << "ERROR: Unsupported image format" << params.format;
+        return EXIT_FAILURE;
+    }
+
+    params.size = parseSizeArg(parser.value(sizeOpt), params.size);
+    params.black = parser.isSet(blackOpt);
+    params.monochrome = parser.isSet(monoOpt);
+
+    bool borderOk;
+    int border = parser.value(borderOpt).toInt(&borderOk);
+    if (borderOk && border >= 0)
+        params.borders = QSize(border, border);
+
+    bool tileSizeOk;
+    int tileSize = parser.value(tileSizeOpt).toInt(&tileSizeOk);
+    if (tileSizeOk)
+        params.tileSize = tileSize;
+
+    bool jobsOk;
+    int jobs = parser.value(jobsOpt).toInt(&jobsOk);
+    if (jobsOk)
+        params.jobs = jobs > 0 ? jobs : QThread::idealThreadCount();
+
+    if (parser.isSet(tilesOpt)) {
+        QStringList range = parser.value(tilesOpt).split(':');
+        bool firstOk = false, lastOk = false;
+        if (range.size() == 2) {
+            params.firstTile = range[0].toInt(&firstOk);
+            params.lastTile = range[1].toInt(&lastOk);
+        }
+        if (!firstOk || !lastOk || params.firstTile < 0) {
+            qDebug() << "ERROR: Bad tile range" << parser.value(tilesOpt);
+            return EXIT_FAILURE;
+        }
+    }
+
+    params.outDir = parser.value(outDirOpt);
+
+    for (auto arg : args) {
+        QFileInfo dxfFileInfo(arg);
+        if (dxfFileInfo.suffix().toLower() != "dxf")
+            continue; // Skip files without .dxf extension
+        params.dxfFiles.append(arg);
+    }
+
+    if (params.dxfFiles.isEmpty())
+        parser.showHelp(EXIT_FAILURE);
+
+    if (!params.outDir.isEmpty()) {
+        // Create output directory
+        if (!QDir().mkpath(params.outDir)) {
+            qDebug() << "ERROR: Cannot create directory" << params.outDir;
+            return EXIT_FAILURE;
+        }
+    }
+
+    RS_FONTLIST->init();
+    RS_PATTERNLIST->init();
+
+    ImgExportLoop *loop = new ImgExportLoop(params, &app);
+
+    QObject::connect(loop, SIGNAL(finished()), &app, SLOT(quit()));
+
+    QTimer::singleShot(0, loop, SLOT(run()));
+
+    int ret = app.exec();
+
+    if (ret == EXIT_SUCCESS && loop->failedCount() > 0)
+        ret = EXIT_FAILURE;
+
+    return ret;
+}
+
+
+static QSize parseSizeArg(QString arg, const QSize& def)
+{
+    if (arg.isEmpty())
+        return def;
+
+    QRegularExpression re("^(?<width>\\d+)[x|X]{1}(?<height>\\d+)$");
+    QRegularExpressionMatch match = re.match(arg);
+
+    if (match.hasMatch()) {
+        QSize size(match.captured("width").toInt(),
+                   match.captured("height").toInt());
+        if (!size.isEmpty())
+            return size;
+    }
+
+    qDebug() << "WARNING: Ignoring bad image size:" << arg;
+
+    return def;
+}
@@ -0,0 +1,350 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <QtCore>
+#include <QImage>
+#include <QImageWriter>
+#include <QSvgGenerator>
+
+#include "rs.h"
+#include "rs_graphic.h"
+#include "rs_painterqt.h"
+#include "rs_staticgraphicview.h"
+
+#include "img_export_loop.h"
+
+
+static void setupPainter(RS_PainterQt&, const QSize&, ImgExportParams&);
+
+
+void ImgExportLoop::run()
+{
+    for (auto f : params.dxfFiles) {
+        if (!exportDxf(f))
+            failures++;
+    }
+
+    emit finished();
+}
+
+
+bool ImgExportLoop::exportDxf(const QString& dxfFile)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFileInfo dxfFileInfo(dxfFile);
+    QString outFile =
+        (params.outDir.isEmpty() ? dxfFileInfo.path() : params.outDir)
+        + "/" + dxfFileInfo.completeBaseName() + "." + params.format;
+
+    bool vector = params.format == "svg";
+    int nrTiles = vector ? 1 : tileColumns() * tileRows();
+    bool worker = params.firstTile >= 0;
+    bool ok = false;
+
+    qDebug() << "Exporting" << dxfFile << "to" << outFile << ">>>>";
+
+    if (nrTiles > 1 && !worker && params.jobs > 1) {
+        // The workers open the document on their own.
+        ok = exportTilesWithWorkers(dxfFile, outFile) && writeIndex(outFile);
+    } else {
+        RS_Graphic graphic;
+
+        if (!graphic.open(dxfFile, RS2::FormatUnknown)) {
+            qDebug() << "ERROR: Failed to open document" << dxfFile;
+            return false;
+        }
+
+        if (vector) {
+            ok = exportVector(&graphic, outFile);
+        } else if (worker) {
+            ok = exportTiles(&graphic, outFile, params.firstTile,
+                             qMin(params.lastTile, nrTiles - 1));
+        } else {
+            ok = exportTiles(&graphic, outFile, 0, nrTiles - 1)
+                && (nrTiles == 1 || writeIndex(outFile));
+        }
+    }
+
+    qDebug() << "Exporting" << dxfFile << "to" << outFile
+             << (ok ? "DONE in" : "FAILED after") << timer.elapsed() << "ms";
+
+    return ok;
+}
+
+
+/**
+ * Writes the whole drawing as svg. QSvgGenerator streams to the file,
+ * so vector images need no tiling.
+ */
+bool ImgExportLoop::exportVector(RS_Graphic* graphic, const QString& outFile)
+{
+    QSvgGenerator generator;
+    generator.setSize(params.size);
+    generator.setViewBox(QRectF(QPointF(0, 0), params.size));
+    generator.setFileName(outFile);
+
+    RS_PainterQt painter(&generator);
+    if (!painter.isActive()) {
+        qDebug() << "ERROR: Cannot write" << outFile;
+        return false;
+    }
+
+    setupPainter(painter, params.size, params);
+
+    RS_StaticGraphicView gv(params.size.width(), params.size.height(),
+                            &painter, &params.borders);
+    gv.setBackground(params.black ? Qt::black : Qt::white);
+    gv.setContainer(graphic);
+    gv.zoomAuto(false);
+    gv.drawEntity(&painter, gv.getContainer());
+
+    painter.end();
+
+    return true;
+}
+
+
+/**
+ * Renders the tiles firstTile to lastTile of the image. Each tile is
+ * written to its own file, an image fitting in one tile to outFile.
+ */
+bool ImgExportLoop::exportTiles(RS_Graphic* graphic, const QString& outFile,
+    int firstTile, int lastTile)
+{
+    // Scale and offset of the whole image, the tiles only shift the offset.
+    RS_StaticGraphicView view(params.size.width(), params.size.height(),
+                              nullptr, &params.borders);
+    view.setContainer(graphic);
+    view.zoomAuto(false);
+
+    RS_Vector factor = view.getFactor();
+    int offsetX = view.getOffsetX();
+    int offsetY = view.getOffsetY();
+
+    for (int tile = firstTile; tile <= lastTile; tile++) {
+
+        QRect rect = tileRect(tile);
+        QImage image(rect.size(), QImage::Format_RGB32);
+
+        RS_PainterQt painter(&image);
+
+        setupPainter(painter, rect.size(), params);
+
+        RS_StaticGraphicView gv(rect.width(), rect.height(), &painter);
+        gv.setBackground(params.black ? Qt::black : Qt::white);
+        gv.setContainer(graphic);
+        gv.setFactorX(factor.x);
+        gv.setFactorY(factor.y);
+        // Screen y is counted from the bottom of the view,
+        // see RS_GraphicView::toGuiY().
+        gv.setOffset(offsetX - rect.x(),
+                     offsetY + rect.y() + rect.height() - params.size.height());
+        gv.drawEntity(&painter, gv.getContainer());
+
+        painter.end();
+
+        QImageWriter writer(tileFileName(outFile, tile),
+                            params.format.toLatin1());
+        if (!writer.write(image)) {
+            qDebug() << "ERROR: Cannot write" << writer.fileName()
+                     << writer.errorString();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * Splits the tiles into contiguous ranges rendered by worker processes
+ * running this very program. Every worker opens the document on its own.
+ */
+bool ImgExportLoop::exportTilesWithWorkers(const QString& dxfFile,
+    const QString& outFile)
+{
+    int nrTiles = tileColumns() * tileRows();
+    int jobs = qMin(params.jobs, nrTiles);
+
+    QList<QProcess*> workers;
+
+    for (int i = 0; i < jobs; i++) {
+        int first = nrTiles * i / jobs;
+        int last = nrTiles * (i + 1) / jobs - 1;
+
+        QProcess* process = new QProcess(this);
+        process->setProcessChannelMode(QProcess::ForwardedChannels);
+        process->start(QCoreApplication::applicationFilePath(),
+                       workerArguments(dxfFile, first, last));
+        workers.append(process);
+    }
+
+    bool ok = true;
+
+    for (auto process : workers) {
+        if (!process->waitForFinished(-1)
+                || process->exitStatus() != QProcess::NormalExit
+                || process->exitCode() != EXIT_SUCCESS) {
+            qDebug() << "ERROR: Worker failed on tiles of" << outFile;
+            ok = false;
+        }
+        delete process;
+    }
+
+    return ok;
+}
+
+
+/**
+ * Writes the tile layout of outFile to a json file next to the tiles.
+ */
+bool ImgExportLoop::writeIndex(const QString& outFile)
+{
+    QFileInfo outFileInfo(outFile);
+    QString indexFile = outFileInfo.path() + "/"
+        + outFileInfo.completeBaseName() + ".tiles.json";
+
+    QJsonArray tiles;
+    for (int tile = 0; tile < tileColumns() * tileRows(); tile++) {
+        QRect rect = tileRect(tile);
+        QJsonObject t;
+        t["file"] = QFileInfo(tileFileName(outFile, tile)).fileName();
+        t["x"] = rect.x();
+        t["y"] = rect.y();
+        t["width"] = rect.width();
+        t["height"] = rect.height();
+        tiles.append(t);
+    }
+
+    QJsonObject index;
+    index["format"] = params.format;
+    index["width"] = params.size.width();
+    index["height"] = params.size.height();
+    index["columns"] = tileColumns();
+    index["rows"] = tileRows();
+    index["tiles"] = tiles;
+
+    QFile file(indexFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "ERROR: Cannot write" << indexFile;
+        return false;
+    }
+    file.write(QJsonDocument(index).toJson());
+
+    return true;
+}
+
+
+int ImgExportLoop::tileColumns() const
+{
+    if (params.tileSize <= 0)
+        return 1;
+    return (params.size.width() + params.tileSize - 1) / params.tileSize;
+}
+
+
+int ImgExportLoop::tileRows() const
+{
+    if (params.tileSize <= 0)
+        return 1;
+    return (params.size.height() + params.tileSize - 1) / params.tileSize;
+}
+
+
+/**
+ * @return Area of the tile in image pixels, tiles are numbered row by row.
+ */
+QRect ImgExportLoop::tileRect(int tile) const
+{
+    if (params.tileSize <= 0)
+        return QRect(QPoint(0, 0), params.size);
+
+    int x = (tile % tileColumns()) * params.tileSize;
+    int y = (tile / tileColumns()) * params.tileSize;
+
+    return QRect(x, y,
+                 qMin(params.tileSize, params.size.width() - x),
+                 qMin(params.tileSize, params.size.height() - y));
+}
+
+
+QString ImgExportLoop::tileFileName(const QString& outFile, int tile) const
+{
+    if (tileColumns() * tileRows() == 1)
+        return outFile;
+
+    QFileInfo outFileInfo(outFile);
+
+    return QString("%1/%2_%3_%4.%5")
+        .arg(outFileInfo.path())
+        .arg(outFileInfo.completeBaseName())
+        .arg(tile / tileColumns())
+        .arg(tile % tileColumns())
+        .arg(outFileInfo.suffix());
+}
+
+
+/**
+ * Command line of a worker process rendering some tiles of the given file
+ * with the same options.
+ */
+QStringList ImgExportLoop::workerArguments(const QString& dxfFile,
+    int firstTile, int lastTile) const
+{
+    QStringList args;
+
+    args << "dxf2png"
+         << "--format" << params.format
+         << "--size" << QString("%1x%2").arg(params.size.width())
+                                        .arg(params.size.height())
+         << "--border" << QString::number(params.borders.width())
+         << "--tile-size" << QString::number(params.tileSize)
+         << "--tiles" << QString("%1:%2").arg(firstTile).arg(lastTile);
+
+    if (params.black)
+        args << "--black";
+    if (params.monochrome)
+        args << "--monochrome";
+
+    if (!params.outDir.isEmpty())
+        args << "--directory" << params.outDir;
+
+    args << dxfFile;
+
+    return args;
+}
+
+
+static void setupPainter(RS_PainterQt& painter, const QSize& size,
+    ImgExportParams& params)
+{
+    painter.setBackground(params.black ? Qt::black : Qt::white);
+
+    if (params.monochrome)
+        painter.setDrawingMode(RS2::ModeBW);
+
+    painter.eraseRect(0, 0, size.width(), size.height());
+}
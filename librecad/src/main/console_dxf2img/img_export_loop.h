@@ -0,0 +1,98 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+#ifndef IMG_EXPORT_LOOP_H
+#define IMG_EXPORT_LOOP_H
+
+#include <QtCore>
+#include <QSize>
+
+class RS_Graphic;
+
+
+struct ImgExportParams {
+        QStringList dxfFiles;
+        QString outDir;
+        QString format = "png";  // "svg" or a raster format known to Qt.
+        QSize size {640, 480};   // Size of the whole image in pixels.
+        QSize borders {5, 5};
+        int tileSize = 4096;     // Raster images are rendered in tiles.
+        int jobs = 1;            // Worker processes rendering tiles.
+        bool black = false;
+        bool monochrome = false;
+        int firstTile = -1;      // If >= 0, only render tiles in
+        int lastTile = -1;       // [firstTile, lastTile], no index.
+};
+
+
+/**
+ * Exports dxf files to images without showing any window.
+ *
+ * Vector images (svg) are written in one pass. Raster images larger than
+ * one tile are rendered tile by tile, every tile to its own file next to
+ * an index file which describes the tile layout. Only one tile is held in
+ * memory at a time. With jobs > 1 the tiles are split between worker
+ * processes running this program.
+ */
+class ImgExportLoop : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    ImgExportLoop(ImgExportParams& params, QObject* parent=0) :
+        QObject(parent) {
+        this->params = params;
+    };
+
+    int failedCount() const { return failures; }
+
+public slots:
+
+    void run();
+
+signals:
+
+    void finished();
+
+private:
+
+    ImgExportParams params;
+    int failures = 0;
+
+    bool exportDxf(const QString& dxfFile);
+    bool exportVector(RS_Graphic* graphic, const QString& outFile);
+    bool exportTiles(RS_Graphic* graphic, const QString& outFile,
+                     int firstTile, int lastTile);
+    bool exportTilesWithWorkers(const QString& dxfFile, const QString& outFile);
+    bool writeIndex(const QString& outFile);
+
+    int tileColumns() const;
+    int tileRows() const;
+    QRect tileRect(int tile) const;
+    QString tileFileName(const QString& outFile, int tile) const;
+    QStringList workerArguments(const QString& dxfFile,
+                                int firstTile, int lastTile) const;
+};
+
+#endif
@@ -74,7 +74,10 @@ int console_dxf2pdf(int argc, char* argv[])
     appDesc += "    -- print all dxf files to pdf files with the same names.\n";
     appDesc += "\n";
     appDesc += "  " + librecad + " dxf2pdf -o some.pdf *.dxf";
-    appDesc += "    -- print all dxf files to 'some.pdf' file.";
+    appDesc += "    -- print all dxf files to 'some.pdf' file.\n";
+    appDesc += "\n";
+    appDesc += "  " + librecad + " dxf2pdf -j 0 *.dxf";
+    appDesc += "    -- print all dxf files to pdf files, one per CPU core at a time.";
     parser.setApplicationDescription(appDesc);
 
     parser.addHelpOption();
@@ -116,6 +119,11 @@ int console_dxf2pdf(int argc, char* argv[])
         "Target output directory.", "path");
     parser.addOption(outDirOpt);
 
+    QCommandLineOption jobsOpt(QStringList() << "j" << "jobs",
+        "Number of files printed in parallel to separate PDF files"
+        " (0 = number of CPU cores).", "integer");
+    parser.addOption(jobsOpt);
+
     parser.addPositionalArgument("<dxf_files>", "Input DXF file(s)");
 
     parser.process(app);
@@ -146,6 +154,11 @@ int console_dxf2pdf(int argc, char* argv[])
     params.outFile = parser.value(outFileOpt);
     params.outDir = parser.value(outDirOpt);
 
+    bool jobsOk;
+    int jobs = parser.value(jobsOpt).toInt(&jobsOk);
+    if (jobsOk)
+        params.jobs = jobs > 0 ? jobs : QThread::idealThreadCount();
+
     for (auto arg : args) {
         QFileInfo dxfFileInfo(arg);
         if (dxfFileInfo.suffix().toLower() != "dxf")
@@ -173,7 +186,12 @@ int console_dxf2pdf(int argc, char* argv[])
 
     QTimer::singleShot(0, loop, SLOT(run()));
 
-    return app.exec();
+    int ret = app.exec();
+
+    if (ret == EXIT_SUCCESS && loop->failedCount() > 0)
+        ret = EXIT_FAILURE;
+
+    return ret;
 }
 
 
@@ -22,13 +22,13 @@
 **
 ******************************************************************************/
 
+#include <memory>
 #include <QtCore>
 
 #include "rs.h"
 #include "rs_graphic.h"
-#include "rs_painterqt.h"
 #include "lc_printing.h"
-#include "rs_staticgraphicview.h"
+#include "lc_printpainter.h"
 
 #include "pdf_print_loop.h"
 
@@ -36,29 +36,42 @@
 static bool openDocAndSetGraphic(RS_Document**, RS_Graphic**, QString&);
 static void touchGraphic(RS_Graphic*, PdfPrintParams&);
 static void setupPrinterAndPaper(RS_Graphic*, QPrinter&, PdfPrintParams&);
-static void drawPage(RS_Graphic*, QPrinter&, RS_PainterQt&);
 
 
 void PdfPrintLoop::run()
 {
-    if (params.outFile.isEmpty()) {
+    if (!params.outFile.isEmpty()) {
+        if (params.jobs > 1)
+            qDebug() << "WARNING: Ignoring --jobs, all files print to"
+                     << params.outFile;
+        printManyDxfToOnePdf();
+    } else if (params.jobs > 1 && params.dxfFiles.size() > 1) {
+        // Documents are printed by worker processes running this very
+        // program for one dxf file each. finished() is emitted as soon as
+        // the last worker is done.
+        pending = params.dxfFiles;
+        startWorkers();
+        return;
+    } else {
         for (auto f : params.dxfFiles) {
-            printOneDxfToOnePdf(f);
+            if (!printOneDxfToOnePdf(f))
+                failures++;
         }
-    } else {
-        printManyDxfToOnePdf();
     }
 
     emit finished();
 }
 
 
-void PdfPrintLoop::printOneDxfToOnePdf(QString& dxfFile) {
+bool PdfPrintLoop::printOneDxfToOnePdf(QString& dxfFile) {
 
     // Main code logic and flow for this method is originally stolen from
     // QC_ApplicationWindow::slotFilePrint(bool printPDF) method.
     // But finally it was splitted in smaller parts.
 
+    QElapsedTimer timer;
+    timer.start();
+
     QFileInfo dxfFileInfo(dxfFile);
     params.outFile =
         (params.outDir.isEmpty() ? dxfFileInfo.path() : params.outDir)
@@ -68,7 +81,7 @@ void PdfPrintLoop::printOneDxfToOnePdf(QString& dxfFile) {
     RS_Graphic *graphic;
 
     if (!openDocAndSetGraphic(&doc, &graphic, dxfFile))
-        return;
+        return false;
 
     qDebug() << "Printing" << dxfFile << "to" << params.outFile << ">>>>";
 
@@ -78,94 +91,173 @@ void PdfPrintLoop::printOneDxfToOnePdf(QString& dxfFile) {
 
     setupPrinterAndPaper(graphic, printer, params);
 
-    RS_PainterQt painter(&printer);
+    LC_PrintPainter painter(&printer);
 
     if (params.monochrome)
         painter.setDrawingMode(RS2::ModeBW);
 
-    drawPage(graphic, printer, painter);
+    LC_Printing::drawPage(graphic, printer, painter);
 
     painter.end();
 
-    qDebug() << "Printing" << dxfFile << "to" << params.outFile << "DONE";
+    qDebug() << "Printing" << dxfFile << "to" << params.outFile << "DONE in"
+             << timer.elapsed() << "ms";
 
     delete doc;
+
+    return true;
 }
 
 
 void PdfPrintLoop::printManyDxfToOnePdf() {
 
-    struct DxfPage {
-        RS_Document* doc;
-        RS_Graphic* graphic;
-        QString dxfFile;
-        QPrinter::PageSize paperSize;
-    };
-
     if (!params.outDir.isEmpty()) {
         QFileInfo outFileInfo(params.outFile);
         params.outFile = params.outDir + "/" + outFileInfo.fileName();
     }
 
-    QVector<DxfPage> pages;
-    int nrPages = 0;
+    QPrinter printer(QPrinter::HighResolution);
+
+    // The painter can't begin before the printer is set up, and the
+    // printer set up needs the first opened dxf file. So the painter is
+    // created together with the first page. Every document is printed and
+    // deleted right after opening it, only one is held in memory at a time.
+    std::unique_ptr<LC_PrintPainter> painter;
 
-    // FIXME: Should probably open and print all dxf files in one 'for' loop.
-    // Tried but failed to do this. It looks like some 'chicken and egg'
-    // situation for the QPrinter and RS_PainterQt. Therefore, first open
-    // all dxf files and apply required actions. Then run another 'for'
-    // loop for actual printing.
     for (auto dxfFile : params.dxfFiles) {
 
-        DxfPage page;
+        QElapsedTimer timer;
+        timer.start();
 
-        page.dxfFile = dxfFile;
+        RS_Document* doc;
+        RS_Graphic* graphic;
 
-        if (!openDocAndSetGraphic(&page.doc, &page.graphic, dxfFile))
+        if (!openDocAndSetGraphic(&doc, &graphic, dxfFile)) {
+            failures++;
             continue;
+        }
 
-        qDebug() << "Opened" << dxfFile;
+        touchGraphic(graphic, params);
 
-        touchGraphic(page.graphic, params);
+        if (!painter) {
+            // FIXME: Is it possible to set up printer and paper for every
+            // opened dxf file and tie them with painter? For now just using
+            // data extracted from the first opened dxf file for all pages.
+            setupPrinterAndPaper(graphic, printer, params);
 
-        pages.append(page);
+            painter.reset(new LC_PrintPainter(&printer));
 
-        nrPages++;
-    }
+            if (params.monochrome)
+                painter->setDrawingMode(RS2::ModeBW);
+        } else {
+            printer.newPage();
+        }
 
-    QPrinter printer(QPrinter::HighResolution);
+        qDebug() << "Printing" << dxfFile
+                 << "to" << params.outFile << ">>>>";
+
+        LC_Printing::drawPage(graphic, printer, *painter);
 
-    if (nrPages > 0) {
-        // FIXME: Is it possible to set up printer and paper for every
-        // opened dxf file and tie them with painter? For now just using
-        // data extracted from the first opened dxf file for all pages.
-        setupPrinterAndPaper(pages.at(0).graphic, printer, params);
+        qDebug() << "Printing" << dxfFile
+                 << "to" << params.outFile << "DONE in"
+                 << timer.elapsed() << "ms";
+
+        delete doc;
     }
 
-    RS_PainterQt painter(&printer);
+    if (painter)
+        painter->end();
+}
 
-    if (params.monochrome)
-        painter.setDrawingMode(RS2::ModeBW);
 
-    // And now it's time to actually print all previously opened dxf files.
-    for (auto page : pages) {
-        nrPages--;
+void PdfPrintLoop::startWorkers()
+{
+    while (workers.size() < params.jobs && !pending.isEmpty()) {
 
-        qDebug() << "Printing" << page.dxfFile
-                 << "to" << params.outFile << ">>>>";
+        QString dxfFile = pending.takeFirst();
+        QProcess* process = new QProcess(this);
 
-        drawPage(page.graphic, printer, painter);
+        process->setProcessChannelMode(QProcess::ForwardedChannels);
+        connect(process, SIGNAL(finished(int,QProcess::ExitStatus)),
+                this, SLOT(workerFinished(int,QProcess::ExitStatus)));
 
-        qDebug() << "Printing" << page.dxfFile
-                 << "to" << params.outFile << "DONE";
+        Worker& worker = workers[process];
+        worker.dxfFile = dxfFile;
+        worker.timer.start();
 
-        delete page.doc;
+        process->start(QCoreApplication::applicationFilePath(),
+                       workerArguments(dxfFile));
 
-        if (nrPages > 0)
-            printer.newPage();
+        if (!process->waitForStarted()) {
+            qDebug() << "ERROR: Failed to start worker for" << dxfFile;
+            workers.remove(process);
+            process->deleteLater();
+            failures++;
+        }
     }
 
-    painter.end();
+    if (workers.isEmpty())
+        emit finished();
+}
+
+
+void PdfPrintLoop::workerFinished(int exitCode,
+    QProcess::ExitStatus exitStatus)
+{
+    QProcess* process = qobject_cast<QProcess*>(sender());
+    if (process == nullptr || !workers.contains(process))
+        return;
+
+    Worker worker = workers.take(process);
+    process->deleteLater();
+
+    if (exitStatus != QProcess::NormalExit || exitCode != EXIT_SUCCESS) {
+        qDebug() << "ERROR: Failed to print" << worker.dxfFile;
+        failures++;
+    }
+
+    qDebug() << "Worker for" << worker.dxfFile << "finished in"
+             << worker.timer.elapsed() << "ms";
+
+    startWorkers();
+}
+
+
+/**
+ * Command line of a worker process printing the given file with the same
+ * options. The program is started with "dxf2pdf" as first argument, this
+ * works whether it was called as "librecad dxf2pdf" or through a link.
+ */
+QStringList PdfPrintLoop::workerArguments(const QString& dxfFile) const
+{
+    QStringList args;
+
+    args << "dxf2pdf";
+
+    if (params.fitToPage)
+        args << "--fit";
+    if (params.centerOnPage)
+        args << "--center";
+    if (params.grayscale)
+        args << "--grayscale";
+    if (params.monochrome)
+        args << "--monochrome";
+
+    if (params.pageSize != RS_Vector(0.0, 0.0))
+        args << "--paper" << QString("%1x%2").arg(params.pageSize.x)
+                                              .arg(params.pageSize.y);
+
+    args << "--resolution" << QString::number(params.resolution);
+
+    if (params.scale > 0.0)
+        args << "--scale" << QString::number(params.scale, 'g', 17);
+
+    if (!params.outDir.isEmpty())
+        args << "--directory" << params.outDir;
+
+    args << dxfFile;
+
+    return args;
 }
 
 
@@ -243,27 +335,3 @@ static void setupPrinterAndPaper(RS_Graphic* graphic, QPrinter& printer,
     else
         printer.setColorMode(QPrinter::Color);
 }
-
-
-static void drawPage(RS_Graphic* graphic, QPrinter& printer,
-    RS_PainterQt& painter)
-{
-    RS_StaticGraphicView gv(printer.width(), printer.height(), &painter);
-    gv.setPrinting(true);
-    gv.setBorders(0,0,0,0);
-
-    double fx = (double) printer.width() / printer.widthMM()
-                * RS_Units::getFactorToMM(graphic->getUnit());
-    double fy = (double) printer.height() / printer.heightMM()
-                * RS_Units::getFactorToMM(graphic->getUnit());
-
-    double f = (fx + fy) / 2.0;
-
-    double scale = graphic->getPaperScale();
-
-    gv.setOffset((int)(graphic->getPaperInsertionBase().x * f),
-                 (int)(graphic->getPaperInsertionBase().y * f));
-    gv.setFactor(f*scale);
-    gv.setContainer(graphic);
-    gv.drawEntity(&painter, graphic);
-}
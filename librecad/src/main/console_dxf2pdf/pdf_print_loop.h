@@ -41,6 +41,7 @@ struct PdfPrintParams {
         bool grayscale;
         double scale = 0.0;  // If scale <= 0.0, use value from dxf file.
         RS_Vector pageSize;  // If zeros, use value from dxf file.
+        int jobs = 1;        // Files printed in parallel to separate pdf files.
 };
 
 
@@ -55,6 +56,8 @@ public:
         this->params = params;
     };
 
+    int failedCount() const { return failures; }
+
 public slots:
 
     void run();
@@ -63,12 +66,26 @@ signals:
 
     void finished();
 
+private slots:
+
+    void workerFinished(int exitCode, QProcess::ExitStatus exitStatus);
+
 private:
 
+    struct Worker {
+        QString dxfFile;
+        QElapsedTimer timer;
+    };
+
     PdfPrintParams params;
+    QStringList pending;   // Files not yet handed to a worker process.
+    QHash<QProcess*, Worker> workers;
+    int failures = 0;
 
-    void printOneDxfToOnePdf(QString&);
+    bool printOneDxfToOnePdf(QString&);
     void printManyDxfToOnePdf();
+    void startWorkers();
+    QStringList workerArguments(const QString& dxfFile) const;
 };
 
 #endif
@@ -0,0 +1,132 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <QtCore>
+#include <QCoreApplication>
+#include <QApplication>
+
+#include "rs_debug.h"
+#include "rs_settings.h"
+#include "rs_system.h"
+
+#include "main.h"
+
+#include "console_selftest.h"
+#include "lc_selftest.h"
+
+
+namespace {
+
+struct SelfTestCase {
+    const char* name;
+    void (*run)(LC_SelfTest& test);
+};
+
+const SelfTestCase selfTests[] = {
+    {"intersection_index", lc_testIntersectionIndex},
+    {"batch_intersections", lc_testBatchIntersections},
+    {"quadratic", lc_testQuadratic},
+    {"undo_attributes", lc_testUndoAttributes},
+    {"undo_transform", lc_testUndoTransform},
+    {"document_snapshot", lc_testDocumentSnapshot},
+};
+
+}
+
+
+int console_selftest(int argc, char* argv[])
+{
+    RS_DEBUG->setLevel(RS_Debug::D_NOTHING);
+
+    // Nothing is shown, so don't require a display. An explicitly
+    // selected platform plugin is still respected.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    QCoreApplication::setOrganizationName("LibreCAD");
+    QCoreApplication::setApplicationName("LibreCAD");
+    QCoreApplication::setApplicationVersion(XSTR(LC_VERSION));
+
+    QFileInfo prgInfo(QFile::decodeName(argv[0]));
+    QString prgDir(prgInfo.absolutePath());
+    RS_SETTINGS->init(app.organizationName(), app.applicationName());
+    RS_SYSTEM->init(app.applicationName(), app.applicationVersion(),
+        XSTR(QC_APPDIR), prgDir);
+
+    QStringList names;
+    for (auto const& selfTest : selfTests)
+        names << selfTest.name;
+
+    QCommandLineParser parser;
+
+    QString appDesc;
+    QString librecad;
+    if (prgInfo.baseName() != "selftest") {
+        librecad = prgInfo.filePath();
+        appDesc = "\nselftest usage: " + prgInfo.filePath()
+            + " selftest [options] [tests...]\n";
+    }
+    appDesc += "\nRun the built-in tests of the geometry code without a display.";
+    appDesc += "\nEvery failed check is printed, the exit status is non-zero";
+    appDesc += "\nwhen a check failed.";
+    appDesc += "\n\nTests: " + names.join(", ");
+    appDesc += "\n\n";
+    appDesc += "Examples:\n\n";
+    appDesc += "  " + librecad + " selftest";
+    appDesc += "    -- run all tests.\n";
+    parser.setApplicationDescription(appDesc);
+
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("<tests>", "Tests to run (default all).");
+
+    parser.process(app);
+
+    QStringList only = parser.positionalArguments();
+    // the subcommand itself when started as "librecad selftest"
+    only.removeAll("selftest");
+    for (auto const& name : only) {
+        if (!names.contains(name)) {
+            qDebug() << "ERROR: Unknown test" << name;
+            return EXIT_FAILURE;
+        }
+    }
+
+    int failed = 0;
+    for (auto const& selfTest : selfTests) {
+        if (!only.isEmpty() && !only.contains(selfTest.name))
+            continue;
+
+        LC_SelfTest test(selfTest.name);
+        selfTest.run(test);
+        qDebug("%s %s: %d checks, %d failed",
+               0 < test.getFailures() ? "FAIL" : "PASS",
+               selfTest.name, test.getChecks(), test.getFailures());
+        if (0 < test.getFailures())
+            ++failed;
+    }
+
+    return 0 < failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -43,6 +43,8 @@
 #include "rs_image.h"
 #include "rs_block.h"
 #include "rs_insert.h"
+#include "rs_dimension.h"
+#include "rs_information.h"
 #include "rs_polyline.h"
 #include "rs_ellipse.h"
 #include "rs_polyline.h"
@@ -143,6 +145,10 @@ Plugin_Entity::Plugin_Entity(RS_Entity* ent, Doc_plugin_interface* d):
   ,hasContainer(true)
   ,dpi(d)
 {
+    // dimensions are regenerated lazily, plugins see the current state
+    if (ent && RS_Information::isDimension(ent->rtti())) {
+        static_cast<RS_Dimension*>(ent)->validateDim();
+    }
 }
 
 /*RS_EntityContainer* parent,
@@ -24,14 +24,19 @@ along with this program; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 **********************************************************************/
 
+#include <QDebug>
 #include <QStringList>
 #include <QFileOpenEvent>
 
 #include "lc_application.h"
 
+bool LC_Application::startupTiming = false;
+QElapsedTimer LC_Application::startupTimer;
+
 LC_Application::LC_Application(int &argc, char **argv)
     : QApplication(argc, argv)
 {
+    startupTimer.start();
 }
 
 // This is only used until the event filter is in place in mainwindow
@@ -51,3 +56,21 @@ QStringList const& LC_Application::fileList(void) const
 {
     return files;
 }
+
+/**
+ * Enables the output of startupStep(), set with the --timing option.
+ */
+void LC_Application::setStartupTiming(bool on)
+{
+    startupTiming = on;
+}
+
+/**
+ * Prints the time since the application was created when step is done.
+ */
+void LC_Application::startupStep(const char* step)
+{
+    if (startupTiming) {
+        qDebug("startup: %6lld ms  %s", (long long) startupTimer.elapsed(), step);
+    }
+}
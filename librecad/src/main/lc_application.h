@@ -28,6 +28,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #define LC_APPLICATION_H
 
 #include <QApplication>
+#include <QElapsedTimer>
 
 class QStringList;
 
@@ -40,11 +41,17 @@ public:
 
     QStringList const& fileList(void) const;
 
+    static void setStartupTiming(bool on);
+    static void startupStep(const char* step);
+
 protected:
     bool event(QEvent *event) Q_DECL_OVERRIDE;
 
 private:
     QStringList files;
+
+    static bool startupTiming;
+    static QElapsedTimer startupTimer;
 };
 
 #endif // LC_APPLICATION_H
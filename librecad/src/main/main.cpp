@@ -44,8 +44,12 @@
 #include "lc_application.h"
 #include "qc_applicationwindow.h"
 #include "rs_debug.h"
+#include "lc_trace.h"
 
 #include "console_dxf2pdf.h"
+#include "console_dxf2img.h"
+#include "console_benchmark.h"
+#include "console_selftest.h"
 
 
 /**
@@ -65,6 +69,9 @@ int main(int argc, char** argv)
     //
     //     dxf2pdf [options] ...
     //
+    // The same works for the image export tools dxf2png and dxf2svg,
+    // for the benchmark suite and for the self tests.
+    //
     for (int i = 0; i < qMin(argc, 2); i++) {
         QString arg(argv[i]);
         if (i == 0) {
@@ -73,6 +80,15 @@ int main(int argc, char** argv)
         if (arg.compare("dxf2pdf") == 0) {
             return console_dxf2pdf(argc, argv);
         }
+        if (arg.compare("dxf2png") == 0 || arg.compare("dxf2svg") == 0) {
+            return console_dxf2img(argc, argv);
+        }
+        if (arg.compare("benchmark") == 0) {
+            return console_benchmark(argc, argv);
+        }
+        if (arg.compare("selftest") == 0) {
+            return console_selftest(argc, argv);
+        }
     }
 
     RS_DEBUG->setLevel(RS_Debug::D_WARNING);
@@ -88,6 +104,9 @@ int main(int argc, char** argv)
 
     const QString lpDebugSwitch0("-d"),lpDebugSwitch1("--debug") ;
     const QString help0("-h"), help1("--help");
+    const QString timingSwitch("--timing");
+    const QString traceSwitch("--trace");
+    QString traceFile;
     bool allowOptions=true;
     QList<int> argClean;
     for (int i=0; i<argc; i++)
@@ -106,11 +125,18 @@ int main(int argc, char** argv)
             qDebug()<<"Commands:";
             qDebug()<<"";
             qDebug()<<"  dxf2pdf\tRun librecad as console dxf2pdf tool. Use -h for help.";
+            qDebug()<<"  dxf2png\tRun librecad as console dxf2png tool. Use -h for help.";
+            qDebug()<<"  dxf2svg\tRun librecad as console dxf2svg tool. Use -h for help.";
+            qDebug()<<"  benchmark\tRun the headless benchmark suite. Use -h for help.";
+            qDebug()<<"  selftest\tRun the built-in tests without a display. Use -h for help.";
             qDebug()<<"";
             qDebug()<<"Options:";
             qDebug()<<"";
             qDebug()<<"  -h, --help\tdisplay this message";
             qDebug()<<"  -d, --debug <level>";
+            qDebug()<<"  --timing\tprint the time spent in the steps of startup";
+            qDebug()<<"  --trace <file>\twrite a trace of drawing, snapping, loading and undo";
+            qDebug()<<"               \tto file on exit, for chrome://tracing";
             qDebug()<<"";
             RS_DEBUG->print( RS_Debug::D_NOTHING, "possible debug levels:");
             RS_DEBUG->print( RS_Debug::D_NOTHING, "    %d Nothing", RS_Debug::D_NOTHING);
@@ -122,6 +148,22 @@ int main(int argc, char** argv)
             RS_DEBUG->print( RS_Debug::D_NOTHING, "    %d Debugging", RS_Debug::D_DEBUGGING);
             exit(0);
         }
+        if (allowOptions && timingSwitch.compare(argstr, Qt::CaseInsensitive)==0)
+        {
+            argClean<<i;
+            LC_Application::setStartupTiming(true);
+            continue;
+        }
+        if (allowOptions && traceSwitch.compare(argstr, Qt::CaseInsensitive)==0
+                && i+1<argc)
+        {
+            argClean<<i;
+            ++i;
+            argClean<<i;
+            traceFile = QFile::decodeName(argv[i]);
+            LC_Trace::setEnabled(true);
+            continue;
+        }
         if ( allowOptions&& (argstr.startsWith(lpDebugSwitch0, Qt::CaseInsensitive) ||
                              argstr.startsWith(lpDebugSwitch1, Qt::CaseInsensitive) ))
         {
@@ -207,6 +249,8 @@ int main(int argc, char** argv)
     RS_SETTINGS->init(app.organizationName(), app.applicationName());
     RS_SYSTEM->init(app.applicationName(), app.applicationVersion(), XSTR(QC_APPDIR), prgDir);
 
+    LC_Application::startupStep("settings and system paths");
+
     // parse command line arguments that might not need a launched program:
     QStringList fileList = handleArgs(argc, argv, argClean);
 
@@ -243,7 +287,9 @@ int main(int argc, char** argv)
         app.processEvents();
         RS_DEBUG->print("main: splashscreen: OK");
     }
+    LC_Application::startupStep("splash screen");
 
+    // both only start listing their files in the background
     RS_DEBUG->print("main: init fontlist..");
     RS_FONTLIST->init();
     RS_DEBUG->print("main: init fontlist: OK");
@@ -251,6 +297,7 @@ int main(int argc, char** argv)
     RS_DEBUG->print("main: init patternlist..");
     RS_PATTERNLIST->init();
     RS_DEBUG->print("main: init patternlist: OK");
+    LC_Application::startupStep("font and pattern directories");
 
     RS_DEBUG->print("main: loading translation..");
 
@@ -261,9 +308,11 @@ int main(int argc, char** argv)
 
     RS_SYSTEM->loadTranslation(lang, langCmd);
     RS_DEBUG->print("main: loading translation: OK");
+    LC_Application::startupStep("translations");
 
     RS_DEBUG->print("main: creating main window..");
     QC_ApplicationWindow appWin;
+    LC_Application::startupStep("main window");
 #ifdef Q_OS_MAC
     app.installEventFilter(&appWin);
 #endif
@@ -306,6 +355,7 @@ int main(int argc, char** argv)
     RS_DEBUG->print("main: set focus");
     appWin.setFocus();
     RS_DEBUG->print("main: creating main window: OK");
+    LC_Application::startupStep("main window shown");
 
     if (show_splash)
     {
@@ -345,6 +395,7 @@ int main(int argc, char** argv)
     {
         appWin.slotFileNewNew();
     }
+    LC_Application::startupStep(files_loaded ? "files loaded" : "new drawing");
 
     if (show_splash)
         splash->finish(&appWin);
@@ -360,6 +411,9 @@ int main(int argc, char** argv)
 
     RS_DEBUG->print("main: exited Qt event loop");
 
+    if (!traceFile.isEmpty() && !LC_Trace::write(traceFile))
+        qWarning() << "Cannot write trace file" << traceFile;
+
     return return_code;
 }
 
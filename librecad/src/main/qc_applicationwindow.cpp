@@ -39,6 +39,8 @@
 #include <QSplitter>
 #include <QMdiArea>
 #include <QPluginLoader>
+#include <QJsonArray>
+#include <QJsonObject>
 #include <QImageWriter>
 #include <QtSvg>
 #include <QStyleFactory>
@@ -56,7 +58,9 @@
 #include "rs_painterqt.h"
 #include "rs_selection.h"
 #include "rs_document.h"
+#include "rs_grid.h"
 
+#include "lc_application.h"
 #include "lc_centralwidget.h"
 #include "qc_mdiwindow.h"
 #include "qg_graphicview.h"
@@ -95,6 +99,7 @@
 #include "comboboxoption.h"
 
 #include "lc_printing.h"
+#include "lc_printpainter.h"
 #include "actionlist.h"
 #include "widgetcreator.h"
 #include "lc_actiongroupmanager.h"
@@ -354,6 +359,7 @@ QC_ApplicationWindow::QC_ApplicationWindow()
     RS_COMMANDS->updateAlias();
     //plugin load
     loadPlugins();
+    LC_Application::startupStep("plugins");
 
     statusBar()->showMessage(qApp->applicationName() + " Ready", 2000);
 }
@@ -384,6 +390,11 @@ QMenu *QC_ApplicationWindow::findMenu(const QString &searchMenu, const QObjectLi
 
 /**
  * Loads the found plugins.
+ *
+ * Plugins which list their menu entries in their JSON metadata, as
+ * "MenuEntries": [{"menu": "plugins_menu", "action": "Name"}], only get
+ * their menu entries here, the library is loaded when one is used.
+ * Other plugins are loaded right away.
  */
 void QC_ApplicationWindow::loadPlugins() {
 
@@ -409,8 +420,25 @@ void QC_ApplicationWindow::loadPlugins() {
             if (loadedPluginFileNames.contains(fileName)) {
                 continue;
             }
-            QPluginLoader pluginLoader(pluginsDir.absoluteFilePath(fileName));
-            QObject *plugin = pluginLoader.instance();
+
+            // reading the metadata doesn't load the library
+            QPluginLoader* pluginLoader = new QPluginLoader(pluginsDir.absoluteFilePath(fileName), this);
+            QJsonObject const metaData = pluginLoader->metaData();
+            QJsonArray const menuEntries = metaData.value("MetaData").toObject().value("MenuEntries").toArray();
+            if (!menuEntries.isEmpty()) {
+                loadedPluginFileNames.push_back(fileName);
+                // plugins translate their action names with tr()
+                QByteArray const context = metaData.value("className").toString().toLatin1();
+                for (const QJsonValue& entry: menuEntries) {
+                    QByteArray const actionName = entry.toObject().value("action").toString().toUtf8();
+                    addPluginMenuEntry(pluginLoader,
+                                       entry.toObject().value("menu").toString(),
+                                       QCoreApplication::translate(context.constData(), actionName.constData()));
+                }
+                continue;
+            }
+
+            QObject *plugin = pluginLoader->instance();
             if (plugin) {
                 QC_PluginInterface *pluginInterface = qobject_cast<QC_PluginInterface *>(plugin);
                 if (pluginInterface) {
@@ -418,48 +446,72 @@ void QC_ApplicationWindow::loadPlugins() {
                     loadedPluginFileNames.push_back(fileName);
                     PluginCapabilities pluginCapabilities=pluginInterface->getCapabilities();
                     for(const PluginMenuLocation& loc: pluginCapabilities.menuEntryPoints) {
-                        QAction *actpl = new QAction(loc.menuEntryActionName, plugin);
-                        actpl->setData(loc.menuEntryActionName);
-                        connect(actpl, SIGNAL(triggered()), this, SLOT(execPlug()));
-                        connect(this, SIGNAL(windowsChanged(bool)), actpl, SLOT(setEnabled(bool)));
-                        QMenu *atMenu = findMenu("/"+loc.menuEntryPoint, menuBar()->children(), "");
-                        if (atMenu) {
-                            atMenu->addAction(actpl);
-                        } else {
-                            QStringList treemenu = loc.menuEntryPoint.split('/', QString::SkipEmptyParts);
-                            QString currentLevel="";
-                            QMenu *parentMenu=0;
-                            do {
-                                QString menuName=treemenu.at(0); treemenu.removeFirst();
-                                currentLevel=currentLevel+"/"+menuName;
-                                atMenu = findMenu(currentLevel, menuBar()->children(), "");
-                                if (atMenu==0) {
-                                    if (parentMenu==0) {
-                                        parentMenu=menuBar()->addMenu(menuName);
-                                    } else {
-                                        parentMenu=parentMenu->addMenu(menuName);
-                                    }
-                                    parentMenu->setObjectName(menuName);
-                                }
-                            } while(treemenu.size()>0);
-							if (parentMenu) parentMenu->addAction(actpl);
-                        }
+                        addPluginMenuEntry(plugin, loc.menuEntryPoint, loc.menuEntryActionName);
                     }
                 }
             } else {
-                QMessageBox::information(this, "Info", pluginLoader.errorString());
-                RS_DEBUG->print("QC_ApplicationWindow::loadPlugin: %s", pluginLoader.errorString().toLatin1().data());
+                QMessageBox::information(this, "Info", pluginLoader->errorString());
+                RS_DEBUG->print("QC_ApplicationWindow::loadPlugin: %s", pluginLoader->errorString().toLatin1().data());
+                delete pluginLoader;
             }
         }
     }
 }
 
+/**
+ * Adds the menu entry of a plugin. parent is either the plugin or
+ * the QPluginLoader of a plugin which isn't loaded yet.
+ */
+void QC_ApplicationWindow::addPluginMenuEntry(QObject* parent, const QString& menuEntryPoint,
+                                              const QString& menuEntryActionName) {
+    QAction *actpl = new QAction(menuEntryActionName, parent);
+    actpl->setData(menuEntryActionName);
+    connect(actpl, SIGNAL(triggered()), this, SLOT(execPlug()));
+    connect(this, SIGNAL(windowsChanged(bool)), actpl, SLOT(setEnabled(bool)));
+    QMenu *atMenu = findMenu("/"+menuEntryPoint, menuBar()->children(), "");
+    if (atMenu) {
+        atMenu->addAction(actpl);
+    } else {
+        QStringList treemenu = menuEntryPoint.split('/', QString::SkipEmptyParts);
+        QString currentLevel="";
+        QMenu *parentMenu=0;
+        do {
+            QString menuName=treemenu.at(0); treemenu.removeFirst();
+            currentLevel=currentLevel+"/"+menuName;
+            atMenu = findMenu(currentLevel, menuBar()->children(), "");
+            if (atMenu==0) {
+                if (parentMenu==0) {
+                    parentMenu=menuBar()->addMenu(menuName);
+                } else {
+                    parentMenu=parentMenu->addMenu(menuName);
+                }
+                parentMenu->setObjectName(menuName);
+            }
+        } while(treemenu.size()>0);
+		if (parentMenu) parentMenu->addAction(actpl);
+    }
+}
+
 /**
  * Execute the plugin.
  */
 void QC_ApplicationWindow::execPlug() {
     QAction *action = qobject_cast<QAction *>(sender());
     QC_PluginInterface *plugin = qobject_cast<QC_PluginInterface *>(action->parent());
+    if (!plugin) {
+        // first use of a plugin known from its metadata
+        QPluginLoader* pluginLoader = qobject_cast<QPluginLoader *>(action->parent());
+        if (!pluginLoader)
+            return;
+        plugin = qobject_cast<QC_PluginInterface *>(pluginLoader->instance());
+        if (!plugin) {
+            QMessageBox::information(this, "Info", pluginLoader->errorString());
+            RS_DEBUG->print("QC_ApplicationWindow::execPlug: %s", pluginLoader->errorString().toLatin1().data());
+            return;
+        }
+        if (!loadedPlugins.contains(plugin))
+            loadedPlugins.push_back(plugin);
+    }
 //get actual drawing
     QC_MDIWindow* w = getMDIWindow();
     RS_Document* currdoc = w->getDocument();
@@ -622,6 +674,7 @@ void QC_ApplicationWindow::initSettings()
     settings.endGroup();
 
     a_map["ViewDraft"]->setChecked(settings.value("Appearance/DraftMode", 0).toBool());
+    a_map["ViewFrameTime"]->setChecked(settings.value("Appearance/ShowFrameTime", 0).toBool());
 }
 
 
@@ -1100,11 +1153,13 @@ QC_MDIWindow* QC_ApplicationWindow::slotFileNew(RS_Document* doc) {
     int aa = RS_SETTINGS->readNumEntry("/Antialiasing", 0);
     int scrollbars = RS_SETTINGS->readNumEntry("/ScrollBars", 1);
     int cursor_hiding = RS_SETTINGS->readNumEntry("/cursor_hiding", 0);
+    int frame_time = RS_SETTINGS->readNumEntry("/ShowFrameTime", 0);
     RS_SETTINGS->endGroup();
 
     QG_GraphicView* view = w->getGraphicView();
 
     view->setAntialiasing(aa);
+    view->setFrameTimeShown(frame_time);
     view->setCursorHiding(cursor_hiding);
     view->device = settings.value("Hardware/Device", "Mouse").toString();
     if (scrollbars) view->addScrollbars();
@@ -2037,33 +2092,10 @@ void QC_ApplicationWindow::slotFilePrint(bool printPDF) {
         QApplication::setOverrideCursor( QCursor(Qt::WaitCursor) );
         printer.setFullPage(true);
 
-        RS_PainterQt painter(&printer);
+        LC_PrintPainter painter(&printer);
         painter.setDrawingMode(w->getGraphicView()->getDrawingMode());
 
-        RS_StaticGraphicView gv(printer.width(), printer.height(), &painter);
-        gv.setPrinting(true);
-        gv.setBorders(0,0,0,0);
-
-        double fx = (double)printer.width() / printer.widthMM()
-                    * RS_Units::getFactorToMM(graphic->getUnit());
-        double fy = (double)printer.height() / printer.heightMM()
-                    * RS_Units::getFactorToMM(graphic->getUnit());
-//RS_DEBUG->print(RS_Debug::D_ERROR, "paper size=(%d, %d)\n",
-//                printer.widthMM(),printer.heightMM());
-
-        double f = (fx+fy)/2.0;
-
-        double scale = graphic->getPaperScale();
-
-        gv.setOffset((int)(graphic->getPaperInsertionBase().x * f),
-                     (int)(graphic->getPaperInsertionBase().y * f));
-        gv.setFactor(f*scale);
-//RS_DEBUG->print(RS_Debug::D_ERROR, "PaperSize=(%d, %d)\n",printer.widthMM(), printer.heightMM());
-        gv.setContainer(graphic);
-//fixme, I don't understand the meaning of 'true' here
-//        gv.drawEntity(&painter, graphic, true);
-
-        gv.drawEntity(&painter, graphic );
+        LC_Printing::drawPage(graphic, printer, painter);
 
         // GraphicView deletes painter
         painter.end();
@@ -2351,6 +2383,22 @@ void QC_ApplicationWindow::slotViewStatusBar(bool toggle) {
     statusBar()->setVisible(toggle);
 }
 
+/**
+ * Shows or hides the time of the last paint event in all views.
+ */
+void QC_ApplicationWindow::slotViewFrameTime(bool toggle) {
+    RS_DEBUG->print("QC_ApplicationWindow::slotViewFrameTime()");
+
+    RS_SETTINGS->beginGroup("/Appearance");
+    RS_SETTINGS->writeEntry("/ShowFrameTime", (int)toggle);
+    RS_SETTINGS->endGroup();
+
+    foreach (QC_MDIWindow* win, window_list)
+    {
+        win->getGraphicView()->setFrameTimeShown(toggle);
+    }
+}
+
 /**
  * Shows the dialog for general application preferences.
  */
@@ -2387,6 +2435,7 @@ void QC_ApplicationWindow::slotOptionsGeneral() {
                 gv->setHandleColor(handleColor);
                 gv->setEndHandleColor(endHandleColor);
                 gv->setAntialiasing(antialiasing?true:false);
+                gv->getGrid()->loadSettings();
                 gv->redraw(RS2::RedrawGrid);
             }
         }
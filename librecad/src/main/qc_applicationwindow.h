@@ -164,6 +164,8 @@ public slots:
     void slotViewDraft(bool toggle);
     /** toggle the statusbar */
     void slotViewStatusBar(bool toggle);
+    /** toggle the frame time overlay */
+    void slotViewFrameTime(bool toggle);
 
     void slotOptionsGeneral();
 
@@ -303,6 +305,8 @@ private:
 
     //Plugin support
     void loadPlugins();
+    void addPluginMenuEntry(QObject* parent, const QString& menuEntryPoint,
+                            const QString& menuEntryActionName);
     QMenu *findMenu(const QString &searchMenu, const QObjectList thisMenuList, const QString& currentEntry);
 
     #ifdef LC_DEBUGGING
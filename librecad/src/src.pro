@@ -7,6 +7,12 @@ DISABLE_POSTSCRIPT = false
 #uncomment to enable a Debugging menu entry for basic unit testing
 #DEFINES += LC_DEBUGGING
 
+#uncomment to compile without the trace scopes of --trace
+#DEFINES += LC_NO_TRACE
+
+#uncomment to keep RS_DEBUG_PRINT_DEBUG messages in release builds
+#DEFINES += LC_DEBUG_LOG
+
 DEFINES += DWGSUPPORT
 DEFINES -= JWW_WRITE_SUPPORT
 
@@ -103,6 +109,9 @@ INCLUDEPATH += \
     actions \
     main \
     main/console_dxf2pdf \
+    main/console_dxf2img \
+    main/console_benchmark \
+    main/console_selftest \
     test \
     plugins \
     ui \
@@ -126,6 +135,7 @@ HEADERS += \
     lib/actions/rs_snapper.h \
     lib/creation/rs_creation.h \
     lib/debug/rs_debug.h \
+    lib/debug/lc_trace.h \
     lib/engine/rs.h \
     lib/engine/rs_arc.h \
     lib/engine/rs_atomicentity.h \
@@ -155,6 +165,7 @@ HEADERS += \
     lib/engine/lc_hyperbola.h \
     lib/engine/rs_insert.h \
     lib/engine/rs_image.h \
+    lib/engine/lc_imagepyramid.h \
     lib/engine/rs_layer.h \
     lib/engine/rs_layerlist.h \
     lib/engine/rs_layerlistlistener.h \
@@ -205,19 +216,25 @@ HEADERS += \
     lib/information/rs_locale.h \
     lib/information/rs_information.h \
     lib/information/rs_infoarea.h \
+    lib/information/lc_intersectionindex.h \
     lib/modification/rs_modification.h \
     lib/modification/rs_selection.h \
     lib/math/rs_math.h \
     lib/math/lc_quadratic.h \
     actions/lc_actiondrawcircle2pr.h \
     test/lc_simpletests.h \
+    test/lc_selftest.h \
     lib/generators/lc_makercamsvg.h \
     lib/generators/lc_xmlwriterinterface.h \
     lib/generators/lc_xmlwriterqxmlstreamwriter.h \
     actions/lc_actionfileexportmakercam.h \
     lib/engine/lc_rect.h \
     lib/engine/lc_undosection.h \
+    lib/engine/lc_undodelta.h \
+    lib/engine/lc_documentsnapshot.h \
+    lib/engine/lc_entityiterator.h \
     lib/printing/lc_printing.h \
+    lib/printing/lc_printpainter.h \
     actions/lc_actiondrawlinepolygon3.h \
     main/lc_application.h
 
@@ -228,6 +245,7 @@ SOURCES += \
     lib/actions/rs_snapper.cpp \
     lib/creation/rs_creation.cpp \
     lib/debug/rs_debug.cpp \
+    lib/debug/lc_trace.cpp \
     lib/engine/rs_arc.cpp \
     lib/engine/rs_block.cpp \
     lib/engine/rs_blocklist.cpp \
@@ -245,12 +263,14 @@ SOURCES += \
     lib/engine/rs_entity.cpp \
     lib/engine/rs_entitycontainer.cpp \
     lib/engine/rs_font.cpp \
+    lib/engine/rs_fontchar.cpp \
     lib/engine/rs_fontlist.cpp \
     lib/engine/rs_graphic.cpp \
     lib/engine/rs_hatch.cpp \
     lib/engine/lc_hyperbola.cpp \
     lib/engine/rs_insert.cpp \
     lib/engine/rs_image.cpp \
+    lib/engine/lc_imagepyramid.cpp \
     lib/engine/rs_layer.cpp \
     lib/engine/rs_layerlist.cpp \
     lib/engine/rs_leader.cpp \
@@ -291,6 +311,7 @@ SOURCES += \
     lib/information/rs_locale.cpp \
     lib/information/rs_information.cpp \
     lib/information/rs_infoarea.cpp \
+    lib/information/lc_intersectionindex.cpp \
     lib/math/rs_math.cpp \
     lib/math/lc_quadratic.cpp \
     lib/modification/rs_modification.cpp \
@@ -299,6 +320,12 @@ SOURCES += \
     lib/engine/rs_pen.cpp \
     actions/lc_actiondrawcircle2pr.cpp \
     test/lc_simpletests.cpp \
+    test/lc_selftest.cpp \
+    test/lc_intersectionindextest.cpp \
+    test/lc_informationtest.cpp \
+    test/lc_quadratictest.cpp \
+    test/lc_undotest.cpp \
+    test/lc_documentsnapshottest.cpp \
     lib/generators/lc_xmlwriterqxmlstreamwriter.cpp \
     lib/generators/lc_makercamsvg.cpp \
     actions/lc_actionfileexportmakercam.cpp \
@@ -307,8 +334,12 @@ SOURCES += \
     lib/engine/rs_flags.cpp \
     lib/engine/lc_rect.cpp \
     lib/engine/lc_undosection.cpp \
+    lib/engine/lc_undodelta.cpp \
+    lib/engine/lc_documentsnapshot.cpp \
+    lib/engine/lc_entityiterator.cpp \
     lib/engine/rs.cpp \
     lib/printing/lc_printing.cpp \
+    lib/printing/lc_printpainter.cpp \
     actions/lc_actiondrawlinepolygon3.cpp \
     main/lc_application.cpp
 
@@ -891,7 +922,12 @@ HEADERS += \
     main/main.h \
     main/mainwindowx.h \
     main/console_dxf2pdf/console_dxf2pdf.h \
-    main/console_dxf2pdf/pdf_print_loop.h
+    main/console_dxf2pdf/pdf_print_loop.h \
+    main/console_dxf2img/console_dxf2img.h \
+    main/console_dxf2img/img_export_loop.h \
+    main/console_benchmark/console_benchmark.h \
+    main/console_benchmark/benchmark_loop.h \
+    main/console_selftest/console_selftest.h
 
 SOURCES += \
     main/qc_applicationwindow.cpp \
@@ -904,7 +940,12 @@ SOURCES += \
     main/main.cpp \
     main/mainwindowx.cpp \
     main/console_dxf2pdf/console_dxf2pdf.cpp \
-    main/console_dxf2pdf/pdf_print_loop.cpp
+    main/console_dxf2pdf/pdf_print_loop.cpp \
+    main/console_dxf2img/console_dxf2img.cpp \
+    main/console_dxf2img/img_export_loop.cpp \
+    main/console_benchmark/console_benchmark.cpp \
+    main/console_benchmark/benchmark_loop.cpp \
+    main/console_selftest/console_selftest.cpp
 
 # If C99 emulation is needed, add the respective source files.
 contains(DEFINES, EMU_C99) {
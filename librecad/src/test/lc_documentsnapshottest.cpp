@@ -0,0 +1,159 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <future>
+#include <random>
+#include <vector>
+#include "lc_documentsnapshot.h"
+#include "lc_entityiterator.h"
+#include "lc_selftest.h"
+#include "lc_undodelta.h"
+#include "rs_block.h"
+#include "rs_circle.h"
+#include "rs_graphic.h"
+#include "rs_insert.h"
+#include "rs_layer.h"
+#include "rs_line.h"
+
+namespace {
+
+/**
+ * Values which a reader computes from the entities of a snapshot.
+ */
+struct Summary {
+    unsigned count {0};
+    double length {0.};
+    unsigned foreignBlocks {0};
+
+    bool operator == (const Summary& other) const {
+        return count == other.count && length == other.length
+            && foreignBlocks == other.foreignBlocks;
+    }
+};
+
+/**
+ * @param blocks Blocks of the snapshot, inserts must not use other blocks.
+ */
+Summary summarize(const RS_EntityContainer& entities, RS_BlockList* blocks)
+{
+    Summary summary;
+    LC_EntityIterator it( entities, RS2::ResolveAll);
+    for (RS_Entity* e = it.first(); e; e = it.next()) {
+        ++summary.count;
+        summary.length += e->getLength();
+    }
+    for (RS_Entity* e : entities) {
+        if (RS2::EntityInsert == e->rtti()) {
+            RS_Block* block = static_cast<RS_Insert*>(e)->getBlockForInsert();
+            if (nullptr == block || blocks->find( block->getName()) != block) {
+                ++summary.foreignBlocks;
+            }
+        }
+    }
+    return summary;
+}
+
+}
+
+/**
+ * Reads a snapshot in a worker thread, while the document is changed
+ * in place, by undo cycles and by removing the contents of its block.
+ */
+void lc_testDocumentSnapshot(LC_SelfTest& test)
+{
+    RS_Graphic graphic;
+    graphic.addLayer( new RS_Layer( "0"));
+    RS_Block* block = new RS_Block( &graphic, RS_BlockData( "B", RS_Vector( 0., 0.), false));
+    block->addEntity( new RS_Line( block, RS_Vector( 0., 0.), RS_Vector( 3., 4.)));
+    block->addEntity( new RS_Circle( block, RS_CircleData( RS_Vector( 0., 0.), 2.)));
+    graphic.addBlock( block);
+
+    std::mt19937 engine( 1);
+    std::uniform_real_distribution<double> coordinate( 0., 100.);
+    std::vector<RS_Entity*> entities;
+    for (int i = 0; i < 2000; ++i) {
+        RS_Vector position( coordinate( engine), coordinate( engine));
+        if (0 == i % 50) {
+            entities.push_back( new RS_Insert( &graphic,
+                                               RS_InsertData( "B", position, RS_Vector( 1., 1.),
+                                                              0., 1, 1, RS_Vector( 0., 0.))));
+            entities.back()->update();
+        }
+        else {
+            entities.push_back( new RS_Line( &graphic, position,
+                                             RS_Vector( coordinate( engine), coordinate( engine))));
+        }
+        graphic.addEntity( entities.back());
+    }
+
+    std::shared_ptr<const LC_DocumentSnapshot> snapshot = graphic.getSnapshot();
+    LC_CHECK( test, snapshot == graphic.getSnapshot());
+    LC_CHECK( test, snapshot == graphic.getLatestSnapshot());
+    LC_CHECK( test, snapshot->getMin() == graphic.getMin());
+    LC_CHECK( test, snapshot->getMax() == graphic.getMax());
+
+    // the snapshot has its own blocks, the first entity is an insert
+    RS_BlockList* blocks = static_cast<RS_Insert*>(*snapshot->getEntities().begin())
+                               ->getData().blockSource;
+    LC_CHECK( test, nullptr != blocks && graphic.getBlockList() != blocks);
+    Summary const expected = summarize( graphic, graphic.getBlockList());
+    LC_CHECK( test, expected == summarize( snapshot->getEntities(), blocks));
+
+    std::future<int> reader = std::async( std::launch::async, [snapshot, blocks, expected]() {
+        int mismatches = 0;
+        for (int i = 0; i < 50; ++i) {
+            if (!(expected == summarize( snapshot->getEntities(), blocks))) {
+                ++mismatches;
+            }
+        }
+        return mismatches;
+    });
+
+    for (int i = 0; i < 20; ++i) {
+        LC_UndoTransform transform( &graphic);
+        for (RS_Entity* e : entities) {
+            transform.addEntity( e);
+        }
+        transform.move( RS_Vector( 1., 2.));
+        transform.apply( false);
+
+        graphic.startUndoCycle();
+        RS_Entity* line = new RS_Line( &graphic, RS_Vector( 0., 0.), RS_Vector( i, 1.));
+        graphic.addEntity( line);
+        graphic.addUndoable( line);
+        graphic.endUndoCycle();
+    }
+    graphic.undo();
+    block->clear();
+    graphic.updateInserts();
+
+    LC_CHECK( test, 0 == reader.get());
+    LC_CHECK( test, expected == summarize( snapshot->getEntities(), blocks));
+
+    // changes by undo cycles and undo outdate the snapshot
+    std::shared_ptr<const LC_DocumentSnapshot> current = graphic.getSnapshot();
+    LC_CHECK( test, snapshot != current);
+    LC_CHECK( test, graphic.getRevision() == current->getRevision());
+    LC_CHECK( test, expected.count + 19 - 40 * 2 == current->getEntities().countDeep());
+}
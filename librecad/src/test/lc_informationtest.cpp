@@ -0,0 +1,172 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "lc_selftest.h"
+#include "rs_arc.h"
+#include "rs_circle.h"
+#include "rs_constructionline.h"
+#include "rs_entitycontainer.h"
+#include "rs_information.h"
+#include "rs_line.h"
+
+namespace {
+
+using Hits = std::vector<RS_Information::IntersectionHit>;
+
+/**
+ * @return true if getIntersections() finds the points and tangent flags
+ * getIntersection() finds for every candidate. Points of the closed-form
+ * solutions may differ by rounding, up to the given tolerance.
+ */
+bool sameAsSingleIntersections(RS_Entity* entity,
+                               std::vector<RS_Entity*> const& candidates,
+                               bool onEntities,
+                               double tolerance = 1.0e-7)
+{
+    Hits hits;
+    RS_Information::getIntersections( entity, candidates, hits, onEntities);
+
+    size_t next = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        RS_VectorSolutions sol = RS_Information::getIntersection( entity, candidates[i],
+                                                                  onEntities);
+        std::vector<RS_Vector> expected;
+        for (RS_Vector const& vp : sol) {
+            if (vp.valid) {
+                expected.push_back( vp);
+            }
+        }
+
+        for (size_t k = 0; k < expected.size(); ++k, ++next) {
+            if (hits.size() <= next
+                || hits[next].candidate != i
+                || hits[next].tangent != sol.isTangent()) {
+                return false;
+            }
+            // the order of the points of one candidate may differ
+            bool found = false;
+            for (RS_Vector const& other : expected) {
+                found = found || hits[next].point.distanceTo( other) <= tolerance;
+            }
+            if (!found) {
+                return false;
+            }
+        }
+    }
+
+    return hits.size() == next;
+}
+
+}
+
+/**
+ * Compares RS_Information::getIntersections() with getIntersection()
+ * for random lines, circles and arcs, and for lines which are nearly
+ * tangent to large circles, where the results depend on tolerances.
+ */
+void lc_testBatchIntersections(LC_SelfTest& test)
+{
+    RS_EntityContainer owner;
+    std::mt19937 engine( 1);
+    auto uniform = [&engine](double min, double max) {
+        return std::uniform_real_distribution<double>( min, max)( engine);
+    };
+
+    std::vector<RS_Entity*> lines;
+    std::vector<RS_Entity*> candidates;
+    for (int i = 0; i < 200; ++i) {
+        RS_Vector start( uniform( 0., 100.), uniform( 0., 100.));
+        RS_Vector end = start + RS_Vector::polar( uniform( 5., 50.), uniform( 0., 2. * M_PI));
+        RS_Entity* e = nullptr;
+        switch (i % 4) {
+        case 0:
+            e = new RS_Circle( &owner, RS_CircleData( start, uniform( 1., 20.)));
+            break;
+        case 1:
+            e = new RS_Arc( &owner, RS_ArcData( start, uniform( 1., 20.),
+                                                uniform( 0., 2. * M_PI),
+                                                uniform( 0., 2. * M_PI),
+                                                0 == i % 8));
+            break;
+        default:
+            e = new RS_Line( &owner, start, end);
+            lines.push_back( e);
+            break;
+        }
+        owner.addEntity( e);
+        candidates.push_back( e);
+    }
+    RS_Entity* construction = new RS_ConstructionLine( &owner,
+        RS_ConstructionLineData( RS_Vector( 0., 10.), RS_Vector( 100., 90.)));
+    owner.addEntity( construction);
+    candidates.push_back( construction);
+    lines.push_back( construction);
+
+    for (RS_Entity* line : lines) {
+        LC_CHECK( test, sameAsSingleIntersections( line, candidates, true));
+        LC_CHECK( test, sameAsSingleIntersections( line, candidates, false));
+    }
+
+    // lines crossing or passing a circle of radius 1000 close to the
+    // tangent point, given by the half length of the chord
+    const double radius = 1000.;
+    std::vector<RS_Entity*> circles;
+    circles.push_back( new RS_Circle( &owner, RS_CircleData( RS_Vector( 0., 0.), radius)));
+    circles.push_back( new RS_Arc( &owner, RS_ArcData( RS_Vector( 0., 0.), radius,
+                                                       0.25 * M_PI, 0.75 * M_PI, false)));
+    circles.push_back( new RS_Arc( &owner, RS_ArcData( RS_Vector( 0., 0.), radius,
+                                                       M_PI_2, M_PI, false)));
+    for (RS_Entity* e : circles) {
+        owner.addEntity( e);
+    }
+
+    const double halfChords[] = {0.45, 0.1, 0.02, 1.0e-3, 1.0e-5, 0.};
+    const double gaps[] = {1.0e-9, 1.0e-6, 1.0e-5, 5.0e-5, 1.0e-4, 2.0e-4};
+    std::vector<double> offsets;
+    for (double h : halfChords) {
+        offsets.push_back( std::sqrt( radius * radius - h * h));
+    }
+    for (double gap : gaps) {
+        offsets.push_back( radius + gap);
+    }
+
+    for (double offset : offsets) {
+        for (double length : {0.2, 1., 10.}) {
+            double angle = uniform( 0., 2. * M_PI);
+            RS_Vector normal = RS_Vector::polar( offset, angle);
+            RS_Vector along = RS_Vector::polar( length, angle + M_PI_2);
+            RS_Line line( &owner, normal - along, normal + along);
+            LC_CHECK( test, sameAsSingleIntersections( &line, circles, true));
+            LC_CHECK( test, sameAsSingleIntersections( &line, circles, false));
+
+            // the same at the top of the circle, where the arcs end
+            RS_Line top( &owner, RS_Vector( -length, offset), RS_Vector( length, offset));
+            LC_CHECK( test, sameAsSingleIntersections( &top, circles, true));
+            LC_CHECK( test, sameAsSingleIntersections( &top, circles, false));
+        }
+    }
+}
@@ -0,0 +1,216 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "lc_selftest.h"
+#include "lc_entityiterator.h"
+#include "lc_intersectionindex.h"
+#include "lc_undodelta.h"
+#include "rs_circle.h"
+#include "rs_graphic.h"
+#include "rs_information.h"
+#include "rs_line.h"
+#include "rs_polyline.h"
+
+namespace {
+
+/**
+ * Lines and circles at random positions, the same for every run.
+ */
+class RandomEntities
+{
+public:
+    RandomEntities() :
+        engine( 1)
+    {
+    }
+
+    RS_Entity* create(RS_EntityContainer* parent)
+    {
+        RS_Vector start( uniform( 0., 100.), uniform( 0., 100.));
+        if (0 == engine() % 4) {
+            return new RS_Circle( parent, RS_CircleData( start, uniform( 1., 10.)));
+        }
+
+        return new RS_Line( parent, start,
+                            start + RS_Vector::polar( uniform( 5., 30.),
+                                                      uniform( 0., 2. * M_PI)));
+    }
+
+    RS_Vector point()
+    {
+        return RS_Vector( uniform( 0., 100.), uniform( 0., 100.));
+    }
+
+private:
+    double uniform(double min, double max)
+    {
+        return std::uniform_real_distribution<double>( min, max)( engine);
+    }
+
+    std::mt19937 engine;
+};
+
+/**
+ * Nearest intersection of entity with all other entities of the
+ * document, found without the index.
+ */
+RS_Vector nearestWithoutIndex(RS_Document& document, RS_Entity* entity,
+                              const RS_Vector& coord)
+{
+    double minDist = RS_MAXDOUBLE;
+    double curDist = RS_MAXDOUBLE;
+    RS_Vector closestPoint( false);
+    LC_EntityIterator it( document, RS2::ResolveAllButTextImage);
+    for (RS_Entity* e = it.first(); e; e = it.next()) {
+        if (e == entity || !e->isVisible()) {
+            continue;
+        }
+
+        RS_VectorSolutions sol = RS_Information::getIntersection( entity, e, true);
+        RS_Vector point = sol.getClosest( coord, &curDist, nullptr);
+        if (0 < sol.getNumber() && curDist < minDist) {
+            closestPoint = point;
+            minDist = curDist;
+        }
+    }
+
+    return closestPoint;
+}
+
+/**
+ * @return Number of entities for which the index finds another nearest
+ * intersection than the search through all entities.
+ */
+int countMismatches(RS_Graphic& graphic, const std::vector<RS_Entity*>& entities,
+                    RandomEntities& random)
+{
+    int mismatches = 0;
+    LC_IntersectionIndex* index = graphic.getIntersectionIndex();
+    for (RS_Entity* e : entities) {
+        RS_Vector coord = random.point();
+        RS_Vector indexed = index->getNearestIntersection( e, coord);
+        RS_Vector expected = nearestWithoutIndex( graphic, e, coord);
+        if (indexed.valid != expected.valid
+            || (expected.valid && indexed.distanceTo( expected) > 1.0e-9)) {
+            ++mismatches;
+        }
+    }
+
+    return mismatches;
+}
+
+}
+
+/**
+ * Compares the intersections found with the index to those found by
+ * intersecting all entities, after the changes the index has to follow:
+ * transformations in place, removed entities and added entities.
+ * Only the latter two change the document revision.
+ */
+void lc_testIntersectionIndex(LC_SelfTest& test)
+{
+    RS_Graphic graphic;
+    RandomEntities random;
+    std::vector<RS_Entity*> entities;
+    for (int i = 0; i < 300; ++i) {
+        entities.push_back( random.create( &graphic));
+        graphic.addEntity( entities.back());
+    }
+    LC_CHECK( test, 0 == countMismatches( graphic, entities, random));
+
+    // repeated queries are answered from the cache
+    LC_CHECK( test, 0 == countMismatches( graphic, entities, random));
+
+    unsigned long revision = graphic.getRevision();
+    LC_UndoTransform transform( &graphic);
+    for (size_t i = 0; i < entities.size(); i += 3) {
+        transform.addEntity( entities[i]);
+    }
+    transform.rotate( RS_Vector( 50., 50.), 0.3);
+    transform.move( RS_Vector( 7.5, -3.25));
+    transform.apply( false);
+    LC_CHECK( test, revision == graphic.getRevision());
+    LC_CHECK( test, 0 == countMismatches( graphic, entities, random));
+
+    transform.apply( true);
+    LC_CHECK( test, 0 == countMismatches( graphic, entities, random));
+
+    std::vector<RS_Entity*> kept;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (1 == i % 5) {
+            graphic.removeEntity( entities[i]);
+        }
+        else {
+            kept.push_back( entities[i]);
+        }
+    }
+    entities.swap( kept);
+    LC_CHECK( test, revision != graphic.getRevision());
+    LC_CHECK( test, 0 == countMismatches( graphic, entities, random));
+
+    // entities of other containers of the document are not indexed
+    RS_EntityContainer preview( &graphic);
+    for (int i = 0; i < 20; ++i) {
+        preview.addEntity( random.create( &preview));
+    }
+    preview.clear();
+    LC_CHECK( test, 0 == countMismatches( graphic, entities, random));
+
+    for (int i = 0; i < 100; ++i) {
+        entities.push_back( random.create( &graphic));
+        graphic.addEntity( entities.back());
+    }
+    LC_CHECK( test, 0 == countMismatches( graphic, entities, random));
+
+    graphic.clear();
+    entities.clear();
+    entities.push_back( new RS_Line( &graphic, RS_Vector( 0., 0.), RS_Vector( 10., 10.)));
+    entities.push_back( new RS_Line( &graphic, RS_Vector( 0., 10.), RS_Vector( 10., 0.)));
+    for (RS_Entity* e : entities) {
+        graphic.addEntity( e);
+    }
+    RS_Vector crossing = graphic.getIntersectionIndex()
+                             ->getNearestIntersection( entities[0], RS_Vector( 4., 4.));
+    LC_CHECK( test, crossing.valid);
+    LC_CHECK_NEAR( test, crossing.x, 5., 1.0e-12);
+    LC_CHECK_NEAR( test, crossing.y, 5., 1.0e-12);
+
+    // a polyline growing while it's drawn, without undo cycle
+    RS_Polyline* polyline = new RS_Polyline( &graphic, RS_PolylineData());
+    polyline->addVertex( RS_Vector( 2., -1.));
+    polyline->addVertex( RS_Vector( 2., 1.));
+    graphic.addEntity( polyline);
+    crossing = graphic.getIntersectionIndex()
+                   ->getNearestIntersection( entities[0], RS_Vector( 2., 2.));
+    LC_CHECK_NEAR( test, crossing.x, 5., 1.0e-12);
+
+    polyline->addVertex( RS_Vector( 6., 10.));
+    crossing = graphic.getIntersectionIndex()
+                   ->getNearestIntersection( entities[0], RS_Vector( 2., 2.));
+    LC_CHECK_NEAR( test, crossing.x, 2.8, 1.0e-12);
+    LC_CHECK_NEAR( test, crossing.y, 2.8, 1.0e-12);
+}
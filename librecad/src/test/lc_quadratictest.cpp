@@ -0,0 +1,246 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <cmath>
+#include <vector>
+#include "lc_selftest.h"
+#include "lc_quadratic.h"
+#include "rs_math.h"
+#include "rs_vector.h"
+
+namespace {
+
+/**
+ * @return true if every expected point is found and nothing else.
+ * Symmetric cases may report double roots of the eliminated quartic twice.
+ */
+bool sameSolutions(RS_VectorSolutions const& sol,
+                   std::vector<RS_Vector> const& expected, double tolerance)
+{
+    if ((0 == sol.size()) != expected.empty()) {
+        return false;
+    }
+
+    RS_VectorSolutions const ref( expected);
+    for (RS_Vector const& v : expected) {
+        double dist = RS_MAXDOUBLE;
+        sol.getClosest( v, &dist);
+        if (dist > tolerance) {
+            return false;
+        }
+    }
+    for (RS_Vector const& v : sol) {
+        double dist = RS_MAXDOUBLE;
+        ref.getClosest( v, &dist);
+        if (dist > tolerance) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+struct CapturedCase {
+    const char* name;
+    std::vector<double> form1;
+    std::vector<double> form2;
+    std::vector<RS_Vector> solutions;
+};
+
+/**
+ * Forms given by their coefficients, see LC_Quadratic(std::vector<double>),
+ * and the solutions of LC_Quadratic::getIntersection() when it still used
+ * boost::numeric::ublas, including repeated roots.
+ */
+const std::vector<CapturedCase> capturedCases {
+    {"circle and line y=0.5",
+     {1., 0., 1., 0., 0., -1.}, {0., 1., -0.5},
+     {{0.8660254037844386, 0.5},
+      {-0.86602540378443871, 0.5}}},
+    {"line y=0.5 and circle",
+     {0., 1., -0.5}, {1., 0., 1., 0., 0., -1.},
+     {{0.8660254037844386, 0.5},
+      {-0.86602540378443871, 0.5}}},
+    {"circle and line x=0.5",
+     {1., 0., 1., 0., 0., -1.}, {1., 0., -0.5},
+     {{0.5, 0.8660254037844386},
+      {0.5, -0.86602540378443871}}},
+    {"slanted line and circle",
+     {1., 2., -1.}, {1., 0., 1., -2., 1., -3.},
+     {{3, -1},
+      {-0.59999999999999998, 0.80000000000000004}}},
+    {"two lines",
+     {1., 1., -1.}, {1., -1., 0.},
+     {{0.5, 0.5}}},
+    {"parallel lines",
+     {1., 1., -1.}, {1., 1., 1.},
+     {}},
+    {"two circles",
+     {1., 0., 1., 0., 0., -4.}, {1., 0., 1., -4., 0., 0.},
+     {{1, 1.7320508075688774},
+      {1, 1.7320508075688774},
+      {1, -1.7320508075688774},
+      {1, -1.7320508075688774}}},
+    {"touching circles",
+     {1., 0., 1., 0., 0., -1.}, {1., 0., 1., -4., 0., 3.},
+     {{1, 0}}},
+    {"separate circles",
+     {1., 0., 1., 0., 0., -1.}, {1., 0., 1., -10., 0., 24.},
+     {}},
+    {"concentric circles",
+     {1., 0., 1., 0., 0., -1.}, {1., 0., 1., 0., 0., -4.},
+     {}},
+    {"ellipse and circle",
+     {0.25, 0., 1., 0., 0., -1.}, {1., 0., 1., 0., 0., -2.25},
+     {{1.2909944487358056, 0.76376261582597338},
+      {-1.2909944487358056, 0.76376261582597338},
+      {1.2909944487358056, -0.76376261582597338},
+      {-1.2909944487358056, -0.76376261582597338},
+      {1.2909944487358056, 0.76376261582597338},
+      {-1.2909944487358056, 0.76376261582597338},
+      {1.2909944487358056, -0.76376261582597338},
+      {-1.2909944487358056, -0.76376261582597338}}},
+    {"line and ellipse",
+     {1., 2., -1.}, {1./9., 0., 0.25, 0., 0., -1.},
+     {{2.7115101530718508, -0.85575507653592542},
+      {-1.9915101530718513, 1.4957550765359255}}},
+    {"hyperbola and circle",
+     {1., 0., -1., 0., 0., -1.}, {1., 0., 1., 0., 0., -4.},
+     {{1.5811388300841895, 1.2247448713915889},
+      {-1.5811388300841895, 1.2247448713915889},
+      {1.5811388300841895, -1.2247448713915889},
+      {-1.5811388300841895, -1.2247448713915889},
+      {1.5811388300841895, 1.2247448713915889},
+      {-1.5811388300841895, 1.2247448713915889},
+      {1.5811388300841895, -1.2247448713915889},
+      {-1.5811388300841895, -1.2247448713915889}}},
+    {"parabola and line",
+     {1., 0., 0., 0., -1., 0.}, {-1., 1., -2.},
+     {{2, 4},
+      {-1, 1}}},
+    {"parabola and circle",
+     {1., 0., 0., 0., -1., 0.}, {1., 0., 1., 0., -2., -0.5},
+     {{1.1687708944803676, 1.3660254037844386},
+      {-1.1687708944803676, 1.3660254037844386},
+      {1.1687708944803676, 1.3660254037844386},
+      {-1.1687708944803676, 1.3660254037844386}}},
+    {"rotated conics",
+     {2., 1., 3., -1., 2., -5.}, {1., -0.5, 0.5, 0.5, -1., -2.},
+     {{-0.56401884099741795, -1.3899218492418663},
+      {1.4174877458168798, 0.49064089766241542}}},
+    {"two ellipses",
+     {1., 0., 4., 0., 0., -4.}, {4., 0., 1., 0., 0., -4.},
+     {{0.89442719099991586, 0.89442719099991586},
+      {-0.89442719099991586, 0.89442719099991586},
+      {0.89442719099991586, -0.89442719099991586},
+      {-0.89442719099991586, -0.89442719099991586},
+      {0.89442719099991586, 0.89442719099991586},
+      {-0.89442719099991586, 0.89442719099991586},
+      {0.89442719099991586, -0.89442719099991586},
+      {-0.89442719099991586, -0.89442719099991586}}},
+    {"line near tangent to circle r=1000",
+     {1., 0., 1., 0., 0., -1.0e6}, {0., 1., -999.99989875},
+     {{0.4499999886219257, 999.99989875000006},
+      {-0.4499999886219257, 999.99989875000006}}},
+    {"line tangent to circle r=1000",
+     {1., 0., 1., 0., 0., -1.0e6}, {0., 1., -1000.},
+     {}},
+    {"line beside circle r=1000",
+     {1., 0., 1., 0., 0., -1.0e6}, {0., 1., -1000.0001},
+     {}},
+};
+
+}
+
+/**
+ * Intersections of quadratic forms: analytic cases, moved, rotated and
+ * flipped forms, and the results captured from the ublas implementation.
+ */
+void lc_testQuadratic(LC_SelfTest& test)
+{
+    double const s3 = std::sqrt( 3.);
+
+    // x^2 + y^2 - 1 = 0, y - 0.5 = 0
+    LC_Quadratic const unitCircle( {1., 0., 1., 0., 0., -1.});
+    LC_Quadratic const horizontal( {0., 1., -0.5});
+    LC_CHECK( test, sameSolutions( LC_Quadratic::getIntersection( unitCircle, horizontal),
+                                   {{0.5 * s3, 0.5}, {-0.5 * s3, 0.5}}, RS_TOLERANCE));
+    LC_CHECK( test, sameSolutions( LC_Quadratic::getIntersection( horizontal, unitCircle),
+                                   {{0.5 * s3, 0.5}, {-0.5 * s3, 0.5}}, RS_TOLERANCE));
+
+    // vertical line x = 0.5, solved with flipped coordinates
+    LC_CHECK( test, sameSolutions( LC_Quadratic::getIntersection( unitCircle,
+                                                                  LC_Quadratic( {1., 0., -0.5})),
+                                   {{0.5, 0.5 * s3}, {0.5, -0.5 * s3}}, RS_TOLERANCE));
+
+    // two lines x + y - 1 = 0, x - y = 0
+    LC_CHECK( test, sameSolutions( LC_Quadratic::getIntersection( LC_Quadratic( {1., 1., -1.}),
+                                                                  LC_Quadratic( {1., -1., 0.})),
+                                   {{0.5, 0.5}}, RS_TOLERANCE));
+    LC_CHECK( test, sameSolutions( LC_Quadratic::getIntersection( LC_Quadratic( {1., 1., -1.}),
+                                                                  LC_Quadratic( {1., 1., 1.})),
+                                   {}, RS_TOLERANCE));
+
+    // circles of radius 2 around (0, 0) and (2, 0)
+    LC_Quadratic const c0( {1., 0., 1., 0., 0., -4.});
+    LC_Quadratic c1( c0);
+    c1.move( {2., 0.});
+    LC_CHECK( test, sameSolutions( LC_Quadratic::getIntersection( c0, c1),
+                                   {{1., s3}, {1., -s3}}, RS_TOLERANCE));
+
+    // x^2/4 + y^2 = 1, x^2 + y^2 = 2.25
+    LC_Quadratic const ellipse( {0.25, 0., 1., 0., 0., -1.});
+    LC_Quadratic const circle( {1., 0., 1., 0., 0., -2.25});
+    double const x = std::sqrt( 5. / 3.);
+    double const y = std::sqrt( 7. / 12.);
+    LC_CHECK( test, sameSolutions( LC_Quadratic::getIntersection( ellipse, circle),
+                                   {{x, y}, {x, -y}, {-x, y}, {-x, -y}}, RS_TOLERANCE));
+
+    // the solutions must follow the forms when both are moved and rotated
+    RS_Vector const center( 3., -2.);
+    double const angle = 0.3;
+    LC_Quadratic e1( ellipse);
+    LC_Quadratic e2( circle);
+    e1.move( center);
+    e1.rotate( center, angle);
+    e2.move( center);
+    e2.rotate( center, angle);
+    std::vector<RS_Vector> moved;
+    for (RS_Vector const& v : {RS_Vector{x, y}, RS_Vector{x, -y}, RS_Vector{-x, y}, RS_Vector{-x, -y}}) {
+        moved.push_back( (v + center).rotate( center, angle));
+    }
+    LC_CHECK( test, sameSolutions( LC_Quadratic::getIntersection( e1, e2), moved, RS_TOLERANCE));
+
+    // flipXY() swaps the coordinates of the solutions
+    LC_CHECK( test, sameSolutions( LC_Quadratic::getIntersection( ellipse.flipXY(), circle.flipXY()),
+                                   {{y, x}, {-y, x}, {y, -x}, {-y, -x}}, RS_TOLERANCE));
+
+    for (CapturedCase const& captured : capturedCases) {
+        RS_VectorSolutions const sol = LC_Quadratic::getIntersection( LC_Quadratic( captured.form1),
+                                                                      LC_Quadratic( captured.form2));
+        test.check( sol.size() == captured.solutions.size()
+                    && sameSolutions( sol, captured.solutions, 1.0e-9),
+                    captured.name, __FILE__, __LINE__);
+    }
+}
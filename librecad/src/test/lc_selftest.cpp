@@ -0,0 +1,74 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <cmath>
+#include <QDebug>
+#include "lc_selftest.h"
+
+LC_SelfTest::LC_SelfTest(const QString& name) :
+    name( name)
+{
+}
+
+/**
+ * @return condition, a failure is reported when it is false.
+ */
+bool LC_SelfTest::check(bool condition, const char* expression,
+                        const char* file, int line)
+{
+    ++checks;
+    if (!condition) {
+        fail( QString( "%1 is false").arg( expression), file, line);
+    }
+
+    return condition;
+}
+
+/**
+ * @return true if value differs from expected by tolerance at most,
+ * a failure with both values is reported otherwise.
+ */
+bool LC_SelfTest::checkNear(double value, double expected, double tolerance,
+                            const char* expression, const char* file, int line)
+{
+    ++checks;
+    bool ok = std::fabs( value - expected) <= tolerance;
+    if (!ok) {
+        fail( QString( "%1 is %2, expected %3 +- %4")
+                  .arg( expression)
+                  .arg( value, 0, 'g', 17)
+                  .arg( expected, 0, 'g', 17)
+                  .arg( tolerance),
+              file, line);
+    }
+
+    return ok;
+}
+
+void LC_SelfTest::fail(const QString& message, const char* file, int line)
+{
+    ++failures;
+    qDebug( "FAIL %s: %s:%d: %s", qPrintable( name), file, line,
+            qPrintable( message));
+}
@@ -0,0 +1,74 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+#ifndef LC_SELFTEST_H
+#define LC_SELFTEST_H
+
+#include <QString>
+
+/**
+ * Collects the results of one self test, run headless by
+ * "librecad selftest". Every failed check is printed with its
+ * source location, the failures are counted.
+ */
+class LC_SelfTest
+{
+public:
+    explicit LC_SelfTest(const QString& name);
+
+    bool check(bool condition, const char* expression,
+               const char* file, int line);
+    bool checkNear(double value, double expected, double tolerance,
+                   const char* expression, const char* file, int line);
+
+    QString getName() const {
+        return name;
+    }
+    int getChecks() const {
+        return checks;
+    }
+    int getFailures() const {
+        return failures;
+    }
+
+private:
+    void fail(const QString& message, const char* file, int line);
+
+    QString name;
+    int checks {0};
+    int failures {0};
+};
+
+#define LC_CHECK(test, condition) \
+    (test).check((condition), #condition, __FILE__, __LINE__)
+#define LC_CHECK_NEAR(test, value, expected, tolerance) \
+    (test).checkNear((value), (expected), (tolerance), #value, __FILE__, __LINE__)
+
+void lc_testIntersectionIndex(LC_SelfTest& test);
+void lc_testBatchIntersections(LC_SelfTest& test);
+void lc_testQuadratic(LC_SelfTest& test);
+void lc_testUndoAttributes(LC_SelfTest& test);
+void lc_testUndoTransform(LC_SelfTest& test);
+void lc_testDocumentSnapshot(LC_SelfTest& test);
+
+#endif // LC_SELFTEST_H
@@ -25,6 +25,7 @@
 #include "rs_entitycontainer.h"
 #include "rs_layer.h"
 #include "rs_graphicview.h"
+#include "rs_dialogfactory.h"
 #include "rs_debug.h"
 
 LC_SimpleTests::LC_SimpleTests(QWidget *parent):
@@ -44,6 +45,11 @@ LC_SimpleTests::LC_SimpleTests(QWidget *parent):
 				this, SLOT(slotTestDumpUndo()));
 		testMenu->addAction(action);
 
+		action = new QAction("Undo Memory Usage", this);
+		connect(action, SIGNAL(triggered()),
+				this, SLOT(slotTestUndoMemory()));
+		testMenu->addAction(action);
+
 		action = new QAction("Update Inserts", this);
 		connect(action, SIGNAL(triggered()),
 				this, SLOT(slotTestUpdateInserts()));
@@ -416,6 +422,24 @@ void LC_SimpleTests::slotTestDumpUndo() {
 	RS_DEBUG->print("%s\n: end\n", __func__);
 }
 
+/**
+ * Testing function.
+ */
+void LC_SimpleTests::slotTestUndoMemory() {
+	RS_DEBUG->print("%s\n: begin\n", __func__);
+
+	RS_Document* d = QC_ApplicationWindow::getAppWindow()->getDocument();
+	if (d) {
+		RS_DIALOGFACTORY->commandMessage(
+					QString("Undo: %1 undo / %2 redo steps, %3 undoables, %4 KiB")
+					.arg(d->countUndoCycles())
+					.arg(d->countRedoCycles())
+					.arg(d->countUndoables())
+					.arg(d->getUndoMemoryUsage() / 1024));
+	}
+	RS_DEBUG->print("%s\n: end\n", __func__);
+}
+
 /**
  * Testing function.
  */
@@ -18,6 +18,8 @@ public slots:
 	void slotTestDumpEntities(RS_EntityContainer* d = nullptr);
 	/** dumps undo info to stdout */
 	void slotTestDumpUndo();
+	/** shows undo history memory estimate in the command widget */
+	void slotTestUndoMemory();
 	/** updates all inserts */
 	void slotTestUpdateInserts();
 	/** draws some random lines */
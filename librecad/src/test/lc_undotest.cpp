@@ -0,0 +1,220 @@
+/******************************************************************************
+**
+** This file was created for the LibreCAD project, a 2D CAD program.
+**
+** Copyright (C) 2018 LibreCAD.org
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+******************************************************************************/
+
+#include <algorithm>
+#include <vector>
+#include "lc_selftest.h"
+#include "rs_arc.h"
+#include "rs_block.h"
+#include "rs_ellipse.h"
+#include "rs_graphic.h"
+#include "rs_insert.h"
+#include "rs_layer.h"
+#include "rs_line.h"
+#include "rs_modification.h"
+#include "rs_polyline.h"
+#include "rs_spline.h"
+
+namespace {
+
+RS_Insert* addInsert(RS_Graphic& graphic, const QString& block, const RS_Vector& position)
+{
+    RS_Insert* insert = new RS_Insert( &graphic,
+                                       RS_InsertData( block, position, RS_Vector( 1., 1.),
+                                                      0., 1, 1, RS_Vector( 0., 0.),
+                                                      graphic.getBlockList()));
+    graphic.addEntity( insert);
+    return insert;
+}
+
+void changeColor(RS_Graphic& graphic, const RS_Color& color)
+{
+    RS_AttributesData data;
+    data.pen = RS_Pen( color, RS2::Width00, RS2::SolidLine);
+    data.changeLayer = false;
+    data.changeColor = true;
+    data.changeLineType = false;
+    data.changeWidth = false;
+    RS_Modification( graphic, nullptr, true).changeAttributes( data);
+}
+
+bool isSame(const RS_ArcData& a, const RS_ArcData& b)
+{
+    return a.center == b.center && a.radius == b.radius
+        && a.angle1 == b.angle1 && a.angle2 == b.angle2 && a.reversed == b.reversed;
+}
+
+bool isSame(const RS_EllipseData& a, const RS_EllipseData& b)
+{
+    return a.center == b.center && a.majorP == b.majorP && a.ratio == b.ratio
+        && a.angle1 == b.angle1 && a.angle2 == b.angle2 && a.reversed == b.reversed;
+}
+
+/**
+ * Geometry of the entities used by lc_testUndoTransform().
+ */
+struct TransformedEntities {
+    RS_Line* line;
+    RS_Arc* arc;
+    RS_Ellipse* ellipse;
+    RS_Polyline* polyline;
+    RS_Spline* spline;
+};
+
+struct TransformedState {
+    explicit TransformedState(const TransformedEntities& e) :
+        lineStart( e.line->getStartpoint()),
+        lineEnd( e.line->getEndpoint()),
+        arc( e.arc->getData()),
+        ellipse( e.ellipse->getData()),
+        polylineStart( e.polyline->getStartpoint()),
+        polylineEnd( e.polyline->getEndpoint()),
+        segment( static_cast<RS_Arc*>(e.polyline->entityAt( 1))->getData()),
+        controlPoints( e.spline->getControlPoints())
+    {
+    }
+
+    bool isSame(const TransformedState& other) const
+    {
+        return lineStart == other.lineStart && lineEnd == other.lineEnd
+            && ::isSame( arc, other.arc) && ::isSame( ellipse, other.ellipse)
+            && polylineStart == other.polylineStart && polylineEnd == other.polylineEnd
+            && ::isSame( segment, other.segment);
+    }
+
+    double controlPointError(const TransformedState& other) const
+    {
+        double error = 0.;
+        for (size_t i = 0; i < controlPoints.size(); ++i) {
+            error = std::max( error, controlPoints[i].distanceTo( other.controlPoints[i]));
+        }
+        return error;
+    }
+
+    RS_Vector lineStart;
+    RS_Vector lineEnd;
+    RS_ArcData arc;
+    RS_EllipseData ellipse;
+    RS_Vector polylineStart;
+    RS_Vector polylineEnd;
+    RS_ArcData segment;
+    std::vector<RS_Vector> controlPoints;
+};
+
+}
+
+/**
+ * Changes the color of inserts, which changes the entities of their
+ * block, and undoes and redoes it.
+ */
+void lc_testUndoAttributes(LC_SelfTest& test)
+{
+    RS_Color const red( 255, 0, 0);
+    RS_Color const green( 0, 255, 0);
+    RS_Color const blue( 0, 0, 255);
+
+    RS_Graphic graphic;
+    graphic.addLayer( new RS_Layer( "0"));
+    RS_Block* block = new RS_Block( &graphic, RS_BlockData( "B", RS_Vector( 0., 0.), false));
+    RS_Line* line = new RS_Line( block, RS_Vector( 0., 0.), RS_Vector( 10., 0.));
+    line->setPen( RS_Pen( red, RS2::Width00, RS2::SolidLine));
+    block->addEntity( line);
+    graphic.addBlock( block);
+
+    RS_Insert* first = addInsert( graphic, "B", RS_Vector( 0., 0.));
+    first->setSelected( true);
+    changeColor( graphic, green);
+    LC_CHECK( test, green == line->getPen( false).getColor());
+    LC_CHECK( test, green == first->getPen( false).getColor());
+
+    graphic.undo();
+    LC_CHECK( test, red == line->getPen( false).getColor());
+    graphic.redo();
+    LC_CHECK( test, green == line->getPen( false).getColor());
+
+    // the block is changed once for each insert, undo restores the first state
+    RS_Insert* second = addInsert( graphic, "B", RS_Vector( 20., 0.));
+    first->setSelected( true);
+    second->setSelected( true);
+    changeColor( graphic, blue);
+    LC_CHECK( test, blue == line->getPen( false).getColor());
+    graphic.undo();
+    LC_CHECK( test, green == line->getPen( false).getColor());
+    LC_CHECK( test, green == first->getPen( false).getColor());
+    graphic.redo();
+    LC_CHECK( test, blue == line->getPen( false).getColor());
+}
+
+/**
+ * Rotates entities in place and undoes and redoes the rotation many
+ * times. Lines, arcs, ellipses and polylines are restored exactly, other
+ * entities like splines within rounding errors, which don't accumulate.
+ */
+void lc_testUndoTransform(LC_SelfTest& test)
+{
+    RS_Graphic graphic;
+    graphic.addLayer( new RS_Layer( "0"));
+
+    TransformedEntities e;
+    e.line = new RS_Line( &graphic, RS_Vector( 1.1, 2.3), RS_Vector( 17.7, -4.9));
+    e.arc = new RS_Arc( &graphic, RS_ArcData( RS_Vector( 3.3, 4.4), 5.5, 0.3, 2.1, false));
+    e.ellipse = new RS_Ellipse( &graphic, RS_EllipseData{ RS_Vector( -7.1, 2.9), RS_Vector( 4.3, 1.7),
+                                                          0.37, 0.2, 4.1, true});
+    e.polyline = new RS_Polyline( &graphic);
+    e.polyline->addVertex( RS_Vector( 0.1, 0.3), 0.);
+    e.polyline->addVertex( RS_Vector( 10.7, 0.2), 0.45);
+    e.polyline->addVertex( RS_Vector( 10.3, 10.9));
+    e.spline = new RS_Spline( &graphic, RS_SplineData( 3, false));
+    e.spline->addControlPoint( RS_Vector( 0.3, 0.7));
+    e.spline->addControlPoint( RS_Vector( 5.1, 9.3));
+    e.spline->addControlPoint( RS_Vector( 11.9, -3.1));
+    e.spline->addControlPoint( RS_Vector( 17.3, 4.1));
+    e.spline->update();
+    for (RS_Entity* entity : std::vector<RS_Entity*>{ e.line, e.arc, e.ellipse, e.polyline, e.spline}) {
+        graphic.addEntity( entity);
+        entity->setSelected( true);
+    }
+    TransformedState const original( e);
+
+    RS_RotateData data;
+    data.number = 0;
+    data.useCurrentAttributes = false;
+    data.useCurrentLayer = false;
+    data.center = RS_Vector( 12.34, -5.67);
+    data.angle = 0.7;
+    RS_Modification( graphic, nullptr, true).rotate( data);
+    TransformedState const rotated( e);
+    LC_CHECK( test, !original.isSame( rotated));
+
+    for (int i = 0; i < 500; ++i) {
+        graphic.undo();
+        graphic.redo();
+    }
+    LC_CHECK( test, rotated.isSame( TransformedState( e)));
+    LC_CHECK( test, rotated.controlPointError( TransformedState( e)) < 1.0e-12);
+
+    graphic.undo();
+    LC_CHECK( test, original.isSame( TransformedState( e)));
+    LC_CHECK( test, original.controlPointError( TransformedState( e)) < 1.0e-12);
+}
@@ -30,6 +30,7 @@
 #include "rs_system.h"
 #include "rs_settings.h"
 #include "rs_units.h"
+#include "rs_undo.h"
 #include "qg_filedialog.h"
 #include "rs_debug.h"
 
@@ -179,6 +180,8 @@ void QG_DlgOptionsGeneral::init()
     // Auto save timer
     cbAutoSaveTime->setValue(RS_SETTINGS->readNumEntry("/AutoSaveTime", 5));
     cbAutoBackup->setChecked(RS_SETTINGS->readNumEntry("/AutoBackupDocument", 1));
+    sbMaxUndoSteps->setValue(RS_SETTINGS->readNumEntry("/MaxUndoSteps", 0));
+    sbMaxUndoMemory->setValue(RS_SETTINGS->readNumEntry("/MaxUndoMemory", 256));
     cbUseQtFileOpenDialog->setChecked(RS_SETTINGS->readNumEntry("/UseQtFileOpenDialog", 1));
     cbWheelScrollInvertH->setChecked(RS_SETTINGS->readNumEntry("/WheelScrollInvertH", 0));
     cbWheelScrollInvertV->setChecked(RS_SETTINGS->readNumEntry("/WheelScrollInvertV", 0));
@@ -271,6 +274,9 @@ void QG_DlgOptionsGeneral::ok()
             RS_Units::unitToString( RS_Units::stringToUnit( cbUnit->currentText() ), false/*untr.*/) );
         RS_SETTINGS->writeEntry("/AutoSaveTime", cbAutoSaveTime->value() );
         RS_SETTINGS->writeEntry("/AutoBackupDocument", cbAutoBackup->isChecked() ? 1 : 0);
+        RS_SETTINGS->writeEntry("/MaxUndoSteps", sbMaxUndoSteps->value());
+        RS_SETTINGS->writeEntry("/MaxUndoMemory", sbMaxUndoMemory->value());
+        RS_Undo::setLimits(sbMaxUndoSteps->value(), sbMaxUndoMemory->value());
         RS_SETTINGS->writeEntry("/UseQtFileOpenDialog", cbUseQtFileOpenDialog->isChecked() ? 1 : 0);
         RS_SETTINGS->writeEntry("/WheelScrollInvertH", cbWheelScrollInvertH->isChecked() ? 1 : 0);
         RS_SETTINGS->writeEntry("/WheelScrollInvertV", cbWheelScrollInvertV->isChecked() ? 1 : 0);
@@ -37,6 +37,7 @@ QG_DlgOptionsMakerCam::QG_DlgOptionsMakerCam(QWidget* parent, bool modal, Qt::Wi
     this->gbDashLines->setToolTip(tr("Many CAM's(MakerCAM, EleskCAM, LaserWeb) ignore dashed/doted line style, \nwhich can be useful in lasercut of plywood or for papercraft. "));
     this->dSpinBoxDefaultElementWidth->setToolTip(tr("Default width of elements can affect some CAM's/SVG Editors, \nbut ignored by other"));
     this->dSpinBoxDashLinePatternLength->setToolTip(tr("Length of line pattern related to zoom, \nso default step value required for baking"));
+    this->gbPaths->setToolTip(tr("Lines and arcs of a layer which are connected end to start \nare written as one <path>, so CAM's see them as one contour \nand the file gets smaller."));
 
     loadSettings();
 }
@@ -67,6 +68,7 @@ void QG_DlgOptionsMakerCam::loadSettings() {
     updateCheckbox(checkEllipsesToBeziers, "ConvertEllipsesToBeziers", 1);
     updateCheckbox(checkImages, "ExportImages", 0);
     updateCheckbox(checkDashDotLines, "BakeDashDotLines", 0);
+    updateCheckbox(checkMergePaths, "MergeConnectedPaths", 0);
     updateDoubleSpinBox(dSpinBoxDefaultElementWidth, "DefaultElementWidth", 1.0);
     updateDoubleSpinBox(dSpinBoxDashLinePatternLength, "DefaultDashLinePatternLength", 2.5);
     RS_SETTINGS->endGroup();
@@ -92,6 +94,7 @@ void QG_DlgOptionsMakerCam::saveSettings() {
     saveBoolean("ConvertEllipsesToBeziers", checkEllipsesToBeziers);
     saveBoolean("ExportImages", checkImages);
     saveBoolean("BakeDashDotLines", checkDashDotLines);
+    saveBoolean("MergeConnectedPaths", checkMergePaths);
     saveDouble("DefaultElementWidth", dSpinBoxDefaultElementWidth);
     saveDouble("DefaultDashLinePatternLength", dSpinBoxDashLinePatternLength);
 
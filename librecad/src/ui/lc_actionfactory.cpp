@@ -1115,6 +1115,12 @@ void LC_ActionFactory::fillActionContainer(QMap<QString, QAction*>& a_map, LC_Ac
     action->setObjectName("ViewStatusBar");
     a_map["ViewStatusBar"] = action;
 
+    action = new QAction(tr("&Frame Time"), agm->view);
+    action->setCheckable(true);
+    connect(action, SIGNAL(toggled(bool)), main_window, SLOT(slotViewFrameTime(bool)));
+    action->setObjectName("ViewFrameTime");
+    a_map["ViewFrameTime"] = action;
+
     action = new QAction(tr("Focus on &Command Line"), agm->view);
     action->setIcon(QIcon(":/main/editclear.png"));
     QList<QKeySequence> commandLineShortcuts;
@@ -619,6 +619,7 @@ void LC_WidgetFactory::createMenus(QMenuBar* menu_bar)
     view_menu->addAction(a_map["ViewStatusBar"]);
     view_menu->addAction(a_map["ViewGrid"]);
     view_menu->addAction(a_map["ViewDraft"]);
+    view_menu->addAction(a_map["ViewFrameTime"]);
     view_menu->addSeparator();
     view_menu->addAction(a_map["ZoomRedraw"]);
     view_menu->addAction(a_map["ZoomIn"]);
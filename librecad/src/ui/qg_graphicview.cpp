@@ -30,6 +30,7 @@
 #include <QLabel>
 #include <QMenu>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QNativeGestureEvent>
 
 #include "rs_actionzoomin.h"
@@ -49,6 +50,7 @@
 #include "qg_scrollbar.h"
 #include "rs_modification.h"
 #include "rs_debug.h"
+#include "lc_trace.h"
 
 #ifdef Q_OS_WIN32
 #define CURSOR_SIZE 16
@@ -70,7 +72,7 @@ QG_GraphicView::QG_GraphicView(QWidget* parent, Qt::WindowFlags f, RS_Document*
     ,redrawMethod(RS2::RedrawAll)
     ,isSmoothScrolling(false)
 {
-    RS_DEBUG->print("QG_GraphicView::QG_GraphicView()..");
+    RS_DEBUG_PRINT_DEBUG("QG_GraphicView::QG_GraphicView()..");
 
     if (doc)
     {
@@ -243,14 +245,14 @@ void QG_GraphicView::redraw(RS2::RedrawMethod method) {
 
 
 void QG_GraphicView::resizeEvent(QResizeEvent* /*e*/) {
-    RS_DEBUG->print("QG_GraphicView::resizeEvent begin");
+    RS_DEBUG_PRINT_DEBUG("QG_GraphicView::resizeEvent begin");
     adjustOffsetControls();
     adjustZoomControls();
 //     updateGrid();
         // Small hack, delete the snapper during resizes
         getOverlayContainer(RS2::Snapper)->clear();
         redraw();
-    RS_DEBUG->print("QG_GraphicView::resizeEvent end");
+    RS_DEBUG_PRINT_DEBUG("QG_GraphicView::resizeEvent end");
 }
 
 void QG_GraphicView::mousePressEvent(QMouseEvent* event)
@@ -286,7 +288,7 @@ void QG_GraphicView::mouseDoubleClickEvent(QMouseEvent* e)
 
 void QG_GraphicView::mouseReleaseEvent(QMouseEvent* event)
 {
-    RS_DEBUG->print("QG_GraphicView::mouseReleaseEvent");
+    RS_DEBUG_PRINT_DEBUG("QG_GraphicView::mouseReleaseEvent");
 
     event->accept();
 
@@ -336,7 +338,7 @@ void QG_GraphicView::mouseReleaseEvent(QMouseEvent* event)
         eventHandler->mouseReleaseEvent(event);
         break;
     }
-    RS_DEBUG->print("QG_GraphicView::mouseReleaseEvent: OK");
+    RS_DEBUG_PRINT_DEBUG("QG_GraphicView::mouseReleaseEvent: OK");
 }
 
 
@@ -905,6 +907,9 @@ void QG_GraphicView::layerActivated(RS_Layer *layer) {
  */
 void QG_GraphicView::paintEvent(QPaintEvent *)
 {
+    LC_TRACE_SCOPE("paint", "paintEvent");
+    QElapsedTimer frameTimer;
+    frameTimer.start();
 
     // Re-Create or get the layering pixmaps
     getPixmapForView(PixmapLayer1);
@@ -922,6 +927,8 @@ void QG_GraphicView::paintEvent(QPaintEvent *)
 
     if (redrawMethod & RS2::RedrawDrawing)
     {
+        QElapsedTimer drawingTimer;
+        drawingTimer.start();
         view_rect = LC_Rect(toGraph(0, 0),
                             toGraph(getWidth(), getHeight()));
         // DRaw layer 2
@@ -937,6 +944,7 @@ void QG_GraphicView::paintEvent(QPaintEvent *)
         painter2.setDrawSelectedOnly(true);
         drawLayer2((RS_Painter*)&painter2);
         painter2.end();
+        drawingTime = drawingTimer.nsecsElapsed() / 1.0e6;
     }
 
     if (redrawMethod & RS2::RedrawOverlay)
@@ -956,6 +964,21 @@ void QG_GraphicView::paintEvent(QPaintEvent *)
     wPainter.drawPixmap(0,0,*PixmapLayer1);
     wPainter.drawPixmap(0,0,*PixmapLayer2);
     wPainter.drawPixmap(0,0,*PixmapLayer3);
+
+    if (frameTimeShown)
+    {
+        // the time of this frame, without showing it
+        QString text = tr("Frame: %1 ms, drawing: %2 ms")
+            .arg(frameTimer.nsecsElapsed() / 1.0e6, 0, 'f', 1)
+            .arg(drawingTime, 0, 'f', 1);
+        QRect rect = wPainter.fontMetrics().boundingRect(text)
+            .translated(8, 8 + wPainter.fontMetrics().ascent())
+            .adjusted(-4, -2, 4, 2);
+        wPainter.QPainter::fillRect(rect, QColor(0, 0, 0, 160));
+        wPainter.QPainter::setPen(Qt::white);
+        wPainter.QPainter::drawText(rect, Qt::AlignCenter, text);
+    }
+
     wPainter.end();
 
     redrawMethod=RS2::RedrawNone;
@@ -966,6 +989,12 @@ void QG_GraphicView::setAntialiasing(bool state)
 	antialiasing = state;
 }
 
+void QG_GraphicView::setFrameTimeShown(bool state)
+{
+    frameTimeShown = state;
+    redraw(RS2::RedrawOverlay);
+}
+
 void QG_GraphicView::addScrollbars()
 {
     scrollbars = true;
@@ -92,6 +92,8 @@ public:
 	RS_Vector getMousePosition() const override;
 
     void setAntialiasing(bool state);
+    /** Shows the time spent in the last paint event in the view. */
+    void setFrameTimeShown(bool state);
     void setCursorHiding(bool state);
     void addScrollbars();
     bool hasScrollbars();
@@ -160,6 +162,9 @@ protected:
 
 private:
     bool antialiasing{false};
+    bool frameTimeShown{false};
+    //! Time of the last redraw of the drawing layer, in ms
+    double drawingTime{0.};
     bool scrollbars{false};
     bool cursor_hiding{false};
 
@@ -26,6 +26,7 @@
 **********************************************************************/
 #include "qg_librarywidget.h"
 
+#include <algorithm>
 #include <QVBoxLayout>
 #include <QTreeView>
 #include <QListView>
@@ -34,17 +35,24 @@
 #include <QDesktopServices>
 #include <QApplication>
 #include <QDateTime>
-#include <QImageWriter>
+#include <QCryptographicHash>
 #include <QMouseEvent>
+#include <QProgressBar>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QThread>
 
 #include "rs_system.h"
 #include "rs_settings.h"
-#include "rs_painterqt.h"
-#include "rs_staticgraphicview.h"
 #include "rs_actionlibraryinsert.h"
 #include "qg_actionhandler.h"
 #include "rs_debug.h"
 
+namespace {
+//! number of thumbnails rendered by one worker process
+const int thumbnailBatchSize = 8;
+}
+
 /*
  *  Constructs a QG_LibraryWidget as a child of 'parent', with the
  *  name 'name' and widget flags set to 'f'.
@@ -56,6 +64,8 @@ QG_LibraryWidget::QG_LibraryWidget(QWidget* parent, const char* name, Qt::Window
 {
     setObjectName(name);
 	actionHandler = nullptr;
+    thumbnailTempDir = nullptr;
+    thumbnailBatches = 0;
 
     QVBoxLayout *vboxLayout = new QVBoxLayout(this);
     vboxLayout->setSpacing(2);
@@ -67,6 +77,10 @@ QG_LibraryWidget::QG_LibraryWidget(QWidget* parent, const char* name, Qt::Window
     ivPreview = new QListView(this);
     ivPreview->setViewMode(QListView::IconMode);
     vboxLayout->addWidget(ivPreview);
+    thumbnailProgress = new QProgressBar(this);
+    thumbnailProgress->setFormat(tr("Thumbnails %v/%m"));
+    thumbnailProgress->hide();
+    vboxLayout->addWidget(thumbnailProgress);
     bInsert = new QPushButton(tr("Insert"), this);
     vboxLayout->addWidget(bInsert);
 
@@ -101,6 +115,8 @@ QG_LibraryWidget::QG_LibraryWidget(QWidget* parent, const char* name, Qt::Window
  */
 QG_LibraryWidget::~QG_LibraryWidget()
 {
+    cancelThumbnails();
+    delete thumbnailTempDir;
     // no need to delete child widgets, Qt does it all for us
 //    delete model; //??????
 /*    QStandardItemModel *model;
@@ -247,6 +263,9 @@ void QG_LibraryWidget::updatePreview(QModelIndex idx) {
 
     QApplication::setOverrideCursor( QCursor(Qt::WaitCursor) );
 
+    // thumbnails of the previous directory aren't needed anymore
+    cancelThumbnails();
+
     // dir from the point of view of the library browser (e.g. /mechanical/screws)
     QString directory = getItemDir(item); //RLZ change to do-while
     iconModel->clear();
@@ -272,14 +291,35 @@ void QG_LibraryWidget::updatePreview(QModelIndex idx) {
     // Sort entries:
     itemPathList.sort();
 
-    // Fill items into icon view:
+    // Fill items into icon view, missing thumbnails are rendered in the background:
+    QPixmap placeholder(64,64);
+    placeholder.fill(Qt::white);
     QStandardItem* newItem;
     for (int i = 0; i < itemPathList.size(); ++i) {
-		QString label = QFileInfo(itemPathList.at(i)).completeBaseName();
-        QIcon icon = getIcon(directory, QFileInfo(itemPathList.at(i)).fileName(), itemPathList.at(i));
+        QFileInfo const fiDxf(itemPathList.at(i));
+        QString label = fiDxf.completeBaseName();
+        QString pngPath = getPathToPixmap(directory, fiDxf.fileName(), itemPathList.at(i));
+        QIcon icon;
+        if (pngPath.isEmpty()) {
+            icon = QIcon(placeholder);
+            // files which couldn't be rendered are only tried again when they change
+            QString const cachePath = getThumbnailCachePath(itemPathList.at(i));
+            if (!failedThumbnails.contains(cachePath)) {
+                thumbnailQueue.append(ThumbnailJob{itemPathList.at(i), QString(), cachePath, i});
+            }
+        } else {
+            icon = QIcon(pngPath);
+        }
         newItem = new QStandardItem(icon, label);
         iconModel->setItem(i, newItem);
     }
+
+    if (!thumbnailQueue.isEmpty()) {
+        thumbnailProgress->setRange(0, thumbnailQueue.size());
+        thumbnailProgress->setValue(0);
+        thumbnailProgress->show();
+        startThumbnailWorkers();
+    }
     QApplication::restoreOverrideCursor();
 }
 
@@ -332,49 +372,25 @@ QString QG_LibraryWidget::getItemPath(QStandardItem* item) {
 
 
 /**
- * @return Pixmap that serves as icon for the given DXF File.
- * The existing PNG file is returned or created and returned..
+ * @return Path to the thumbnail of the given DXF file, either a PNG file next to it
+ * in one of the library directories or one in the thumbnail cache. If no up to date
+ * thumbnail exists, an empty string is returned.
  *
  * @param dir Library directory (e.g. "/mechanical/screws")
  * @param dxfFile File name (e.g. "screw1.dxf")
- * @param dxfPath Full path to the existing DXF file on disk 
+ * @param dxfPath Full path to the existing DXF file on disk
  *                          (e.g. /home/tux/.qcad/library/mechanical/screws/screw1.dxf)
  */
-QIcon QG_LibraryWidget::getIcon(const QString& dir, const QString& dxfFile,
-                                    const QString& dxfPath) {
-    QString pngFile = getPathToPixmap(dir, dxfFile, dxfPath);
-    QFileInfo fiPng(pngFile);
-
-    // found existing thumbnail:
-    if (fiPng.isFile()) {
-        return QIcon(pngFile);
-    }
-    // default thumbnail:
-    else {
-        return QIcon(QPixmap(64,64));
-    }
-}
-
-
-
-/**
- * @return Path to the thumbnail of the given DXF file. If no thumbnail exists, one is
- * created in the user's home. If no thumbnail can be created, an empty string is returned.
- */
 QString QG_LibraryWidget::getPathToPixmap(const QString& dir,
         const QString& dxfFile,
         const QString& dxfPath) {
 
-    // the thumbnail must be created in the user's home.
-    QString iconCacheLocation=QStandardPaths::writableLocation(QStandardPaths::DataLocation) + QDir::separator() + "iconCache" + QDir::separator();
-
     RS_DEBUG->print("QG_LibraryWidget::getPathToPixmap: "
                     "dir: '%s' dxfFile: '%s' dxfPath: '%s'",
                     dir.toLatin1().data(), dxfFile.toLatin1().data(), dxfPath.toLatin1().data());
 
     // List of all directories that contain part libraries:
     QStringList directoryList = RS_SYSTEM->getDirectoryList("library");
-    directoryList.prepend(iconCacheLocation);
     QStringList::Iterator it;
 
     QFileInfo fiDxf(dxfPath);
@@ -405,56 +421,193 @@ QString QG_LibraryWidget::getPathToPixmap(const QString& dir,
         }
     }
 
-    // create all directories needed:
-    RS_SYSTEM->createPaths(iconCacheLocation + dir);
-
-//    QString foo=iconCacheLocation + dir + QDir::separator() + fiDxf.baseName() + ".png";
-    pngPath = iconCacheLocation + dir + QDir::separator() + fiDxf.baseName() + ".png";
-
-    QPixmap* buffer = new QPixmap(128,128);
-    RS_PainterQt painter(buffer);
-    painter.setBackground(RS_Color(255,255,255));
-    painter.eraseRect(0,0, 128,128);
-
-    RS_StaticGraphicView gv(128,128, &painter);
-    RS_Graphic graphic;
-    if (graphic.open(dxfPath, RS2::FormatUnknown)) {
-        gv.setContainer(&graphic);
-        gv.zoomAuto(false);
-        // gv.drawEntity(&graphic, true);
-
-        for (RS_Entity* e=graphic.firstEntity(RS2::ResolveAll);
-                e; e=graphic.nextEntity(RS2::ResolveAll)) {
-            if (e->rtti() != RS2::EntityHatch){
-                RS_Pen pen = e->getPen();
-                pen.setColor(Qt::black);
-                e->setPen(pen);
-            }
-            gv.drawEntity(&painter, e);
+    pngPath = getThumbnailCachePath(dxfPath);
+    if (QFileInfo(pngPath).isFile()) {
+        RS_DEBUG->print("QG_LibraryWidget::getPathToPixmap: cached thumbnail found: '%s'",
+                        pngPath.toLatin1().data());
+        return pngPath;
+    }
+
+    return "";
+}
+
+
+
+/**
+ * @return Path of the cached thumbnail of the given DXF file in the user's home,
+ * named "<base>-<path key>-<version key>.png". The path key identifies the file,
+ * the version key depends on its size and modification time, so a changed
+ * file gets a new thumbnail and the outdated ones can be found by the path key.
+ */
+QString QG_LibraryWidget::getThumbnailCachePath(const QString& dxfPath) {
+    QFileInfo const fiDxf(dxfPath);
+    QByteArray const pathKey = QCryptographicHash::hash(
+                fiDxf.absoluteFilePath().toUtf8(),
+                QCryptographicHash::Md5).toHex();
+    QByteArray const versionKey = QCryptographicHash::hash(
+                QString("%1|%2")
+                .arg(fiDxf.size())
+                .arg(fiDxf.lastModified().toMSecsSinceEpoch()).toUtf8(),
+                QCryptographicHash::Md5).toHex();
+
+    return QStandardPaths::writableLocation(QStandardPaths::DataLocation)
+            + "/iconCache/" + fiDxf.completeBaseName() + "-" + QString(pathKey)
+            + "-" + QString(versionKey) + ".png";
+}
+
+
+
+/**
+ * Removes the outdated cached thumbnails of the DXF file which the given,
+ * up to date thumbnail belongs to. Also removes thumbnails of the former
+ * "<base>-<key>.png" scheme with the same base name, they aren't used anymore.
+ */
+void QG_LibraryWidget::pruneThumbnailCache(const QString& pngPath) {
+    QFileInfo const fiPng(pngPath);
+    QString const name = fiPng.fileName();
+    // "<base>-<path key>-", keys are 32 hex digits
+    QString const prefix = name.left(name.lastIndexOf('-') + 1);
+    QString const base = prefix.left(prefix.size() - 34);
+
+    QDir cacheDir = fiPng.absoluteDir();
+    QStringList const stale = cacheDir.entryList(
+                QStringList() << prefix + "*.png"
+                              << base + "-" + QString(32, '?') + ".png",
+                QDir::Files);
+    for (auto const& file: stale) {
+        if (file != name) {
+            RS_DEBUG->print("QG_LibraryWidget::pruneThumbnailCache: removing '%s'",
+                            file.toLatin1().data());
+            cacheDir.remove(file);
         }
+    }
+}
+
+
+
+/**
+ * Renders the queued thumbnails in worker processes which run this program
+ * as dxf2png tool, a batch of files each. The drawing engine isn't thread safe,
+ * so rendering can't be moved to threads.
+ */
+void QG_LibraryWidget::startThumbnailWorkers() {
+    if (!thumbnailTempDir) {
+        thumbnailTempDir = new QTemporaryDir();
+    }
+    QString const cacheDir = QStandardPaths::writableLocation(QStandardPaths::DataLocation)
+            + "/iconCache";
+    if (!thumbnailTempDir->isValid() || !RS_SYSTEM->createPaths(cacheDir)) {
+        RS_DEBUG->print(RS_Debug::D_ERROR,
+                        "QG_LibraryWidget::startThumbnailWorkers: Cannot create thumbnail directories");
+        cancelThumbnails();
+        return;
+    }
+
+    int const maxWorkers = std::max(1, QThread::idealThreadCount());
+    while (!thumbnailQueue.isEmpty() && thumbnailWorkers.size() < maxWorkers) {
+        QString const outDir = QString("%1/%2").arg(thumbnailTempDir->path()).arg(thumbnailBatches++);
+        QStringList args;
+        args << "dxf2png" << "--size" << "128x128" << "--monochrome"
+             << "--tile-size" << "0" << "--directory" << outDir;
+
+        QList<ThumbnailJob> batch;
+        while (!thumbnailQueue.isEmpty() && batch.size() < thumbnailBatchSize) {
+            ThumbnailJob job = thumbnailQueue.takeFirst();
+            job.imagePath = outDir + "/" + QFileInfo(job.dxfPath).completeBaseName() + ".png";
+            args << job.dxfPath;
+            batch.append(job);
+        }
+
+        QProcess* worker = new QProcess(this);
+        connect(worker, SIGNAL(finished(int,QProcess::ExitStatus)),
+                this, SLOT(thumbnailWorkerFinished(int,QProcess::ExitStatus)));
+        connect(worker, SIGNAL(error(QProcess::ProcessError)),
+                this, SLOT(thumbnailWorkerError(QProcess::ProcessError)));
+        thumbnailWorkers.insert(worker, batch);
+        worker->start(QCoreApplication::applicationFilePath(), args);
+    }
+}
+
+
+
+/**
+ * Stops rendering thumbnails, for example if another directory is shown.
+ */
+void QG_LibraryWidget::cancelThumbnails() {
+    thumbnailQueue.clear();
+    for (auto it = thumbnailWorkers.begin(); it != thumbnailWorkers.end(); ++it) {
+        // don't wait for the killed worker, it deletes itself when it has exited
+        QProcess* worker = it.key();
+        worker->disconnect(this);
+        if (worker->state() == QProcess::NotRunning) {
+            worker->deleteLater();
+        } else {
+            connect(worker, SIGNAL(finished(int,QProcess::ExitStatus)),
+                    worker, SLOT(deleteLater()));
+            worker->kill();
+        }
+    }
+    thumbnailWorkers.clear();
+    thumbnailProgress->hide();
+}
+
+
+
+void QG_LibraryWidget::thumbnailWorkerFinished(int /*exitCode*/, QProcess::ExitStatus /*exitStatus*/) {
+    finishThumbnailWorker(qobject_cast<QProcess*>(sender()));
+}
+
+
+
+void QG_LibraryWidget::thumbnailWorkerError(QProcess::ProcessError error) {
+    // other errors are followed by finished()
+    if (error == QProcess::FailedToStart) {
+        finishThumbnailWorker(qobject_cast<QProcess*>(sender()));
+    }
+}
+
+
+
+/**
+ * Stores the thumbnails rendered by the worker in the cache, shows them
+ * and starts the next batch.
+ */
+void QG_LibraryWidget::finishThumbnailWorker(QProcess* worker) {
+    if (!worker || !thumbnailWorkers.contains(worker)) {
+        return;
+    }
+    QList<ThumbnailJob> const batch = thumbnailWorkers.take(worker);
+    worker->deleteLater();
+
+    for (auto const& job: batch) {
+        QImage img(job.imagePath);
+        if (img.isNull()) {
+            RS_DEBUG->print(RS_Debug::D_ERROR,
+                            "QG_LibraryWidget::finishThumbnailWorker: Cannot render thumbnail: '%s'",
+                            job.dxfPath.toLatin1().data());
+            failedThumbnails.insert(job.pngPath);
+            continue;
+        }
+        QFile::remove(job.imagePath);
 
-        QImageWriter iio;
-        QImage img;
-        img = buffer->toImage();
         img = img.scaled(64,64, Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
-        // iio.setImage(img);
-        iio.setFileName(pngPath);
-        iio.setFormat("PNG");
-        if (!iio.write(img)) {
-            pngPath = "";
+        if (img.save(job.pngPath, "PNG")) {
+            pruneThumbnailCache(job.pngPath);
+        } else {
             RS_DEBUG->print(RS_Debug::D_ERROR,
-                            "QG_LibraryWidget::getPathToPixmap: Cannot write thumbnail: '%s'",
-                            pngPath.toLatin1().data());
+                            "QG_LibraryWidget::finishThumbnailWorker: Cannot write thumbnail: '%s'",
+                            job.pngPath.toLatin1().data());
         }
-    } else {
-        RS_DEBUG->print(RS_Debug::D_ERROR,
-                        "QG_LibraryWidget::getPathToPixmap: Cannot open file: '%s'",
-                        dxfPath.toLatin1().data());
-    }
 
-    // GraphicView deletes painter
-    painter.end();
-    delete buffer;
+        QStandardItem* item = iconModel->item(job.row);
+        if (item) {
+            item->setIcon(QIcon(QPixmap::fromImage(img)));
+        }
+    }
 
-    return pngPath;
+    thumbnailProgress->setValue(thumbnailProgress->value() + batch.size());
+    startThumbnailWorkers();
+    if (thumbnailWorkers.isEmpty()) {
+        thumbnailProgress->hide();
+    }
 }
@@ -28,6 +28,10 @@
 
 #include <QWidget>
 #include <QModelIndex>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QProcess>
 
 class QG_ActionHandler;
 class QStandardItemModel;
@@ -35,6 +39,8 @@ class QStandardItem;
 class QTreeView;
 class QListView;
 class QPushButton;
+class QProgressBar;
+class QTemporaryDir;
 
 class QG_LibraryWidget : public QWidget
 {
@@ -48,8 +54,12 @@ public:
 private:
     virtual QString getItemDir( QStandardItem * item );
     virtual QString getItemPath( QStandardItem * item );
-    virtual QIcon getIcon( const QString & dir, const QString & dxfFile, const QString & dxfPath );
     virtual QString getPathToPixmap( const QString & dir, const QString & dxfFile, const QString & dxfPath );
+    QString getThumbnailCachePath( const QString & dxfPath );
+    void pruneThumbnailCache( const QString & pngPath );
+    void startThumbnailWorkers();
+    void cancelThumbnails();
+    void finishThumbnailWorker( QProcess * worker );
 
 public slots:
     virtual void setActionHandler( QG_ActionHandler * ah );
@@ -60,6 +70,10 @@ public slots:
     virtual void expandView( QModelIndex idx );
     virtual void collapseView( QModelIndex idx );
 
+private slots:
+    void thumbnailWorkerFinished( int exitCode, QProcess::ExitStatus exitStatus );
+    void thumbnailWorkerError( QProcess::ProcessError error );
+
 signals:
     void escape();
 
@@ -72,6 +86,24 @@ private:
     QStandardItemModel *iconModel;
     QTreeView *dirView;
     QListView *ivPreview;
+    QProgressBar *thumbnailProgress;
+
+    /** A thumbnail which is rendered by a worker process. */
+    struct ThumbnailJob {
+        QString dxfPath;
+        /** Image written by the worker. */
+        QString imagePath;
+        /** Thumbnail in the cache. */
+        QString pngPath;
+        /** Row of the item in iconModel. */
+        int row;
+    };
+    QList<ThumbnailJob> thumbnailQueue;
+    QHash<QProcess*, QList<ThumbnailJob>> thumbnailWorkers;
+    /** Cache paths of thumbnails which couldn't be rendered. */
+    QSet<QString> failedThumbnails;
+    QTemporaryDir *thumbnailTempDir;
+    int thumbnailBatches;
 };
 
 #endif // QG_LIBRARYWIDGET_H